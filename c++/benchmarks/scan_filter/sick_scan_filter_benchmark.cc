@@ -0,0 +1,135 @@
+/*!
+ * \file sick_scan_filter_benchmark.cc
+ * \brief Times the SickScanFilter stages on synthetic scans.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+/* Implementation dependencies */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <sicktoolbox/SickScan.hh>
+#include <sicktoolbox/SickScanFilter.hh>
+
+/* Use the namespace */
+using namespace SickToolbox;
+
+/* Scans timed per stage */
+#define NUM_ITERATIONS (20000)
+
+/**
+ * \brief Current time (usecs)
+ */
+static double now_usecs( ) {
+  struct timespec curr_time;
+  clock_gettime(CLOCK_MONOTONIC,&curr_time);
+  return curr_time.tv_sec*1e6 + curr_time.tv_nsec/1e3;
+}
+
+/**
+ * \brief Fills a scan w/ a noisy room: walls, a few occluding posts and some dropouts
+ */
+static void fill_scan( SickScan &sick_scan, const unsigned int num_beams, const double start_angle, const double step_angle ) {
+
+  sick_scan.Resize(num_beams);
+  sick_scan.FillAngles(0,num_beams,start_angle,step_angle);
+
+  float * const range_values = sick_scan.GetRangeValues();
+  uint32_t * const flag_values = sick_scan.GetFlagValues();
+
+  srand(1);
+  for (unsigned int i = 0; i < num_beams; i++) {
+    const double noise = 0.02*(rand()/(double)RAND_MAX - 0.5);
+    double range = 6.0 + 2.0*sin(i*0.01) + noise;
+    if (i % 97 < 6) {
+      range = 1.5 + noise;                      // a post in front of the wall
+    }
+    range_values[i] = (rand() % 50 == 0) ? 0.0f : (float)range;
+    flag_values[i] = (range_values[i] == 0) ? SickScan::SICK_SCAN_FLAG_NO_RETURN : SickScan::SICK_SCAN_FLAG_NONE;
+  }
+
+}
+
+/**
+ * \brief Times one filter (or the whole chain) on a copy of the scan
+ */
+static void time_stage( const char * const stage_name, const SickScan &sick_scan, SickScanFilterChain &sick_scan_chain ) {
+
+  SickScan work_scan;
+  work_scan.CopyFrom(sick_scan);
+  sick_scan_chain.Reserve(sick_scan.GetNumBeams());
+
+  /* Restoring the ranges is part of each iteration, so time it on its own too */
+  double copy_time = 0, total_time = 0;
+  for (unsigned int i = 0; i < NUM_ITERATIONS; i++) {
+    const double beg_time = now_usecs();
+    memcpy(work_scan.GetRangeValues(),sick_scan.GetRangeValues(),sick_scan.GetNumBeams()*sizeof(float));
+    memcpy(work_scan.GetFlagValues(),sick_scan.GetFlagValues(),sick_scan.GetNumBeams()*sizeof(uint32_t));
+    const double mid_time = now_usecs();
+    sick_scan_chain.Apply(work_scan);
+    total_time += now_usecs() - mid_time;
+    copy_time += mid_time - beg_time;
+  }
+
+  printf("  %-20s %8.2f us/scan (restore %.2f us)\n",stage_name,total_time/NUM_ITERATIONS,copy_time/NUM_ITERATIONS);
+
+}
+
+int main( ) {
+
+  const SickScanRangeClipFilter clip_filter(0.1,20.0);
+  const SickScanMedianFilter median3_filter(3);
+  const SickScanMedianFilter median5_filter(5);
+  const SickScanMedianFilter median7_filter(7);
+  const SickScanShadowFilter shadow_filter(10.0,1);
+
+  /* An LMS 1xx scan (270 deg @ 0.25 deg) and an LD scan (360 deg @ 0.125 deg) */
+  const unsigned int num_beams[2] = {1082, 2881};
+  const double start_angles[2] = {-135.0, 0.0};
+  const double step_angles[2] = {0.25, 0.125};
+
+  for (unsigned int s = 0; s < 2; s++) {
+
+    SickScan sick_scan;
+    fill_scan(sick_scan,num_beams[s],start_angles[s],step_angles[s]);
+    printf("%u beams:\n",num_beams[s]);
+
+    SickScanFilterChain sick_scan_chain;
+
+    sick_scan_chain.ClearFilters(); sick_scan_chain.AddFilter(clip_filter);
+    time_stage("clip",sick_scan,sick_scan_chain);
+
+    sick_scan_chain.ClearFilters(); sick_scan_chain.AddFilter(median3_filter);
+    time_stage("median3",sick_scan,sick_scan_chain);
+
+    sick_scan_chain.ClearFilters(); sick_scan_chain.AddFilter(median5_filter);
+    time_stage("median5",sick_scan,sick_scan_chain);
+
+    sick_scan_chain.ClearFilters(); sick_scan_chain.AddFilter(median7_filter);
+    time_stage("median7",sick_scan,sick_scan_chain);
+
+    sick_scan_chain.ClearFilters(); sick_scan_chain.AddFilter(shadow_filter);
+    time_stage("shadow",sick_scan,sick_scan_chain);
+
+    sick_scan_chain.ClearFilters();
+    sick_scan_chain.AddFilter(clip_filter);
+    sick_scan_chain.AddFilter(median5_filter);
+    sick_scan_chain.AddFilter(shadow_filter);
+    time_stage("clip+median5+shadow",sick_scan,sick_scan_chain);
+
+  }
+
+  return 0;
+
+}
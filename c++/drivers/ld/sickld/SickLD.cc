@@ -39,6 +39,8 @@
 #include <sicktoolbox/SickLDBufferMonitor.hh>
 #include <sicktoolbox/SickLDUtility.hh>   
 #include <sicktoolbox/SickException.hh>
+#include <sicktoolbox/SickLogger.hh>
+#include <sicktoolbox/SickTrace.hh>
 
 /* Associate the namespace */
 namespace SickToolbox {
@@ -55,7 +57,28 @@ namespace SickToolbox {
     _sick_sensor_mode(SICK_SENSOR_MODE_UNKNOWN),
     _sick_motor_mode(SICK_MOTOR_MODE_UNKNOWN),
     _sick_streaming_range_data(false),
-    _sick_streaming_range_and_echo_data(false)
+    _sick_streaming_range_and_echo_data(false),
+    _sick_pose_callback(NULL),
+    _sick_pose_user_data(NULL),
+    _sick_clock_sync_running(false),
+    _sick_clock_sync_period(DEFAULT_SICK_CLOCK_SYNC_PERIOD),
+    _sick_clock_sync_send_time(0),
+    _sick_clock_sync_profile_recvd(false),
+    _sick_scan_profile(NULL),
+    _sick_profile_ring(NULL),
+    _sick_profile_messages(NULL),
+    _sick_profile_recv_times(NULL),
+    _sick_profile_ring_size(0),
+    _sick_profile_ring_head(0),
+    _sick_profile_stream_synced(false),
+    _sick_profile_stream_fault(false),
+    _sick_profile_stream_last_number(0),
+    _sick_profile_stream_last_counter(0),
+    _sick_profile_stream_num_lost(0),
+    _sick_profile_stream_num_skipped(0),
+    _sick_sector_callback(NULL),
+    _sick_sector_mask(0),
+    _sick_sector_user_data(NULL)
   {
     /* Initialize the sick identity */
     _sick_identity.sick_part_number =
@@ -78,12 +101,42 @@ namespace SickToolbox {
 
     /* Initialize the sector configuration structure */
     memset(&_sick_sector_config,0,sizeof(sick_ld_config_sector_t));
+
+    /* Initialize the clock sync state */
+    pthread_mutex_init(&_sick_clock_sync_mutex,NULL);
+    pthread_cond_init(&_sick_clock_sync_cond,NULL);
+
+    /* Request/reply exchanges may nest (e.g. a clock sample taken while holding the device) */
+    pthread_mutexattr_t device_mutex_attr;
+    pthread_mutexattr_init(&device_mutex_attr);
+    pthread_mutexattr_settype(&device_mutex_attr,PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&_sick_device_mutex,&device_mutex_attr);
+    pthread_mutexattr_destroy(&device_mutex_attr);
   }
 
   /**
    * A standard destructor
    */
-  SickLD::~SickLD( ) { }
+  SickLD::~SickLD( ) {
+
+    try {
+      StopSickClockSync();
+    }
+
+    catch (...) {
+      SICK_LOG_ERROR("SickLD::~SickLD: Failed to stop the clock sync thread!");
+    }
+
+    delete _sick_scan_profile;
+    delete [] _sick_profile_ring;
+    delete [] _sick_profile_messages;
+    delete [] _sick_profile_recv_times;
+
+    pthread_cond_destroy(&_sick_clock_sync_cond);
+    pthread_mutex_destroy(&_sick_clock_sync_mutex);
+    pthread_mutex_destroy(&_sick_device_mutex);
+
+  }
 
   /**
    * \brief Initializes the driver and syncs it with Sick LD unit. Uses sector config given in flash.
@@ -111,22 +164,22 @@ namespace SickToolbox {
     }
     
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickLD::Initialize - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLD::Initialize - Unknown exception!");
       throw;
     }
     
@@ -157,17 +210,17 @@ namespace SickToolbox {
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickLD::GetSickStatus - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLD::GetSickStatus - Unknown exception!");
       throw;
     }
     
@@ -207,22 +260,22 @@ namespace SickToolbox {
     }
     
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     catch(...) {
-      std::cerr << "SickLD::Initialize - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLD::Initialize - Unknown exception!");
       throw;
     }
     
@@ -256,25 +309,25 @@ namespace SickToolbox {
                
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::SetSickTimeAbsolute: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::SetSickTimeAbsolute: Unknown exception!!!");
 	throw;
       }  
       
@@ -304,19 +357,19 @@ namespace SickToolbox {
             
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }
 
@@ -331,6 +384,9 @@ namespace SickToolbox {
     memcpy(&clock_time,&payload_buffer[2],2);
     new_sick_clock_time = sick_ld_to_host_byte_order(clock_time);
 
+    /* The old clock mapping no longer holds */
+    _resetSickClockSync();
+
     std::cout << "\t\tClock time set!" << std::endl;
   
     /* Success */
@@ -362,25 +418,25 @@ namespace SickToolbox {
       
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::SetSickTimeRelative: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::SetSickTimeRelative: Unknown exception!!!");
 	throw;
       }  
       
@@ -410,19 +466,19 @@ namespace SickToolbox {
             
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickTimeRelative: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickTimeRelative: Unknown exception!!!");
       throw;
     }
 
@@ -437,6 +493,9 @@ namespace SickToolbox {
     memcpy(&clock_time,&payload_buffer[2],2);
     new_sick_clock_time = sick_ld_to_host_byte_order(clock_time);
 
+    /* The old clock mapping no longer holds */
+    _resetSickClockSync();
+
     std::cout << "\t\tClock time set!" << std::endl;
   
     /* Success */
@@ -465,25 +524,25 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_syncDriverWithSick: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_syncDriverWithSick: Unknown exception!!!");
       throw;
     } 
 
@@ -522,19 +581,19 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::GetSickSignals: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::GetSickSignals: Unknown exception!!!");
       throw;
     }
     
@@ -580,19 +639,19 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::GetSickTime: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::GetSickTime: Unknown exception!!!");
       throw;
     }
 
@@ -609,6 +668,65 @@ namespace SickToolbox {
 
     /* Success */
   }
+  /**
+   * \brief Starts sampling the internal clock in the background to map device time to host time
+   * \param sample_period The time between clock samples (usecs)
+   *
+   * NOTE: While no data stream is active the clock thread takes regular GetSickTime round
+   *       trips. While a profile stream (see StartSickProfileStream) is running, it sends
+   *       GET_SYNC_CLOCK right after a profile has been received and the reply is picked
+   *       up by DrainSickProfiles and timed by its arrival, so the scan path never waits
+   *       on a clock request. Streams without the monitor's FIFO (GetSickMeasurements,
+   *       GetSickScan) are not sampled, as a reply could overwrite a profile in the single
+   *       message slot. Use GetSickClockSync() to convert sector/measurement timestamps to
+   *       host monotonic time.
+   *
+   * NOTE: SetSickTimeAbsolute/SetSickTimeRelative drop the current mapping, and
+   *       Uninitialize stops the sampler (restart it after the next Initialize).
+   */
+  void SickLD::StartSickClockSync( const unsigned int sample_period ) throw( SickIOException, SickThreadException ) {
+
+    /* Ensure the device has been initialized */
+    if (!_sick_initialized) {
+      throw SickIOException("SickLD::StartSickClockSync: Device NOT Initialized!!!");
+    }
+
+    if (_sick_clock_sync_running) {
+      return;
+    }
+
+    _sick_clock_sync_period = sample_period;
+    _sick_clock_sync_send_time = 0;
+    _sick_clock_sync_running = true;
+
+    if (pthread_create(&_sick_clock_sync_thread_id,NULL,SickLD::_clockSyncThread,this) != 0) {
+      _sick_clock_sync_running = false;
+      throw SickThreadException("SickLD::StartSickClockSync: pthread_create() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Stops the background clock sampling (the current mapping is kept)
+   */
+  void SickLD::StopSickClockSync( ) throw( SickThreadException ) {
+
+    if (!_sick_clock_sync_running) {
+      return;
+    }
+
+    /* Wake the thread up so it notices */
+    pthread_mutex_lock(&_sick_clock_sync_mutex);
+    _sick_clock_sync_running = false;
+    pthread_cond_broadcast(&_sick_clock_sync_cond);
+    pthread_mutex_unlock(&_sick_clock_sync_mutex);
+
+    if (pthread_join(_sick_clock_sync_thread_id,NULL) != 0) {
+      throw SickThreadException("SickLD::StopSickClockSync: pthread_join() failed!");
+    }
+
+  }
+
 
   /**
    * \brief Enables nearfield suppressive filtering
@@ -632,25 +750,25 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::EnableNearfieldSuppression: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::EnableNearfieldSuppression: Unknown exception!!!");
       throw;
     }  
     
@@ -681,25 +799,25 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::DisableNearfieldSuppression: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::DisableNearfieldSuppression: Unknown exception!!!");
       throw;
     }  
     
@@ -733,6 +851,21 @@ namespace SickToolbox {
    *                                 the ith active sector.
    * \param *sector_stop_timestamps  An array where the ith element denotes the time at which the last scan was taken for
    *                                 the ith active sector.
+   * \param *scan_angles             A single array holding the scan angle of each range measurement. It is indexed the
+   *                                 same as range_measurements (Default: NULL).
+   * \param *scan_timestamps         A single array holding the time (in ms, interpolated between the sector's start and
+   *                                 stop timestamps) of each range measurement. It is indexed the same as range_measurements
+   *                                 (Default: NULL).
+   *
+   * NOTE: Measurements are passed through the scan ROI (see SetSickScanROI) while the profile is parsed,
+   *       so num_measurements[i] only counts the beams it selects. Use scan_angles to recover their directions.
+   *       If a pose lookup is registered (see SetSickPoseCallback) the ranges and scan angles are deskewed into
+   *       the sensor frame at the first measurement of the profile. Subscribed sectors (see SetSickSectorCallback)
+   *       are handed over while the profile is parsed, i.e. before this method returns and before the
+   *       profile's sensor/motor status is checked.
+   *
+   * NOTE: The sector timestamps are unwrapped against the first sector of the profile, so a later
+   *       sector's timestamps may exceed 65535 (ms) when the device counter wrapped mid-profile.
    *
    * ALERT: The user is responsible for ensuring that enough space is allocated for the return buffers to avoid overflow.
    *        See the example code for an easy way to do this.
@@ -746,7 +879,9 @@ namespace SickToolbox {
 				    double * const sector_start_angles,
 				    double * const sector_stop_angles,
 				    unsigned int * const sector_start_timestamps,
-				    unsigned int * const sector_stop_timestamps )
+				    unsigned int * const sector_stop_timestamps,
+				    double * const scan_angles,
+				    double * const scan_timestamps )
     throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException ){
 
     /* Ensure the device has been initialized */
@@ -754,174 +889,11 @@ namespace SickToolbox {
       throw SickIOException("SickLD::GetSickMeasurements: Device NOT Initialized!!!");
     }
   
-    /* The following conditional holds true if the user wants a RANGE+ECHO data
-     * stream but already has an active RANGE-ONLY stream.
-     */
-    if (_sick_streaming_range_data && echo_measurements != NULL) {
-
-      try {
-	
-        /* Cancel the current RANGE-ONLY data stream */
-        _cancelSickScanProfiles();
-
-        /* Request a RANGE+ECHO data stream */
-        _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE_AND_ECHO);
-
-      }
-
-      /* Handle a timeout! */
-      catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* Handle I/O exceptions */
-      catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* Handle a returned error code */
-      catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* A safety net */
-      catch (...) {
-	std::cerr << "SickLMS::GetSickMeasurements: Unknown exception!!!" << std::endl;
-	throw;
-      }  
-      
-    }
-
-    /* The following conditional holds true if the user wants a RANGE-ONLY data
-     * stream but already has an active RANGE+ECHO stream.
-     */
-    if (_sick_streaming_range_and_echo_data && echo_measurements == NULL) {
-
-      try {
-
-	/* Cancel the current RANGE+ECHO data stream */
-        _cancelSickScanProfiles();
-
-        /* Request a RANGE-ONLY data stream */
-        _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE);
-	
-      }
-      
-      /* Handle a timeout! */
-      catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* Handle I/O exceptions */
-      catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* Handle a returned error code */
-      catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* A safety net */
-      catch (...) {
-	std::cerr << "SickLMS::GetSickMeasurements: Unknown exception!!!" << std::endl;
-	throw;
-      }  
-      
-    }
-
-    /* If there aren't any active data streams, setup a new one */
-    if (!_sick_streaming_range_data && !_sick_streaming_range_and_echo_data) {
-
-      try {
-      
-	/* Determine the target data stream by checking the value of echo_measurements */
-	if (echo_measurements != NULL) {
-	  
-	  /* Request a RANGE+ECHO data stream */
-	  _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE_AND_ECHO);	  
-	  
-	}
-	else {
-	  
-	  /* Request a RANGE+ONLY data stream */
-	  _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE);
-	  
-	}
-
-      }
-
-      /* Handle a timeout! */
-      catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* Handle I/O exceptions */
-      catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* Handle a returned error code */
-      catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
-	throw;
-      }
-      
-      /* A safety net */
-      catch (...) {
-	std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
-	throw;
-      }  
-      
-    }
-
-    /* Declare the receive message object */
-    SickLDMessage recv_message;
-  
-    /* Acquire the most recently buffered message */
-    try {
-      _recvMessage(recv_message,(unsigned int)1e6);
-    }
-    
-    catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
-      throw;
-    }  
-
-    catch(...) {
-      std::cerr << "SickLD::GetSickMeasurements - Unknown exception!" << std::endl;
-      throw;
-    }
-    
-    /* A single buffer for payload contents */
-    uint8_t payload_buffer[SickLDMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
-
-    /* Get the message payload */
-    recv_message.GetPayload(payload_buffer);
-
-    /* Define the destination Sick LD scan profile struct */
-    sick_ld_scan_profile_t profile_data;
-  
-    /* Extract the scan profile */
-    _parseScanProfile(&payload_buffer[2],profile_data);
-
-    /* Update and check the returned sensor status */
-    if ((_sick_sensor_mode = profile_data.sensor_status) != SICK_SENSOR_MODE_MEASURE) {
-      throw SickConfigException("SickLD::GetSickMeasurements: Unexpected sensor mode! " + _sickSensorModeToString(_sick_sensor_mode));
-    }
+    /* The destination Sick LD scan profile struct (too large for the stack) */
+    sick_ld_scan_profile_t &profile_data = _getSickScanProfile();
 
-    /* Update and check the returned motor status */
-    if ((_sick_motor_mode = profile_data.motor_status) != SICK_MOTOR_MODE_OK) {
-      throw SickConfigException("SickLD::GetSickMeasurements: Unexpected motor mode! (Are you using a valid motor speed!)");
-    }
+    /* Grab the next profile (switching the stream type if needed) */
+    _recvSickScanProfile(profile_data,echo_measurements != NULL);
 
     /* Everything is OK, so now populate the relevant return buffers */
     for (unsigned int i = 0, total_measurements = 0; i < _sick_sector_config.sick_num_active_sectors; i++) {
@@ -930,6 +902,18 @@ namespace SickToolbox {
       memcpy(&range_measurements[total_measurements],profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].range_values,
 	     profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].num_data_points*sizeof(double));
     
+      /* Copy the returned scan angles if requested */
+      if (scan_angles != NULL) {
+	memcpy(&scan_angles[total_measurements],profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].scan_angles,
+	       profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].num_data_points*sizeof(double));
+      }
+
+      /* Copy the measurement timestamps if requested */
+      if (scan_timestamps != NULL) {
+	memcpy(&scan_timestamps[total_measurements],profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].scan_timestamps,
+	       profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].num_data_points*sizeof(double));
+      }
+
       /* Copy the returned echo values  if requested */
       if (echo_measurements != NULL) {
 	memcpy(&echo_measurements[total_measurements],profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].echo_values,
@@ -985,64 +969,449 @@ namespace SickToolbox {
   }
 
   /**
-   * \brief Attempts to set a new sensor ID for the device (in flash)
-   * \param sick_sensor_id The desired sensor ID
+   * \brief Acquires the measurements of the active sectors as a SickScan
+   * \param sick_scan The destination scan
+   * \param with_echo Whether to request a RANGE+ECHO stream and fill the intensities (Default: false)
+   *
+   * NOTE: The active sectors are stored back to back (as in GetSickMeasurements) and
+   *       the first beam of each sector is flagged with SICK_SCAN_FLAG_SECTOR_START.
+   *       Time offsets come from the interpolated measurement timestamps and are relative to the first beam of the first active sector, whose
+   *       timestamp (ms) goes into the header along with the profile counter.
+   *
+   * NOTE: Once the clock sync (see StartSickClockSync) has a mapping, the header also
+   *       carries the host time of that first beam in sick_device_host_time.
    */
-  void SickLD::SetSickSensorID( const unsigned int sick_sensor_id )
-    throw( SickErrorException, SickTimeoutException, SickIOException ){
+  void SickLD::GetSickScan( SickScan &sick_scan, const bool with_echo )
+    throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException ) {
 
     /* Ensure the device has been initialized */
-    if (!_sick_initialized) {
-      throw SickConfigException("SickLD::SetSickSensorID: Device NOT Initialized!!!");
+    if(!_sick_initialized) {
+      throw SickIOException("SickLD::GetSickScan: Device NOT Initialized!!!");
     }
 
-    /* Check that the given ID is valid */
-    if (!_validSickSensorID(sick_sensor_id)) {
-      throw SickConfigException("SickLD::SetSickSensorID: Invalid sensor ID!!!");
+    /* The destination Sick LD scan profile struct (too large for the stack) */
+    sick_ld_scan_profile_t &profile_data = _getSickScanProfile();
+
+    /* Grab the next profile (switching the stream type if needed) */
+    _recvSickScanProfile(profile_data,with_echo);
+
+    /* Count the beams of the active sectors */
+    unsigned int num_beams = 0;
+    for (unsigned int i = 0; i < _sick_sector_config.sick_num_active_sectors; i++) {
+      num_beams += profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]].num_data_points;
     }
 
-    /* Attempt to set the new sensor ID in the flash! */
     try {
-      _setSickGlobalConfig(sick_sensor_id,GetSickMotorSpeed(),GetSickScanResolution());
+      sick_scan.Resize(num_beams);
     }
-    
-    /* Handle a timeout! */
-    catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
-      throw;
+
+    catch (std::bad_alloc &) {
+      throw SickIOException("SickLD::GetSickScan: Failed to allocate scan storage!");
     }
-    
-    /* Handle I/O exceptions */
-    catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
-      throw;
+
+    float * const range_values = sick_scan.GetRangeValues();
+    float * const intensity_values = sick_scan.GetIntensityValues();
+    uint32_t * const flag_values = sick_scan.GetFlagValues();
+    float * const angle_values = sick_scan.GetAngleValues();
+    float * const time_offsets = sick_scan.GetTimeOffsets();
+
+    /* Time offsets are taken relative to the first active sector */
+    const unsigned int scan_timestamp = (_sick_sector_config.sick_num_active_sectors > 0) ?
+      profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[0]].timestamp_start : 0;
+
+    /* Decode each active sector straight into the scan */
+    for (unsigned int i = 0, offset = 0; i < _sick_sector_config.sick_num_active_sectors; i++) {
+
+      const sick_ld_sector_data_t &sector_data = profile_data.sector_data[_sick_sector_config.sick_active_sector_ids[i]];
+      const unsigned int num_sector_beams = sector_data.num_data_points;
+
+      for (unsigned int j = 0; j < num_sector_beams; j++) {
+	range_values[offset+j] = (float)sector_data.range_values[j];
+	intensity_values[offset+j] = (with_echo) ? (float)sector_data.echo_values[j] : 0;
+	flag_values[offset+j] = (sector_data.range_values[j] == 0) ? SickScan::SICK_SCAN_FLAG_NO_RETURN : SickScan::SICK_SCAN_FLAG_NONE;
+      }
+
+      if (num_sector_beams > 0) {
+	flag_values[offset] |= SickScan::SICK_SCAN_FLAG_SECTOR_START;
+      }
+
+      /* Measurement timestamps are in ms */
+      for (unsigned int j = 0; j < num_sector_beams; j++) {
+	angle_values[offset+j] = (float)sector_data.scan_angles[j];
+	time_offsets[offset+j] = (float)(1e3*(sector_data.scan_timestamps[j] - scan_timestamp));
+      }
+
+      offset += num_sector_beams;
     }
-    
-    /* Handle a returned error code */
-    catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
-      throw;
+
+    /* Fill in the header */
+    SickScan::sick_scan_header_t &sick_scan_header = sick_scan.GetHeader();
+    sick_scan_header.sick_scan_index = profile_data.profile_counter;
+    sick_scan_header.sick_device_timestamp = scan_timestamp & 0xFFFF;
+    sick_scan_header.sick_scan_period = (_sick_global_config.sick_motor_speed > 0) ? 1e6f/_sick_global_config.sick_motor_speed : 0;
+    gettimeofday(&sick_scan_header.sick_host_time,NULL);
+
+    /* Map the device time to host time (0 until the clock sync has a sample) */
+    try {
+      sick_scan_header.sick_device_host_time = _sick_clock_sync.ToHostTime(scan_timestamp);
     }
-    
-    /* A safety net */
-    catch (...) {
-      std::cerr << "SickLMS::SetSickSensorID: Unknown exception!!!" << std::endl;
-      throw;
-    }  
-  
-    /* Success! */
+
+    catch (SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      sick_scan_header.sick_device_host_time = 0;
+    }
+
   }
 
   /**
-   * \brief Attempts to set a new motor speed for the device (in flash)
-   * \param sick_motor_speed The desired motor speed (Hz)
+   * \brief Acquires the measurements of the active sectors as Cartesian points
+   * \param x_values A buffer to hold the x coordinates (m)
+   * \param y_values A buffer to hold the y coordinates (m)
+   * \param z_values A buffer to hold the z coordinates, always 0 (Default: NULL => Not wanted)
+   * \param num_points The total number of points written
+   * \param num_sector_points The number of points in each sector (Default: NULL => Not wanted)
+   * \param sector_ids The sector id of each sector (Default: NULL => Not wanted)
+   * \param sector_data_offsets The index of each sector's first point (Default: NULL => Not wanted)
+   *
+   * NOTE: Points follow the layout of GetSickMeasurements, i.e. one point per
+   *       measurement with the active sectors stored back to back. Each sector
+   *       slot keeps its own cos/sin table, which is only recomputed when the
+   *       sector's start angle, step angle or number of measurements changes.
    */
-  void SickLD::SetSickMotorSpeed( const unsigned int sick_motor_speed )
-    throw( SickErrorException, SickTimeoutException, SickIOException ) {
+  void SickLD::GetSickScanAsPoints( float * const x_values,
+				    float * const y_values,
+				    float * const z_values,
+				    unsigned int & num_points,
+				    unsigned int * const num_sector_points,
+				    unsigned int * const sector_ids,
+				    unsigned int * const sector_data_offsets )
+    throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException ) {
+
+    /* Buffers for the raw sector data */
+    double range_values[SICK_MAX_NUM_MEASURING_SECTORS*SICK_MAX_NUM_MEASUREMENTS] = {0};
+    unsigned int num_measurements[SICK_MAX_NUM_MEASURING_SECTORS] = {0};
+    unsigned int data_offsets[SICK_MAX_NUM_MEASURING_SECTORS] = {0};
+    double step_angles[SICK_MAX_NUM_MEASURING_SECTORS] = {0};
+    double start_angles[SICK_MAX_NUM_MEASURING_SECTORS] = {0};
+    double scan_angles[SICK_MAX_NUM_MEASURING_SECTORS*SICK_MAX_NUM_MEASUREMENTS] = {0};
+
+    /* Grab the latest profile */
+    GetSickMeasurements(range_values,NULL,num_measurements,sector_ids,data_offsets,step_angles,start_angles,
+			NULL,NULL,NULL,scan_angles);
+
+    num_points = 0;
+    for (unsigned int i = 0; i < _sick_sector_config.sick_num_active_sectors; i++) {
 
-    /* Ensure the device has been initialized */
-    if (!_sick_initialized) {
-      throw SickIOException("SickLD::SetSickMotorSpeed: Device NOT Initialized!!!");
+      const unsigned int offset = data_offsets[i];
+
+      /* Under an ROI (or once deskewed) the sector is no longer evenly spaced, so use each beam's own direction */
+      if (!_sick_scan_roi.SelectsAllBeams() || _sick_pose_callback != NULL) {
+
+	for (unsigned int j = offset; j < offset + num_measurements[i]; j++) {
+	  const double scan_angle = scan_angles[j]*M_PI/180.0;
+	  x_values[j] = (float)(range_values[j]*cos(scan_angle));
+	  y_values[j] = (float)(range_values[j]*sin(scan_angle));
+	}
+
+	if (z_values) {
+	  memset(&z_values[offset],0,num_measurements[i]*sizeof(float));
+	}
+
+      }
+      else {
+
+	try {
+	  _sick_projection_tables[i].Update(start_angles[i],step_angles[i],num_measurements[i]);
+	}
+
+	catch (std::bad_alloc &) {
+	  throw SickIOException("SickLD::GetSickScanAsPoints: Failed to allocate projection table!");
+	}
+
+	/* Ranges are given in meters */
+	_sick_projection_tables[i].Project(&range_values[offset],num_measurements[i],1.0f,
+					   &x_values[offset],&y_values[offset],(z_values) ? &z_values[offset] : NULL);
+
+      }
+
+      /* Set the number of points if requested */
+      if (num_sector_points != NULL) {
+	num_sector_points[i] = num_measurements[i];
+      }
+
+      /* Set the sector's index into the point buffers if requested */
+      if (sector_data_offsets != NULL) {
+	sector_data_offsets[i] = offset;
+      }
+
+      num_points += num_measurements[i];
+    }
+
+  }
+  /**
+   * \brief Starts a continuous data stream feeding a ring of pre-sized profiles
+   * \param want_echo Whether to request a RANGE+ECHO (as opposed to a RANGE-ONLY) stream (Default: false)
+   * \param ring_size The number of profiles held by the ring (Default: DEFAULT_SICK_PROFILE_RING_SIZE)
+   *
+   * NOTE: The buffer monitor queues every incoming profile (up to ring_size of them),
+   *       so profiles that arrive while the caller is busy are kept rather than
+   *       overwritten. Drain them with DrainSickProfiles and do not mix this with
+   *       GetSickMeasurements/GetSickScan while the stream is running. Uninitialize
+   *       stops the stream.
+   */
+  void SickLD::StartSickProfileStream( const bool want_echo, const unsigned int ring_size )
+    throw( SickErrorException, SickIOException, SickConfigException, SickTimeoutException, SickThreadException ) {
+
+    /* Ensure the device has been initialized */
+    if (!_sick_initialized) {
+      throw SickIOException("SickLD::StartSickProfileStream: Device NOT Initialized!!!");
+    }
+
+    if (ring_size == 0) {
+      throw SickConfigException("SickLD::StartSickProfileStream: Invalid ring size!");
+    }
+
+    /* Pre-size the ring (and the raw message buffer that feeds it) */
+    if (ring_size != _sick_profile_ring_size) {
+
+      delete [] _sick_profile_ring;
+      delete [] _sick_profile_messages;
+      delete [] _sick_profile_recv_times;
+      _sick_profile_ring = NULL;
+      _sick_profile_messages = NULL;
+      _sick_profile_recv_times = NULL;
+      _sick_profile_ring_size = 0;
+
+      try {
+	_sick_profile_ring = new sick_ld_scan_profile_t[ring_size];
+	_sick_profile_messages = new SickLDMessage[ring_size];
+	_sick_profile_recv_times = new struct timeval[ring_size];
+      }
+
+      catch (std::bad_alloc &) {
+	delete [] _sick_profile_ring;
+	delete [] _sick_profile_messages;
+	_sick_profile_ring = NULL;
+	_sick_profile_messages = NULL;
+	throw SickIOException("SickLD::StartSickProfileStream: Failed to allocate profile ring!");
+      }
+
+      _sick_profile_ring_size = ring_size;
+    }
+
+    _sick_profile_ring_head = 0;
+    _sick_profile_stream_synced = false;
+    _sick_profile_stream_fault = false;
+    _sick_profile_stream_num_lost = _sick_profile_stream_num_skipped = 0;
+
+    /* Queue every message from here on */
+    _sick_buffer_monitor->SetMessageQueueDepth(ring_size);
+
+    /* Make sure the right data stream is active */
+    _setupSickScanProfileStream(want_echo);
+
+  }
+
+  /**
+   * \brief Parses the profiles received since the last call into the ring (oldest first)
+   * \param profiles Set to the drained profiles, which stay valid until the next call
+   * \param max_num_profiles The maximum number of profiles to drain (at most the ring size is used)
+   * \param num_lost_profiles Set to the number of profiles lost just before the drained ones (Default: NULL)
+   * \param timeout_value The time to wait for a first profile (usecs, 0 => return immediately)
+   * \return The number of profiles drained
+   *
+   * NOTE: Losses are detected from gaps in PROFILESENT (e.g. when the caller falls more
+   *       than a ring behind). The ROI and deskew stages are applied as the profiles are
+   *       parsed, exactly as for GetSickMeasurements.
+   *
+   * NOTE: A profile reporting an unexpected sensor/motor status does not abort the batch
+   *       (the profiles are already off the queue). The batch is returned as usual and
+   *       the status error is thrown by the next call.
+   */
+  unsigned int SickLD::DrainSickProfiles( const sick_ld_scan_profile_t ** const profiles,
+					  const unsigned int max_num_profiles,
+					  unsigned int * const num_lost_profiles,
+					  const unsigned int timeout_value )
+    throw( SickConfigException, SickTimeoutException, SickThreadException ) {
+
+    if (num_lost_profiles != NULL) {
+      *num_lost_profiles = 0;
+    }
+
+    if (_sick_profile_ring == NULL) {
+      throw SickConfigException("SickLD::DrainSickProfiles: Profile stream NOT started!");
+    }
+
+    if (max_num_profiles == 0) {
+      throw SickConfigException("SickLD::DrainSickProfiles: Invalid max number of profiles!");
+    }
+
+    /* Report a bad status seen in the previous batch */
+    if (_sick_profile_stream_fault) {
+
+      _sick_profile_stream_fault = false;
+
+      if (_sick_sensor_mode != SICK_SENSOR_MODE_MEASURE) {
+	throw SickConfigException("SickLD::DrainSickProfiles: Unexpected sensor mode! " + _sickSensorModeToString(_sick_sensor_mode));
+      }
+
+      throw SickConfigException("SickLD::DrainSickProfiles: Unexpected motor mode! (Are you using a valid motor speed!)");
+    }
+
+    /* Pull the queued messages */
+    const unsigned int max_num_messages = (max_num_profiles < _sick_profile_ring_size) ? max_num_profiles : _sick_profile_ring_size;
+    const unsigned int num_messages = (timeout_value > 0) ?
+      _recvMessages(_sick_profile_messages,_sick_profile_recv_times,max_num_messages,timeout_value) :
+      _sick_buffer_monitor->GetMessagesFromMonitor(_sick_profile_messages,_sick_profile_recv_times,max_num_messages);
+
+    /* A single buffer for payload contents */
+    uint8_t payload_buffer[SickLDMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
+
+    unsigned int num_profiles = 0;
+    for (unsigned int i = 0; i < num_messages; i++) {
+
+      /* Skip anything but profiles (e.g. streamed clock sync replies) */
+      if (_handleSickClockSyncReply(_sick_profile_messages[i],_sick_profile_recv_times[i]) ||
+	  _sick_profile_messages[i].GetServiceCode() != (SICK_MEAS_SERV_CODE | 0x80) ||
+	  _sick_profile_messages[i].GetServiceSubcode() != SICK_MEAS_SERV_GET_PROFILE) {
+	continue;
+      }
+
+      sick_ld_scan_profile_t &profile_data = _sick_profile_ring[_sick_profile_ring_head];
+      _sick_profile_ring_head = (_sick_profile_ring_head + 1) % _sick_profile_ring_size;
+
+      _sick_profile_messages[i].GetPayload(payload_buffer);
+      _parseScanProfile(&payload_buffer[2],profile_data);
+
+      /* Update and check the returned sensor/motor status (the first bad one is kept for the next call) */
+      if (!_sick_profile_stream_fault) {
+	_sick_sensor_mode = profile_data.sensor_status;
+	_sick_motor_mode = profile_data.motor_status;
+	_sick_profile_stream_fault = (_sick_sensor_mode != SICK_SENSOR_MODE_MEASURE || _sick_motor_mode != SICK_MOTOR_MODE_OK);
+      }
+
+      /* Check for gaps (both counters are 16 bits wide on the wire) */
+      if (_sick_profile_stream_synced) {
+
+	const unsigned int number_step = (profile_data.profile_number - _sick_profile_stream_last_number) & 0xFFFF;
+	const unsigned int counter_step = (profile_data.profile_counter - _sick_profile_stream_last_counter) & 0xFFFF;
+
+	if (number_step > 1) {
+	  _sick_profile_stream_num_lost += number_step - 1;
+	  if (num_lost_profiles != NULL) {
+	    *num_lost_profiles += number_step - 1;
+	  }
+	}
+
+	if (counter_step > number_step) {
+	  _sick_profile_stream_num_skipped += counter_step - number_step;
+	}
+
+      }
+
+      _sick_profile_stream_synced = true;
+      _sick_profile_stream_last_number = profile_data.profile_number;
+      _sick_profile_stream_last_counter = profile_data.profile_counter;
+
+      profiles[num_profiles++] = &profile_data;
+    }
+
+    /* Let the clock sync thread know the link is quiet until the next profile */
+    if (num_profiles > 0) {
+      _signalSickProfileRecvd();
+    }
+
+    return num_profiles;
+
+  }
+
+  /**
+   * \brief Stops the continuous data stream
+   */
+  void SickLD::StopSickProfileStream( ) throw( SickErrorException, SickIOException, SickTimeoutException, SickThreadException ) {
+
+    if (_sick_profile_ring == NULL) {
+      return;
+    }
+
+    /* Back to the single message container */
+    _sick_buffer_monitor->SetMessageQueueDepth(0);
+
+    delete [] _sick_profile_ring;
+    delete [] _sick_profile_messages;
+    delete [] _sick_profile_recv_times;
+    _sick_profile_ring = NULL;
+    _sick_profile_messages = NULL;
+    _sick_profile_recv_times = NULL;
+    _sick_profile_ring_size = 0;
+
+    /* Cancel the data stream */
+    if (_sick_streaming_range_data || _sick_streaming_range_and_echo_data) {
+      _cancelSickScanProfiles();
+    }
+
+  }
+
+
+  /**
+   * \brief Attempts to set a new sensor ID for the device (in flash)
+   * \param sick_sensor_id The desired sensor ID
+   */
+  void SickLD::SetSickSensorID( const unsigned int sick_sensor_id )
+    throw( SickErrorException, SickTimeoutException, SickIOException ){
+
+    /* Ensure the device has been initialized */
+    if (!_sick_initialized) {
+      throw SickConfigException("SickLD::SetSickSensorID: Device NOT Initialized!!!");
+    }
+
+    /* Check that the given ID is valid */
+    if (!_validSickSensorID(sick_sensor_id)) {
+      throw SickConfigException("SickLD::SetSickSensorID: Invalid sensor ID!!!");
+    }
+
+    /* Attempt to set the new sensor ID in the flash! */
+    try {
+      _setSickGlobalConfig(sick_sensor_id,GetSickMotorSpeed(),GetSickScanResolution());
+    }
+    
+    /* Handle a timeout! */
+    catch (SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      throw;
+    }
+    
+    /* Handle I/O exceptions */
+    catch (SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      throw;
+    }
+    
+    /* Handle a returned error code */
+    catch (SickErrorException &sick_error_exception) {
+      SICK_LOG_ERROR(sick_error_exception.what());
+      throw;
+    }
+    
+    /* A safety net */
+    catch (...) {
+      SICK_LOG_ERROR("SickLMS::SetSickSensorID: Unknown exception!!!");
+      throw;
+    }  
+  
+    /* Success! */
+  }
+
+  /**
+   * \brief Attempts to set a new motor speed for the device (in flash)
+   * \param sick_motor_speed The desired motor speed (Hz)
+   */
+  void SickLD::SetSickMotorSpeed( const unsigned int sick_motor_speed )
+    throw( SickErrorException, SickTimeoutException, SickIOException ) {
+
+    /* Ensure the device has been initialized */
+    if (!_sick_initialized) {
+      throw SickIOException("SickLD::SetSickMotorSpeed: Device NOT Initialized!!!");
     }
 
     /* Check that the given motor speed is valid */
@@ -1062,25 +1431,25 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::SetSickMotorSpeed: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::SetSickMotorSpeed: Unknown exception!!!");
       throw;
     }      
   
@@ -1157,31 +1526,31 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle config exception */
     catch (SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::SetSickGlobalParamsAndScanAreas: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::SetSickGlobalParamsAndScanAreas: Unknown exception!!!");
       throw;
     }  
   
@@ -1213,31 +1582,31 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle config exception */
     catch (SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::SetSickScanAreas: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::SetSickScanAreas: Unknown exception!!!");
       throw;
     }  
     
@@ -1281,19 +1650,19 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }
 
@@ -1667,6 +2036,12 @@ namespace SickToolbox {
   
     /* If necessary, tell the Sick LD to stop streaming data */
     try {
+
+      /* Stop the clock sampler before the connection goes away */
+      StopSickClockSync();
+
+      /* Release the profile ring and return the monitor to a single message slot */
+      StopSickProfileStream();
       
       std::cout << "\tSetting Sick LD to idle mode..." << std::endl;
       _setSickSensorModeToIdle();
@@ -1688,31 +2063,31 @@ namespace SickToolbox {
            
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
 
     /* Handle a returned error code */
     catch (SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }  
 
@@ -1816,17 +2191,17 @@ namespace SickToolbox {
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     catch(...) {
-      std::cerr << "SickLD::_setupConnection - Unknown exception occurred!" << std::endl;
+      SICK_LOG_ERROR("SickLD::_setupConnection - Unknown exception occurred!");
       throw;
     }
 
@@ -1844,10 +2219,37 @@ namespace SickToolbox {
       
       /* Acquire current configuration */
       _getSickStatus();
-      _getSickIdentity();
-      _getSickEthernetConfig();
-      _getSickGlobalConfig();
-      _getSickSectorConfig();
+
+      try {
+
+	/* Issue the identity/config queries as a single batch */
+	_getSickIdentityAndConfig();
+
+      }
+
+      /* An unresponsive unit would only time out again */
+      catch (SickTimeoutException &) {
+	throw;
+      }
+
+      /* Fall back to one query at a time */
+      catch (SickException &sick_exception) {
+
+	SICK_LOG_ERROR(sick_exception.what());
+	SICK_LOG_WARN("SickLD::_syncDriverWithSick: Pipelined sync failed, falling back to sequential queries");
+
+	/* Discard any late replies */
+	usleep(DEFAULT_SICK_PIPELINE_DRAIN_DELAY);
+	_flushTCPRecvBuffer();
+	SickLDMessage stale_message;
+	_sick_buffer_monitor->GetNextMessageFromMonitor(stale_message);
+	
+	_getSickIdentity();
+	_getSickEthernetConfig();
+	_getSickGlobalConfig();
+	_getSickSectorConfig();
+
+      }
 
       /* Reset Sick signals */
       _setSickSignals();
@@ -1856,31 +2258,191 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
+
+    /* Handle a thread exception (e.g. from flushing the monitor), reported as I/O */
+    catch (SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      throw SickIOException("SickLD::_syncDriverWithSick: Buffer monitor failure!");
+    }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_syncDriverWithSick: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_syncDriverWithSick: Unknown exception!!!");
       throw;
     }  
   
     /* Success */
   }
 
+  /**
+   * \brief Acquires the identity, Ethernet, global and sector config of the
+   *        Sick LD using a single batch of pipelined requests. All requests
+   *        are written back to back and the replies are matched to their
+   *        requests by service code/subcode (in order, as the Sick LD answers
+   *        requests sequentially).
+   */
+  void SickLD::_getSickIdentityAndConfig( )
+    throw( SickErrorException, SickTimeoutException, SickIOException, SickThreadException ) {
+
+    /* The config queries require the device to be idle */
+    _setSickSensorModeToIdle();
+
+    /* The identification strings to be requested (in order) */
+    const uint8_t id_request_codes[SICK_LD_NUM_ID_STRINGS] = {
+      SICK_STAT_SERV_GET_ID_SENSOR_PART_NUM,
+      SICK_STAT_SERV_GET_ID_SENSOR_NAME,
+      SICK_STAT_SERV_GET_ID_SENSOR_VERSION,
+      SICK_STAT_SERV_GET_ID_SENSOR_SERIAL_NUM,
+      SICK_STAT_SERV_GET_ID_SENSOR_EDM_SERIAL_NUM,
+      SICK_STAT_SERV_GET_ID_FIRMWARE_PART_NUM,
+      SICK_STAT_SERV_GET_ID_FIRMWARE_NAME,
+      SICK_STAT_SERV_GET_ID_FIRMWARE_VERSION,
+      SICK_STAT_SERV_GET_ID_APP_PART_NUM,
+      SICK_STAT_SERV_GET_ID_APP_NAME,
+      SICK_STAT_SERV_GET_ID_APP_VERSION
+    };
+
+    std::string * const id_strings[SICK_LD_NUM_ID_STRINGS] = {
+      &_sick_identity.sick_part_number,
+      &_sick_identity.sick_name,
+      &_sick_identity.sick_version,
+      &_sick_identity.sick_serial_number,
+      &_sick_identity.sick_edm_serial_number,
+      &_sick_identity.sick_firmware_part_number,
+      &_sick_identity.sick_firmware_name,
+      &_sick_identity.sick_firmware_version,
+      &_sick_identity.sick_application_software_part_number,
+      &_sick_identity.sick_application_software_name,
+      &_sick_identity.sick_application_software_version
+    };
+    
+    /* ID strings + Ethernet config + global config + one request per sector */
+    const unsigned int num_requests = SICK_LD_NUM_ID_STRINGS + 2 + SICK_MAX_NUM_SECTORS;
+    
+    /* Request/reply messages (heap allocated as they are fairly large) */
+    SickLDMessage *messages = new SickLDMessage[2*num_requests];
+    SickLDMessage * const send_messages = messages;
+    SickLDMessage * const recv_messages = &messages[num_requests];
+    
+    uint8_t payload_buffer[SickLDMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
+    unsigned int n = 0;
+
+    /* Build the ID requests */
+    for (unsigned int i = 0; i < SICK_LD_NUM_ID_STRINGS; i++, n++) {
+      memset(payload_buffer,0,4);
+      payload_buffer[0] = SICK_STAT_SERV_CODE;
+      payload_buffer[1] = SICK_STAT_SERV_GET_ID;
+      payload_buffer[3] = id_request_codes[i];
+      send_messages[n].BuildMessage(payload_buffer,4);
+    }
+
+    /* Build the config requests */
+    memset(payload_buffer,0,4);
+    payload_buffer[0] = SICK_CONF_SERV_CODE;
+    payload_buffer[1] = SICK_CONF_SERV_GET_CONFIGURATION;
+    payload_buffer[3] = SICK_CONF_KEY_ETHERNET;
+    send_messages[n++].BuildMessage(payload_buffer,4);
+
+    payload_buffer[3] = SICK_CONF_KEY_GLOBAL;
+    send_messages[n++].BuildMessage(payload_buffer,4);
+
+    /* Build the sector function requests */
+    for (unsigned int i = 0; i < SICK_MAX_NUM_SECTORS; i++, n++) {
+      memset(payload_buffer,0,4);
+      payload_buffer[0] = SICK_CONF_SERV_CODE;
+      payload_buffer[1] = SICK_CONF_SERV_GET_FUNCTION;
+      payload_buffer[3] = i;
+      send_messages[n].BuildMessage(payload_buffer,4);
+    }
+
+    try {
+
+      /* Send the batch and collect the replies */
+      _sendMessagesAndGetReplies(send_messages,recv_messages,num_requests);
+
+      /* Extract the ID strings */
+      n = 0;
+      for (unsigned int i = 0; i < SICK_LD_NUM_ID_STRINGS; i++, n++) {
+	memset(payload_buffer,0,SickLDMessage::MESSAGE_PAYLOAD_MAX_LENGTH);
+	recv_messages[n].GetPayload(payload_buffer);
+	*id_strings[i] = (char *) &payload_buffer[2];
+      }
+
+      /* Extract the Ethernet config */
+      recv_messages[n++].GetPayload(payload_buffer);
+      _parseSickEthernetConfig(payload_buffer);
+
+      /* Extract the global config (needed for the sector start angles) */
+      recv_messages[n++].GetPayload(payload_buffer);
+      _parseSickGlobalConfig(payload_buffer);
+
+      /* Extract the sector functions */
+      uint8_t sector_functions[SICK_MAX_NUM_SECTORS] = {0};
+      double sector_stop_angles[SICK_MAX_NUM_SECTORS] = {0};
+      for (unsigned int i = 0; i < SICK_MAX_NUM_SECTORS; i++, n++) {
+	recv_messages[n].GetPayload(payload_buffer);
+	_parseSickSectorFunction(payload_buffer,i,sector_functions[i],sector_stop_angles[i]);
+      }
+
+      _buildSickSectorConfig(sector_functions,sector_stop_angles);
+      
+    }
+
+    /* Handle a timeout! */
+    catch (SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      delete [] messages;
+      throw;
+    }
+    
+    /* Handle I/O exceptions */
+    catch (SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      delete [] messages;
+      throw;
+    }
+    
+    /* Handle a returned error code */
+    catch (SickErrorException &sick_error_exception) {
+      SICK_LOG_ERROR(sick_error_exception.what());
+      delete [] messages;
+      throw;
+    }
+
+    /* Handle thread exceptions */
+    catch (SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      delete [] messages;
+      throw;
+    }
+    
+    /* A safety net */
+    catch (...) {
+      SICK_LOG_ERROR("SickLD::_getSickIdentityAndConfig: Unknown exception!!!");
+      delete [] messages;
+      throw;
+    }
+
+    delete [] messages;
+    
+    /* Success */
+  }
+
   /** \brief Sets the function for a particular scan sector.
    *  \param sector_number The number of the sector (should be in [0,7])
    *  \param sector_function The function of the sector (e.g. no measurement, reserved, normal measurement, ...)
@@ -1901,25 +2463,25 @@ namespace SickToolbox {
 
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_setSickSectorFunction: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_setSickSectorFunction: Unknown exception!!!");
 	throw;
       }  
       
@@ -1977,19 +2539,19 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSectorFunction: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSectorFunction: Unknown exception!!!");
       throw;
     }
 
@@ -2026,25 +2588,25 @@ namespace SickToolbox {
 
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_getSickSectorFunction: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_getSickSectorFunction: Unknown exception!!!");
 	throw;
       }  
       
@@ -2069,19 +2631,19 @@ namespace SickToolbox {
             
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSickSectorFunction: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSickSectorFunction: Unknown exception!!!");
       throw;
     }
 
@@ -2091,26 +2653,9 @@ namespace SickToolbox {
     /* Extract the message payload */
     recv_message.GetPayload(payload_buffer);
 
-    /* Extract the returned sector number */
-    uint16_t temp_buffer = 0;
-    memcpy(&temp_buffer,&payload_buffer[2],2);
-    temp_buffer = sick_ld_to_host_byte_order(temp_buffer);
-
-    /* Check to make sure the returned sector number matches
-     * the requested sector number.
-     */
-    if (temp_buffer != sector_num) {
-      throw SickConfigException("SickLD::_getSickSectorFunction: Unexpected sector number returned by Sick LD!");
-    }
-
-    /* Extract the sector function */
-    memcpy(&temp_buffer,&payload_buffer[4],2);
-    sector_function = sick_ld_to_host_byte_order(temp_buffer);
+    /* Parse the reply */
+    _parseSickSectorFunction(payload_buffer,sector_num,sector_function,sector_stop_angle);
 
-    /* Extract the sector stop angle (in ticks) */
-    memcpy(&temp_buffer,&payload_buffer[6],2);
-    sector_stop_angle = _ticksToAngle(sick_ld_to_host_byte_order(temp_buffer));
-  
     /* S'ok */
   }
 
@@ -2130,25 +2675,25 @@ namespace SickToolbox {
       
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
 
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_setSickSensorModeToIdle: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_setSickSensorModeToIdle: Unknown exception!!!");
 	throw;
       }  
       
@@ -2173,25 +2718,25 @@ namespace SickToolbox {
 
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
 
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_setSickSensorModeToRotate: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_setSickSensorModeToRotate: Unknown exception!!!");
 	throw;
       }  
     
@@ -2216,25 +2761,25 @@ namespace SickToolbox {
 
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
 
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_setSickSensorModeToMeasure: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_setSickSensorModeToMeasure: Unknown exception!!!");
 	throw;
       }  
     
@@ -2279,25 +2824,25 @@ namespace SickToolbox {
           
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }  
     
@@ -2330,19 +2875,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }
       
@@ -2396,25 +2941,25 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }  
   
@@ -2457,25 +3002,25 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }  
   
@@ -2513,11 +3058,240 @@ namespace SickToolbox {
   }
 
   /**
-   * \brief Parses a well-formed sequence of bytes into a corresponding scan profile
-   * \param *src_buffer The source data buffer
-   * \param &profile_data The destination data structure
+   * \brief Makes sure the requested data stream is active (switching stream types if needed)
+   * \param want_echo Whether a RANGE+ECHO (as opposed to a RANGE-ONLY) stream is wanted
    */
-  void SickLD::_parseScanProfile( uint8_t * const src_buffer, sick_ld_scan_profile_t &profile_data ) const {
+  void SickLD::_setupSickScanProfileStream( const bool want_echo )
+    throw( SickErrorException, SickIOException, SickTimeoutException ) {
+
+    /* The following conditional holds true if the user wants a RANGE+ECHO data
+     * stream but already has an active RANGE-ONLY stream.
+     */
+    if (_sick_streaming_range_data && want_echo) {
+
+      try {
+	
+        /* Cancel the current RANGE-ONLY data stream */
+        _cancelSickScanProfiles();
+
+        /* Request a RANGE+ECHO data stream */
+        _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE_AND_ECHO);
+
+      }
+
+      /* Handle a timeout! */
+      catch (SickTimeoutException &sick_timeout_exception) {
+	SICK_LOG_ERROR(sick_timeout_exception.what());
+	throw;
+      }
+      
+      /* Handle I/O exceptions */
+      catch (SickIOException &sick_io_exception) {
+	SICK_LOG_ERROR(sick_io_exception.what());
+	throw;
+      }
+      
+      /* Handle a returned error code */
+      catch (SickErrorException &sick_error_exception) {
+	SICK_LOG_ERROR(sick_error_exception.what());
+	throw;
+      }
+      
+      /* A safety net */
+      catch (...) {
+	SICK_LOG_ERROR("SickLMS::GetSickMeasurements: Unknown exception!!!");
+	throw;
+      }  
+      
+    }
+
+    /* The following conditional holds true if the user wants a RANGE-ONLY data
+     * stream but already has an active RANGE+ECHO stream.
+     */
+    if (_sick_streaming_range_and_echo_data && !want_echo) {
+
+      try {
+
+	/* Cancel the current RANGE+ECHO data stream */
+        _cancelSickScanProfiles();
+
+        /* Request a RANGE-ONLY data stream */
+        _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE);
+	
+      }
+      
+      /* Handle a timeout! */
+      catch (SickTimeoutException &sick_timeout_exception) {
+	SICK_LOG_ERROR(sick_timeout_exception.what());
+	throw;
+      }
+      
+      /* Handle I/O exceptions */
+      catch (SickIOException &sick_io_exception) {
+	SICK_LOG_ERROR(sick_io_exception.what());
+	throw;
+      }
+      
+      /* Handle a returned error code */
+      catch (SickErrorException &sick_error_exception) {
+	SICK_LOG_ERROR(sick_error_exception.what());
+	throw;
+      }
+      
+      /* A safety net */
+      catch (...) {
+	SICK_LOG_ERROR("SickLMS::GetSickMeasurements: Unknown exception!!!");
+	throw;
+      }  
+      
+    }
+
+    /* If there aren't any active data streams, setup a new one */
+    if (!_sick_streaming_range_data && !_sick_streaming_range_and_echo_data) {
+
+      /* Keep the clock sync thread from sampling until the stream flags are set */
+      pthread_mutex_lock(&_sick_device_mutex);
+
+      try {
+      
+	/* Determine the target data stream by checking want_echo */
+	if (want_echo) {
+	  
+	  /* Request a RANGE+ECHO data stream */
+	  _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE_AND_ECHO);	  
+	  
+	}
+	else {
+	  
+	  /* Request a RANGE+ONLY data stream */
+	  _getSickScanProfiles(SICK_SCAN_PROFILE_RANGE);
+	  
+	}
+
+      }
+
+      /* Handle a timeout! */
+      catch (SickTimeoutException &sick_timeout_exception) {
+	SICK_LOG_ERROR(sick_timeout_exception.what());
+	pthread_mutex_unlock(&_sick_device_mutex);
+	throw;
+      }
+      
+      /* Handle I/O exceptions */
+      catch (SickIOException &sick_io_exception) {
+	SICK_LOG_ERROR(sick_io_exception.what());
+	pthread_mutex_unlock(&_sick_device_mutex);
+	throw;
+      }
+      
+      /* Handle a returned error code */
+      catch (SickErrorException &sick_error_exception) {
+	SICK_LOG_ERROR(sick_error_exception.what());
+	pthread_mutex_unlock(&_sick_device_mutex);
+	throw;
+      }
+      
+      /* A safety net */
+      catch (...) {
+	SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
+	pthread_mutex_unlock(&_sick_device_mutex);
+	throw;
+      }  
+
+      pthread_mutex_unlock(&_sick_device_mutex);
+      
+    }
+
+  }
+
+  /**
+   * \brief Gets the profile filled by GetSickMeasurements/GetSickScan (allocated on first use)
+   * \return The profile buffer
+   */
+  SickLD::sick_ld_scan_profile_t & SickLD::_getSickScanProfile( ) throw( SickIOException ) {
+
+    if (_sick_scan_profile == NULL) {
+
+      try {
+	_sick_scan_profile = new sick_ld_scan_profile_t;
+      }
+
+      catch (std::bad_alloc &) {
+	throw SickIOException("SickLD::_getSickScanProfile: Failed to allocate scan profile!");
+      }
+
+    }
+
+    return *_sick_scan_profile;
+
+  }
+
+  /**
+   * \brief Receives the next scan profile, setting up the data stream if needed
+   * \param profile_data The destination profile
+   * \param want_echo Whether a RANGE+ECHO (vs. RANGE-ONLY) stream is needed
+   */
+  void SickLD::_recvSickScanProfile( sick_ld_scan_profile_t &profile_data, const bool want_echo )
+    throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException ) {
+
+    /* Make sure the right data stream is active */
+    _setupSickScanProfileStream(want_echo);
+
+    /* Declare the receive message object */
+    SickLDMessage recv_message;
+    struct timeval recv_time;
+  
+    /* Acquire the most recently buffered message (streamed clock sync replies are consumed here) */
+    do {
+
+      try {
+	_recvMessage(recv_message,recv_time,(unsigned int)1e6);
+      }
+    
+      catch(SickTimeoutException &sick_timeout_exception) {
+	SICK_LOG_ERROR(sick_timeout_exception.what());
+	throw;
+      }  
+
+      catch(...) {
+	SICK_LOG_ERROR("SickLD::_recvSickScanProfile - Unknown exception!");
+	throw;
+      }
+
+    } while (_handleSickClockSyncReply(recv_message,recv_time));
+
+    /* Let the clock sync thread know the link is quiet until the next profile */
+    _signalSickProfileRecvd();
+    
+    /* A single buffer for payload contents */
+    uint8_t payload_buffer[SickLDMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
+
+    /* Get the message payload */
+    recv_message.GetPayload(payload_buffer);
+
+    /* Extract the scan profile */
+    _parseScanProfile(&payload_buffer[2],profile_data);
+
+    /* Update and check the returned sensor status */
+    if ((_sick_sensor_mode = profile_data.sensor_status) != SICK_SENSOR_MODE_MEASURE) {
+      throw SickConfigException("SickLD::_recvSickScanProfile: Unexpected sensor mode! " + _sickSensorModeToString(_sick_sensor_mode));
+    }
+
+    /* Update and check the returned motor status */
+    if ((_sick_motor_mode = profile_data.motor_status) != SICK_MOTOR_MODE_OK) {
+      throw SickConfigException("SickLD::_recvSickScanProfile: Unexpected motor mode! (Are you using a valid motor speed!)");
+    }
+
+  }
+
+  /**
+   * \brief Parses a well-formed sequence of bytes into a corresponding scan profile
+   * \param *src_buffer The source data buffer
+   * \param &profile_data The destination data structure
+   */
+  void SickLD::_parseScanProfile( uint8_t * const src_buffer, sick_ld_scan_profile_t &profile_data ) const {
+
+    SICK_TRACE_SCOPE_ARG("SickLD::_parseScanProfile",_sick_fd);
 
     uint16_t profile_format = 0;
     unsigned int data_offset = 0;
@@ -2560,6 +3334,12 @@ namespace SickToolbox {
     /* The extraneous stuff is out of the way, now extract the data
      * for each of the sectors in the scan area...
      */
+    sick_ld_pose_t ref_pose = {0,0,0};
+    bool ref_pose_queried = false, have_ref_pose = false;
+
+    /* TSTART of the first sector, against which the 16-bit timestamps are unwrapped */
+    unsigned int profile_timestamp_base = 0;
+
     for (unsigned int i=0; i < profile_data.num_sectors; i++) {
 
       /* Check if SECTORNUM is included */
@@ -2597,6 +3377,14 @@ namespace SickToolbox {
 	memcpy(&temp_buffer,&src_buffer[data_offset],2);
 	profile_data.sector_data[i].timestamp_start = sick_ld_to_host_byte_order(temp_buffer);
 	data_offset += 2;
+
+	/* Keep the profile on one time axis should the counter wrap between sectors */
+	if (i == 0) {
+	  profile_timestamp_base = profile_data.sector_data[i].timestamp_start;
+	}
+	else if (profile_data.sector_data[i].timestamp_start < profile_timestamp_base) {
+	  profile_data.sector_data[i].timestamp_start += 65536;
+	}
       }
       else {
 	profile_data.sector_data[i].timestamp_start = 0;
@@ -2612,46 +3400,76 @@ namespace SickToolbox {
 	profile_data.sector_data[i].angle_start = 0;
       }
     
-      /* Acquire the range and echo values for the sector */
-      for (unsigned int j=0; j < profile_data.sector_data[i].num_data_points; j++) {
+      /* Acquire the range and echo values for the sector, passing them through
+       * the ROI so that unselected beams are skipped without being converted
+       */
+      const unsigned int num_sector_points = profile_data.sector_data[i].num_data_points;
+      const unsigned int beam_stride = ((profile_format & 0x0100) ? 2 : 0) + ((profile_format & 0x0200) ? 2 : 0) + ((profile_format & 0x0400) ? 2 : 0);
+      const bool select_all = _sick_scan_roi.SelectsAllBeams();
+
+      unsigned int min_range_value = 0, max_range_value = UINT_MAX;
+      _sick_scan_roi.GetRawRangeLimits(1.0/256,min_range_value,max_range_value);
+
+      unsigned int num_selected_points = 0;
+      for (unsigned int j=0; j < num_sector_points; j++) {
+
+	unsigned int beam_offset = data_offset + j*beam_stride;
+
+	/* Acquire the beam's direction (DIRECTION-n follows DISTANCE-n) */
+	double scan_angle = profile_data.sector_data[i].angle_start + j*profile_data.sector_data[i].angle_step;
+	if (profile_format & 0x0200) {
+	  memcpy(&temp_buffer,&src_buffer[beam_offset + ((profile_format & 0x0100) ? 2 : 0)],2);
+	  scan_angle = ((double)sick_ld_to_host_byte_order(temp_buffer))/16;
+	}
+
+	if (!select_all && !_sick_scan_roi.SelectBeam(j,scan_angle)) {
+	  continue;
+	}
+
+	const unsigned int k = num_selected_points++;
+	profile_data.sector_data[i].scan_angles[k] = scan_angle;
 
 	/* Check if DISTANCE-n is included */
 	if (profile_format & 0x0100) {
-	  memcpy(&temp_buffer,&src_buffer[data_offset],2);
-	  profile_data.sector_data[i].range_values[j] = ((double)sick_ld_to_host_byte_order(temp_buffer))/256;
-	  data_offset += 2;
+	  memcpy(&temp_buffer,&src_buffer[beam_offset],2);
+	  const uint16_t range_value = sick_ld_to_host_byte_order(temp_buffer);
+	  profile_data.sector_data[i].range_values[k] =
+	    (range_value >= min_range_value && range_value <= max_range_value) ? ((double)range_value)/256 : 0;
+	  beam_offset += 2;
 	}
 	else {
-	  profile_data.sector_data[i].range_values[j] = 0;
+	  profile_data.sector_data[i].range_values[k] = 0;
 	}
-      
-	/* Check if DIRECTION-n is included */
+
+	/* Skip DIRECTION-n (acquired above) */
 	if (profile_format & 0x0200) {
-	  memcpy(&temp_buffer,&src_buffer[data_offset],2);
-	  profile_data.sector_data[i].scan_angles[j] = ((double)sick_ld_to_host_byte_order(temp_buffer))/16;
-	  data_offset += 2;
-	}
-	else {
-	  profile_data.sector_data[i].scan_angles[j] = 0;
+	  beam_offset += 2;
 	}
-      
+
 	/* Check if ECHO-n is included */
 	if (profile_format & 0x0400) {
-	  memcpy(&temp_buffer,&src_buffer[data_offset],2);
-	  profile_data.sector_data[i].echo_values[j] = sick_ld_to_host_byte_order(temp_buffer);
-	  data_offset += 2;      
+	  memcpy(&temp_buffer,&src_buffer[beam_offset],2);
+	  profile_data.sector_data[i].echo_values[k] = sick_ld_to_host_byte_order(temp_buffer);
 	}
 	else {
-	  profile_data.sector_data[i].echo_values[j] = 0;
+	  profile_data.sector_data[i].echo_values[k] = 0;
 	}
-	      
+
       }
 
+      data_offset += num_sector_points*beam_stride;
+      profile_data.sector_data[i].num_data_points = num_selected_points;
+
       /* Check if TEND is included */
       if (profile_format & 0x0800) {
 	memcpy(&temp_buffer,&src_buffer[data_offset],2);
 	profile_data.sector_data[i].timestamp_stop = sick_ld_to_host_byte_order(temp_buffer);
 	data_offset += 2;
+
+	/* ...and within the sector */
+	while (profile_data.sector_data[i].timestamp_stop < profile_data.sector_data[i].timestamp_start) {
+	  profile_data.sector_data[i].timestamp_stop += 65536;
+	}
       }
       else {
 	profile_data.sector_data[i].timestamp_stop = 0;
@@ -2666,6 +3484,42 @@ namespace SickToolbox {
       else {
 	profile_data.sector_data[i].angle_stop = 0;
       }
+
+      /* Spread the sector's duration over its measurements by angle */
+      const unsigned int sector_duration = (profile_data.sector_data[i].timestamp_stop >= profile_data.sector_data[i].timestamp_start) ?
+	profile_data.sector_data[i].timestamp_stop - profile_data.sector_data[i].timestamp_start : 0;
+      const double sector_span = profile_data.sector_data[i].angle_stop - profile_data.sector_data[i].angle_start;
+
+      for (unsigned int j=0; j < profile_data.sector_data[i].num_data_points; j++) {
+	profile_data.sector_data[i].scan_timestamps[j] = profile_data.sector_data[i].timestamp_start +
+	  ((sector_span > 0) ? sector_duration*(profile_data.sector_data[i].scan_angles[j] - profile_data.sector_data[i].angle_start)/sector_span : 0);
+      }
+
+      /*
+       * Deskew the measurements if a pose lookup is registered. The first measurement of the
+       * profile is the reference; its pose is looked up once and, if it is unavailable, the
+       * whole profile is left as measured.
+       */
+      if (_sick_pose_callback != NULL && profile_data.sector_data[i].num_data_points > 0) {
+
+	if (!ref_pose_queried) {
+	  ref_pose_queried = true;
+	  if (!(have_ref_pose = _sick_pose_callback(profile_data.sector_data[i].scan_timestamps[0],ref_pose,_sick_pose_user_data))) {
+	    SICK_LOG_WARN("SickLD::_parseScanProfile: Reference pose unavailable, profile was not deskewed!");
+	  }
+	}
+
+	if (have_ref_pose && !_deskewScanSector(profile_data.sector_data[i],ref_pose)) {
+	  SICK_LOG_WARN("SickLD::_parseScanProfile: Pose unavailable, sector was not deskewed!");
+	}
+
+      }
+
+      /* Hand the sector over to its subscriber right away */
+      if (_sick_sector_callback != NULL && profile_data.sector_data[i].sector_num < SICK_MAX_NUM_SECTORS &&
+	  (_sick_sector_mask & (1 << profile_data.sector_data[i].sector_num))) {
+	_sick_sector_callback(profile_data.sector_data[i],profile_data.profile_counter,_sick_sector_user_data);
+      }
     
     }
 
@@ -2681,6 +3535,70 @@ namespace SickToolbox {
   
   }
 
+  /**
+   * \brief Moves the measurements of a parsed sector into the sensor frame at the reference pose
+   * \param &sector_data The parsed sector (ranges/scan angles are rewritten in place)
+   * \param &ref_pose The sensor pose at the first measurement of the profile
+   * \return True if the sector was deskewed, false if a pose was unavailable (the sector is then untouched)
+   *
+   * NOTE: The pose lookup is only queried for the first/last measurement of the
+   *       sector. Poses in between are interpolated linearly, which is accurate
+   *       since a sector spans a small fraction of a revolution.
+   */
+  bool SickLD::_deskewScanSector( sick_ld_sector_data_t &sector_data, const sick_ld_pose_t &ref_pose ) const {
+
+    if (sector_data.num_data_points == 0) {
+      return true;
+    }
+
+    sick_ld_pose_t start_pose, stop_pose;
+    if (!_sick_pose_callback(sector_data.scan_timestamps[0],start_pose,_sick_pose_user_data) ||
+	!_sick_pose_callback(sector_data.scan_timestamps[sector_data.num_data_points-1],stop_pose,_sick_pose_user_data)) {
+      return false;
+    }
+
+    const double degs_to_rads = M_PI/180.0;
+    const double cos_ref = cos(ref_pose.theta*degs_to_rads), sin_ref = sin(ref_pose.theta*degs_to_rads);
+
+    const double t_start = sector_data.scan_timestamps[0];
+    const double t_span = sector_data.scan_timestamps[sector_data.num_data_points-1] - t_start;
+
+    /* Take the shorter way around when the heading crosses +/-180 */
+    double theta_span = stop_pose.theta - start_pose.theta;
+    theta_span -= 360.0*floor((theta_span + 180.0)/360.0);
+
+    for (unsigned int j = 0; j < sector_data.num_data_points; j++) {
+
+      if (sector_data.range_values[j] == 0) {
+	continue;
+      }
+
+      /* Interpolate the pose at the measurement */
+      const double s = (t_span > 0) ? (sector_data.scan_timestamps[j] - t_start)/t_span : 0;
+      const double dx = start_pose.x + s*(stop_pose.x - start_pose.x) - ref_pose.x;
+      const double dy = start_pose.y + s*(stop_pose.y - start_pose.y) - ref_pose.y;
+      const double dtheta = (start_pose.theta + s*theta_span - ref_pose.theta)*degs_to_rads;
+
+      /* Measured point in the sensor frame at the measurement, then in the reference frame */
+      const double point_x = sector_data.range_values[j]*cos(sector_data.scan_angles[j]*degs_to_rads);
+      const double point_y = sector_data.range_values[j]*sin(sector_data.scan_angles[j]*degs_to_rads);
+      const double cos_dtheta = cos(dtheta), sin_dtheta = sin(dtheta);
+      const double ref_x = cos_dtheta*point_x - sin_dtheta*point_y + cos_ref*dx + sin_ref*dy;
+      const double ref_y = sin_dtheta*point_x + cos_dtheta*point_y - sin_ref*dx + cos_ref*dy;
+
+      sector_data.range_values[j] = sqrt(ref_x*ref_x + ref_y*ref_y);
+      sector_data.scan_angles[j] = atan2(ref_y,ref_x)/degs_to_rads;
+      if (sector_data.scan_angles[j] < 0) {
+	sector_data.scan_angles[j] += 360.0;
+      }
+
+    }
+
+    return true;
+
+  }
+
+
   /** 
    * \brief Kills the current data stream
    */
@@ -2694,25 +3612,25 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_cancelSickScanProfiles: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_cancelSickScanProfiles: Unknown exception!!!");
       throw;
     }  
   
@@ -2736,19 +3654,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getFirmwareName: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getFirmwareName: Unknown exception!!!");
       throw;
     }
   
@@ -2800,25 +3718,25 @@ namespace SickToolbox {
          
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_setSickFilter: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_setSickFilter: Unknown exception!!!");
 	throw;
       }  
 
@@ -2844,19 +3762,19 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickFilter: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickFilter: Unknown exception!!!");
       throw;
     }
 
@@ -2902,19 +3820,19 @@ namespace SickToolbox {
  
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSickIdentity: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSickIdentity: Unknown exception!!!");
       throw;
     }
   
@@ -2943,17 +3861,17 @@ namespace SickToolbox {
     }
     
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickLD::_getSickStatus - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLD::_getSickStatus - Unknown exception!");
       throw;
     }
     
@@ -2995,25 +3913,25 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickGlobalConfig: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickGlobalConfig: Unknown exception!!!");
       throw;
     }  
 
@@ -3047,19 +3965,19 @@ namespace SickToolbox {
               
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickGlobalConfig: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickGlobalConfig: Unknown exception!!!");
       throw;
     }  
 
@@ -3094,25 +4012,25 @@ namespace SickToolbox {
        
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSickGlobalConfig: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSickGlobalConfig: Unknown exception!!!");
       throw;
     }  
   
@@ -3135,19 +4053,19 @@ namespace SickToolbox {
             
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSickGlobalConfig: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSickGlobalConfig: Unknown exception!!!");
       throw;
     }
 
@@ -3157,34 +4075,11 @@ namespace SickToolbox {
     /* Extract the message payload */
     recv_message.GetPayload(payload_buffer);
 
-    /* Extract the configuration key */
-    uint16_t temp_buffer = 0;
-    unsigned int data_offset = 2;
-    memcpy(&temp_buffer,&payload_buffer[data_offset],2);
-    temp_buffer = sick_ld_to_host_byte_order(temp_buffer);
-    data_offset += 2;
+    /* Parse the reply */
+    _parseSickGlobalConfig(payload_buffer);
 
-    /* A quick sanity check */
-    if (temp_buffer != SICK_CONF_KEY_GLOBAL) {
-      throw SickErrorException("SickLD::_getSickGlobalConfig: Unexpected message contents!");
-    }
-
-    /* Extract the global sensor ID */
-    memcpy(&_sick_global_config.sick_sensor_id,&payload_buffer[data_offset],2);
-    _sick_global_config.sick_sensor_id = sick_ld_to_host_byte_order(_sick_global_config.sick_sensor_id);
-    data_offset += 2;
-  
-    /* Extract the nominal motor speed */
-    memcpy(&_sick_global_config.sick_motor_speed,&payload_buffer[data_offset],2);
-    _sick_global_config.sick_motor_speed = sick_ld_to_host_byte_order(_sick_global_config.sick_motor_speed);
-    data_offset += 2;
-
-    /* Extract the angular step */
-    memcpy(&temp_buffer,&payload_buffer[data_offset],2);
-    _sick_global_config.sick_angle_step = _ticksToAngle(sick_ld_to_host_byte_order(temp_buffer));
-  
-    /* Success */
-  }
+    /* Success */
+  }
 
   /**
    * \brief Get the Sick LD's Ethernet configuration.
@@ -3199,25 +4094,25 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }  
     
@@ -3239,19 +4134,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }  
     
@@ -3261,48 +4156,8 @@ namespace SickToolbox {
     /* Extract the message payload */
     recv_message.GetPayload(payload_buffer);
 
-    /* Extract the configuration key */
-    uint16_t temp_buffer = 0;
-    unsigned int data_offset = 2;
-    memcpy(&temp_buffer,&payload_buffer[data_offset],2);
-    temp_buffer = sick_ld_to_host_byte_order(temp_buffer);
-    data_offset += 2;
-
-    /* A quick sanity check */
-    if (temp_buffer != SICK_CONF_KEY_ETHERNET) {
-      throw SickErrorException("SickLD::_getSickEthernetConfig: Unexpected message contents!");
-    }
-  
-    /* Extract the IP address of the Sick LD */
-    for(unsigned int i=0; i < 4; i++,data_offset+=2) {
-      memcpy(&_sick_ethernet_config.sick_ip_address[i],&payload_buffer[data_offset],2);
-      _sick_ethernet_config.sick_ip_address[i] = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_ip_address[i]);
-    }
-
-    /* Extract the associated subnet mask */
-    for(unsigned int i=0; i < 4; i++,data_offset+=2) {
-      memcpy(&_sick_ethernet_config.sick_subnet_mask[i],&payload_buffer[data_offset],2);
-      _sick_ethernet_config.sick_subnet_mask[i] = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_subnet_mask[i]);
-    }
-
-    /* Extract the default gateway */
-    for(unsigned int i=0; i < 4; i++,data_offset+=2) {
-      memcpy(&_sick_ethernet_config.sick_gateway_ip_address[i],&payload_buffer[data_offset],2);
-      _sick_ethernet_config.sick_gateway_ip_address[i] = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_gateway_ip_address[i]);
-    }
-
-    /* Extract the sick node ID (NOTE: This value doesn't matter, but we buffer it anyways) */
-    memcpy(&_sick_ethernet_config.sick_node_id,&payload_buffer[data_offset],2);
-    _sick_ethernet_config.sick_node_id = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_node_id);
-    data_offset += 2;
-
-    /* Extract the transparent TCP port (NOTE: The significance of this value is unclear as
-     * it doesn't affect the actual TCP port number that the Sick server is operating at.
-     * But, we buffer it anyways as it is included in the configuration.)
-     */
-    memcpy(&_sick_ethernet_config.sick_transparent_tcp_port,&payload_buffer[data_offset],2);
-    _sick_ethernet_config.sick_transparent_tcp_port = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_transparent_tcp_port);
-    data_offset += 2;
+    /* Parse the reply */
+    _parseSickEthernetConfig(payload_buffer);
 
     /* Success */
   }
@@ -3318,71 +4173,51 @@ namespace SickToolbox {
   void SickLD::_getSickSectorConfig( )
     throw( SickErrorException, SickTimeoutException, SickIOException ) {
 
-    /* Reset the sector config struct */
-    memset(&_sick_sector_config,0,sizeof(sick_ld_config_sector_t));
+    /* Buffers for the sector functions and stop angles */
+    uint8_t sector_functions[SICK_MAX_NUM_SECTORS] = {0};
+    double sector_stop_angles[SICK_MAX_NUM_SECTORS] = {0};
     
     /* Get the configuration for all initialized sectors */
     for (unsigned int i = 0; i < SICK_MAX_NUM_SECTORS; i++) {
       
       /* Query the Sick for the function of the ith sector */
       try {
-	_getSickSectorFunction(i,_sick_sector_config.sick_sector_functions[i],_sick_sector_config.sick_sector_stop_angles[i]);
+	_getSickSectorFunction(i,sector_functions[i],sector_stop_angles[i]);
       }
       
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_getSickSectorConfig: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_getSickSectorConfig: Unknown exception!!!");
 	throw;
       } 
       
-      /* Check if the sector is initialized */
-      if (_sick_sector_config.sick_sector_functions[i] != SICK_CONF_SECTOR_NOT_INITIALIZED) {
-	
-	/* Check whether the sector is active (i.e. measuring) */
-	if (_sick_sector_config.sick_sector_functions[i] == SICK_CONF_SECTOR_NORMAL_MEASUREMENT) {
-	  _sick_sector_config.sick_active_sector_ids[_sick_sector_config.sick_num_active_sectors] = i;
-	  _sick_sector_config.sick_num_active_sectors++;
-	}
-	
-	/* Update the number of initialized sectors */
-	_sick_sector_config.sick_num_initialized_sectors++;
-      }    
-      else {
-	
-	/* An uninitialized sector marks the end of the sector configuration */
+      /* An uninitialized sector marks the end of the sector configuration */
+      if (sector_functions[i] == SICK_CONF_SECTOR_NOT_INITIALIZED) {
 	break;
       }
       
     } 
-  
-    /* Compute the starting angle for each of the initialized sectors */  
-    for (unsigned int i = 1; i < _sick_sector_config.sick_num_initialized_sectors; i++) {
-      _sick_sector_config.sick_sector_start_angles[i] = fmod(_sick_sector_config.sick_sector_stop_angles[i-1]+_sick_global_config.sick_angle_step,360);      
-    }
 
-    /* Determine the starting angle for the first sector */
-    if (_sick_sector_config.sick_num_initialized_sectors > 1) {
-      _sick_sector_config.sick_sector_start_angles[0] =
-	fmod(_sick_sector_config.sick_sector_stop_angles[_sick_sector_config.sick_num_initialized_sectors-1]+_sick_global_config.sick_angle_step,360);
-    }
+    /* Buffer the results */
+    _buildSickSectorConfig(sector_functions,sector_stop_angles);
   
     /* Success! */
   }
@@ -3414,19 +4249,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getIdentificationString: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getIdentificationString: Unknown exception!!!");
       throw;
     }
 
@@ -3454,19 +4289,19 @@ namespace SickToolbox {
           
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSensorPartNumber: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSensorPartNumber: Unknown exception!!!");
       throw;
     }
 
@@ -3485,19 +4320,19 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSensorName: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSensorName: Unknown exception!!!");
       throw;
     }
   
@@ -3516,19 +4351,19 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSensorVersion: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSensorVersion: Unknown exception!!!");
       throw;
     }
   
@@ -3546,19 +4381,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSensorSerialNumber: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSensorSerialNumber: Unknown exception!!!");
       throw;
     }
   
@@ -3576,19 +4411,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getSensorEDMSerialNumber: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getSensorEDMSerialNumber: Unknown exception!!!");
       throw;
     }
 
@@ -3606,19 +4441,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getFirmwarePartNumber: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getFirmwarePartNumber: Unknown exception!!!");
       throw;
     }
   
@@ -3636,19 +4471,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getFirmwareName: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getFirmwareName: Unknown exception!!!");
       throw;
     }
   
@@ -3666,19 +4501,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getFirmwareVersion: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getFirmwareVersion: Unknown exception!!!");
       throw;
     }
     
@@ -3696,19 +4531,19 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getApplicationSoftwarePartNumber: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getApplicationSoftwarePartNumber: Unknown exception!!!");
       throw;
     }
   
@@ -3726,19 +4561,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getApplication Software Name: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getApplication Software Name: Unknown exception!!!");
       throw;
     }
   
@@ -3756,19 +4591,19 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_getApplicationSoftwareVersion: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_getApplicationSoftwareVersion: Unknown exception!!!");
       throw;
     }
   
@@ -3851,25 +4686,25 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickGlobalParamsAndScanAreas: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickGlobalParamsAndScanAreas: Unknown exception!!!");
       throw;
     }  
     
@@ -3928,25 +4763,25 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickTemporaryScanAreas: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickTemporaryScanAreas: Unknown exception!!!");
       throw;
     }  
     
@@ -3979,31 +4814,31 @@ namespace SickToolbox {
       
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Handle I/O exceptions */
       catch (SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickErrorException &sick_error_exception) {
-	std::cerr << sick_error_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_error_exception.what());
 	throw;
       }
       
       /* Handle a returned error code */
       catch (SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLMS::_setSickSectorConfig: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS::_setSickSectorConfig: Unknown exception!!!");
 	throw;
       }  
 
@@ -4041,19 +4876,19 @@ namespace SickToolbox {
            
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }
 
@@ -4089,6 +4924,9 @@ namespace SickToolbox {
     byte_sequence[0] = send_message.GetServiceCode() | 0x80;
     byte_sequence[1] = send_message.GetServiceSubcode();
 
+    /* One exchange at a time (the clock sync thread shares the link) */
+    pthread_mutex_lock(&_sick_device_mutex);
+
     /* Send message and get reply using parent's method */
     try {
       SickLIDAR< SickLDBufferMonitor, SickLDMessage >::_sendMessageAndGetReply(send_message,recv_message,byte_sequence,2,0,DEFAULT_SICK_MESSAGE_TIMEOUT,1);
@@ -4096,22 +4934,509 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      pthread_mutex_unlock(&_sick_device_mutex);
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
+      pthread_mutex_unlock(&_sick_device_mutex);
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLD::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLD::_sendMessageAndGetReply: Unknown exception!!!");
+      pthread_mutex_unlock(&_sick_device_mutex);
       throw;
     }
 
+    pthread_mutex_unlock(&_sick_device_mutex);
+
+  }
+
+  /**
+   * \brief Sends a batch of requests back to back and collects their replies
+   * \param *send_messages The requests to send
+   * \param *recv_messages Array (num_messages long) to hold the matching replies
+   * \param num_messages The number of requests
+   * \param timeout_value The time in usecs to wait for the whole batch
+   *
+   * NOTE: Replies are matched by service code/subcode. Several requests w/ the
+   *       same codes are matched in the order they were sent.
+   */
+  void SickLD::_sendMessagesAndGetReplies( const SickLDMessage * const send_messages,
+					   SickLDMessage * const recv_messages,
+					   const unsigned int num_messages,
+					   const unsigned int timeout_value ) throw( SickIOException, SickTimeoutException, SickThreadException ) {
+
+    /* One exchange at a time (the clock sync thread shares the link) */
+    pthread_mutex_lock(&_sick_device_mutex);
+
+    /* Make sure the monitor queues every reply */
+    const unsigned int prev_queue_depth = _sick_buffer_monitor->GetMessageQueueDepth();
+    _sick_buffer_monitor->SetMessageQueueDepth(2*num_messages);
+
+    SickLDMessage *queued_messages = new SickLDMessage[num_messages];
+    struct timeval *queued_times = new struct timeval[num_messages];
+    bool *matched = new bool[num_messages];
+    
+    try {
+
+      for (unsigned int i = 0; i < num_messages; i++) {
+	matched[i] = false;
+      }
+      
+      /* Write the whole batch */
+      for (unsigned int i = 0; i < num_messages; i++) {
+	_sendMessage(send_messages[i],0);
+      }
+
+      struct timeval beg_time, end_time;
+      gettimeofday(&beg_time,NULL);
+      
+      /* Match the replies as they arrive */
+      unsigned int num_matched = 0;
+      while (num_matched < num_messages) {
+
+	/* Check whether the allowed time has expired */
+	gettimeofday(&end_time,NULL);
+	double elapsed_time = _computeElapsedTime(beg_time,end_time);
+	if (elapsed_time >= timeout_value) {
+	  _sick_buffer_monitor->GetMetrics().Increment(SickMetrics::SICK_METRICS_RECV_TIMEOUTS);
+	  throw SickTimeoutException("SickLD::_sendMessagesAndGetReplies: Timeout occurred!");
+	}
+	
+	unsigned int num_queued = _recvMessages(queued_messages,queued_times,num_messages,timeout_value - (unsigned int)elapsed_time);
+
+	for (unsigned int j = 0; j < num_queued; j++) {
+
+	  /* Find the oldest unmatched request w/ these codes */
+	  bool found_request = false;
+	  for (unsigned int i = 0; i < num_messages; i++) {
+	    if (!matched[i] &&
+		(send_messages[i].GetServiceCode() | 0x80) == queued_messages[j].GetServiceCode() &&
+		send_messages[i].GetServiceSubcode() == queued_messages[j].GetServiceSubcode()) {
+	      recv_messages[i] = queued_messages[j];
+	      matched[i] = found_request = true;
+	      num_matched++;
+	      break;
+	    }
+	  }
+
+	  /* A late streamed clock sync reply still makes a sample */
+	  if (!found_request) {
+	    _handleSickClockSyncReply(queued_messages[j],queued_times[j]);
+	  }
+
+	}
+	
+      }
+
+    }
+
+    /* Handle a timeout! */
+    catch (SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      _sick_buffer_monitor->SetMessageQueueDepth(prev_queue_depth);
+      delete [] queued_messages;
+      delete [] queued_times;
+      delete [] matched;
+      pthread_mutex_unlock(&_sick_device_mutex);
+      throw;
+    }
+    
+    /* Handle write buffer exceptions */
+    catch (SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      _sick_buffer_monitor->SetMessageQueueDepth(prev_queue_depth);
+      delete [] queued_messages;
+      delete [] queued_times;
+      delete [] matched;
+      pthread_mutex_unlock(&_sick_device_mutex);
+      throw;
+    }
+
+    /* Handle thread exceptions */
+    catch (SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      _sick_buffer_monitor->SetMessageQueueDepth(prev_queue_depth);
+      delete [] queued_messages;
+      delete [] queued_times;
+      delete [] matched;
+      pthread_mutex_unlock(&_sick_device_mutex);
+      throw;
+    }
+    
+    /* A safety net */
+    catch (...) {
+      SICK_LOG_ERROR("SickLD::_sendMessagesAndGetReplies: Unknown exception!!!");
+      _sick_buffer_monitor->SetMessageQueueDepth(prev_queue_depth);
+      delete [] queued_messages;
+      delete [] queued_times;
+      delete [] matched;
+      pthread_mutex_unlock(&_sick_device_mutex);
+      throw;
+    }
+
+    /* Restore the monitor */
+    _sick_buffer_monitor->SetMessageQueueDepth(prev_queue_depth);
+    delete [] queued_messages;
+    delete [] queued_times;
+    delete [] matched;
+    pthread_mutex_unlock(&_sick_device_mutex);
+    
+  }
+  /**
+   * \brief Hands a streamed GET_SYNC_CLOCK reply to the clock sync
+   * \param &sick_message A message received while streaming
+   * \param &recv_time The time at which the buffer monitor framed the message
+   * \return True if the message was a GET_SYNC_CLOCK reply (and was consumed), false otherwise
+   *
+   * NOTE: The round trip ends when the reply was framed, not when it was picked
+   *       up, so a slow consumer does not skew the sample.
+   */
+  bool SickLD::_handleSickClockSyncReply( const SickLDMessage &sick_message, const struct timeval &recv_time ) {
+
+    if (sick_message.GetServiceCode() != (SICK_CONF_SERV_CODE | 0x80) || sick_message.GetServiceSubcode() != SICK_CONF_SERV_GET_SYNC_CLOCK) {
+      return false;
+    }
+
+    const uint64_t host_recv_time = SickLDClockSync::GetHostTime(recv_time);
+
+    /* Claim the outstanding request (a late reply to an abandoned one is dropped) */
+    pthread_mutex_lock(&_sick_clock_sync_mutex);
+    const uint64_t host_send_time = _sick_clock_sync_send_time;
+    _sick_clock_sync_send_time = 0;
+    pthread_mutex_unlock(&_sick_clock_sync_mutex);
+
+    if (host_send_time != 0) {
+
+      uint8_t payload_buffer[SickLDMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
+      sick_message.GetPayload(payload_buffer);
+
+      uint16_t sick_time = 0;
+      memcpy(&sick_time,&payload_buffer[2],2);
+
+      try {
+	_sick_clock_sync.AddSample(host_send_time,sick_ld_to_host_byte_order(sick_time),host_recv_time);
+      }
+
+      catch (SickThreadException &sick_thread_exception) {
+	SICK_LOG_ERROR(sick_thread_exception.what());
+      }
+
+    }
+
+    return true;
+
+  }
+
+  /**
+   * \brief Drops the clock mapping and any outstanding sample
+   */
+  void SickLD::_resetSickClockSync( ) {
+
+    pthread_mutex_lock(&_sick_clock_sync_mutex);
+    _sick_clock_sync_send_time = 0;
+    pthread_mutex_unlock(&_sick_clock_sync_mutex);
+
+    try {
+      _sick_clock_sync.Reset();
+    }
+
+    catch (SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+    }
+
+  }
+
+  /**
+   * \brief Tells the clock sync thread a profile was just received
+   */
+  void SickLD::_signalSickProfileRecvd( ) {
+
+    if (_sick_clock_sync_running) {
+      pthread_mutex_lock(&_sick_clock_sync_mutex);
+      _sick_clock_sync_profile_recvd = true;
+      pthread_cond_broadcast(&_sick_clock_sync_cond);
+      pthread_mutex_unlock(&_sick_clock_sync_mutex);
+    }
+
+  }
+
+  /**
+   * \brief Takes one clock sample
+   */
+  void SickLD::_sampleSickClock( ) {
+
+    /* Hold the device so the stream cannot start/stop in between */
+    pthread_mutex_lock(&_sick_device_mutex);
+
+    try {
+
+      if (!_sick_streaming_range_data && !_sick_streaming_range_and_echo_data) {
+
+	/* A regular round trip */
+	uint16_t sick_time = 0;
+	const uint64_t host_send_time = SickLDClockSync::GetHostTime();
+	GetSickTime(sick_time);
+	_sick_clock_sync.AddSample(host_send_time,sick_time,SickLDClockSync::GetHostTime());
+
+      }
+      else if (_sick_buffer_monitor->GetMessageQueueDepth() > 0) {
+
+	/* Fire the request; the profile receive path picks up the reply from the FIFO */
+	uint8_t payload_buffer[2] = {SICK_CONF_SERV_CODE,SICK_CONF_SERV_GET_SYNC_CLOCK};
+	SickLDMessage send_message(payload_buffer,2);
+
+	pthread_mutex_lock(&_sick_clock_sync_mutex);
+	_sick_clock_sync_send_time = SickLDClockSync::GetHostTime();
+	pthread_mutex_unlock(&_sick_clock_sync_mutex);
+
+	_sendMessage(send_message,0);
+
+      }
+
+    }
+
+    /* Sampling failures are not fatal, the next period tries again */
+    catch (SickException &sick_exception) {
+      SICK_LOG_WARN("SickLD::_sampleSickClock: Failed to sample the sync clock!");
+    }
+
+    catch (...) {
+      SICK_LOG_ERROR("SickLD::_sampleSickClock: Unknown exception!!!");
+    }
+
+    pthread_mutex_unlock(&_sick_device_mutex);
+
+  }
+
+  /**
+   * \brief The clock sync thread
+   * \param thread_args The SickLD instance
+   *
+   * NOTE: While streaming, samples are only taken right after a profile has been
+   *       received and only while the monitor's FIFO is enabled (i.e. a profile
+   *       stream is running), so a clock reply never overwrites a profile.
+   */
+  void * SickLD::_clockSyncThread( void * thread_args ) {
+
+    SickLD * const sick_ld = (SickLD *)thread_args;
+
+    pthread_mutex_lock(&sick_ld->_sick_clock_sync_mutex);
+    while (sick_ld->_sick_clock_sync_running) {
+
+      /* Wait for a profile if streaming */
+      if (sick_ld->_sick_streaming_range_data || sick_ld->_sick_streaming_range_and_echo_data) {
+
+	sick_ld->_sick_clock_sync_profile_recvd = false;
+
+	struct timeval curr_time;
+	gettimeofday(&curr_time,NULL);
+	struct timespec wake_time;
+	wake_time.tv_sec = curr_time.tv_sec + 1;
+	wake_time.tv_nsec = curr_time.tv_usec*1000;
+
+	while (sick_ld->_sick_clock_sync_running && !sick_ld->_sick_clock_sync_profile_recvd &&
+	       pthread_cond_timedwait(&sick_ld->_sick_clock_sync_cond,&sick_ld->_sick_clock_sync_mutex,&wake_time) == 0);
+
+	/* No profile within a second, check the stream state again */
+	if (!sick_ld->_sick_clock_sync_profile_recvd) {
+	  continue;
+	}
+
+      }
+
+      pthread_mutex_unlock(&sick_ld->_sick_clock_sync_mutex);
+      sick_ld->_sampleSickClock();
+      pthread_mutex_lock(&sick_ld->_sick_clock_sync_mutex);
+
+      /* Sleep until the next sample is due (or we are stopped) */
+      struct timeval curr_time;
+      gettimeofday(&curr_time,NULL);
+      const uint64_t wake_usecs = (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_usec + sick_ld->_sick_clock_sync_period;
+      struct timespec wake_time;
+      wake_time.tv_sec = wake_usecs/1000000;
+      wake_time.tv_nsec = (wake_usecs%1000000)*1000;
+
+      while (sick_ld->_sick_clock_sync_running &&
+	     pthread_cond_timedwait(&sick_ld->_sick_clock_sync_cond,&sick_ld->_sick_clock_sync_mutex,&wake_time) == 0);
+
+    }
+    pthread_mutex_unlock(&sick_ld->_sick_clock_sync_mutex);
+
+    return NULL;
+
+  }
+
+
+  /**
+   * \brief Parses the reply to a GET_CONFIGURATION (global) request
+   * \param *payload_buffer The reply payload
+   */
+  void SickLD::_parseSickGlobalConfig( const uint8_t * const payload_buffer ) throw( SickErrorException ) {
+
+    /* Extract the configuration key */
+    uint16_t temp_buffer = 0;
+    unsigned int data_offset = 2;
+    memcpy(&temp_buffer,&payload_buffer[data_offset],2);
+    temp_buffer = sick_ld_to_host_byte_order(temp_buffer);
+    data_offset += 2;
+
+    /* A quick sanity check */
+    if (temp_buffer != SICK_CONF_KEY_GLOBAL) {
+      throw SickErrorException("SickLD::_parseSickGlobalConfig: Unexpected message contents!");
+    }
+
+    /* Extract the global sensor ID */
+    memcpy(&_sick_global_config.sick_sensor_id,&payload_buffer[data_offset],2);
+    _sick_global_config.sick_sensor_id = sick_ld_to_host_byte_order(_sick_global_config.sick_sensor_id);
+    data_offset += 2;
+  
+    /* Extract the nominal motor speed */
+    memcpy(&_sick_global_config.sick_motor_speed,&payload_buffer[data_offset],2);
+    _sick_global_config.sick_motor_speed = sick_ld_to_host_byte_order(_sick_global_config.sick_motor_speed);
+    data_offset += 2;
+
+    /* Extract the angular step */
+    memcpy(&temp_buffer,&payload_buffer[data_offset],2);
+    _sick_global_config.sick_angle_step = _ticksToAngle(sick_ld_to_host_byte_order(temp_buffer));
+
+  }
+
+  /**
+   * \brief Parses the reply to a GET_CONFIGURATION (Ethernet) request
+   * \param *payload_buffer The reply payload
+   */
+  void SickLD::_parseSickEthernetConfig( const uint8_t * const payload_buffer ) throw( SickErrorException ) {
+
+    /* Extract the configuration key */
+    uint16_t temp_buffer = 0;
+    unsigned int data_offset = 2;
+    memcpy(&temp_buffer,&payload_buffer[data_offset],2);
+    temp_buffer = sick_ld_to_host_byte_order(temp_buffer);
+    data_offset += 2;
+
+    /* A quick sanity check */
+    if (temp_buffer != SICK_CONF_KEY_ETHERNET) {
+      throw SickErrorException("SickLD::_parseSickEthernetConfig: Unexpected message contents!");
+    }
+  
+    /* Extract the IP address of the Sick LD */
+    for(unsigned int i=0; i < 4; i++,data_offset+=2) {
+      memcpy(&_sick_ethernet_config.sick_ip_address[i],&payload_buffer[data_offset],2);
+      _sick_ethernet_config.sick_ip_address[i] = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_ip_address[i]);
+    }
+
+    /* Extract the associated subnet mask */
+    for(unsigned int i=0; i < 4; i++,data_offset+=2) {
+      memcpy(&_sick_ethernet_config.sick_subnet_mask[i],&payload_buffer[data_offset],2);
+      _sick_ethernet_config.sick_subnet_mask[i] = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_subnet_mask[i]);
+    }
+
+    /* Extract the default gateway */
+    for(unsigned int i=0; i < 4; i++,data_offset+=2) {
+      memcpy(&_sick_ethernet_config.sick_gateway_ip_address[i],&payload_buffer[data_offset],2);
+      _sick_ethernet_config.sick_gateway_ip_address[i] = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_gateway_ip_address[i]);
+    }
+
+    /* Extract the sick node ID (NOTE: This value doesn't matter, but we buffer it anyways) */
+    memcpy(&_sick_ethernet_config.sick_node_id,&payload_buffer[data_offset],2);
+    _sick_ethernet_config.sick_node_id = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_node_id);
+    data_offset += 2;
+
+    /* Extract the transparent TCP port (NOTE: The significance of this value is unclear as
+     * it doesn't affect the actual TCP port number that the Sick server is operating at.
+     * But, we buffer it anyways as it is included in the configuration.)
+     */
+    memcpy(&_sick_ethernet_config.sick_transparent_tcp_port,&payload_buffer[data_offset],2);
+    _sick_ethernet_config.sick_transparent_tcp_port = sick_ld_to_host_byte_order(_sick_ethernet_config.sick_transparent_tcp_port);
+    data_offset += 2;
+
+  }
+
+  /**
+   * \brief Parses the reply to a GET_FUNCTION request
+   * \param *payload_buffer The reply payload
+   * \param sector_num The sector that was queried
+   * \param &sector_function The function of the sector
+   * \param &sector_stop_angle The stop angle of the sector (deg)
+   */
+  void SickLD::_parseSickSectorFunction( const uint8_t * const payload_buffer, const uint8_t sector_num,
+					 uint8_t &sector_function, double &sector_stop_angle ) const throw( SickErrorException ) {
+
+    /* Extract the returned sector number */
+    uint16_t temp_buffer = 0;
+    memcpy(&temp_buffer,&payload_buffer[2],2);
+    temp_buffer = sick_ld_to_host_byte_order(temp_buffer);
+
+    /* Check to make sure the returned sector number matches
+     * the requested sector number.
+     */
+    if (temp_buffer != sector_num) {
+      throw SickErrorException("SickLD::_parseSickSectorFunction: Unexpected sector number returned by Sick LD!");
+    }
+
+    /* Extract the sector function */
+    memcpy(&temp_buffer,&payload_buffer[4],2);
+    sector_function = sick_ld_to_host_byte_order(temp_buffer);
+
+    /* Extract the sector stop angle (in ticks) */
+    memcpy(&temp_buffer,&payload_buffer[6],2);
+    sector_stop_angle = _ticksToAngle(sick_ld_to_host_byte_order(temp_buffer));
+
+  }
+
+  /**
+   * \brief Buffers the sector config given the function/stop angle of each sector
+   * \param *sector_functions The function of each sector (terminated by an uninitialized sector)
+   * \param *sector_stop_angles The stop angle of each sector (deg)
+   */
+  void SickLD::_buildSickSectorConfig( const uint8_t * const sector_functions, const double * const sector_stop_angles ) {
+
+    /* Reset the sector config struct */
+    memset(&_sick_sector_config,0,sizeof(sick_ld_config_sector_t));
+
+    for (unsigned int i = 0; i < SICK_MAX_NUM_SECTORS; i++) {
+
+      _sick_sector_config.sick_sector_functions[i] = sector_functions[i];
+      _sick_sector_config.sick_sector_stop_angles[i] = sector_stop_angles[i];
+      
+/* Check if the sector is initialized */
+      if (_sick_sector_config.sick_sector_functions[i] != SICK_CONF_SECTOR_NOT_INITIALIZED) {
+	
+	/* Check whether the sector is active (i.e. measuring) */
+	if (_sick_sector_config.sick_sector_functions[i] == SICK_CONF_SECTOR_NORMAL_MEASUREMENT) {
+	  _sick_sector_config.sick_active_sector_ids[_sick_sector_config.sick_num_active_sectors] = i;
+	  _sick_sector_config.sick_num_active_sectors++;
+	}
+	
+	/* Update the number of initialized sectors */
+	_sick_sector_config.sick_num_initialized_sectors++;
+      }    
+      else {
+	
+	/* An uninitialized sector marks the end of the sector configuration */
+	break;
+      }
+      
+    } 
+  
+    /* Compute the starting angle for each of the initialized sectors */  
+    for (unsigned int i = 1; i < _sick_sector_config.sick_num_initialized_sectors; i++) {
+      _sick_sector_config.sick_sector_start_angles[i] = fmod(_sick_sector_config.sick_sector_stop_angles[i-1]+_sick_global_config.sick_angle_step,360);      
+    }
+
+    /* Determine the starting angle for the first sector */
+    if (_sick_sector_config.sick_num_initialized_sectors > 1) {
+      _sick_sector_config.sick_sector_start_angles[0] =
+	fmod(_sick_sector_config.sick_sector_stop_angles[_sick_sector_config.sick_num_initialized_sectors-1]+_sick_global_config.sick_angle_step,360);
+    }
+
   }
 
   /**
@@ -4144,19 +5469,19 @@ namespace SickToolbox {
 
     /* Catch any serious IO exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* A sanity check */
     catch(...) {
-      std::cerr << "SickLMS::_flushTerminalBuffer: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_flushTerminalBuffer: Unknown exception!");
       throw;
     }
     
@@ -4356,7 +5681,7 @@ namespace SickToolbox {
 
     /* Check the validity of the new Sick LD angular step */
     if (sick_angle_step < SICK_MAX_SCAN_ANGULAR_RESOLUTION || fmod(sick_angle_step,SICK_MAX_SCAN_ANGULAR_RESOLUTION) != 0) {
-      std::cerr << "Invalid scan resolution! (should be a positive multiple of " << SICK_MAX_SCAN_ANGULAR_RESOLUTION << ")" << std::endl;
+      SICK_LOG_ERROR("Invalid scan resolution! (should be a positive multiple of " << SICK_MAX_SCAN_ANGULAR_RESOLUTION << ")");
       return false;
     }
   
@@ -4365,7 +5690,7 @@ namespace SickToolbox {
       
       /* Check both the sector start and stop angles */
       if (fmod(sector_start_angles[i],sick_angle_step) != 0 || fmod(sector_stop_angles[i],sick_angle_step) != 0) {
-	std::cerr << "Invalid scan resolution! (sector boundaries must be evenly divisible by the step angle)" << std::endl;
+	SICK_LOG_ERROR("Invalid scan resolution! (sector boundaries must be evenly divisible by the step angle)");
 	return false;
       }
     
@@ -4410,13 +5735,13 @@ namespace SickToolbox {
   
     /* Check the mean pulse rate of the desired configuration */
     if (_computeMeanPulseFrequency(scan_area,sick_motor_speed,sick_angle_step) > SICK_MAX_MEAN_PULSE_FREQUENCY) { 
-      std::cerr << "Max mean pulse frequency exceeded! (try a slower motor speed, a larger step angle and/or a smaller active scan area)" << std::endl;
+      SICK_LOG_ERROR("Max mean pulse frequency exceeded! (try a slower motor speed, a larger step angle and/or a smaller active scan area)");
       return false;
     }
 
     /* Check the maximum pulse rate of the desired configuration */
     if (_computeMaxPulseFrequency(SICK_MAX_SCAN_AREA,sick_motor_speed,sick_angle_step) > SICK_MAX_PULSE_FREQUENCY) { 
-      std::cerr << "Max pulse frequency exceeded! (try a slower motor speed, a larger step angle and/or a smaller active scan area)" << std::endl;
+      SICK_LOG_ERROR("Max pulse frequency exceeded! (try a slower motor speed, a larger step angle and/or a smaller active scan area)");
       return false;
     }
   
@@ -4502,7 +5827,7 @@ namespace SickToolbox {
       if (sector_start_angles[i] < 0 || sector_stop_angles[i] < 0 ||
 	  sector_start_angles[i] >= 360 || sector_stop_angles[i] >= 360) {
 
-	std::cerr << "Invalid sector config! (all degree values must be in [0,360))" << std::endl;
+	SICK_LOG_ERROR("Invalid sector config! (all degree values must be in [0,360))");
 	return false;
       }
     
@@ -4514,7 +5839,7 @@ namespace SickToolbox {
       /* Check whether the given sector arrangement is overlapping */
       for (unsigned int i = 0; i < (num_sectors - 1); i++) {
 	if (sector_start_angles[i] > sector_stop_angles[i] || sector_stop_angles[i] >= sector_start_angles[i+1]) {
-	  std::cerr << "Invalid sector definitions! (check sector bounds)" << std::endl;
+	  SICK_LOG_ERROR("Invalid sector definitions! (check sector bounds)");
 	  return false;
 	}    
       }
@@ -4522,7 +5847,7 @@ namespace SickToolbox {
       /* Check the last sector against the first */    
       if (sector_stop_angles[num_sectors-1] <= sector_start_angles[num_sectors-1] &&
 	  sector_stop_angles[num_sectors-1] >= sector_start_angles[0]) {
-	std::cerr << "Invalid sector definitions! (check sector bounds)" << std::endl;
+	SICK_LOG_ERROR("Invalid sector definitions! (check sector bounds)");
 	return false;
       }
     
@@ -4573,7 +5898,7 @@ namespace SickToolbox {
    * \param print_sector_data Indicates whether to print the sector data fields associated
    *                          with the given profile.
    */
-  void SickLD::_printSickScanProfile( const sick_ld_scan_profile_t profile_data, const bool print_sector_data ) const {
+  void SickLD::_printSickScanProfile( const sick_ld_scan_profile_t &profile_data, const bool print_sector_data ) const {
   
     std::cout << "\t========= Sick Scan Prof. =========" << std::endl;
     std::cout << "\tProfile Num.: " << profile_data.profile_number << std::endl;
@@ -4607,7 +5932,7 @@ namespace SickToolbox {
     case SICK_SENSOR_MODE_MEASURE:
       return SICK_WORK_SERV_TRANS_MEASURE;
     default:
-      std::cerr << "SickLD::_sickSensorModeToWorkServiceSubcode: Invalid sensor mode! (Returning 0)" << std::endl;
+      SICK_LOG_WARN("SickLD::_sickSensorModeToWorkServiceSubcode: Invalid sensor mode! (Returning 0)");
       return 0; //Something is seriously wrong if we end up here!
     }
   }
@@ -40,6 +40,8 @@
 #include <sicktoolbox/SickLMS1xxBufferMonitor.hh>
 #include <sicktoolbox/SickLMS1xxUtility.hh>   
 #include <sicktoolbox/SickException.hh>
+#include <sicktoolbox/SickLogger.hh>
+#include <sicktoolbox/SickTrace.hh>
 
 /* Associate the namespace */
 namespace SickToolbox {
@@ -109,27 +111,27 @@ namespace SickToolbox {
     }
     
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickLMS1xx::Initialize - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::Initialize - Unknown exception!");
       throw;
     }
     
@@ -170,25 +172,25 @@ namespace SickToolbox {
 
     /* Handle config exceptions */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::SetSickScanFreqAndRes: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::SetSickScanFreqAndRes: Unknown exception!!!");
       throw;
     }
     
@@ -287,18 +289,18 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     catch (...) {
-      std::cerr << "SickLMS1xx::SetSickScanDataFormat: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::SetSickScanDataFormat: Unknown exception!!!");
       throw;
     }
 
@@ -336,24 +338,24 @@ namespace SickToolbox {
 
     /* Handle config exceptions */
     catch (SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     catch (...) {
-      std::cerr << "SickLMS1xx::GetSickMeasurements: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::GetSickMeasurements: Unknown exception!!!");
       throw;
     }
 
@@ -369,15 +371,18 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     catch (...) {
-      std::cerr << "SickLMS1xx::GetSickMeasurements: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::GetSickMeasurements: Unknown exception!!!");
       throw;
     }
     
+    /* Trace the parse below */
+    SICK_TRACE_SCOPE_ARG("SickLMS1xx::GetSickMeasurements (parse)",_sick_fd);
+
     /* Allocate a single buffer for payload contents */
     uint8_t payload_buffer[SickLMS1xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH+1] = {0};
     
@@ -418,18 +423,8 @@ namespace SickToolbox {
 	throw SickIOException("SickLMS1xx::GetSickMeasurements: _findSubString() failed!");
       }
       
-      /* Extract Num DIST1 Values */
-      payload_str = (char *)&payload_buffer[substr_dist_1_pos+6];
-      for (unsigned int i = 0; i < 4; i++) {
-	payload_str = _convertNextTokenToUInt(payload_str,null_int);
-      }
-      
-      payload_str = _convertNextTokenToUInt(payload_str,num_dist_1_vals);
-      
-      /* Grab the DIST1 values */
-      for (unsigned int i = 0; i < num_dist_1_vals; i++) {
-	payload_str = _convertNextTokenToUInt(payload_str,range_1_vals[i]);
-      }
+      /* Grab the DIST1 values (through the ROI) */
+      _extractSickChannelValues((char *)&payload_buffer[substr_dist_1_pos+6],range_1_vals,num_dist_1_vals,true);
 
     }
       
@@ -444,22 +439,12 @@ namespace SickToolbox {
       unsigned int substr_dist_2_pos = 0;
       if (_findSubString((char *)payload_buffer,substr_dist_2,recv_message.GetPayloadLength()+1,5,substr_dist_2_pos)) {
 
-	/* Extract Num DIST2 Values */
-	payload_str = (char *)&payload_buffer[substr_dist_2_pos+6];
-	for (unsigned int i = 0; i < 4; i++) {
-	  payload_str = _convertNextTokenToUInt(payload_str,null_int);
-	}
-	
-	payload_str = _convertNextTokenToUInt(payload_str,num_dist_2_vals);
-	
-	/* Acquire the DIST2 values */
-	for (unsigned int i = 0; i < num_dist_2_vals; i++) {
-	  payload_str = _convertNextTokenToUInt(payload_str,range_2_vals[i]);
-	}
+	/* Acquire the DIST2 values (through the ROI) */
+	_extractSickChannelValues((char *)&payload_buffer[substr_dist_2_pos+6],range_2_vals,num_dist_2_vals,true);
       }
       else {
-	std::cerr << "SickLMS1xx::GetSickMeasurements: WARNING! It seems you are expecting double-pulse range values, which are not being streamed! ";
-	std::cerr << "Use SetSickScanDataFormat to configure the LMS 1xx to stream these values - or - set the corresponding buffer input to NULL to avoid this warning." << std::endl;	
+	SICK_LOG_WARN("SickLMS1xx::GetSickMeasurements: WARNING! It seems you are expecting double-pulse range values, which are not being streamed! "
+		      << "Use SetSickScanDataFormat to configure the LMS 1xx to stream these values - or - set the corresponding buffer input to NULL to avoid this warning.");
       }
 	
     }
@@ -475,22 +460,12 @@ namespace SickToolbox {
       unsigned int substr_rssi_1_pos = 0;
       if (_findSubString((char *)payload_buffer,substr_rssi_1,recv_message.GetPayloadLength()+1,5,substr_rssi_1_pos)) {
       
-	/* Extract Num RSSI1 Values */
-	payload_str = (char *)&payload_buffer[substr_rssi_1_pos+6];
-	for (unsigned int i = 0; i < 4; i++) {
-	  payload_str = _convertNextTokenToUInt(payload_str,null_int);
-	}
-	
-	payload_str = _convertNextTokenToUInt(payload_str,num_rssi_1_vals);
-	
-	/* Grab the RSSI1 values */
-	for (unsigned int i = 0; i < num_rssi_1_vals; i++) {
-	  payload_str = _convertNextTokenToUInt(payload_str,reflect_1_vals[i]);
-	}
+	/* Grab the RSSI1 values (through the ROI) */
+	_extractSickChannelValues((char *)&payload_buffer[substr_rssi_1_pos+6],reflect_1_vals,num_rssi_1_vals,false);
       }
       else {
-	std::cerr << "SickLMS1xx::GetSickMeasurements: WARNING! It seems you are expecting single-pulse reflectivity values, which are not being streamed! ";
-	std::cerr << "Use SetSickScanDataFormat to configure the LMS 1xx to stream these values - or - set the corresponding buffer input to NULL to avoid this warning." << std::endl;	
+	SICK_LOG_WARN("SickLMS1xx::GetSickMeasurements: WARNING! It seems you are expecting single-pulse reflectivity values, which are not being streamed! "
+		      << "Use SetSickScanDataFormat to configure the LMS 1xx to stream these values - or - set the corresponding buffer input to NULL to avoid this warning.");
       }
 	  
     }
@@ -506,22 +481,12 @@ namespace SickToolbox {
       unsigned int substr_rssi_2_pos = 0;
       if (_findSubString((char *)payload_buffer,substr_rssi_2,recv_message.GetPayloadLength()+1,5,substr_rssi_2_pos)) {
     
-	/* Extract Num RSSI1 Values */
-	payload_str = (char *)&payload_buffer[substr_rssi_2_pos+6];
-	for (unsigned int i = 0; i < 4; i++) {
-	  payload_str = _convertNextTokenToUInt(payload_str,null_int);
-	}
-	
-	payload_str = _convertNextTokenToUInt(payload_str,num_rssi_2_vals);
-	
-	/* Grab the RSSI1 values */
-	for (unsigned int i = 0; i < num_rssi_2_vals; i++) {
-	  payload_str = _convertNextTokenToUInt(payload_str,reflect_2_vals[i]);
-	}
+	/* Grab the RSSI2 values (through the ROI) */
+	_extractSickChannelValues((char *)&payload_buffer[substr_rssi_2_pos+6],reflect_2_vals,num_rssi_2_vals,false);
       }
       else {
-	std::cerr << "SickLMS1xx::GetSickMeasurements: WARNING! It seems you are expecting double-pulse reflectivity values, which are not being streamed! ";
-	std::cerr << "Use SetSickScanDataFormat to configure the LMS 1xx to stream these values - or - set the corresponding buffer input to NULL to avoid this warning." << std::endl;	
+	SICK_LOG_WARN("SickLMS1xx::GetSickMeasurements: WARNING! It seems you are expecting double-pulse reflectivity values, which are not being streamed! "
+		      << "Use SetSickScanDataFormat to configure the LMS 1xx to stream these values - or - set the corresponding buffer input to NULL to avoid this warning.");
       }
 
     }
@@ -533,6 +498,277 @@ namespace SickToolbox {
     
   }
   
+  /**
+   * \brief Acquire single-pulse sick range measurements as a SickScan
+   * \param sick_scan The destination scan
+   *
+   * NOTE: The DIST1 (and, if streamed, RSSI1) channels are decoded straight
+   *       into the scan. Ranges are scaled by the channel's scale factor and
+   *       given in meters; angles are taken from the channel header (device
+   *       frame, 90 deg straight ahead). The header holds the device's scan
+   *       counter and its time since startup (usecs).
+   */
+  void SickLMS1xx::GetSickScan( SickScan &sick_scan ) throw ( SickIOException, SickConfigException, SickTimeoutException ) {
+
+    /* Ensure the device has been initialized */
+    if (!_sick_initialized) {
+      throw SickIOException("SickLMS1xx::GetSickScan: Device NOT Initialized!!!");
+    }
+
+    try {
+
+      /* Is the device already streaming? */
+      if (!_sick_streaming) {
+	_requestDataStream();
+      }
+
+    }
+
+    /* Handle config exceptions */
+    catch (SickConfigException &sick_config_exception) {
+      SICK_LOG_ERROR(sick_config_exception.what());
+      throw;
+    }
+
+    /* Handle a timeout! */
+    catch (SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      throw;
+    }
+
+    /* Handle write buffer exceptions */
+    catch (SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      throw;
+    }
+
+    catch (...) {
+      SICK_LOG_ERROR("SickLMS1xx::GetSickScan: Unknown exception!!!");
+      throw;
+    }
+
+    /* Allocate receive message */
+    SickLMS1xxMessage recv_message;
+
+    try {
+
+      /* Grab the next message from the stream */
+      _recvMessage(recv_message);
+
+    }
+
+    /* Handle a timeout! */
+    catch (SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      throw;
+    }
+
+    catch (...) {
+      SICK_LOG_ERROR("SickLMS1xx::GetSickScan: Unknown exception!!!");
+      throw;
+    }
+
+    /* Trace the parse below */
+    SICK_TRACE_SCOPE_ARG("SickLMS1xx::GetSickScan (parse)",_sick_fd);
+
+    /* Allocate a single buffer for payload contents */
+    uint8_t payload_buffer[SickLMS1xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH+1] = {0};
+
+    recv_message.GetPayloadAsCStr((char *)payload_buffer);
+
+    char * payload_str = NULL;
+    unsigned int null_int = 0;
+
+    /*
+     * Acquire the scan counter and time since startup
+     */
+    SickScan::sick_scan_header_t &sick_scan_header = sick_scan.GetHeader();
+
+    payload_str = (char *)&payload_buffer[16];
+    for (unsigned int i = 0; i < 6; i++) {
+      payload_str = _convertNextTokenToUInt(payload_str,null_int);
+    }
+
+    unsigned int scan_counter = 0, time_since_startup = 0;
+    payload_str = _convertNextTokenToUInt(payload_str,scan_counter);
+    _convertNextTokenToUInt(payload_str,time_since_startup);
+
+    sick_scan_header.sick_scan_index = scan_counter;
+    sick_scan_header.sick_device_timestamp = time_since_startup;
+    gettimeofday(&sick_scan_header.sick_host_time,NULL);
+    sick_scan_header.sick_device_host_time = 0;
+
+    /*
+     * Process DIST1
+     */
+    const char * substr_dist_1 = "DIST1";
+    unsigned int substr_dist_1_pos = 0;
+    if (!_findSubString((char *)payload_buffer,substr_dist_1,recv_message.GetPayloadLength()+1,5,substr_dist_1_pos)) {
+      throw SickIOException("SickLMS1xx::GetSickScan: _findSubString() failed!");
+    }
+
+    /* Extract the channel header (scale factor, offset, start angle, step, count) */
+    unsigned int scale_factor_bits = 0, start_angle = 0, step_angle = 0, num_dist_1_vals = 0;
+    payload_str = (char *)&payload_buffer[substr_dist_1_pos+6];
+    payload_str = _convertNextTokenToUInt(payload_str,scale_factor_bits);
+    payload_str = _convertNextTokenToUInt(payload_str,null_int);
+    payload_str = _convertNextTokenToUInt(payload_str,start_angle);
+    payload_str = _convertNextTokenToUInt(payload_str,step_angle);
+    payload_str = _convertNextTokenToUInt(payload_str,num_dist_1_vals);
+
+    if (num_dist_1_vals > SICK_LMS_1XX_MAX_NUM_MEASUREMENTS) {
+      throw SickIOException("SickLMS1xx::GetSickScan: Too many DIST1 values!");
+    }
+
+    /* The scale factor is sent as the bits of an IEEE float */
+    float scale_factor = 0;
+    const uint32_t scale_factor_word = scale_factor_bits;
+    memcpy(&scale_factor,&scale_factor_word,sizeof(float));
+    const double range_scale = ((scale_factor > 0) ? scale_factor : 1.0f)*0.001;
+
+    try {
+      sick_scan.Resize(num_dist_1_vals);
+    }
+
+    catch (std::bad_alloc &) {
+      throw SickIOException("SickLMS1xx::GetSickScan: Failed to allocate scan storage!");
+    }
+
+    /* Beams are evenly spaced over one revolution */
+    const unsigned int scan_freq = _convertSickFreqUnitsToHz(_sick_scan_config.sick_scan_freq);
+    const double scan_period = (scan_freq > 0) ? 1e6/scan_freq : 0;
+    const double start_angle_degs = _convertSickAngleUnitsToDegs((int32_t)start_angle);
+    const double step_angle_degs = _convertSickAngleUnitsToDegs(step_angle);
+    const double beam_period = scan_period*step_angle_degs/360.0;
+    sick_scan_header.sick_scan_period = (float)scan_period;
+
+    /* Acquire the ROI range limits (in device units) */
+    unsigned int min_range_value = 0, max_range_value = UINT_MAX;
+    _sick_scan_roi.GetRawRangeLimits(range_scale,min_range_value,max_range_value);
+    const bool select_all = _sick_scan_roi.SelectsAllBeams();
+
+    /* Decode the selected ranges straight into the scan */
+    float * const range_values = sick_scan.GetRangeValues();
+    float * const angle_values = sick_scan.GetAngleValues();
+    float * const time_offsets = sick_scan.GetTimeOffsets();
+    uint32_t * const flag_values = sick_scan.GetFlagValues();
+
+    unsigned int num_beams = 0;
+    for (unsigned int i = 0; i < num_dist_1_vals; i++) {
+
+      const double beam_angle = start_angle_degs + i*step_angle_degs;
+      if (!select_all && !_sick_scan_roi.SelectBeam(i,beam_angle)) {
+	payload_str = _skipNextToken(payload_str);
+	continue;
+      }
+
+      unsigned int range_value = 0;
+      payload_str = _convertNextTokenToUInt(payload_str,range_value);
+      if (range_value < min_range_value || range_value > max_range_value) {
+	range_value = 0;
+      }
+
+      range_values[num_beams] = (float)(range_value*range_scale);
+      angle_values[num_beams] = (float)beam_angle;
+      time_offsets[num_beams] = (float)(i*beam_period);
+      flag_values[num_beams] = (range_value == 0) ? SickScan::SICK_SCAN_FLAG_NO_RETURN : SickScan::SICK_SCAN_FLAG_NONE;
+      num_beams++;
+    }
+
+    sick_scan.Resize(num_beams);
+
+    /*
+     * Process RSSI1 (if streamed)
+     */
+    float * const intensity_values = sick_scan.GetIntensityValues();
+    memset(intensity_values,0,num_beams*sizeof(float));
+
+    const char * substr_rssi_1 = "RSSI1";
+    unsigned int substr_rssi_1_pos = 0;
+    if (_findSubString((char *)payload_buffer,substr_rssi_1,recv_message.GetPayloadLength()+1,5,substr_rssi_1_pos)) {
+
+      /* Extract Num RSSI1 Values */
+      unsigned int num_rssi_1_vals = 0;
+      payload_str = (char *)&payload_buffer[substr_rssi_1_pos+6];
+      for (unsigned int i = 0; i < 4; i++) {
+	payload_str = _convertNextTokenToUInt(payload_str,null_int);
+      }
+
+      payload_str = _convertNextTokenToUInt(payload_str,num_rssi_1_vals);
+
+      /* Decode the RSSI1 values of the selected beams straight into the scan */
+      for (unsigned int i = 0, j = 0; i < num_rssi_1_vals && j < num_beams; i++) {
+
+	if (!select_all && !_sick_scan_roi.SelectBeam(i,start_angle_degs + i*step_angle_degs)) {
+	  payload_str = _skipNextToken(payload_str);
+	  continue;
+	}
+
+	unsigned int reflect_value = 0;
+	payload_str = _convertNextTokenToUInt(payload_str,reflect_value);
+	intensity_values[j++] = (float)reflect_value;
+      }
+
+    }
+
+    /* Success! */
+
+  }
+
+  /**
+   * \brief Acquire single-pulse sick range measurements as Cartesian points
+   * \param x_values A buffer to hold the x coordinates (m)
+   * \param y_values A buffer to hold the y coordinates (m)
+   * \param z_values A buffer to hold the z coordinates, always 0 (NULL => not wanted)
+   * \param num_points The number of points written (one per beam)
+   * \param reflect_vals A buffer to hold the first pulse reflectivity (NULL => not wanted)
+   * \param dev_status The device status (NULL => not wanted)
+   *
+   * NOTE: Points are given in the device frame, in which 90 deg (y-axis) is
+   *       straight ahead. Beams without a return (range 0) are projected onto
+   *       the origin so that point i always corresponds to the i-th selected
+   *       beam. The cos/sin tables are only recomputed when the scan area/
+   *       resolution changes.
+   */
+  void SickLMS1xx::GetSickScanAsPoints( float * const x_values,
+					float * const y_values,
+					float * const z_values,
+					unsigned int & num_points,
+					unsigned int * const reflect_vals,
+					unsigned int * const dev_status ) throw ( SickIOException, SickConfigException, SickTimeoutException ) {
+
+    /* Grab the latest scan */
+    unsigned int range_vals[SICK_LMS_1XX_MAX_NUM_MEASUREMENTS] = {0};
+    GetSickMeasurements(range_vals,NULL,reflect_vals,NULL,num_points,dev_status);
+
+    const double start_angle = _convertSickAngleUnitsToDegs(_sick_scan_config.sick_start_angle);
+    const double step_angle = _convertSickAngleUnitsToDegs(_sick_scan_config.sick_scan_res);
+
+    /* Under an ROI the table spans the full layout and the selected beams index into it */
+    unsigned int num_beams = num_points;
+    unsigned int beam_indices[SICK_LMS_1XX_MAX_NUM_MEASUREMENTS] = {0};
+    if (!_sick_scan_roi.SelectsAllBeams()) {
+      num_beams = (_sick_scan_config.sick_stop_angle - _sick_scan_config.sick_start_angle)/_sick_scan_config.sick_scan_res + 1;
+      if (num_beams > SICK_LMS_1XX_MAX_NUM_MEASUREMENTS) {
+	num_beams = SICK_LMS_1XX_MAX_NUM_MEASUREMENTS;
+      }
+      _sick_scan_roi.SelectBeams(start_angle,step_angle,num_beams,beam_indices);
+    }
+
+    try {
+      _sick_projection_table.Update(start_angle,step_angle,num_beams);
+    }
+
+    catch (std::bad_alloc &) {
+      throw SickIOException("SickLMS1xx::GetSickScanAsPoints: Failed to allocate projection table!");
+    }
+
+    /* Ranges are given in mm */
+    _sick_projection_table.Project(range_vals,num_points,0.001f,x_values,y_values,z_values,
+				   (_sick_scan_roi.SelectsAllBeams() ? NULL : beam_indices));
+
+  }
+
   /**
    * \brief Tear down the connection between the host and the Sick LD
    */
@@ -579,31 +815,31 @@ namespace SickToolbox {
            
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
 
     /* Handle a returned error code */
     catch (SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::Uninitialize: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::Uninitialize: Unknown exception!!!");
       throw;
     }  
 
@@ -767,17 +1003,17 @@ namespace SickToolbox {
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     catch(...) {
-      std::cerr << "SickLMS1xx::_setupConnection - Unknown exception occurred!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_setupConnection - Unknown exception occurred!");
       throw;
     }
 
@@ -805,30 +1041,30 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle a timeout! */
     catch (SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle a timeout! */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     catch (...) {
-      std::cerr << "SickLMS1xx::_reinitialize: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_reinitialize: Unknown exception!!!");
       throw;
     }
     
@@ -883,19 +1119,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -954,19 +1190,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -1170,19 +1406,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -1208,19 +1444,19 @@ namespace SickToolbox {
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_setSickScanConfig: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_setSickScanConfig: Unknown exception!!!");
       throw;
     }
 
@@ -1293,19 +1529,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_setAuthorizedClientAccessMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_setAuthorizedClientAccessMode: Unknown exception!!!");
       throw;
     }
     
@@ -1367,19 +1603,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_writeToEEPROM: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_writeToEEPROM: Unknown exception!!!");
       throw;
     }
     
@@ -1441,19 +1677,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_startMeasuring: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_startMeasuring: Unknown exception!!!");
       throw;
     }
 
@@ -1512,19 +1748,19 @@ namespace SickToolbox {
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_stopMeasuring: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_stopMeasuring: Unknown exception!!!");
       throw;
     }
     
@@ -1562,24 +1798,24 @@ namespace SickToolbox {
     
     /* Handle config exceptions */
     catch (SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     catch (...) {
-      std::cerr << "SickLMS1xx::SetSickScanArea: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::SetSickScanArea: Unknown exception!!!");
       throw;
     }
 
@@ -1633,19 +1869,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_startStreamingMeasurements: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_startStreamingMeasurements: Unknown exception!!!");
       throw;
     }
 
@@ -1704,13 +1940,13 @@ namespace SickToolbox {
         
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_stopStreamingMeasurements: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_stopStreamingMeasurements: Unknown exception!!!");
       throw;
     }
 
@@ -1754,19 +1990,19 @@ namespace SickToolbox {
         
 	/* Handle a timeout! */
 	catch (SickTimeoutException &sick_timeout_exception) {
-	  std::cerr << sick_timeout_exception.what() << std::endl;
+	  SICK_LOG_ERROR(sick_timeout_exception.what());
 	  throw;
 	}
 	
 	/* Handle write buffer exceptions */
 	catch (SickIOException &sick_io_exception) {
-	  std::cerr << sick_io_exception.what() << std::endl;
+	  SICK_LOG_ERROR(sick_io_exception.what());
 	  throw;
 	}
 	
 	/* A safety net */
 	catch (...) {
-	  std::cerr << "SickLMS1xx::_checkForMeasuringStatus: Unknown exception!!!" << std::endl;
+	  SICK_LOG_ERROR("SickLMS1xx::_checkForMeasuringStatus: Unknown exception!!!");
 	  throw;
 	}
 	
@@ -1913,30 +2149,30 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle thread exception */
     catch (SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle Sick error */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
     
     catch (...) {
-      std::cerr << "SickLMS1xx::_setSickScanDataFormat: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_setSickScanDataFormat: Unknown exception!!!");
       throw;
     }
 
@@ -1978,19 +2214,19 @@ namespace SickToolbox {
         
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_restoreMeasuringMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_restoreMeasuringMode: Unknown exception!!!");
       throw;
     }
 
@@ -1999,7 +2235,7 @@ namespace SickToolbox {
     
     /* Check return value */
     if (payload_buffer[8] != '0') {
-      std::cerr << "SickLMS1xx::_restoreMeasuringMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_restoreMeasuringMode: Unknown exception!!!");
       throw;
     }
 
@@ -2046,13 +2282,13 @@ namespace SickToolbox {
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_error) {
-      std::cerr << sick_io_error.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_error.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -2093,13 +2329,13 @@ namespace SickToolbox {
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_error) {
-      std::cerr << sick_io_error.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_error.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
 
@@ -2126,7 +2362,7 @@ namespace SickToolbox {
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS1xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -2290,5 +2526,80 @@ namespace SickToolbox {
     return str_buffer + strlen(token) + 1;
     
   }
+
+  /**
+   * \brief Utility function for skipping the next token of a tokenized string
+   * \param str_buffer The string
+   * \param delimeter The token delimeter (Default: " ")
+   * \return The string following the token
+   */
+  char * SickLMS1xx::_skipNextToken( char * const str_buffer, const char * const delimeter ) const {
+
+    char * token_end = str_buffer + strspn(str_buffer,delimeter);
+    token_end += strcspn(token_end,delimeter);
+
+    return (*token_end != '\0') ? token_end + 1 : token_end;
+
+  }
+
+  /**
+   * \brief Extracts the values of a scan data channel (DIST1, RSSI1, ...) through the scan ROI
+   * \param str_buffer The channel contents following its name (scale factor, offset, start angle, step, count, values)
+   * \param values A buffer to hold the extracted values
+   * \param num_values The number of values extracted
+   * \param range_channel Whether the channel holds ranges (for applying the range limits)
+   * \return The string following the channel's values
+   *
+   * NOTE: Values of beams the ROI does not select are skipped without being
+   *       converted and the returned values are compacted.
+   */
+  char * SickLMS1xx::_extractSickChannelValues( char * const str_buffer, unsigned int * const values, unsigned int & num_values,
+						const bool range_channel ) const {
+
+    /* Extract the channel header */
+    unsigned int scale_factor_bits = 0, null_int = 0, start_angle = 0, step_angle = 0, num_channel_vals = 0;
+    char * payload_str = _convertNextTokenToUInt(str_buffer,scale_factor_bits);
+    payload_str = _convertNextTokenToUInt(payload_str,null_int);
+    payload_str = _convertNextTokenToUInt(payload_str,start_angle);
+    payload_str = _convertNextTokenToUInt(payload_str,step_angle);
+    payload_str = _convertNextTokenToUInt(payload_str,num_channel_vals);
+
+    if (num_channel_vals > SICK_LMS_1XX_MAX_NUM_MEASUREMENTS) {
+      throw SickIOException("SickLMS1xx::_extractSickChannelValues: Too many channel values!");
+    }
+
+    /* Acquire the range limits (in device units) */
+    unsigned int min_value = 0, max_value = UINT_MAX;
+    if (range_channel && _sick_scan_roi.IsRangeLimited()) {
+      float scale_factor = 0;
+      const uint32_t scale_factor_word = scale_factor_bits;
+      memcpy(&scale_factor,&scale_factor_word,sizeof(float));
+      _sick_scan_roi.GetRawRangeLimits(((scale_factor > 0) ? scale_factor : 1.0f)*0.001,min_value,max_value);
+    }
+
+    const bool select_all = _sick_scan_roi.SelectsAllBeams();
+    const double start_angle_degs = _convertSickAngleUnitsToDegs((int32_t)start_angle);
+    const double step_angle_degs = _convertSickAngleUnitsToDegs(step_angle);
+
+    /* Grab the selected values */
+    num_values = 0;
+    for (unsigned int i = 0; i < num_channel_vals; i++) {
+
+      if (!select_all && !_sick_scan_roi.SelectBeam(i,start_angle_degs + i*step_angle_degs)) {
+	payload_str = _skipNextToken(payload_str);
+	continue;
+      }
+
+      payload_str = _convertNextTokenToUInt(payload_str,values[num_values]);
+      if (values[num_values] < min_value || values[num_values] > max_value) {
+	values[num_values] = 0;
+      }
+
+      num_values++;
+    }
+
+    return payload_str;
+
+  }
   
 } //namespace SickToolbox
@@ -44,53 +44,52 @@ namespace SickToolbox {
     uint8_t byte_buffer = 0;
     uint8_t payload_buffer[SickLMS1xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
     
-    try {
+    /* Flush the TCP receive buffer */
+    _flushTCPRecvBuffer();
 
-      /* Flush the TCP receive buffer */
-      _flushTCPRecvBuffer();
-
-      /* Search for STX in the byte stream */
-      do {
-	
- 	/* Grab the next byte from the stream */
- 	_readBytes(&byte_buffer,1,DEFAULT_SICK_LMS_1XX_BYTE_TIMEOUT);
+    /* Search for STX in the byte stream */
+    unsigned int bytes_searched = 0;
+    do {
 	
+      /* Grab the next byte from the stream (a timeout is ok!) */
+      if (_readTimedOut(_tryReadBytes(&byte_buffer,1,DEFAULT_SICK_LMS_1XX_BYTE_TIMEOUT))) {
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched);
+	return;
       }
-      while (byte_buffer != 0x02);
-      
-      /* Ok, now acquire the payload! (until ETX) */
-      int payload_length = 0;
-      do {
+      bytes_searched++;
 	
-	payload_length++;
- 	_readBytes(&payload_buffer[payload_length-1],1,DEFAULT_SICK_LMS_1XX_BYTE_TIMEOUT);
+    }
+    while (byte_buffer != 0x02);
+
+    /* Anything ahead of STX was skipped */
+    _sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched - 1);
+      
+    /* Ok, now acquire the payload! (until ETX) */
+    int payload_length = 0;
+    do {
+
+      /* Disregard an overlong frame (resync on the next pass) */
+      if (payload_length == (int)SickLMS1xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH) {
+	return;
+      }
 	
+      payload_length++;
+      if (_readTimedOut(_tryReadBytes(&payload_buffer[payload_length-1],1,DEFAULT_SICK_LMS_1XX_BYTE_TIMEOUT))) {
+	return;
       }
-      while (payload_buffer[payload_length-1] != 0x03);
-      payload_length--;
+	
+    }
+    while (payload_buffer[payload_length-1] != 0x03);
+    payload_length--;
       
-      /* Build the return message object based upon the received payload
-       * NOTE: In constructing this message we ignore the header bytes
-       *       buffered since the BuildMessage routine will insert the
-       *       correct header automatically and verify the message size
-       */
-      sick_message.BuildMessage(payload_buffer,payload_length);
+    /* Build the return message object based upon the received payload
+     * NOTE: In constructing this message we ignore the header bytes
+     *       buffered since the BuildMessage routine will insert the
+     *       correct header automatically and verify the message size
+     */
+    sick_message.BuildMessage(payload_buffer,payload_length);
 
-      /* Success */
-      
-    }
-    
-    catch(SickTimeoutException &sick_timeout) { /* This is ok! */ }
-    
-    /* Catch any serious IO buffer exceptions */
-    catch(SickIOException &sick_io_exception) {
-      throw;
-    }
-    
-    /* A sanity check */
-    catch (...) {
-      throw;
-    }
+    /* Success */
     
   }
 
@@ -18,9 +18,16 @@
 
 /* Implementation dependencies */
 #include <sstream>
+#include <fstream>
 #include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <signal.h>
 
 #include <sicktoolbox/SickLMS2xx.hh>
@@ -28,6 +35,8 @@
 #include <sicktoolbox/SickLMS2xxBufferMonitor.hh>
 #include <sicktoolbox/SickLMS2xxUtility.hh>
 #include <sicktoolbox/SickException.hh>
+#include <sicktoolbox/SickLogger.hh>
+#include <sicktoolbox/SickTrace.hh>
 
 #ifdef HAVE_LINUX_SERIAL_H
 #include <linux/serial.h>
@@ -49,7 +58,11 @@ namespace SickToolbox {
 								_sick_type(SICK_LMS_TYPE_UNKNOWN),
 								_sick_mean_value_sample_size(0),
 								_sick_values_subrange_start_index(0),
-								_sick_values_subrange_stop_index(0)
+								_sick_values_subrange_stop_index(0),
+								_sick_scan_batch_messages(NULL),
+								_sick_scan_batch_times(NULL),
+								_sick_scan_batch_size(0),
+								_sick_stream_session(NULL)
   {
     
     /* Initialize the protected/private structs */
@@ -79,13 +92,17 @@ namespace SickToolbox {
 
     /* Catch an I/O exception */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::~SickLMS2xx: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::~SickLMS2xx: Unknown exception!");
     }
+
+    /* Release the batch scratch buffers */
+    delete [] _sick_scan_batch_messages;
+    delete [] _sick_scan_batch_times;
     
   }
   
@@ -100,6 +117,10 @@ namespace SickToolbox {
 
     /* Buffer the desired baud rate in case we have to reset */
     _desired_session_baud = desired_baud_rate;
+
+    /* Consult the init cache (if enabled) */
+    sick_lms_2xx_baud_t cached_baud = SICK_BAUD_UNKNOWN;
+    bool sick_init_cached = _readSickInitCache(cached_baud);
     
     try {
     
@@ -124,8 +145,19 @@ namespace SickToolbox {
 
       try {
 
-	std::cout << "\tAttempting to set requested baud rate..." << std::endl;
-	_setSessionBaud(_desired_session_baud);
+	/* Try the baud the device was last left at first */
+	bool sick_baud_verified = false;
+	if (sick_init_cached && cached_baud != _curr_session_baud) {
+	  std::cout << "\tAttempting cached baud rate..." << std::endl;
+	  if (!(sick_baud_verified = _testSickBaud(cached_baud))) {
+	    _setTerminalBaud(_baudToSickBaud(DEFAULT_SICK_LMS_2XX_SICK_BAUD));
+	  }
+	}
+
+	if (!sick_baud_verified || _curr_session_baud != _desired_session_baud) {
+	  std::cout << "\tAttempting to set requested baud rate..." << std::endl;
+	  _setSessionBaud(_desired_session_baud);
+	}
 	
       }
 
@@ -160,7 +192,7 @@ namespace SickToolbox {
 
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::Initialize: Unknown exception!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::Initialize: Unknown exception!");
 	throw;
       }
 
@@ -178,36 +210,39 @@ namespace SickToolbox {
 
       /* Set the flag */
       _sick_initialized = true;
+
+      /* Remember what we found */
+      _writeSickInitCache();
       
     }
 
     /* Handle a config exception */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::Initialize: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::Initialize: Unknown exception!");
       throw;
     }
 
@@ -232,6 +267,9 @@ namespace SickToolbox {
 
       std::cout << std::endl << "\t*** Attempting to uninitialize the Sick LMS..." << std::endl;       
 
+      /* Release any pinned stream session */
+      _sick_stream_session = NULL;
+
       try {
 	
 	/* Restore original operating mode */
@@ -240,6 +278,9 @@ namespace SickToolbox {
 	/* Restore original baud rate settings */
 	_setSessionBaud(_baudToSickBaud(DEFAULT_SICK_LMS_2XX_SICK_BAUD));
 
+	/* The device is back at the default baud */
+	_writeSickInitCache();
+
 	/* Attempt to cancel the buffer monitor */
 	if (_sick_monitor_running) {
 	  std::cout << "\tAttempting to stop buffer monitor..." << std::endl;
@@ -253,31 +294,31 @@ namespace SickToolbox {
     
       /* Handle any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << " (attempting to kill connection anyways)" << std::endl;
+	SICK_LOG_WARN(sick_config_exception.what() << " (attempting to kill connection anyways)");
 	throw;
       }
       
       /* Handle a timeout exception */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << " (attempting to kill connection anyways)" << std::endl;
+	SICK_LOG_WARN(sick_timeout_exception.what() << " (attempting to kill connection anyways)");
 	throw;
       }
       
       /* Handle any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << " (attempting to kill connection anyways)" << std::endl;
+	SICK_LOG_WARN(sick_io_exception.what() << " (attempting to kill connection anyways)");
 	throw;
       }
       
       /* Handle any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << " (attempting to kill connection anyways)" << std::endl;
+	SICK_LOG_WARN(sick_thread_exception.what() << " (attempting to kill connection anyways)");
 	throw;
       }
       
       /* Handle anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::Unintialize: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::Unintialize: Unknown exception!!!");
 	throw;
       }
 
@@ -288,6 +329,22 @@ namespace SickToolbox {
       
   }
 
+  /**
+   * \brief Enables a persistent cache of the baud rate each device was left at.
+   *        On the next Initialize the cached baud is tried first, skipping the
+   *        default-baud handshake and the baud switch. A miss falls back to
+   *        the full probe.
+   * \param sick_init_cache_path Path of the cache file (shared by all devices, keyed by device path)
+   *
+   * NOTE: Must be called before Initialize. An empty path disables the cache.
+   *
+   * NOTE: The type and config are always queried, since the protocol offers no
+   *       way to tell a swapped or reconfigured unit from the cached one.
+   */
+  void SickLMS2xx::SetSickInitCache( const std::string sick_init_cache_path ) {
+    _sick_init_cache_path = sick_init_cache_path;
+  }
+
   /**
    * \brief Gets the Sick LMS 2xx device path
    * \return The device path as a std::string
@@ -382,37 +439,37 @@ namespace SickToolbox {
 	
       /* Handle any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-      	std::cerr << sick_config_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_config_exception.what());
       	throw;
       }
       
       /* Handle a timeout exception */
       catch(SickTimeoutException &sick_timeout_exception) {
-      	std::cerr << sick_timeout_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_timeout_exception.what());
       	throw;
       }
       
       /* Handle any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-      	std::cerr << sick_io_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_io_exception.what());
       	throw;
       }
       
       /* Handle any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-      	std::cerr << sick_thread_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Handle anything else */
       catch(...) {
-      	std::cerr << "SickLMS2xx::SetSickMeasuringUnits: Unknown exception!!!" << std::endl;
+      	SICK_LOG_ERROR("SickLMS2xx::SetSickMeasuringUnits: Unknown exception!!!");
       	throw;
       }
 
     }
     else {
-      std::cerr << "\tSickLMS2xx::SetSickMeasuringUnits - Device is already configured w/ these units. (skipping write)" << std::endl;
+      SICK_LOG_WARN("\tSickLMS2xx::SetSickMeasuringUnits - Device is already configured w/ these units. (skipping write)");
     }
       
   }
@@ -476,37 +533,37 @@ namespace SickToolbox {
 	
       /* Handle any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-      	std::cerr << sick_config_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_config_exception.what());
       	throw;
       }
       
       /* Handle a timeout exception */
       catch(SickTimeoutException &sick_timeout_exception) {
-      	std::cerr << sick_timeout_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_timeout_exception.what());
       	throw;
       }
       
       /* Handle any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-      	std::cerr << sick_io_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_io_exception.what());
       	throw;
       }
       
       /* Handle any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-      	std::cerr << sick_thread_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Handle anything else */
       catch(...) {
-      	std::cerr << "SickLMS2xx::SetSickSensitivity: Unknown exception!!!" << std::endl;
+      	SICK_LOG_ERROR("SickLMS2xx::SetSickSensitivity: Unknown exception!!!");
       	throw;
       }
 
     }
     else {
-      std::cerr << "\tSickLMS2xx::SetSickSensitivity - Sick is already operating at this sensitivity level! (skipping write)" << std::endl;
+      SICK_LOG_WARN("\tSickLMS2xx::SetSickSensitivity - Sick is already operating at this sensitivity level! (skipping write)");
     }
       
   }
@@ -554,37 +611,37 @@ namespace SickToolbox {
 	
       /* Handle any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-      	std::cerr << sick_config_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_config_exception.what());
       	throw;
       }
       
       /* Handle a timeout exception */
       catch(SickTimeoutException &sick_timeout_exception) {
-      	std::cerr << sick_timeout_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_timeout_exception.what());
       	throw;
       }
       
       /* Handle any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-      	std::cerr << sick_io_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_io_exception.what());
       	throw;
       }
       
       /* Handle any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-      	std::cerr << sick_thread_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Handle anything else */
       catch(...) {
-      	std::cerr << "SickLMS2xx::SetSickPeakThreshold: Unknown exception!!!" << std::endl;
+      	SICK_LOG_ERROR("SickLMS2xx::SetSickPeakThreshold: Unknown exception!!!");
       	throw;
       }
 
     }
     else {
-      std::cerr << "\tSickLMS2xx::SetSickPeakThreshold - Sick is already operating w/ given threshold! (skipping write)" << std::endl;
+      SICK_LOG_WARN("\tSickLMS2xx::SetSickPeakThreshold - Sick is already operating w/ given threshold! (skipping write)");
     }
     
   }
@@ -602,7 +659,7 @@ namespace SickToolbox {
     
     /* Make sure sensitivity is something that is defined for this model */
     if(!_isSickLMS211() && !_isSickLMS221() && !_isSickLMS291()) {
-      std::cerr << "Sensitivity is undefined for model: " << SickTypeToString(GetSickType()) << " (returning \"Unknown\")" << std::endl;
+      SICK_LOG_WARN("Sensitivity is undefined for model: " << SickTypeToString(GetSickType()) << " (returning \"Unknown\")");
       return SICK_SENSITIVITY_UNKNOWN;
     }
 
@@ -624,7 +681,7 @@ namespace SickToolbox {
     
     /* Make sure sensitivity is something that is defined for this model */
     if(!_isSickLMS200() && !_isSickLMS220()) {
-      std::cerr << "Peak threshold is undefined for model: " << SickTypeToString(GetSickType()) << " (returning \"Unknown\")" << std::endl;
+      SICK_LOG_WARN("Peak threshold is undefined for model: " << SickTypeToString(GetSickType()) << " (returning \"Unknown\")");
       return SICK_PEAK_THRESHOLD_UNKNOWN;
     }
 
@@ -671,37 +728,37 @@ namespace SickToolbox {
 	
       /* Handle any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-      	std::cerr << sick_config_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_config_exception.what());
       	throw;
       }
       
       /* Handle a timeout exception */
       catch(SickTimeoutException &sick_timeout_exception) {
-      	std::cerr << sick_timeout_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_timeout_exception.what());
       	throw;
       }
       
       /* Handle any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-      	std::cerr << sick_io_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_io_exception.what());
       	throw;
       }
       
       /* Handle any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-      	std::cerr << sick_thread_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Handle anything else */
       catch(...) {
-      	std::cerr << "SickLMS2xx::SetSickMeasuringMode: Unknown exception!!!" << std::endl;
+      	SICK_LOG_ERROR("SickLMS2xx::SetSickMeasuringMode: Unknown exception!!!");
       	throw;
       }
 
     }
     else {
-      std::cerr << "\tSickLMS2xx::SetSickMeasuringMode - Sick is already operating w/ this measuring mode! (skipping write)" << std::endl;
+      SICK_LOG_WARN("\tSickLMS2xx::SetSickMeasuringMode - Sick is already operating w/ this measuring mode! (skipping write)");
     }
       
   }
@@ -779,37 +836,37 @@ namespace SickToolbox {
 	
       /* Handle any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-      	std::cerr << sick_config_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_config_exception.what());
       	throw;
       }
       
       /* Handle a timeout exception */
       catch(SickTimeoutException &sick_timeout_exception) {
-      	std::cerr << sick_timeout_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_timeout_exception.what());
       	throw;
       }
       
       /* Handle any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-      	std::cerr << sick_io_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_io_exception.what());
       	throw;
       }
       
       /* Handle any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-      	std::cerr << sick_thread_exception.what() << std::endl;
+      	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Handle anything else */
       catch(...) {
-      	std::cerr << "SickLMS2xx::SetSickAvailabilityFlags: Unknown exception!!!" << std::endl;
+      	SICK_LOG_ERROR("SickLMS2xx::SetSickAvailabilityFlags: Unknown exception!!!");
       	throw;
       }
 
     }
     else {
-      std::cerr << "\tSickLMS2xx::SetSickAvailability - Device is already operating w/ given availability. (skipping write)" << std::endl;
+      SICK_LOG_WARN("\tSickLMS2xx::SetSickAvailability - Device is already operating w/ given availability. (skipping write)");
     }
     
   }
@@ -910,31 +967,31 @@ namespace SickToolbox {
 
     /* Handle a config exception */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::SetSickVariant: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::SetSickVariant: Unknown exception!!!");
       throw;
     }
     
@@ -1057,34 +1114,433 @@ namespace SickToolbox {
 
     /* Handle any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetSickScan: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetSickScan: Unknown exception!!!");
+      throw;
+    }
+
+  }
+
+  /**
+   * \brief Gets a range scan from the Sick LMS as a SickScan
+   * \param &sick_scan The destination scan
+   *
+   * NOTE: The profile is decoded straight into the scan: ranges in meters,
+   *       angles in the device frame (90 deg straight ahead), field A/B/C bits
+   *       as flags and per-beam time offsets derived from the mirror frequency.
+   *       Intensities are 0 since the B0 profile carries none. The header's
+   *       scan index is the telegram index (modulo 256). Beams dropped by the
+   *       scan ROI are left out.
+   */
+  void SickLMS2xx::GetSickScan( SickScan &sick_scan ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException) {
+
+    /* Ensure the device is initialized */
+    if (!_sick_initialized) {
+      throw SickConfigException("SickLMS2xx::GetSickScan: Sick LMS is not initialized!");
+    }
+
+    /* Reflectivity values are not ranges */
+    if (_sick_operating_status.sick_measuring_mode == SICK_MS_MODE_REFLECTIVITY) {
+      throw SickConfigException("SickLMS2xx::GetSickScan: Sick LMS is returning reflectivity values!");
+    }
+
+    /* Declare message objects */
+    SickLMS2xxMessage response;
+
+    /* Declare some useful variables and a buffer */
+    uint8_t payload_buffer[SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
+
+    /* Define a local scan profile object */
+    sick_lms_2xx_scan_profile_b0_t sick_scan_profile;
+
+    try {
+
+      /* Restore original operating mode */
+      _setSickOpModeMonitorStreamValues();
+
+      /* Receive a data frame from the stream. */
+      _recvMessage(response,DEFAULT_SICK_LMS_2XX_SICK_MESSAGE_TIMEOUT);
+
+      /* Check that our payload has the proper command byte of 0xB0 */
+      if(response.GetCommandCode() != 0xB0) {
+	throw SickIOException("SickLMS2xx::GetSickScan: Unexpected message!");
+      }
+
+      /* Acquire the payload buffer and length*/
+      response.GetPayload(payload_buffer);
+
+      /* Initialize the profile */
+      memset(&sick_scan_profile,0,sizeof(sick_lms_2xx_scan_profile_b0_t));
+
+      /* Parse the message payload */
+      _parseSickScanProfileB0(&payload_buffer[1],sick_scan_profile);
+
+      /* Make room for the beams */
+      sick_scan.Resize(sick_scan_profile.sick_num_measurements);
+
+    }
+
+    /* Handle any config exceptions */
+    catch(SickConfigException &sick_config_exception) {
+      SICK_LOG_ERROR(sick_config_exception.what());
+      throw;
+    }
+
+    /* Handle a timeout exception */
+    catch(SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      throw;
+    }
+
+    /* Handle any I/O exceptions */
+    catch(SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      throw;
+    }
+
+    /* Handle any thread exceptions */
+    catch(SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      throw;
+    }
+
+    /* Handle a failed allocation */
+    catch(std::bad_alloc &) {
+      throw SickIOException("SickLMS2xx::GetSickScan: Failed to allocate scan storage!");
+    }
+
+    /* Handle anything else */
+    catch(...) {
+      SICK_LOG_ERROR("SickLMS2xx::GetSickScan: Unknown exception!!!");
       throw;
     }
 
+    const unsigned int num_beams = sick_scan_profile.sick_num_measurements;
+    const float range_scale = (_sick_device_config.sick_measuring_units == SICK_MEASURING_UNITS_CM) ? 0.01f : 0.001f;
+
+    /* Copy the ranges and field bits */
+    float * const range_values = sick_scan.GetRangeValues();
+    float * const intensity_values = sick_scan.GetIntensityValues();
+    uint32_t * const flag_values = sick_scan.GetFlagValues();
+    for (unsigned int i = 0; i < num_beams; i++) {
+
+      range_values[i] = sick_scan_profile.sick_measurements[i]*range_scale;
+      intensity_values[i] = 0;
+
+      uint32_t flags = (sick_scan_profile.sick_measurements[i] == 0) ? SickScan::SICK_SCAN_FLAG_NO_RETURN : SickScan::SICK_SCAN_FLAG_NONE;
+      if (sick_scan_profile.sick_field_a_values[i]) {
+	flags |= SickScan::SICK_SCAN_FLAG_FIELD_A;
+      }
+      if (sick_scan_profile.sick_field_b_values[i]) {
+	flags |= SickScan::SICK_SCAN_FLAG_FIELD_B;
+      }
+      if (sick_scan_profile.sick_field_c_values[i]) {
+	flags |= SickScan::SICK_SCAN_FLAG_FIELD_C;
+      }
+      flag_values[i] = flags;
+
+    }
+
+    /* Acquire the angular layout of the scan as sent (the mirror turns at a fixed rate) */
+    const unsigned int num_sent_beams = payload_buffer[1] + 256*(payload_buffer[2] & 0x03);
+    double start_angle = 0, step_angle = 0;
+    _getSickBeamLayout(num_sent_beams,sick_scan_profile.sick_partial_scan_index,start_angle,step_angle);
+
+    const double scan_period = 1e6/SICK_MIRROR_FREQUENCY;
+    const double beam_period = scan_period*step_angle/360.0;
+
+    if (_sick_scan_roi.SelectsAllBeams()) {
+      sick_scan.FillAngles(0,num_beams,start_angle,step_angle);
+      sick_scan.FillTimeOffsets(0,num_beams,0,beam_period);
+    }
+    else {
+
+      /* Recover the beams the ROI kept while parsing */
+      unsigned int beam_indices[SICK_MAX_NUM_MEASUREMENTS] = {0};
+      _sick_scan_roi.SelectBeams(start_angle,step_angle,num_sent_beams,beam_indices);
+
+      float * const angle_values = sick_scan.GetAngleValues();
+      float * const time_offsets = sick_scan.GetTimeOffsets();
+      for (unsigned int i = 0; i < num_beams; i++) {
+	angle_values[i] = (float)(start_angle + beam_indices[i]*step_angle);
+	time_offsets[i] = (float)(beam_indices[i]*beam_period);
+      }
+
+    }
+
+    /* Fill in the header */
+    SickScan::sick_scan_header_t &sick_scan_header = sick_scan.GetHeader();
+    sick_scan_header.sick_scan_index = sick_scan_profile.sick_telegram_index;
+    sick_scan_header.sick_device_timestamp = 0;
+    sick_scan_header.sick_scan_period = (float)scan_period;
+    gettimeofday(&sick_scan_header.sick_host_time,NULL);
+    sick_scan_header.sick_device_host_time = 0;
+
+  }
+
+  /**
+   * \brief Gets a range scan from the Sick LMS as Cartesian points
+   * \param *x_values Destination x buffer (m)
+   * \param *y_values Destination y buffer (m)
+   * \param *z_values Destination z buffer, always 0 (Default: NULL => Not wanted)
+   * \param &num_points The number of points written (one per beam)
+   * \param *sick_telegram_index The telegram index assigned to the message (modulo: 256) (Default: NULL => Not wanted)
+   * \param *sick_real_time_scan_index The real time scan index for the latest message (module 256) (Default: NULL => Not wanted)
+   *
+   * NOTE: Points are given in the device frame, where beam angles run from 0 deg
+   *       (x-axis, right) to 180 deg with 90 deg (y-axis) straight ahead. Beams
+   *       without a return (range 0) are projected onto the origin so that point
+   *       i always corresponds to beam i (of the beams selected by the scan ROI).
+   *
+   * NOTE: The cos/sin tables are cached and only recomputed when the scan
+   *       angle/resolution (or the number of beams) changes.
+   */
+  void SickLMS2xx::GetSickScanAsPoints( float * const x_values,
+				     float * const y_values,
+				     float * const z_values,
+				     unsigned int & num_points,
+				     unsigned int * const sick_telegram_index,
+				     unsigned int * const sick_real_time_scan_index ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException) {
+
+    /* Ensure the device is initialized */
+    if (!_sick_initialized) {
+      throw SickConfigException("SickLMS2xx::GetSickScanAsPoints: Sick LMS is not initialized!");
+    }
+
+    /* Reflectivity values cannot be projected */
+    if (_sick_operating_status.sick_measuring_mode == SICK_MS_MODE_REFLECTIVITY) {
+      throw SickConfigException("SickLMS2xx::GetSickScanAsPoints: Sick LMS is returning reflectivity values!");
+    }
+
+    /* Grab the latest scan */
+    unsigned int range_values[SICK_MAX_NUM_MEASUREMENTS] = {0};
+    GetSickScan(range_values,num_points,NULL,NULL,NULL,sick_telegram_index,sick_real_time_scan_index);
+
+    /* The scan is centered on 90 deg */
+    double start_angle = 0, scan_resolution = 0;
+    _getSickBeamLayout(0,0,start_angle,scan_resolution);
+
+    /* The ROI may have dropped beams, in which case the table spans the full scan */
+    unsigned int num_beams = num_points;
+    unsigned int beam_indices[SICK_MAX_NUM_MEASUREMENTS] = {0};
+    if (!_sick_scan_roi.SelectsAllBeams() && scan_resolution > 0) {
+      num_beams = (unsigned int)(_sick_operating_status.sick_scan_angle/scan_resolution + 0.5) + 1;
+      num_beams = (num_beams < SICK_MAX_NUM_MEASUREMENTS) ? num_beams : SICK_MAX_NUM_MEASUREMENTS;
+      _sick_scan_roi.SelectBeams(start_angle,scan_resolution,num_beams,beam_indices);
+    }
+
+    try {
+      _sick_projection_table.Update(start_angle,scan_resolution,num_beams);
+    }
+
+    catch(std::bad_alloc &) {
+      throw SickIOException("SickLMS2xx::GetSickScanAsPoints: Failed to allocate projection table!");
+    }
+
+    /* Scale the device units to meters */
+    const float range_scale = (_sick_device_config.sick_measuring_units == SICK_MEASURING_UNITS_CM) ? 0.01f : 0.001f;
+    _sick_projection_table.Project(range_values,num_points,range_scale,x_values,y_values,z_values,
+				   (num_beams != num_points) ? beam_indices : NULL);
+
+  }
+
+  /**
+   * \brief Drains the scans buffered by the monitor since the last call
+   * \param max_num_scans The maximum number of scans to return
+   * \param *measurement_values Destination block of max_num_scans x measurement_stride values (scan i starts at i*measurement_stride)
+   * \param measurement_stride Distance (in values) between consecutive scans in measurement_values (at least the
+   *                           number of measurements in a full scan, i.e. scan angle/resolution + 1)
+   * \param *num_measurement_values Number of values stored for each scan (max_num_scans long)
+   * \param *sick_telegram_indices The telegram index of each scan (modulo: 256) (Default: NULL => Not wanted)
+   * \param *sick_real_time_scan_indices The real time scan index of each scan (modulo: 256) (Default: NULL => Not wanted)
+   * \param *sick_recv_times The host time at which each scan was received (Default: NULL => Not wanted)
+   * \return The number of scans written (at least one)
+   *
+   * NOTE: Scans are returned oldest first. The monitor buffers up to
+   *       max(max_num_scans,DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH) messages,
+   *       so this should be called often enough to avoid dropping scans.
+   *
+   * NOTE: As with GetSickScan, either range or reflectivity measurements are
+   *       returned depending upon the current measuring mode of the device.
+   */
+  unsigned int SickLMS2xx::GetSickScans( const unsigned int max_num_scans,
+					 unsigned int * const measurement_values,
+					 const unsigned int measurement_stride,
+					 unsigned int * const num_measurement_values,
+					 unsigned int * const sick_telegram_indices,
+					 unsigned int * const sick_real_time_scan_indices,
+					 struct timeval * const sick_recv_times ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException) {
+
+    /* Ensure the device is initialized */
+    if (!_sick_initialized) {
+      throw SickConfigException("SickLMS2xx::GetSickScans: Sick LMS is not initialized!");
+    }
+
+    /* Nothing to do */
+    if (max_num_scans == 0) {
+      return 0;
+    }
+
+    /* Check the stride up front, as drained scans could not be handed back once the batch is under way */
+    if (_sick_operating_status.sick_scan_resolution == 0 ||
+	measurement_stride < (unsigned int)((_sick_operating_status.sick_scan_angle*100)/_sick_operating_status.sick_scan_resolution + 1)) {
+      throw SickConfigException("SickLMS2xx::GetSickScans: measurement_stride is smaller than a full scan!");
+    }
+
+    /* Number of scans returned */
+    unsigned int num_scans = 0;
+    
+    try {
+
+      /* Restore original operating mode */
+      _setSickOpModeMonitorStreamValues();
+
+      /* Make sure the scratch buffers are large enough */
+      if (_sick_scan_batch_size < max_num_scans) {
+
+	delete [] _sick_scan_batch_messages;
+	delete [] _sick_scan_batch_times;
+	
+	_sick_scan_batch_messages = new SickLMS2xxMessage[max_num_scans];
+	_sick_scan_batch_times = new struct timeval[max_num_scans];
+	_sick_scan_batch_size = max_num_scans;
+	
+      }
+
+      /* Make sure the monitor is buffering enough messages (growing keeps what is queued) */
+      const unsigned int queue_depth = (max_num_scans > DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH) ? max_num_scans : DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH;
+      if (_sick_buffer_monitor->GetMessageQueueDepth() < queue_depth) {
+	_sick_buffer_monitor->SetMessageQueueDepth(queue_depth);
+      }
+      
+      /* Define a local scan profile object */
+      sick_lms_2xx_scan_profile_b0_t sick_scan_profile;
+
+      /* Declare a buffer */
+      uint8_t payload_buffer[SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
+      
+      /* The timeout covers the whole call, not each batch */
+      struct timeval beg_time, end_time;
+      gettimeofday(&beg_time,NULL);
+
+      /* Keep draining until at least one scan has been acquired */
+      while (num_scans == 0) {
+
+	/* Wait on the monitor for whatever time is left */
+	gettimeofday(&end_time,NULL);
+	const double elapsed_time = _computeElapsedTime(beg_time,end_time);
+	if (elapsed_time >= DEFAULT_SICK_LMS_2XX_SICK_MESSAGE_TIMEOUT) {
+	  throw SickTimeoutException("SickLMS2xx::GetSickScans: No scan was received in time!");
+	}
+      
+	/* Acquire the buffered messages */
+	unsigned int num_messages = _recvMessages(_sick_scan_batch_messages,_sick_scan_batch_times,max_num_scans,
+						  (unsigned int)(DEFAULT_SICK_LMS_2XX_SICK_MESSAGE_TIMEOUT - elapsed_time));
+	
+	for (unsigned int j = 0; j < num_messages; j++) {
+
+	  /* Skip anything that isn't a scan (e.g. stale replies) */
+	  if (_sick_scan_batch_messages[j].GetCommandCode() != 0xB0) {
+	    continue;
+	  }
+
+	  /* Acquire the payload buffer */
+	  _sick_scan_batch_messages[j].GetPayload(payload_buffer);
+
+	  /* Parse the message payload */
+	  memset(&sick_scan_profile,0,sizeof(sick_lms_2xx_scan_profile_b0_t));
+	  _parseSickScanProfileB0(&payload_buffer[1],sick_scan_profile);
+
+	  /* Make sure the scan fits in its slot */
+	  if (sick_scan_profile.sick_num_measurements > measurement_stride) {
+	    throw SickConfigException("SickLMS2xx::GetSickScans: measurement_stride is smaller than the scan!");
+	  }
+
+	  /* Copy the measurement values */
+	  unsigned int * const scan_values = &measurement_values[num_scans*measurement_stride];
+	  for (unsigned int i = 0; i < sick_scan_profile.sick_num_measurements; i++) {
+	    scan_values[i] = sick_scan_profile.sick_measurements[i];
+	  }
+
+	  /* Populate the per scan metadata */
+	  num_measurement_values[num_scans] = sick_scan_profile.sick_num_measurements;
+
+	  if (sick_telegram_indices) {
+	    sick_telegram_indices[num_scans] = sick_scan_profile.sick_telegram_index;
+	  }
+
+	  if (sick_real_time_scan_indices) {
+	    sick_real_time_scan_indices[num_scans] = sick_scan_profile.sick_real_time_scan_index;
+	  }
+
+	  if (sick_recv_times) {
+	    sick_recv_times[num_scans] = _sick_scan_batch_times[j];
+	  }
+
+	  num_scans++;
+	  
+	}
+
+      }
+
+    }
+
+    /* Handle any config exceptions */
+    catch(SickConfigException &sick_config_exception) {
+      SICK_LOG_ERROR(sick_config_exception.what());
+      throw;
+    }
+    
+    /* Handle a timeout exception */
+    catch(SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      throw;
+    }
+    
+    /* Handle any I/O exceptions */
+    catch(SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      throw;
+    }
+
+    /* Handle any thread exceptions */
+    catch(SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      throw;
+    }
+    
+    /* Handle anything else */
+    catch(...) {
+      SICK_LOG_ERROR("SickLMS2xx::GetSickScans: Unknown exception!!!");
+      throw;
+    }
+
+    /* Success */
+    return num_scans;
+    
   }
 
   /**
@@ -1195,31 +1651,31 @@ namespace SickToolbox {
 
     /* Handle any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetSickScan: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetSickScan: Unknown exception!!!");
       throw;
     }
 
@@ -1332,31 +1788,31 @@ namespace SickToolbox {
 
     /* Handle any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetSickScanSubrange: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetSickScanSubrange: Unknown exception!!!");
       throw;
     }
 
@@ -1472,31 +1928,31 @@ namespace SickToolbox {
 
     /* Handle any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetSickPartialScan: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetSickPartialScan: Unknown exception!!!");
       throw;
     }
 
@@ -1580,31 +2036,31 @@ namespace SickToolbox {
 
     /* Handle any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetSickMeanValues: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetSickMeanValues: Unknown exception!!!");
       throw;
     }
 
@@ -1698,31 +2154,31 @@ namespace SickToolbox {
 
     /* Handle any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
     
     /* Handle a timeout exception */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetMeanValuesSubrange: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetMeanValuesSubrange: Unknown exception!!!");
       throw;
     }
 
@@ -1751,25 +2207,25 @@ namespace SickToolbox {
 
     /* Catch any timeout exceptions */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
       
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::GetSickStatus: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::GetSickStatus: Unknown exception!");
       throw;
     }
 
@@ -1830,7 +2286,7 @@ namespace SickToolbox {
       
       /* Verify the response */
       if(response.GetCommandCode() != 0x90) {
- 	std::cerr << "SickLMS2xx::ResetSick: Unexpected reply! (assuming device has been reset!)"  << std::endl;
+ 	SICK_LOG_WARN("SickLMS2xx::ResetSick: Unexpected reply! (assuming device has been reset!)");
       } else {
  	std::cout << "\t\tLMS Ready message received!" << std::endl;
       }
@@ -1843,25 +2299,25 @@ namespace SickToolbox {
     
     /* Catch any timeout exceptions */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::ResetSick: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::ResetSick: Unknown exception!!!");
       throw;
     }
     
@@ -2350,19 +2806,19 @@ namespace SickToolbox {
 
     /* Handle any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle unknown exceptions */
     catch(...) {
-      std::cerr << "SickLMS2xx::_setupConnection: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_setupConnection: Unknown exception!");
       throw;
     }
     
@@ -2412,13 +2868,13 @@ namespace SickToolbox {
 
     /* Handle thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* A sanity check */
     catch(...) {
-      std::cerr << "SickLMS2xx::_flushTerminalBuffer: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_flushTerminalBuffer: Unknown exception!");
       throw;
     }
 
@@ -2456,19 +2912,19 @@ namespace SickToolbox {
     
     /* Handle a thread exception */
     catch (SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_error) {
-      std::cerr << sick_io_error.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_error.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS2xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -2505,19 +2961,19 @@ namespace SickToolbox {
     
     /* Handle a thread exception */
     catch (SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Handle write buffer exceptions */
     catch (SickIOException &sick_io_error) {
-      std::cerr << sick_io_error.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_error.what());
       throw;
     }
     
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS2xx::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_sendMessageAndGetReply: Unknown exception!!!");
       throw;
     }
     
@@ -2559,25 +3015,25 @@ namespace SickToolbox {
     
     /* Catch a timeout */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::_getSickErrors: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_getSickErrors: Unknown exception!!!");
       throw;
     }
 
@@ -2617,7 +3073,7 @@ namespace SickToolbox {
 
       /* Catch anything else and throw it away */
       catch(...) {
-	std::cerr << "SickLMS2xx::_testBaudRate: Unknown exception!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_testBaudRate: Unknown exception!");
 	throw;
       }
       
@@ -2625,19 +3081,19 @@ namespace SickToolbox {
 
     /* Handle any IO exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw; 
     }
 
     /* A safety net */
     catch(...) {
-      std::cerr << "SickLMS2xx::_testBaudRate: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_testBaudRate: Unknown exception!!!");
       throw; 
     }
 
@@ -2691,16 +3147,14 @@ namespace SickToolbox {
 
 	/* We let the next few errors slide in case USB adapter is being used */
 	if(ioctl(_sick_fd,TIOCGSERIAL,&serial) < 0) {
-	  std::cerr << "SickLMS2xx::_setTermSpeed: ioctl() failed while trying to get serial port info!" << std::endl;
-	  std::cerr << "\tNOTE: This is normal when connected via USB!" <<std::endl;
+	  SICK_LOG_WARN("SickLMS2xx::_setTermSpeed: ioctl() failed while trying to get serial port info!" << " (NOTE: This is normal when connected via USB!)");
 	}
 	
 	serial.custom_divisor = 0;
         serial.flags &= ~ASYNC_SPD_CUST;
 	
 	if(ioctl(_sick_fd,TIOCSSERIAL,&serial) < 0) {
-	  std::cerr << "SickLMS2xx::_setTerminalBaud: ioctl() failed while trying to set serial port info!" << std::endl;
-	  std::cerr << "\tNOTE: This is normal when connected via USB!" <<std::endl;
+	  SICK_LOG_WARN("SickLMS2xx::_setTerminalBaud: ioctl() failed while trying to set serial port info!" << " (NOTE: This is normal when connected via USB!)");
 	}
 	
       }
@@ -2757,19 +3211,19 @@ namespace SickToolbox {
 
     /* Catch an IO exception */
     catch(SickIOException sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch an IO exception */
     catch(SickThreadException sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* A sanity check */
     catch(...) {
-      std::cerr << "SickLMS2xx::_setTerminalBaud: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_setTerminalBaud: Unknown exception!!!");
       throw;
     }
 
@@ -2800,25 +3254,25 @@ namespace SickToolbox {
     
     /* Catch any timeout exceptions */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::_getSickType: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_getSickType: Unknown exception!!!");
       throw;
     }
     
@@ -2917,25 +3371,25 @@ namespace SickToolbox {
 
      /* Catch any timeout exceptions */
      catch(SickTimeoutException &sick_timeout_exception) {
-       std::cerr << sick_timeout_exception.what() << std::endl;
+       SICK_LOG_ERROR(sick_timeout_exception.what());
        throw;
      }
      
      /* Catch any I/O exceptions */
      catch(SickIOException &sick_io_exception) {
-       std::cerr << sick_io_exception.what() << std::endl;
+       SICK_LOG_ERROR(sick_io_exception.what());
        throw;
      }
      
      /* Catch any thread exceptions */
      catch(SickThreadException &sick_thread_exception) {
-       std::cerr << sick_thread_exception.what() << std::endl;
+       SICK_LOG_ERROR(sick_thread_exception.what());
        throw;
      }
      
      /* Catch anything else */
      catch(...) {
-       std::cerr << "SickLMS2xx::_getSickConfig: Unknown exception!!!" << std::endl;
+       SICK_LOG_ERROR("SickLMS2xx::_getSickConfig: Unknown exception!!!");
        throw;
      }
 
@@ -2950,6 +3404,112 @@ namespace SickToolbox {
      
   }
 
+  /**
+   * \brief Looks up the init cache entry for this device path
+   * \param &sick_baud The baud rate the device was last left at
+   * \return True if an entry was found, false otherwise
+   */
+  bool SickLMS2xx::_readSickInitCache( sick_lms_2xx_baud_t &sick_baud ) const {
+
+    /* Is the cache enabled? */
+    if (_sick_init_cache_path.empty()) {
+      return false;
+    }
+
+    std::ifstream cache_file(_sick_init_cache_path.c_str());
+    std::string line;
+
+    /* Each line: <device path> <baud> */
+    while (std::getline(cache_file,line)) {
+
+      std::istringstream line_stream(line);
+      std::string device_path;
+      int baud = 0;
+
+      if (!(line_stream >> device_path) || device_path != _sick_device_path) {
+	continue;
+      }
+
+      if (!(line_stream >> baud)) {
+	SICK_LOG_WARN("SickLMS2xx::_readSickInitCache: Ignoring malformed cache entry!");
+	return false;
+      }
+
+      sick_baud = (sick_lms_2xx_baud_t)baud;
+      return sick_baud != SICK_BAUD_UNKNOWN;
+    }
+
+    /* No entry for this device */
+    return false;
+
+  }
+
+  /**
+   * \brief Stores the current baud rate in the init cache
+   *
+   * NOTE: Processes sharing the cache serialize on an flock of <path>.lock and
+   *       each update is written to a unique temp file that is renamed over
+   *       the cache, so readers never see a partial file.
+   *
+   * NOTE: Failing to write the cache is not fatal.
+   */
+  void SickLMS2xx::_writeSickInitCache( ) const {
+
+    /* Is the cache enabled? */
+    if (_sick_init_cache_path.empty() || _curr_session_baud == SICK_BAUD_UNKNOWN) {
+      return;
+    }
+
+    /* The cache itself is replaced on every update, so lock a separate file */
+    const std::string lock_path = _sick_init_cache_path + ".lock";
+    const int lock_fd = open(lock_path.c_str(),O_RDWR | O_CREAT,0644);
+    if (lock_fd < 0 || flock(lock_fd,LOCK_EX) != 0) {
+      SICK_LOG_ERROR("SickLMS2xx::_writeSickInitCache: Failed to lock " << lock_path);
+      if (lock_fd >= 0) {
+	close(lock_fd);
+      }
+      return;
+    }
+
+    /* Keep the entries of the other devices */
+    std::ifstream cache_file(_sick_init_cache_path.c_str());
+    std::ostringstream contents;
+    std::string line;
+    while (std::getline(cache_file,line)) {
+      std::istringstream line_stream(line);
+      std::string device_path;
+      if ((line_stream >> device_path) && device_path != _sick_device_path) {
+	contents << line << std::endl;
+      }
+    }
+    cache_file.close();
+    contents << _sick_device_path << " " << (int)_curr_session_baud << std::endl;
+
+    /* Write to a unique temp file and swap it in */
+    const std::string temp_contents = contents.str();
+    std::string temp_path = _sick_init_cache_path + ".XXXXXX";
+    const int temp_fd = mkstemp(&temp_path[0]);
+
+    bool written = false;
+    if (temp_fd >= 0) {
+      written = fchmod(temp_fd,0644) == 0 &&
+	write(temp_fd,temp_contents.data(),temp_contents.size()) == (ssize_t)temp_contents.size();
+      written = (close(temp_fd) == 0) && written;
+      written = written && rename(temp_path.c_str(),_sick_init_cache_path.c_str()) == 0;
+      if (!written) {
+	unlink(temp_path.c_str());
+      }
+    }
+
+    if (!written) {
+      SICK_LOG_ERROR("SickLMS2xx::_writeSickInitCache: Failed to update " << _sick_init_cache_path);
+    }
+
+    flock(lock_fd,LOCK_UN);
+    close(lock_fd);
+
+  }
+
   /**
    * \brief Sets the current configuration in flash
    * \param &sick_device_config The desired Sick LMS configuration
@@ -3102,31 +3662,31 @@ namespace SickToolbox {
     
     /* Catch any timeout exceptions */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     /* Catch any config exceptions */
     catch(SickConfigException &sick_config_exception) {
-      std::cerr << sick_config_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_config_exception.what());
       throw;
     }
       
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::_setSickConfig: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_setSickConfig: Unknown exception!");
       throw;
     }
 
@@ -3158,25 +3718,25 @@ namespace SickToolbox {
 
      /* Catch any timeout exceptions */
      catch(SickTimeoutException &sick_timeout_exception) {
-       std::cerr << sick_timeout_exception.what() << std::endl;
+       SICK_LOG_ERROR(sick_timeout_exception.what());
        throw;
      }
      
      /* Catch any I/O exceptions */
      catch(SickIOException &sick_io_exception) {
-       std::cerr << sick_io_exception.what() << std::endl;
+       SICK_LOG_ERROR(sick_io_exception.what());
        throw;
      }
      
      /* Catch any thread exceptions */
      catch(SickThreadException &sick_thread_exception) {
-       std::cerr << sick_thread_exception.what() << std::endl;
+       SICK_LOG_ERROR(sick_thread_exception.what());
        throw;
      }
      
      /* Catch anything else */
      catch(...) {
-       std::cerr << "SickLMS2xx::_getSickErrors: Unknown exception!!!" << std::endl;
+       SICK_LOG_ERROR("SickLMS2xx::_getSickErrors: Unknown exception!!!");
        throw;
      }
      
@@ -3234,25 +3794,25 @@ namespace SickToolbox {
     
     /* Catch any timeout exceptions */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
     
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
     
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::_getSickStatus: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_getSickStatus: Unknown exception!");
       throw;
     }
 
@@ -3517,31 +4077,31 @@ namespace SickToolbox {
 
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!");
 	throw;
       } 
       
@@ -3575,31 +4135,31 @@ namespace SickToolbox {
 
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!");
 	throw;
       } 
       
@@ -3633,31 +4193,31 @@ namespace SickToolbox {
 
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeMonitorRequestValues: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeMonitorRequestValues: Unknown exception!!!");
 	throw;
       } 
       
@@ -3691,31 +4251,31 @@ namespace SickToolbox {
 
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeMonitorStreamValues: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeMonitorStreamValues: Unknown exception!!!");
 	throw;
       } 
       
@@ -3759,31 +4319,31 @@ namespace SickToolbox {
       
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeStreamRangeAndReflectivity: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeStreamRangeAndReflectivity: Unknown exception!!!");
 	throw;
       } 
       
@@ -3819,31 +4379,31 @@ namespace SickToolbox {
 
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeStreamValuesFromPartialScan: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeStreamValuesFromPartialScan: Unknown exception!!!");
 	throw;
       } 
       
@@ -3885,31 +4445,31 @@ namespace SickToolbox {
 
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeStreamRangeFromPartialScan: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeStreamRangeFromPartialScan: Unknown exception!!!");
 	throw;
       } 
       
@@ -3972,31 +4532,31 @@ namespace SickToolbox {
       
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!");
 	throw;
       } 
       
@@ -4070,31 +4630,31 @@ namespace SickToolbox {
       
       /* Catch any config exceptions */
       catch(SickConfigException &sick_config_exception) {
-	std::cerr << sick_config_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_config_exception.what());
 	throw;
       }
       
       /* Catch any timeout exceptions */
       catch(SickTimeoutException &sick_timeout_exception) {
-	std::cerr << sick_timeout_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_timeout_exception.what());
 	throw;
       }
       
       /* Catch any I/O exceptions */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
 	throw;
       }
       
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
 	throw;
       }
       
       /* Catch anything else */
       catch(...) {
-	std::cerr << "SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLMS2xx::_setSickOpModeInstallation: Unknown exception!!!");
 	throw;
       } 
       
@@ -4122,6 +4682,11 @@ namespace SickToolbox {
   void SickLMS2xx::_switchSickOperatingMode( const uint8_t sick_mode, const uint8_t * const mode_params )
     throw( SickConfigException, SickIOException, SickThreadException, SickTimeoutException) {
 
+    /* Make sure the mode isn't pinned by a stream session */
+    if (_sick_stream_session) {
+      throw SickConfigException("SickLMS2xx::_switchSickOperatingMode: Operating mode is pinned by a stream session!");
+    }
+    
     SickLMS2xxMessage message,response;
 
     uint8_t payload_buffer[SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};    
@@ -4286,25 +4851,25 @@ namespace SickToolbox {
 
     /* Catch any timeout exceptions */
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
     
     /* Catch any I/O exceptions */
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Catch any thread exceptions */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Catch anything else */
     catch(...) {
-      std::cerr << "SickLMS2xx::_switchSickOperatingMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS2xx::_switchSickOperatingMode: Unknown exception!!!");
       throw;
     }
     
@@ -4328,22 +4893,29 @@ namespace SickToolbox {
    */
   void SickLMS2xx::_parseSickScanProfileB0( const uint8_t * const src_buffer, sick_lms_2xx_scan_profile_b0_t &sick_scan_profile ) const {
 
+    SICK_TRACE_SCOPE_ARG("SickLMS2xx::_parseSickScanProfileB0",_sick_fd);
+
     /* Read block A, the number of measurments */
-    sick_scan_profile.sick_num_measurements = src_buffer[0] + 256*(src_buffer[1] & 0x03);
+    const uint16_t num_measurements = src_buffer[0] + 256*(src_buffer[1] & 0x03);
 
     /* Check whether this is a partial scan */
     sick_scan_profile.sick_partial_scan_index = ((src_buffer[1] & 0x18) >> 3);
 
+    /* Acquire the beam angles (for the ROI) */
+    double start_angle = 0, step_angle = 0;
+    _getSickBeamLayout(num_measurements,sick_scan_profile.sick_partial_scan_index,start_angle,step_angle);
+
     /* Extract the measurements and Field values (if there are any) */
-    _extractSickMeasurementValues(&src_buffer[2],
-				  sick_scan_profile.sick_num_measurements,
-				  sick_scan_profile.sick_measurements,
-				  sick_scan_profile.sick_field_a_values,
-				  sick_scan_profile.sick_field_b_values,
-				  sick_scan_profile.sick_field_c_values);
+    sick_scan_profile.sick_num_measurements = _extractSickMeasurementValues(&src_buffer[2],
+									    num_measurements,
+									    sick_scan_profile.sick_measurements,
+									    sick_scan_profile.sick_field_a_values,
+									    sick_scan_profile.sick_field_b_values,
+									    sick_scan_profile.sick_field_c_values,
+									    start_angle,step_angle,0,true);
     
     /* If the Sick is pulling real-time indices then pull them too */
-    unsigned int data_offset = 2 + 2*sick_scan_profile.sick_num_measurements;
+    unsigned int data_offset = 2 + 2*num_measurements;
     if (_returningRealTimeIndices()) {
       sick_scan_profile.sick_real_time_scan_index = src_buffer[data_offset];
       data_offset++;
@@ -4361,19 +4933,27 @@ namespace SickToolbox {
    */
   void SickLMS2xx::_parseSickScanProfileB6( const uint8_t * const src_buffer, sick_lms_2xx_scan_profile_b6_t &sick_scan_profile ) const {
 
+    SICK_TRACE_SCOPE_ARG("SickLMS2xx::_parseSickScanProfileB6",_sick_fd);
+
     /* Read Block A, the sample size used in computing the mean return */
     sick_scan_profile.sick_sample_size = src_buffer[0];
 
     /* Read Block B, the number of measured values sent */
-    sick_scan_profile.sick_num_measurements = src_buffer[1] + 256*(src_buffer[2] & 0x03);
+    const uint16_t num_measurements = src_buffer[1] + 256*(src_buffer[2] & 0x03);
+
+    /* Acquire the beam angles (for the ROI) */
+    double start_angle = 0, step_angle = 0;
+    _getSickBeamLayout(num_measurements,0,start_angle,step_angle);
 
     /* Read Block C, extract the range measurements and Field values (if there are any) */
-    _extractSickMeasurementValues(&src_buffer[3],
-				  sick_scan_profile.sick_num_measurements,
-				  sick_scan_profile.sick_measurements);
+    sick_scan_profile.sick_num_measurements = _extractSickMeasurementValues(&src_buffer[3],
+									    num_measurements,
+									    sick_scan_profile.sick_measurements,
+									    NULL,NULL,NULL,
+									    start_angle,step_angle,0,true);
     
     /* Read Block D, if the Sick is pulling real-time indices then pull them too */
-    unsigned int data_offset = 3 + 2*sick_scan_profile.sick_num_measurements;
+    unsigned int data_offset = 3 + 2*num_measurements;
     if (_returningRealTimeIndices()) {
       sick_scan_profile.sick_real_time_scan_index = src_buffer[data_offset];
       data_offset++;
@@ -4391,6 +4971,8 @@ namespace SickToolbox {
    */
   void SickLMS2xx::_parseSickScanProfileB7( const uint8_t * const src_buffer, sick_lms_2xx_scan_profile_b7_t &sick_scan_profile ) const {
 
+    SICK_TRACE_SCOPE_ARG("SickLMS2xx::_parseSickScanProfileB7",_sick_fd);
+
     /* Read Block A, Sick LMS measured value subrange start index */
     sick_scan_profile.sick_subrange_start_index = src_buffer[0] + 256*src_buffer[1];
 
@@ -4398,21 +4980,27 @@ namespace SickToolbox {
     sick_scan_profile.sick_subrange_stop_index = src_buffer[2] + 256*src_buffer[3];
     
     /* Read block C, the number of measurements */
-    sick_scan_profile.sick_num_measurements = src_buffer[4] + 256*(src_buffer[5] & 0x03);
+    const uint16_t num_measurements = src_buffer[4] + 256*(src_buffer[5] & 0x03);
 
     /* Acquire the partial scan index (also in Block C) */
     sick_scan_profile.sick_partial_scan_index = ((src_buffer[5] & 0x18) >> 3);
+
+    /* Acquire the beam angles of the full scan (for the ROI) */
+    double start_angle = 0, step_angle = 0;
+    _getSickBeamLayout(0,0,start_angle,step_angle);
+    const unsigned int first_beam_index = (sick_scan_profile.sick_subrange_start_index > 0) ? sick_scan_profile.sick_subrange_start_index - 1 : 0;
     
     /* Read Block D, extract the range measurements and Field values (if there are any) */
-    _extractSickMeasurementValues(&src_buffer[6],
-				  sick_scan_profile.sick_num_measurements,
-				  sick_scan_profile.sick_measurements,
-				  sick_scan_profile.sick_field_a_values,
-				  sick_scan_profile.sick_field_b_values,
-				  sick_scan_profile.sick_field_c_values);
+    sick_scan_profile.sick_num_measurements = _extractSickMeasurementValues(&src_buffer[6],
+									    num_measurements,
+									    sick_scan_profile.sick_measurements,
+									    sick_scan_profile.sick_field_a_values,
+									    sick_scan_profile.sick_field_b_values,
+									    sick_scan_profile.sick_field_c_values,
+									    start_angle,step_angle,first_beam_index,true);
     
     /* Read Block E, if the Sick is pulling real-time indices then pull them too */
-    unsigned int data_offset = 6 + 2*sick_scan_profile.sick_num_measurements;
+    unsigned int data_offset = 6 + 2*num_measurements;
     if (_returningRealTimeIndices()) {
       sick_scan_profile.sick_real_time_scan_index = src_buffer[data_offset];
       data_offset++;
@@ -4430,6 +5018,8 @@ namespace SickToolbox {
    */
   void SickLMS2xx::_parseSickScanProfileBF( const uint8_t * const src_buffer, sick_lms_2xx_scan_profile_bf_t &sick_scan_profile ) const {
 
+    SICK_TRACE_SCOPE_ARG("SickLMS2xx::_parseSickScanProfileBF",_sick_fd);
+
     /* Read Block A, the sample size used in computing the mean return */
     sick_scan_profile.sick_sample_size = src_buffer[0];
 
@@ -4440,15 +5030,22 @@ namespace SickToolbox {
     sick_scan_profile.sick_subrange_stop_index = src_buffer[3] + 256*src_buffer[4];
     
     /* Read Block D, the number of measured values sent */
-    sick_scan_profile.sick_num_measurements = src_buffer[5] + 256*(src_buffer[6] & 0x3F);
+    const uint16_t num_measurements = src_buffer[5] + 256*(src_buffer[6] & 0x3F);
+
+    /* Acquire the beam angles of the full scan (for the ROI) */
+    double start_angle = 0, step_angle = 0;
+    _getSickBeamLayout(0,0,start_angle,step_angle);
+    const unsigned int first_beam_index = (sick_scan_profile.sick_subrange_start_index > 0) ? sick_scan_profile.sick_subrange_start_index - 1 : 0;
 
     /* Read Block E, extract the mean measurements */
-    _extractSickMeasurementValues(&src_buffer[7],
-				  sick_scan_profile.sick_num_measurements,
-				  sick_scan_profile.sick_measurements);
+    sick_scan_profile.sick_num_measurements = _extractSickMeasurementValues(&src_buffer[7],
+									    num_measurements,
+									    sick_scan_profile.sick_measurements,
+									    NULL,NULL,NULL,
+									    start_angle,step_angle,first_beam_index,true);
     
     /* Read Block D, if the Sick is pulling real-time indices then pull them too */
-    unsigned int data_offset = 7 + 2*sick_scan_profile.sick_num_measurements;
+    unsigned int data_offset = 7 + 2*num_measurements;
     if (_returningRealTimeIndices()) {
       sick_scan_profile.sick_real_time_scan_index = src_buffer[data_offset];
       data_offset++;
@@ -4466,6 +5063,8 @@ namespace SickToolbox {
    */
   void SickLMS2xx::_parseSickScanProfileC4( const uint8_t * const src_buffer, sick_lms_2xx_scan_profile_c4_t &sick_scan_profile ) const {
 
+    SICK_TRACE_SCOPE_ARG("SickLMS2xx::_parseSickScanProfileC4",_sick_fd);
+
     /* Read block A - the number of range measurments.  We need the low two bits
      * of the most significant byte. */
     sick_scan_profile.sick_num_range_measurements = src_buffer[0] + 256*(src_buffer[1] & 0x03);
@@ -4620,163 +5219,145 @@ namespace SickToolbox {
    * \param *field_a_values Stores the Field A values associated with the given measurements (Default: NULL => Not wanted)
    * \param *field_b_values Stores the Field B values associated with the given measurements (Default: NULL => Not wanted)
    * \param *field_c_values Stores the Field C values associated with the given measurements (Default: NULL => Not wanted)
+   * \param start_angle The angle of beam 0 of the full scan (deg)
+   * \param step_angle The angle between consecutive beams (deg)
+   * \param first_beam_index The index (in the full scan) of the first value in the byte sequence
+   * \param apply_roi Whether to apply the scan ROI (Default: false => Extract all values)
+   * \return The number of values extracted
+   *
+   * NOTE: When the ROI is applied, beams it does not select are skipped without
+   *       being decoded and the returned buffers are compacted.
    */
-  void SickLMS2xx::_extractSickMeasurementValues( const uint8_t * const byte_sequence, const uint16_t num_measurements, uint16_t * const measured_values,
-					       uint8_t * const field_a_values, uint8_t * const field_b_values, uint8_t * const field_c_values ) const {
+  uint16_t SickLMS2xx::_extractSickMeasurementValues( const uint8_t * const byte_sequence, const uint16_t num_measurements, uint16_t * const measured_values,
+						   uint8_t * const field_a_values, uint8_t * const field_b_values, uint8_t * const field_c_values,
+						   const double start_angle, const double step_angle, const unsigned int first_beam_index,
+						   const bool apply_roi ) const {
 
-    /* Parse the byte sequence and fill the return buffer with range measurements... */   
+    /* Bits of the high byte holding the measured value and the Field values */
+    uint8_t value_mask = 0, field_a_mask = 0, field_b_mask = 0, field_c_mask = 0;
+
+    /* Acquire the masks for the current measuring mode... */
     switch(_sick_device_config.sick_measuring_mode) {
     case SICK_MS_MODE_8_OR_80_FA_FB_DAZZLE:
+    case SICK_MS_MODE_8_OR_80_FA_FB_FC:
       {
-
-	/* Extract the range and Field values */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x1F);
-
-	  if(field_a_values) {  
-	    field_a_values[i] = byte_sequence[i*2+1] & 0x20;
-	  }
-	  
-	  if(field_b_values) {
-	    field_b_values[i] = byte_sequence[i*2+1] & 0x40;
-	  }
-	  
-	  if(field_c_values) {
-	    field_c_values[i] = byte_sequence[i*2+1] & 0x80;
-	  }
-	  
-	}
-	
+	/* Range and Fields A,B and C (or Dazzle) */
+	value_mask = 0x1F;
+	field_a_mask = 0x20;
+	field_b_mask = 0x40;
+	field_c_mask = 0x80;
 	break;
       }
     case SICK_MS_MODE_8_OR_80_REFLECTOR:
       {
-	
-	/* Extract the range and Field A */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x1F);
-	  
-	  if(field_a_values) {
-	    field_a_values[i] = byte_sequence[i*2+1] & 0xE0;
-	  }
-	  
-	}
-	
-	break;
-      }     
-    case SICK_MS_MODE_8_OR_80_FA_FB_FC:
-      {
-	
-	/* Extract the range and Fields A,B and C */	
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x1F);
-	  
-	  if(field_a_values) {
-	    field_a_values[i] = byte_sequence[i*2+1] & 0x20;
-	  }
-	  
-	  if(field_b_values) {
-	    field_b_values[i] = byte_sequence[i*2+1] & 0x40;
-	  }
-	  
-	  if(field_c_values) {
-	    field_c_values[i] = byte_sequence[i*2+1] & 0x80;
-	  }
-	  
-	}
-	
+	/* Range and Field A (reflector bits in 8 levels) */
+	value_mask = 0x1F;
+	field_a_mask = 0xE0;
 	break;
       }
     case SICK_MS_MODE_16_REFLECTOR:
       {
-
-	/* Extract the range and reflector values */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x3F);
-
-	  if (field_a_values) {
-	    field_a_values[i] = byte_sequence[i*2+1] & 0xC0;
-	  }
-	  
-	}
-	
+	/* Range and reflector values */
+	value_mask = 0x3F;
+	field_a_mask = 0xC0;
 	break;
       }
     case SICK_MS_MODE_16_FA_FB:
       {
-
-	/* Extract the range and Fields A and B values */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x3F);
-
-	  if(field_a_values) {
-	    field_a_values[i] = byte_sequence[i*2+1] & 0x40;
-	  }
-
-	  if(field_b_values) {
-	    field_b_values[i] = byte_sequence[i*2+1] & 0x80;
-	  }
-
-	}
-	
+	/* Range and Fields A and B values */
+	value_mask = 0x3F;
+	field_a_mask = 0x40;
+	field_b_mask = 0x80;
 	break;
       }
     case SICK_MS_MODE_32_REFLECTOR:
-      {
-
-	/* Extract the range and reflector values */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x7F);
-
-	  if(field_a_values) {
-	    field_a_values[i] = byte_sequence[i*2+1] & 0x80;
-	  }
-	  
-	}
-	
-	break;
-      }
     case SICK_MS_MODE_32_FA:
       {
-
-	/* Extract the range and Field A values */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1] & 0x7F);
-
-	  if(field_a_values) {
-	    field_a_values[i] = byte_sequence[i*2+1] & 0x80;
-	  }
-	  
-	}
-	
+	/* Range and reflector/Field A values */
+	value_mask = 0x7F;
+	field_a_mask = 0x80;
 	break;
       }
     case SICK_MS_MODE_32_IMMEDIATE:
+    case SICK_MS_MODE_REFLECTIVITY:
       {
-	
-	/* Extract the range measurements (no flags for this mode */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1]);
-	}
-	
+	/* Range (no flags for this mode) or reflectivity values */
+	value_mask = 0xFF;
 	break;
       }
-    case SICK_MS_MODE_REFLECTIVITY:
-      {
+    default:
+      return num_measurements;
+    }
 
-	/* Extract the reflectivity values */
-	for(unsigned int i = 0; i < num_measurements; i++) {
-	  measured_values[i] = byte_sequence[i*2] + 256*(byte_sequence[i*2+1]);
-	}
-	
-	break;
-      }      
-    default:      
-      break;
+    /* Acquire the range limits (in device units) */
+    unsigned int min_value = 0, max_value = UINT_MAX;
+    if (apply_roi && _sick_scan_roi.IsRangeLimited() && _sick_device_config.sick_measuring_mode != SICK_MS_MODE_REFLECTIVITY) {
+      _sick_scan_roi.GetRawRangeLimits((_sick_device_config.sick_measuring_units == SICK_MEASURING_UNITS_CM) ? 0.01 : 0.001,min_value,max_value);
     }
-    
+
+    const bool select_all = !apply_roi || _sick_scan_roi.SelectsAllBeams();
+
+    /* Parse the byte sequence and fill the return buffer with the selected measurements... */
+    uint16_t num_values = 0;
+    for(unsigned int i = 0; i < num_measurements; i++) {
+
+      /* Skip the beams outside of the ROI */
+      const unsigned int beam_index = first_beam_index + i;
+      if (!select_all && !_sick_scan_roi.SelectBeam(beam_index,start_angle + beam_index*step_angle)) {
+	continue;
+      }
+
+      const uint8_t high_byte = byte_sequence[i*2+1];
+      const unsigned int measured_value = byte_sequence[i*2] + 256*(high_byte & value_mask);
+      measured_values[num_values] = (measured_value >= min_value && measured_value <= max_value) ? measured_value : 0;
+
+      if(field_a_values && field_a_mask) {
+	field_a_values[num_values] = high_byte & field_a_mask;
+      }
+
+      if(field_b_values && field_b_mask) {
+	field_b_values[num_values] = high_byte & field_b_mask;
+      }
+
+      if(field_c_values && field_c_mask) {
+	field_c_values[num_values] = high_byte & field_c_mask;
+      }
+
+      num_values++;
+    }
+
+    return num_values;
+
   }
-  
+
+  /**
+   * \brief Acquires the angular layout of a scan with the given number of values
+   * \param num_measurements The number of values in the scan
+   * \param partial_scan_index The partial scan index reported with the scan
+   * \param &start_angle The angle of beam 0 (deg)
+   * \param &step_angle The angle between consecutive beams (deg)
+   *
+   * NOTE: A scan holding fewer values than the configured angle/resolution implies
+   *       is an interlaced partial scan, offset by its partial scan index (which
+   *       counts 0.25 deg steps, i.e. 0/2 for the two halves of a 0.5 deg scan).
+   */
+  void SickLMS2xx::_getSickBeamLayout( const unsigned int num_measurements, const unsigned int partial_scan_index,
+				       double &start_angle, double &step_angle ) const {
+
+    const double scan_angle = _sick_operating_status.sick_scan_angle;
+    const double scan_resolution = _sick_operating_status.sick_scan_resolution/100.0;
+
+    /* The scan is centered on 90 deg */
+    start_angle = (180.0 - scan_angle)/2.0;
+    step_angle = scan_resolution;
+
+    if (num_measurements > 1 && scan_resolution > 0 && (num_measurements - 1)*scan_resolution < scan_angle - scan_resolution/2) {
+      step_angle = scan_angle/(num_measurements - 1);
+      start_angle += partial_scan_index*SICK_LMS_2XX_PARTIAL_SCAN_ANGLE_STEP;
+    }
+
+  }
+
   /**
    * \brief Indicates whether the given measuring units are valid/defined
    * \param sick_units The units in question
@@ -5025,7 +5606,7 @@ namespace SickToolbox {
     case B500000:
       return SICK_BAUD_500K;
     default:
-      std::cerr << "Unexpected baud rate!" << std::endl;
+      SICK_LOG_ERROR("Unexpected baud rate!");
       return SICK_BAUD_9600;
     }
     
@@ -46,81 +46,72 @@ namespace SickToolbox {
     uint8_t payload_buffer[SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH] = {0};
     uint8_t checksum_buffer[2] = {0};  
     uint16_t payload_length, checksum;
-    
-    try {
 
-      /* Drain the I/O buffers! */
-      if (tcdrain(_sick_fd) != 0) {
-     	throw SickIOException("SickLMS2xxBufferMonitor::GetNextMessageFromDataStream: tcdrain failed!");
-      }
+    /* Drain the I/O buffers! */
+    if (tcdrain(_sick_fd) != 0) {
+      throw SickIOException("SickLMS2xxBufferMonitor::GetNextMessageFromDataStream: tcdrain failed!");
+    }
 
-      /* Read until we get a valid message header */
-      unsigned int bytes_searched = 0;
-      while(search_buffer[0] != 0x02 || search_buffer[1] != DEFAULT_SICK_LMS_2XX_HOST_ADDRESS) {
+    /* Read until we get a valid message header */
+    unsigned int bytes_searched = 0;
+    while(search_buffer[0] != 0x02 || search_buffer[1] != DEFAULT_SICK_LMS_2XX_HOST_ADDRESS) {
 	
- 	/* Slide the search window */
- 	search_buffer[0] = search_buffer[1];
+      /* Slide the search window */
+      search_buffer[0] = search_buffer[1];
 	
- 	/* Attempt to read in another byte */
- 	_readBytes(&search_buffer[1],1,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT);
+      /* Attempt to read in another byte (a timeout is ok!) */
+      if (_readTimedOut(_tryReadBytes(&search_buffer[1],1,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT))) {
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched);
+	return;
+      }
 
-	/* Header should be no more than max message length + header length bytes away */
-	if (bytes_searched > SickLMS2xxMessage::MESSAGE_MAX_LENGTH + SickLMS2xxMessage::MESSAGE_HEADER_LENGTH) {
-	  throw SickTimeoutException("SickLMS2xxBufferMonitor::GetNextMessageFromDataStream: header timeout!");
-	}
+      /* Header should be no more than max message length + header length bytes away (resync on the next pass) */
+      if (bytes_searched > SickLMS2xxMessage::MESSAGE_MAX_LENGTH + SickLMS2xxMessage::MESSAGE_HEADER_LENGTH) {
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched);
+	return;
+      }
 	
-	/* Increment the number of bytes searched */
-	bytes_searched++;
+      /* Increment the number of bytes searched */
+      bytes_searched++;
 	
-      }
+    }
+
+    /* Anything ahead of the two header bytes was skipped */
+    if (bytes_searched > 2) {
+      _sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched - 2);
+    }
       
-      /* Read until we receive the payload length or we timeout */
-      _readBytes(payload_length_buffer,2,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT);
+    /* Read until we receive the payload length or we timeout */
+    if (_readTimedOut(_tryReadBytes(payload_length_buffer,2,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT))) {
+      return;
+    }
 
-      /* Extract the payload length */
-      memcpy(&payload_length,payload_length_buffer,2);
-      payload_length = sick_lms_2xx_to_host_byte_order(payload_length);
+    /* Extract the payload length */
+    memcpy(&payload_length,payload_length_buffer,2);
+    payload_length = sick_lms_2xx_to_host_byte_order(payload_length);
 
-      /* Make sure the payload length is legitimate, otherwise disregard */
-      if (payload_length <= SickLMS2xxMessage::MESSAGE_MAX_LENGTH) {
+    /* Make sure the payload length is legitimate, otherwise disregard */
+    if (payload_length <= SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH) {
 
-	/* Read until we receive the payload or we timeout */
-	_readBytes(payload_buffer,payload_length,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT);
-	
-	/* Read until we receive the checksum or we timeout */
-	_readBytes(checksum_buffer,2,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT);
+      /* Read until we receive the payload and the checksum or we timeout */
+      if (_readTimedOut(_tryReadBytes(payload_buffer,payload_length,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT)) ||
+	  _readTimedOut(_tryReadBytes(checksum_buffer,2,DEFAULT_SICK_LMS_2XX_SICK_BYTE_TIMEOUT))) {
+	return;
+      }
 	
-	/* Copy into uint16_t so it can be used */
-	memcpy(&checksum,checksum_buffer,2);
-	checksum = sick_lms_2xx_to_host_byte_order(checksum);
+      /* Copy into uint16_t so it can be used */
+      memcpy(&checksum,checksum_buffer,2);
+      checksum = sick_lms_2xx_to_host_byte_order(checksum);
 	
-	/* Build a frame and compute the crc */
-	sick_message.BuildMessage(DEFAULT_SICK_LMS_2XX_HOST_ADDRESS,payload_buffer,payload_length);
+      /* Build a frame and compute the crc */
+      sick_message.BuildMessage(DEFAULT_SICK_LMS_2XX_HOST_ADDRESS,payload_buffer,payload_length);
 	
-	/* See if the checksums match */
-	if(sick_message.GetChecksum() != checksum) {
-	  throw SickBadChecksumException("SickLMS2xx::GetNextMessageFromDataStream: CRC16 failed!");
-	}
-
+      /* See if the checksums match (otherwise drop the frame) */
+      if(sick_message.GetChecksum() != checksum) {
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_CHECKSUM_FAILURES);
+	sick_message.Clear();
       }
-      
-    }
-    
-    catch(SickTimeoutException &sick_timeout_exception) { /* This is ok! */ }
-    
-    /* Handle a bad checksum! */
-    catch(SickBadChecksumException &sick_checksum_exception) {
-      sick_message.Clear(); // Clear the message container
-    }
-    
-    /* Handle any serious IO exceptions */
-    catch(SickIOException &sick_io_exception) {
-      throw; 
-    }
 
-    /* A sanity check */
-    catch (...) { 
-      throw; 
     }
     
   }
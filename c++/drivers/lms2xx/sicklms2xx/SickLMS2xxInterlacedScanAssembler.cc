@@ -0,0 +1,376 @@
+/*!
+ * \file SickLMS2xxInterlacedScanAssembler.cc
+ * \brief Implementation of class SickLMS2xxInterlacedScanAssembler.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+/* Auto-generated header */
+#include <sicktoolbox/SickConfig.hh>
+
+/* Implementation dependencies */
+#include <new>
+#include <iostream>
+
+#include <sicktoolbox/SickLMS2xxInterlacedScanAssembler.hh>
+#include <sicktoolbox/SickLMS2xx.hh>
+#include <sicktoolbox/SickLMS2xxMessage.hh>
+#include <sicktoolbox/SickException.hh>
+#include <sicktoolbox/SickLogger.hh>
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \brief Primary constructor
+   * \param &sick_lms The (initialized) Sick LMS 2xx to be streamed
+   * \param num_scan_buffers Number of complete scans held until they are fetched
+   *
+   * NOTE: All scan and message buffers are allocated here, so assembly
+   *       itself never allocates.
+   */
+  SickLMS2xxInterlacedScanAssembler::SickLMS2xxInterlacedScanAssembler( SickLMS2xx &sick_lms,
+									const unsigned int num_scan_buffers ) throw( SickConfigException ) :
+    _sick_lms(sick_lms), _sick_stream_session(sick_lms), _sick_scans(NULL), _sick_num_scan_buffers(num_scan_buffers),
+    _sick_scan_head(0), _sick_num_pending_scans(0), _sick_assembly_mask(0), _sick_num_assembled(0), _sick_last_telegram_index(0),
+    _sick_last_real_time_index(0), _sick_revolution_offset(0),
+    _sick_num_partial_scans(0), _sick_num_lost_partial_scans(0), _sick_num_discarded_scans(0), _sick_num_dropped_scans(0),
+    _sick_messages(NULL), _sick_recv_times(NULL) {
+
+    if (num_scan_buffers == 0) {
+      throw SickConfigException("SickLMS2xxInterlacedScanAssembler::SickLMS2xxInterlacedScanAssembler: At least one scan buffer is required!");
+    }
+
+    try {
+      _sick_scans = new sick_lms_2xx_interlaced_scan_t[num_scan_buffers + 1];
+      _sick_messages = new SickLMS2xxMessage[DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH];
+      _sick_recv_times = new struct timeval[DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH];
+    }
+
+    catch(std::bad_alloc &) {
+      delete [] _sick_scans;
+      delete [] _sick_messages;
+      throw SickConfigException("SickLMS2xxInterlacedScanAssembler::SickLMS2xxInterlacedScanAssembler: Failed to allocate buffers!");
+    }
+
+    memset(_sick_scans,0,(num_scan_buffers + 1)*sizeof(sick_lms_2xx_interlaced_scan_t));
+    memset(_sick_payload_buffer,0,sizeof(_sick_payload_buffer));
+    memset(&_sick_profile_b0,0,sizeof(_sick_profile_b0));
+
+  }
+
+  /**
+   * \brief Switches the Sick into the partial scan stream and resets the assembly
+   *
+   * NOTE: The scan ROI may limit ranges but must not drop beams, since the
+   *       partial scans are interleaved by position.
+   */
+  void SickLMS2xxInterlacedScanAssembler::Begin( ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException ) {
+
+    if (!_sick_lms._sick_scan_roi.SelectsAllBeams()) {
+      throw SickConfigException("SickLMS2xxInterlacedScanAssembler::Begin: The scan ROI must not drop beams!");
+    }
+
+    _sick_stream_session.Begin(SickLMS2xxStreamSession::SICK_LMS_2XX_STREAM_PARTIAL_SCAN);
+
+    /* Start from a clean slate */
+    _sick_scan_head = _sick_num_pending_scans = 0;
+    _sick_num_partial_scans = 0;
+    _resetAssembly();
+
+  }
+
+  /**
+   * \brief Gets the next complete scan
+   * \param *measurement_values Destination buffer for the measured values (SICK_MAX_NUM_MEASUREMENTS long)
+   * \param &num_measurement_values Number of values stored in measurement_values
+   * \param *sick_scan_index Index (real-time or telegram, modulo 256) of the scan's first partial scan (Default: NULL => Not wanted)
+   * \param *sick_recv_time Receive time of the scan's last partial scan (Default: NULL => Not wanted)
+   * \param timeout_value The time in usecs to wait for a complete scan
+   *
+   * NOTE: Scans are returned oldest first. As with GetSickPartialScan, either range
+   *       or reflectivity values are returned depending upon the measuring mode.
+   */
+  void SickLMS2xxInterlacedScanAssembler::GetNextScan( unsigned int * const measurement_values,
+						       unsigned int & num_measurement_values,
+						       unsigned int * const sick_scan_index,
+						       struct timeval * const sick_recv_time,
+						       const unsigned int timeout_value ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException ) {
+
+    /* Ensure the assembler still owns the device */
+    if (!IsActive()) {
+      throw SickConfigException("SickLMS2xxInterlacedScanAssembler::GetNextScan: Assembler is not active!");
+    }
+
+    _assembleNextScan(timeout_value);
+
+    const sick_lms_2xx_interlaced_scan_t &sick_scan = _sick_scans[_sick_scan_head];
+
+    num_measurement_values = sick_scan.sick_num_measurements;
+    for (unsigned int i = 0; i < num_measurement_values; i++) {
+      measurement_values[i] = sick_scan.sick_measurements[i];
+    }
+
+    /* If requested, copy the scan index */
+    if (sick_scan_index) {
+      *sick_scan_index = sick_scan.sick_scan_index;
+    }
+
+    /* If requested, copy the receive time */
+    if (sick_recv_time) {
+      *sick_recv_time = sick_scan.sick_recv_time;
+    }
+
+    _sick_scan_head = (_sick_scan_head + 1) % (_sick_num_scan_buffers + 1);
+    _sick_num_pending_scans--;
+
+  }
+
+  /**
+   * \brief Gets the next complete scan as a SickScan
+   * \param &sick_scan Destination scan (its storage is reused across calls)
+   * \param timeout_value The time in usecs to wait for a complete scan
+   *
+   * NOTE: Ranges are in m and angles in the device frame. The time offset of
+   *       each beam accounts for the revolution its partial scan was taken in,
+   *       and the header carries the receive time of the last partial scan.
+   */
+  void SickLMS2xxInterlacedScanAssembler::GetNextScan( SickScan &sick_scan, const unsigned int timeout_value ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException ) {
+
+    /* Ensure the assembler still owns the device */
+    if (!IsActive()) {
+      throw SickConfigException("SickLMS2xxInterlacedScanAssembler::GetNextScan: Assembler is not active!");
+    }
+
+    /* Reflectivity values are not ranges */
+    if (_sick_lms._sick_operating_status.sick_measuring_mode == SickLMS2xx::SICK_MS_MODE_REFLECTIVITY) {
+      throw SickConfigException("SickLMS2xxInterlacedScanAssembler::GetNextScan: Sick LMS is returning reflectivity values!");
+    }
+
+    _assembleNextScan(timeout_value);
+
+    const sick_lms_2xx_interlaced_scan_t &interlaced_scan = _sick_scans[_sick_scan_head];
+    const unsigned int num_beams = interlaced_scan.sick_num_measurements;
+
+    try {
+      sick_scan.Resize(num_beams);
+    }
+
+    catch(std::bad_alloc &) {
+      throw SickIOException("SickLMS2xxInterlacedScanAssembler::GetNextScan: Failed to allocate scan storage!");
+    }
+
+    const float range_scale = (_sick_lms._sick_device_config.sick_measuring_units == SickLMS2xx::SICK_MEASURING_UNITS_CM) ? 0.01f : 0.001f;
+
+    /* Copy the ranges and field bits */
+    float * const range_values = sick_scan.GetRangeValues();
+    float * const intensity_values = sick_scan.GetIntensityValues();
+    uint32_t * const flag_values = sick_scan.GetFlagValues();
+    for (unsigned int i = 0; i < num_beams; i++) {
+
+      range_values[i] = interlaced_scan.sick_measurements[i]*range_scale;
+      intensity_values[i] = 0;
+
+      /* The field bits are stored in the order of the A/B/C flags */
+      flag_values[i] = ((uint32_t)interlaced_scan.sick_field_values[i] << 1) |
+	((interlaced_scan.sick_measurements[i] == 0) ? SickScan::SICK_SCAN_FLAG_NO_RETURN : SickScan::SICK_SCAN_FLAG_NONE);
+
+    }
+
+    /* Beam j was taken by partial scan j % n, at position j / n within it */
+    double start_angle = 0, scan_resolution = 0;
+    _sick_lms._getSickBeamLayout(0,0,start_angle,scan_resolution);
+    sick_scan.FillAngles(0,num_beams,start_angle,scan_resolution);
+
+    const unsigned int num_partial_scans = interlaced_scan.sick_num_partial_scans;
+    const double scan_period = 1e6/SickLMS2xx::SICK_MIRROR_FREQUENCY;
+    const double beam_period = scan_period*num_partial_scans*scan_resolution/360.0;
+
+    float * const time_offsets = sick_scan.GetTimeOffsets();
+    for (unsigned int j = 0; j < num_beams; j++) {
+      time_offsets[j] = (float)(interlaced_scan.sick_revolution_offsets[j % num_partial_scans]*scan_period + (j / num_partial_scans)*beam_period);
+    }
+
+    /* Fill in the header */
+    SickScan::sick_scan_header_t &sick_scan_header = sick_scan.GetHeader();
+    sick_scan_header.sick_scan_index = interlaced_scan.sick_scan_index;
+    sick_scan_header.sick_device_timestamp = 0;
+    sick_scan_header.sick_scan_period = (float)scan_period;
+    sick_scan_header.sick_host_time = interlaced_scan.sick_recv_time;
+    sick_scan_header.sick_device_host_time = 0;
+
+    _sick_scan_head = (_sick_scan_head + 1) % (_sick_num_scan_buffers + 1);
+    _sick_num_pending_scans--;
+
+  }
+
+  /**
+   * \brief Unpins the operating mode. The device is left streaming partial scans.
+   */
+  void SickLMS2xxInterlacedScanAssembler::End( ) {
+    _sick_stream_session.End();
+  }
+
+  /**
+   * \brief Destructor
+   */
+  SickLMS2xxInterlacedScanAssembler::~SickLMS2xxInterlacedScanAssembler( ) {
+
+    End();
+
+    delete [] _sick_scans;
+    delete [] _sick_messages;
+    delete [] _sick_recv_times;
+
+  }
+
+  /**
+   * \brief Drains the buffered partial scans until a complete scan is pending
+   * \param timeout_value The time in usecs to wait for a complete scan
+   */
+  void SickLMS2xxInterlacedScanAssembler::_assembleNextScan( const unsigned int timeout_value ) throw( SickTimeoutException, SickIOException, SickThreadException ) {
+
+    struct timeval beg_time, end_time;
+    gettimeofday(&beg_time,NULL);
+
+    while (_sick_num_pending_scans == 0) {
+
+      /* Wait on the monitor for whatever time is left */
+      gettimeofday(&end_time,NULL);
+      const double elapsed_time = _sick_lms._computeElapsedTime(beg_time,end_time);
+      if (elapsed_time >= timeout_value) {
+	throw SickTimeoutException("SickLMS2xxInterlacedScanAssembler::_assembleNextScan: No complete scan was assembled in time!");
+      }
+
+      const unsigned int num_messages = _sick_lms._recvMessages(_sick_messages,_sick_recv_times,DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH,
+								(unsigned int)(timeout_value - elapsed_time));
+
+      for (unsigned int j = 0; j < num_messages; j++) {
+
+	/* Skip anything that isn't a scan (e.g. stale replies) */
+	if (_sick_messages[j].GetCommandCode() != 0xB0) {
+	  continue;
+	}
+
+	_sick_messages[j].GetPayload(_sick_payload_buffer);
+	_sick_lms._parseSickScanProfileB0(&_sick_payload_buffer[1],_sick_profile_b0);
+	_addPartialScan(_sick_profile_b0,_sick_recv_times[j]);
+
+      }
+
+    }
+
+  }
+
+  /**
+   * \brief Interleaves one partial scan into the scan being assembled
+   * \param &sick_scan_profile The parsed partial scan
+   * \param &recv_time Its receive time
+   */
+  void SickLMS2xxInterlacedScanAssembler::_addPartialScan( const SickLMS2xx::sick_lms_2xx_scan_profile_b0_t &sick_scan_profile, const struct timeval &recv_time ) {
+
+    const double scan_angle = _sick_lms._sick_operating_status.sick_scan_angle;
+    const double scan_resolution = _sick_lms._sick_operating_status.sick_scan_resolution/100.0;
+    const unsigned int num_values = sick_scan_profile.sick_num_measurements;
+
+    if (scan_resolution <= 0 || num_values == 0) {
+      return;
+    }
+
+    /* Number of partial scans per scan and the position of this one */
+    double start_angle = 0, step_angle = 0;
+    _sick_lms._getSickBeamLayout(num_values,sick_scan_profile.sick_partial_scan_index,start_angle,step_angle);
+
+    const unsigned int num_partial_scans = (unsigned int)(step_angle/scan_resolution + 0.5);
+    const unsigned int position = (unsigned int)(sick_scan_profile.sick_partial_scan_index*SICK_LMS_2XX_PARTIAL_SCAN_ANGLE_STEP/scan_resolution + 0.5);
+    if (num_partial_scans == 0 || num_partial_scans > SICK_LMS_2XX_MAX_NUM_PARTIAL_SCANS || position >= num_partial_scans) {
+      _sick_num_discarded_scans += (_sick_num_assembled > 0) ? 1 : 0;
+      _resetAssembly();
+      return;
+    }
+
+    const bool real_time_indices = _sick_lms._returningRealTimeIndices();
+    const uint8_t telegram_index = sick_scan_profile.sick_telegram_index;
+    const uint8_t real_time_index = sick_scan_profile.sick_real_time_scan_index;
+
+    /*
+     * A lost telegram, a repeat or a layout change ends the scan being assembled. Real-time
+     * indices are not checked since they skip whenever the link is slower than the mirror.
+     */
+    if (_sick_num_assembled > 0) {
+
+      const uint8_t telegram_step = (uint8_t)(telegram_index - _sick_last_telegram_index);
+      if (telegram_step != 1 || (_sick_assembly_mask & (1 << position)) || num_partial_scans != _sick_num_partial_scans) {
+	if (telegram_step > 1) {
+	  _sick_num_lost_partial_scans += telegram_step - 1;
+	}
+	_sick_num_discarded_scans++;
+	_resetAssembly();
+      }
+      else {
+	_sick_revolution_offset += (real_time_indices) ? (uint8_t)(real_time_index - _sick_last_real_time_index) : 1;
+      }
+
+    }
+
+    sick_lms_2xx_interlaced_scan_t &sick_scan = _sick_scans[(_sick_scan_head + _sick_num_pending_scans) % (_sick_num_scan_buffers + 1)];
+
+    if (_sick_num_assembled == 0) {
+
+      unsigned int num_measurements = (unsigned int)(scan_angle/scan_resolution + 0.5) + 1;
+      num_measurements = (num_measurements < SickLMS2xx::SICK_MAX_NUM_MEASUREMENTS) ? num_measurements : SickLMS2xx::SICK_MAX_NUM_MEASUREMENTS;
+
+      sick_scan.sick_num_measurements = num_measurements;
+      sick_scan.sick_num_partial_scans = num_partial_scans;
+      sick_scan.sick_scan_index = (real_time_indices) ? real_time_index : telegram_index;
+      memset(sick_scan.sick_measurements,0,num_measurements*sizeof(uint16_t));
+      memset(sick_scan.sick_field_values,0,num_measurements*sizeof(uint8_t));
+
+      _sick_num_partial_scans = num_partial_scans;
+      _sick_revolution_offset = 0;
+
+    }
+
+    /* Value i of the partial scan at position k is beam k + i*n */
+    const unsigned int num_measurements = sick_scan.sick_num_measurements;
+    for (unsigned int i = 0, j = position; i < num_values && j < num_measurements; i++, j += num_partial_scans) {
+      sick_scan.sick_measurements[j] = sick_scan_profile.sick_measurements[i];
+      sick_scan.sick_field_values[j] = (sick_scan_profile.sick_field_a_values[i] ? 0x01 : 0) |
+	                               (sick_scan_profile.sick_field_b_values[i] ? 0x02 : 0) |
+	                               (sick_scan_profile.sick_field_c_values[i] ? 0x04 : 0);
+    }
+
+    sick_scan.sick_revolution_offsets[position] = (uint16_t)_sick_revolution_offset;
+    sick_scan.sick_recv_time = recv_time;
+
+    _sick_assembly_mask |= 1 << position;
+    _sick_last_telegram_index = telegram_index;
+    _sick_last_real_time_index = real_time_index;
+    _sick_num_assembled++;
+
+    /* Publish the scan once every position is in */
+    if (_sick_num_assembled == num_partial_scans) {
+
+      if (_sick_num_pending_scans == _sick_num_scan_buffers) {
+	_sick_scan_head = (_sick_scan_head + 1) % (_sick_num_scan_buffers + 1);
+	_sick_num_dropped_scans++;
+      }
+      else {
+	_sick_num_pending_scans++;
+      }
+
+      _resetAssembly();
+
+    }
+
+  }
+
+} //namespace SickToolbox
@@ -0,0 +1,269 @@
+/*!
+ * \file SickLMS2xxStreamSession.cc
+ * \brief Implementation of class SickLMS2xxStreamSession.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+/* Auto-generated header */
+#include <sicktoolbox/SickConfig.hh>
+
+/* Implementation dependencies */
+#include <iostream>
+
+#include <sicktoolbox/SickLMS2xxStreamSession.hh>
+#include <sicktoolbox/SickLMS2xx.hh>
+#include <sicktoolbox/SickLMS2xxMessage.hh>
+#include <sicktoolbox/SickException.hh>
+#include <sicktoolbox/SickLogger.hh>
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \brief Primary constructor
+   * \param &sick_lms The (initialized) Sick LMS 2xx to be streamed
+   */
+  SickLMS2xxStreamSession::SickLMS2xxStreamSession( SickLMS2xx &sick_lms ) :
+    _sick_lms(sick_lms), _sick_stream_type(SICK_LMS_2XX_STREAM_VALUES), _sick_expected_command_code(0xB0) {
+
+    memset(_sick_payload_buffer,0,sizeof(_sick_payload_buffer));
+
+  }
+
+  /**
+   * \brief Switches the Sick into the requested stream and pins the operating mode
+   * \param stream_type The stream to be pinned
+   * \param sick_sample_size Number of scans to average (mean value streams only)
+   * \param sick_subrange_start_index Start index of the subrange (subrange streams only)
+   * \param sick_subrange_stop_index Stop index of the subrange (subrange streams only)
+   *
+   * NOTE: Calling Begin() on an active session re-pins it to the new stream.
+   */
+  void SickLMS2xxStreamSession::Begin( const sick_lms_2xx_stream_type_t stream_type,
+				       const uint8_t sick_sample_size,
+				       const uint16_t sick_subrange_start_index,
+				       const uint16_t sick_subrange_stop_index ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException ) {
+
+    /* Ensure the device is initialized */
+    if (!_sick_lms._sick_initialized) {
+      throw SickConfigException("SickLMS2xxStreamSession::Begin: Sick LMS is not initialized!");
+    }
+
+    /* Only one session may pin the device */
+    if (_sick_lms._sick_stream_session != NULL && _sick_lms._sick_stream_session != this) {
+      throw SickConfigException("SickLMS2xxStreamSession::Begin: Another stream session is active!");
+    }
+
+    /* Temporarily unpin so the mode can be switched */
+    _sick_lms._sick_stream_session = NULL;
+
+    try {
+
+      /* Switch into the requested stream (no-op if already there) */
+      switch (stream_type) {
+      case SICK_LMS_2XX_STREAM_VALUES:
+	_sick_lms._setSickOpModeMonitorStreamValues();
+	_sick_expected_command_code = 0xB0;
+	break;
+      case SICK_LMS_2XX_STREAM_RANGE_AND_REFLECT:
+	_sick_lms._setSickOpModeMonitorStreamRangeAndReflectivity();
+	_sick_expected_command_code = 0xC4;
+	break;
+      case SICK_LMS_2XX_STREAM_PARTIAL_SCAN:
+	_sick_lms._setSickOpModeMonitorStreamValuesFromPartialScan();
+	_sick_expected_command_code = 0xB0;
+	break;
+      case SICK_LMS_2XX_STREAM_MEAN_VALUES:
+	_sick_lms._setSickOpModeMonitorStreamMeanValues(sick_sample_size);
+	_sick_expected_command_code = 0xB6;
+	break;
+      case SICK_LMS_2XX_STREAM_VALUES_SUBRANGE:
+	_sick_lms._setSickOpModeMonitorStreamValuesSubrange(sick_subrange_start_index,sick_subrange_stop_index);
+	_sick_expected_command_code = 0xB7;
+	break;
+      case SICK_LMS_2XX_STREAM_MEAN_VALUES_SUBRANGE:
+	_sick_lms._setSickOpModeMonitorStreamMeanValuesSubrange(sick_sample_size,sick_subrange_start_index,sick_subrange_stop_index);
+	_sick_expected_command_code = 0xBF;
+	break;
+      default:
+	throw SickConfigException("SickLMS2xxStreamSession::Begin: Unrecognized stream type!");
+      }
+
+    }
+
+    /* Handle any config exceptions */
+    catch(SickConfigException &sick_config_exception) {
+      SICK_LOG_ERROR(sick_config_exception.what());
+      throw;
+    }
+
+    /* Handle a timeout exception */
+    catch(SickTimeoutException &sick_timeout_exception) {
+      SICK_LOG_ERROR(sick_timeout_exception.what());
+      throw;
+    }
+
+    /* Handle any I/O exceptions */
+    catch(SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+      throw;
+    }
+
+    /* Handle any thread exceptions */
+    catch(SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      throw;
+    }
+
+    /* Handle anything else */
+    catch(...) {
+      SICK_LOG_ERROR("SickLMS2xxStreamSession::Begin: Unknown exception!!!");
+      throw;
+    }
+
+    /* Pin the mode */
+    _sick_stream_type = stream_type;
+    _sick_lms._sick_stream_session = this;
+
+  }
+
+  /**
+   * \brief Receives the next scan of the pinned stream
+   * \param *measurement_values Destination buffer for the measured (or range) values
+   * \param &num_measurement_values Number of values stored in measurement_values
+   * \param *reflect_values Destination for reflectivity values (range and reflect stream only) (Default: NULL => Not wanted)
+   * \param *num_reflect_values Number of values stored in reflect_values (Default: NULL => Not wanted)
+   * \param *sick_telegram_index The telegram index of the scan (modulo: 256) (Default: NULL => Not wanted)
+   * \param *sick_real_time_scan_index The real time scan index of the scan (modulo: 256) (Default: NULL => Not wanted)
+   * \param *sick_partial_scan_index The partial scan index (partial scan stream only) (Default: NULL => Not wanted)
+   * \param timeout_value The time in usecs to wait for the scan
+   */
+  void SickLMS2xxStreamSession::GetNextScan( unsigned int * const measurement_values,
+					     unsigned int & num_measurement_values,
+					     unsigned int * const reflect_values,
+					     unsigned int * const num_reflect_values,
+					     unsigned int * const sick_telegram_index,
+					     unsigned int * const sick_real_time_scan_index,
+					     unsigned int * const sick_partial_scan_index,
+					     const unsigned int timeout_value ) throw( SickConfigException, SickTimeoutException, SickIOException ) {
+
+    /* Ensure the session still owns the device */
+    if (!IsActive()) {
+      throw SickConfigException("SickLMS2xxStreamSession::GetNextScan: Session is not active!");
+    }
+
+    /* Receive a data frame from the stream */
+    _sick_lms._recvMessage(_sick_response,timeout_value);
+
+    /* Check that our payload has the expected command byte */
+    if (_sick_response.GetCommandCode() != _sick_expected_command_code) {
+      throw SickIOException("SickLMS2xxStreamSession::GetNextScan: Unexpected message!");
+    }
+
+    /* Acquire the payload buffer */
+    _sick_response.GetPayload(_sick_payload_buffer);
+
+    uint8_t telegram_index = 0, real_time_scan_index = 0;
+
+    /* Parse the profile for the pinned stream */
+    switch (_sick_expected_command_code) {
+    case 0xB0:
+      _sick_lms._parseSickScanProfileB0(&_sick_payload_buffer[1],_sick_profile_b0);
+      _copyValues(_sick_profile_b0.sick_measurements,_sick_profile_b0.sick_num_measurements,measurement_values);
+      num_measurement_values = _sick_profile_b0.sick_num_measurements;
+      telegram_index = _sick_profile_b0.sick_telegram_index;
+      real_time_scan_index = _sick_profile_b0.sick_real_time_scan_index;
+      if (sick_partial_scan_index) {
+	*sick_partial_scan_index = _sick_profile_b0.sick_partial_scan_index;
+      }
+      break;
+    case 0xB6:
+      _sick_lms._parseSickScanProfileB6(&_sick_payload_buffer[1],_sick_profile_b6);
+      _copyValues(_sick_profile_b6.sick_measurements,_sick_profile_b6.sick_num_measurements,measurement_values);
+      num_measurement_values = _sick_profile_b6.sick_num_measurements;
+      telegram_index = _sick_profile_b6.sick_telegram_index;
+      real_time_scan_index = _sick_profile_b6.sick_real_time_scan_index;
+      break;
+    case 0xB7:
+      _sick_lms._parseSickScanProfileB7(&_sick_payload_buffer[1],_sick_profile_b7);
+      _copyValues(_sick_profile_b7.sick_measurements,_sick_profile_b7.sick_num_measurements,measurement_values);
+      num_measurement_values = _sick_profile_b7.sick_num_measurements;
+      telegram_index = _sick_profile_b7.sick_telegram_index;
+      real_time_scan_index = _sick_profile_b7.sick_real_time_scan_index;
+      break;
+    case 0xBF:
+      _sick_lms._parseSickScanProfileBF(&_sick_payload_buffer[1],_sick_profile_bf);
+      _copyValues(_sick_profile_bf.sick_measurements,_sick_profile_bf.sick_num_measurements,measurement_values);
+      num_measurement_values = _sick_profile_bf.sick_num_measurements;
+      telegram_index = _sick_profile_bf.sick_telegram_index;
+      real_time_scan_index = _sick_profile_bf.sick_real_time_scan_index;
+      break;
+    case 0xC4:
+      _sick_lms._parseSickScanProfileC4(&_sick_payload_buffer[1],_sick_profile_c4);
+      _copyValues(_sick_profile_c4.sick_range_measurements,_sick_profile_c4.sick_num_range_measurements,measurement_values);
+      num_measurement_values = _sick_profile_c4.sick_num_range_measurements;
+      if (reflect_values) {
+	_copyValues(_sick_profile_c4.sick_reflect_measurements,_sick_profile_c4.sick_num_reflect_measurements,reflect_values);
+      }
+      if (num_reflect_values) {
+	*num_reflect_values = _sick_profile_c4.sick_num_reflect_measurements;
+      }
+      telegram_index = _sick_profile_c4.sick_telegram_index;
+      real_time_scan_index = _sick_profile_c4.sick_real_time_scan_index;
+      break;
+    default:
+      break;
+    }
+
+    /* If requested, copy the telegram index */
+    if (sick_telegram_index) {
+      *sick_telegram_index = telegram_index;
+    }
+
+    /* If requested, copy the real time scan index */
+    if (sick_real_time_scan_index) {
+      *sick_real_time_scan_index = real_time_scan_index;
+    }
+
+  }
+
+  /**
+   * \brief Unpins the operating mode. The device is left in its current
+   *        stream so a following session/Get call of the same kind is free.
+   */
+  void SickLMS2xxStreamSession::End( ) {
+
+    if (IsActive()) {
+      _sick_lms._sick_stream_session = NULL;
+    }
+
+  }
+
+  /**
+   * \brief Destructor
+   */
+  SickLMS2xxStreamSession::~SickLMS2xxStreamSession( ) {
+    End();
+  }
+
+  /**
+   * \brief Widens the parsed 16-bit values into the caller's buffer
+   */
+  void SickLMS2xxStreamSession::_copyValues( const uint16_t * const src_values, const unsigned int num_values, unsigned int * const dest_values ) const {
+
+    for (unsigned int i = 0; i < num_values; i++) {
+      dest_values[i] = src_values[i];
+    }
+
+  }
+
+} //namespace SickToolbox
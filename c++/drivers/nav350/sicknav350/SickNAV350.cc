@@ -41,6 +41,8 @@
 #include "sicktoolbox/SickNAV350BufferMonitor.hh"
 #include "sicktoolbox/SickNAV350Utility.hh"
 #include "sicktoolbox/SickException.hh"
+#include "sicktoolbox/SickLogger.hh"
+#include "sicktoolbox/SickTrace.hh"
 
 using namespace std;
 /* Associate the namespace */
@@ -244,22 +246,22 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickNav350::Initialize - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickNav350::Initialize - Unknown exception!");
       throw;
     }
 
@@ -298,22 +300,22 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 
 		}catch(SickIOException &sick_io_exception){
 
-			std::cerr << sick_io_exception.what() << std::endl;
+			SICK_LOG_ERROR(sick_io_exception.what());
 			throw;
 
 		}catch(SickThreadException &sick_thread_exception){
 
-			std::cerr << sick_thread_exception.what() << std::endl;
+			SICK_LOG_ERROR(sick_thread_exception.what());
 			throw;
 
 		}catch(SickTimeoutException &sick_timeout_exception){
 
-			std::cerr << sick_timeout_exception.what() << std::endl;
+			SICK_LOG_ERROR(sick_timeout_exception.what());
 			throw;
 
 		}catch(...){
 
-			std::cerr << "SickNav350::Uninitialize - Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::Uninitialize - Unknown exception!");
 			throw;
 
 		}
@@ -502,17 +504,17 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickNav350::_setupConnection - Unknown exception occurred!" << std::endl;
+      SICK_LOG_ERROR("SickNav350::_setupConnection - Unknown exception occurred!");
       throw;
     }
 
@@ -539,25 +541,25 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* Handle a returned error code */
     catch (SickErrorException &sick_error_exception) {
-      std::cerr << sick_error_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_error_exception.what());
       throw;
     }
 
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }
 
@@ -582,19 +584,19 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 
     /* Handle a timeout! */
     catch (SickTimeoutException &sick_timeout_exception) {
-      std::cerr << sick_timeout_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_timeout_exception.what());
       throw;
     }
 
     /* Handle I/O exceptions */
     catch (SickIOException &sick_io_exception) {
-      std::cerr << sick_io_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_io_exception.what());
       throw;
     }
 
     /* A safety net */
     catch (...) {
-      std::cerr << "SickLMS::_setSickSensorMode: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLMS::_setSickSensorMode: Unknown exception!!!");
       throw;
     }
 
@@ -632,17 +634,17 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
     }
 
     catch(SickTimeoutException &sick_timeout_exception) {
-      std::cerr << "sick_timeout_exception" << std::endl;
+      SICK_LOG_ERROR("sick_timeout_exception");
       throw;
     }
 
     catch(SickIOException &sick_io_exception) {
-      std::cerr << "sick_io_exception" << std::endl;
+      SICK_LOG_ERROR("sick_io_exception");
       throw;
     }
 
     catch(...) {
-      std::cerr << "SickNav350::_getSickStatus - Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickNav350::_getSickStatus - Unknown exception!");
       throw;
     }
 
@@ -685,19 +687,19 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 
       /* Handle a timeout! */
       catch (SickTimeoutException &sick_timeout_exception) {
-        std::cerr << sick_timeout_exception.what() << std::endl;
+        SICK_LOG_ERROR(sick_timeout_exception.what());
         throw;
       }
 
       /* Handle write buffer exceptions */
       catch (SickIOException &sick_io_exception) {
-        std::cerr << sick_io_exception.what() << std::endl;
+        SICK_LOG_ERROR(sick_io_exception.what());
         throw;
       }
 
       /* A safety net */
       catch (...) {
-        std::cerr << "SickLMS::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+        SICK_LOG_ERROR("SickLMS::_sendMessageAndGetReply: Unknown exception!!!");
         throw;
       }
 
@@ -748,18 +750,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_exception");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_getSickStatus - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_getSickStatus - Unknown exception!");
 	      throw;
 	    }
 
@@ -800,18 +802,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_exception");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_getSickStatus - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_getSickStatus - Unknown exception!");
 	      throw;
 	    }
 
@@ -853,18 +855,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_exception");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_getSickStatus - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_getSickStatus - Unknown exception!");
 	      throw;
 	    }
 
@@ -906,18 +908,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_exception");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_getSickStatus - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_getSickStatus - Unknown exception!");
 	      throw;
 	    }
 
@@ -971,18 +973,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 	    }
 
 	    catch(...) {
-			std::cerr << "SickNav350::_set operating mode - Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::_set operating mode - Unknown exception!");
 			throw;
 		}
 
@@ -1052,18 +1054,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::_setLandmarkDataFormat - Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::_setLandmarkDataFormat - Unknown exception!");
 			throw;
 		}
 
@@ -1115,18 +1117,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::_setReflectorThreshold - Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::_setReflectorThreshold - Unknown exception!");
 			throw;
 		}
 
@@ -1173,21 +1175,21 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 
 	  catch(SickTimeoutException &sick_timeout_exception) {
 
-		  std::cerr << "sick_timeout_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_timeout_exception");
 		  throw;
 
 	  }
 
 	  catch(SickIOException &sick_io_exception) {
 
-		  std::cerr << "sick_io_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_io_exception");
 		  throw;
 
 	  }
 
 	  catch(...) {
 
-		  std::cerr << "SickNav350::_set current layer - Unknown exception!" << std::endl;
+		  SICK_LOG_ERROR("SickNav350::_set current layer - Unknown exception!");
 		  throw;
 
 	  }
@@ -1278,18 +1280,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	}
 
 	catch(SickTimeoutException &sick_timeout_exception) {
-		std::cerr << "sick_timeout_exception" << std::endl;
+		SICK_LOG_ERROR("sick_timeout_exception");
 
 		throw;
 	}
 
 	catch(SickIOException &sick_io_exception) {
-		std::cerr << "sick_io_exception" << std::endl;
+		SICK_LOG_ERROR("sick_io_exception");
 		throw;
 	}
 
 	catch(...) {
-		std::cerr << "SickNav350::_set operating mode - Unknown exception!" << std::endl;
+		SICK_LOG_ERROR("SickNav350::_set operating mode - Unknown exception!");
 		throw;
 	}
 
@@ -1430,18 +1432,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  }
 
 	  catch(SickTimeoutException &sick_timeout_exception) {
-		  std::cerr << "sick_timeout_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_timeout_exception");
 
 		  throw;
 	  }
 
 	  catch(SickIOException &sick_io_exception) {
-		  std::cerr << "sick_io_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_io_exception");
 		  throw;
 	  }
 
 	  catch(...) {
-		  std::cerr << "SickNav350::_set current layer - Unknown exception!" << std::endl;
+		  SICK_LOG_ERROR("SickNav350::_set current layer - Unknown exception!");
 		  throw;
 	  }
 
@@ -1505,18 +1507,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 			}
 
 			catch(SickTimeoutException &sick_timeout_exception) {
-				std::cerr << "sick_timeout_exception" << std::endl;
+				SICK_LOG_ERROR("sick_timeout_exception");
 
 				throw;
 			}
 
 			catch(SickIOException &sick_io_exception) {
-				std::cerr << "sick_io_exception" << std::endl;
+				SICK_LOG_ERROR("sick_io_exception");
 				throw;
 			}
 
 			catch(...) {
-				std::cerr << "SickNav350::_set current layer - Unknown exception!" << std::endl;
+				SICK_LOG_ERROR("SickNav350::_set current layer - Unknown exception!");
 				throw;
 			}
 
@@ -1554,18 +1556,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::_ReadLayout - Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::_ReadLayout - Unknown exception!");
 			throw;
 		}
 
@@ -1646,21 +1648,21 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 
 	catch(SickTimeoutException &sick_timeout_exception) {
 
-		std::cerr << "sick_timeout_exception" << std::endl;
+		SICK_LOG_ERROR("sick_timeout_exception");
 		throw;
 
 	}
 
 	catch(SickIOException &sick_io_exception) {
 
-		std::cerr << "sick_io_exception" << std::endl;
+		SICK_LOG_ERROR("sick_io_exception");
 		throw;
 
 	}
 
 	catch(...) {
 
-		std::cerr << "SickNav350::_set operating mode - Unknown exception!" << std::endl;
+		SICK_LOG_ERROR("SickNav350::_set operating mode - Unknown exception!");
 		throw;
 
 	}
@@ -1714,18 +1716,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  }
 
 	  catch(SickTimeoutException &sick_timeout_exception) {
-		  std::cerr << "sick_timeout_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_timeout_exception");
 
 		  throw;
 	  }
 
 	  catch(SickIOException &sick_io_exception) {
-		  std::cerr << "sick_io_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_io_exception");
 		  throw;
 	  }
 
 	  catch(...) {
-		  std::cerr << "SickNav350::_set current layer - Unknown exception!" << std::endl;
+		  SICK_LOG_ERROR("SickNav350::_set current layer - Unknown exception!");
 		  throw;
 	  }
 
@@ -1786,18 +1788,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  }
 
 	  catch(SickTimeoutException &sick_timeout_exception) {
-		  std::cerr << "sick_timeout_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_timeout_exception");
 
 		  throw;
 	  }
 
 	  catch(SickIOException &sick_io_exception) {
-		  std::cerr << "sick_io_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_io_exception");
 		  throw;
 	  }
 
 	  catch(...) {
-		  std::cerr << "SickNav350::_set scan data format - Unknown exception!" << std::endl;
+		  SICK_LOG_ERROR("SickNav350::_set scan data format - Unknown exception!");
 		  throw;
 	  }
 
@@ -1849,18 +1851,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::- Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::- Unknown exception!");
 			throw;
 		}
 	}
@@ -1913,18 +1915,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::- Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::- Unknown exception!");
 			throw;
 		}
 	}
@@ -1987,18 +1989,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::- Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::- Unknown exception!");
 			throw;
 		}
 	}
@@ -2053,18 +2055,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::- Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::- Unknown exception!");
 			throw;
 		}
 	}
@@ -2105,18 +2107,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::- Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::- Unknown exception!");
 			throw;
 		}
 	}
@@ -2207,18 +2209,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::- Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::- Unknown exception!");
 			throw;
 		}
 	}
@@ -2316,18 +2318,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		}
 
 		catch(SickTimeoutException &sick_timeout_exception) {
-			std::cerr << "sick_timeout_exception" << std::endl;
+			SICK_LOG_ERROR("sick_timeout_exception");
 
 			throw;
 		}
 
 		catch(SickIOException &sick_io_exception) {
-			std::cerr << "sick_io_exception" << std::endl;
+			SICK_LOG_ERROR("sick_io_exception");
 			throw;
 		}
 
 		catch(...) {
-			std::cerr << "SickNav350::_set access mode - Unknown exception!" << std::endl;
+			SICK_LOG_ERROR("SickNav350::_set access mode - Unknown exception!");
 			throw;
 		}
 
@@ -2390,18 +2392,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  }
 
 	  catch(SickTimeoutException &sick_timeout_exception) {
-		  std::cerr << "sick_timeout_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_timeout_exception");
 
 		  throw;
 	  }
 
 	  catch(SickIOException &sick_io_exception) {
-		  std::cerr << "sick_io_exception" << std::endl;
+		  SICK_LOG_ERROR("sick_io_exception");
 		  throw;
 	  }
 
 	  catch(...) {
-		  std::cerr << "SickNav350::_set access mode - Unknown exception!" << std::endl;
+		  SICK_LOG_ERROR("SickNav350::_set access mode - Unknown exception!");
 		  throw;
 	  }
 
@@ -2452,18 +2454,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_except=0;ion" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_except=0;ion");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_get data - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_get data - Unknown exception!");
 	      throw;
 	    }
   }
@@ -2515,18 +2517,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_except=0;ion" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_except=0;ion");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_get data - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_get data - Unknown exception!");
 	      throw;
 	    }
   }
@@ -2556,15 +2558,16 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
   }
   void SickNav350::_ParseScanData()
   {
+	  SICK_TRACE_SCOPE_ARG("SickNav350::_ParseScanData",_sick_fd);
 	  int count=0;
 	  if (arg[3]!="0")
 	  {
-		  std::cout<<"Scan data unsuccesfull"<<std::endl;
+		  SICK_LOG_WARN("Scan data unsuccesfull");
 		  return;
 	  }
 	  if (arg[5]<"1")
 	  {
-		 std::cout<<"Wrong selected signals"<<std::endl;
+		 SICK_LOG_WARN("Wrong selected signals");
 		 return;
 	  }
 	  count=6;
@@ -2585,7 +2588,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  switch (atoi(arg[count++].c_str()))
 	  {
 	  case 0:
-		  std::cout<<"No scan data"<<std::endl;
+		  SICK_LOG_DEBUG("No scan data");
 		  break;
 	  case 1:
 //		  std::cout<<"One output channel"<<std::endl;
@@ -2617,7 +2620,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		  }
 		  break;
 	  case 2:
-		  std::cout<<"Two output channels"<<std::endl;
+		  SICK_LOG_DEBUG("Two output channels");
 		  break;
 	  }
 
@@ -2625,6 +2628,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
   }
   void SickNav350::_ParseScanDataLandMark()
   {
+	  SICK_TRACE_SCOPE_ARG("SickNav350::_ParseScanDataLandMark",_sick_fd);
 /*	  for (int i=0;i<this->argumentcount_;i++)
 	  {
 		  std::cout<<" "<<arg[i];
@@ -2633,12 +2637,12 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  int count=0;
 	  if (arg[3]!="0")
 	  {
-		  std::cout<<"Scan data unsuccessful"<<std::endl;
+		  SICK_LOG_WARN("Scan data unsuccessful");
 		  return;
 	  }
 	  if (arg[5]<"1")
 	  {
-		 std::cout<<"Wrong selected signals"<<std::endl;
+		 SICK_LOG_WARN("Wrong selected signals");
 		 return;
 	  }
 	  count=6;
@@ -2652,11 +2656,11 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  }*/
 	  if (arg[count++]=="1")
 	  {
-		  std::cout<<"\nLandmark data follow"<<std::endl;
-		  std::cout<<"Landmark filter "<<
-				 arg[count++] <<std::endl;
+		  SICK_LOG_DEBUG("Landmark data follow");
+		  SICK_LOG_DEBUG("Landmark filter " << arg[count]);
+		  count++;
 		  int refcount=atoi(arg[count++].c_str());
-		  std::cout<<"reflector count: "<<refcount<<"\n" <<std::endl;
+		  SICK_LOG_DEBUG("reflector count: "<<refcount);
 		  for (int i=0;i<refcount;i++)
 		  {
 			  if (arg[count++]=="0")
@@ -2665,12 +2669,12 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 			  }
 			  else
 			  {
-				  std::cout<<"Cartesian"<<std::endl;
+				  SICK_LOG_DEBUG("Cartesian");
           int x = atoi(arg[count++].c_str());
           int y = atoi(arg[count++].c_str());
 				  //arg[count++];
 				  //arg[count++];
-          std::cout << "[" << x << "," << y << "]" << std::endl;
+          SICK_LOG_DEBUG("[" << x << "," << y << "]");
 
 			  }
 			  if (arg[count++]=="0")
@@ -2699,7 +2703,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  switch (atoi(arg[count++].c_str()))
 	  {
 	  case 0:
-		  std::cout<<"No scan data"<<std::endl;
+		  SICK_LOG_DEBUG("No scan data");
 		  break;
 	  case 1:
 		  //std::cout<<"One output channel"<<std::endl;
@@ -2731,7 +2735,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		  }
 		  break;
 	  case 2:
-		  std::cout<<"Two output channels"<<std::endl;
+		  SICK_LOG_DEBUG("Two output channels");
 		  break;
 	  }
 
@@ -2804,6 +2808,69 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  *sector_start_timestamp=MeasuredData_->timestamp_start;
 	  *sector_stop_timestamp=MeasuredData_->timestamp_start;
   }
+  /**
+   * \brief Copies the last measurements (see GetDataNavigation) into a SickScan
+   * \param sick_scan The destination scan
+   * \param with_remission Whether the last request included remission data (Default: false)
+   *
+   * NOTE: Ranges are given in meters and time offsets assume the nominal motor speed.
+   */
+  void SickNav350::GetSickScan(SickScan &sick_scan,const bool with_remission)
+  {
+	  const unsigned int num_beams=MeasuredData_->num_data_points;
+	  try {
+		  sick_scan.Resize(num_beams);
+	  }
+	  catch (std::bad_alloc &) {
+		  throw SickIOException("SickNav350::GetSickScan: Failed to allocate scan storage!");
+	  }
+
+	  float *range_values=sick_scan.GetRangeValues();
+	  float *intensity_values=sick_scan.GetIntensityValues();
+	  uint32_t *flag_values=sick_scan.GetFlagValues();
+	  for (unsigned int i=0;i<num_beams;i++)
+	  {
+		  /* Ranges are given in mm */
+		  range_values[i]=(float)MeasuredData_->range_values[i]*0.001f;
+		  intensity_values[i]=(with_remission) ? (float)MeasuredData_->echo_values[i] : 0;
+		  flag_values[i]=(MeasuredData_->range_values[i]==0) ? SickScan::SICK_SCAN_FLAG_NO_RETURN : SickScan::SICK_SCAN_FLAG_NONE;
+	  }
+
+	  const double scan_period=1e6/SICK_MAX_MOTOR_SPEED;
+	  sick_scan.FillAngles(0,num_beams,MeasuredData_->angle_start,MeasuredData_->angle_step);
+	  sick_scan.FillTimeOffsets(0,num_beams,0,scan_period*MeasuredData_->angle_step/360.0);
+
+	  SickScan::sick_scan_header_t &sick_scan_header=sick_scan.GetHeader();
+	  sick_scan_header.sick_scan_index=0;
+	  sick_scan_header.sick_device_timestamp=MeasuredData_->timestamp_start;
+	  sick_scan_header.sick_scan_period=(float)scan_period;
+	  gettimeofday(&sick_scan_header.sick_host_time,NULL);
+	  sick_scan_header.sick_device_host_time = 0;
+  }
+
+  /**
+   * \brief Projects the last measurements (see GetDataNavigation) into Cartesian points
+   * \param x_values A buffer to hold the x coordinates (m)
+   * \param y_values A buffer to hold the y coordinates (m)
+   * \param z_values A buffer to hold the z coordinates, always 0 (NULL => not wanted)
+   * \param num_points The number of points written (one per measurement)
+   *
+   * NOTE: The cos/sin table is only recomputed when the sector's start angle,
+   *       step angle or number of measurements changes.
+   */
+  void SickNav350::GetSickScanAsPoints(float* x_values,float* y_values,float* z_values,unsigned int *num_points)
+  {
+	  try {
+		  _sick_projection_table.Update(MeasuredData_->angle_start,MeasuredData_->angle_step,MeasuredData_->num_data_points);
+	  }
+	  catch (std::bad_alloc &) {
+		  throw SickIOException("SickNav350::GetSickScanAsPoints: Failed to allocate projection table!");
+	  }
+
+	  /* Ranges are given in mm */
+	  _sick_projection_table.Project(MeasuredData_->range_values,MeasuredData_->num_data_points,0.001f,x_values,y_values,z_values);
+	  *num_points=MeasuredData_->num_data_points;
+  }
   void SickNav350::GetResponseFromCustomMessage(uint8_t *req,int req_size,uint8_t *res,int* res_size)
   {
 	    SickNav350Message send_message(req,req_size);
@@ -2822,18 +2889,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_except=0;isector_data_tagon" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_except=0;isector_data_tagon");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_get data - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_get data - Unknown exception!");
 	      throw;
 	    }
 
@@ -2885,18 +2952,18 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	    }
 
 	    catch(SickTimeoutException &sick_timeout_exception) {
-	      std::cerr << "sick_timeout_except=0;ion" << std::endl;
+	      SICK_LOG_ERROR("sick_timeout_except=0;ion");
 
 	      throw;
 	    }
 
 	    catch(SickIOException &sick_io_exception) {
-	      std::cerr << "sick_io_exception" << std::endl;
+	      SICK_LOG_ERROR("sick_io_exception");
 	      throw;
 	    }
 
 	    catch(...) {
-	      std::cerr << "SickNav350::_get data - Unknown exception!" << std::endl;
+	      SICK_LOG_ERROR("SickNav350::_get data - Unknown exception!");
 	      throw;
 	    }
   }
@@ -3018,7 +3085,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
       _sendMessageAndGetReply(send_message,recv_message);
 
     }catch(...){
-      std::cerr << "SickNav350::setSpeed - Unknow Exception!" << std::endl;
+      SICK_LOG_ERROR("SickNav350::setSpeed - Unknow Exception!");
       throw;
     }
 
@@ -3026,6 +3093,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
   }
   void SickNav350::_ParseScanDataNavigation()
   {
+	  SICK_TRACE_SCOPE_ARG("SickNav350::_ParseScanDataNavigation",_sick_fd);
 /*	  for (int i=0;i<this->argumentcount_;i++)
 	  {
 		  std::cout<<" "<<arg[i];
@@ -3067,7 +3135,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 			  PoseData_.meanDeviation=_ConvertHexToDec(arg[count++]);
 			  PoseData_.positionMode=_ConvertHexToDec(arg[count++]);
         std::string message = arg[count++];
-        std::cout << message << std::endl;
+        SICK_LOG_DEBUG(message);
 			  PoseData_.infoState= _ConvertHexToDec(message);
 			  PoseData_.numUsedReflectors=_ConvertHexToDec(arg[count++]);
 		  }
@@ -3141,7 +3209,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 	  switch (atoi(arg[count++].c_str()))
 	  {
 	  case 0:
-		  std::cout<<"No scan data"<<std::endl;
+		  SICK_LOG_DEBUG("No scan data");
 		  break;
 	  case 1:
 		  if (arg[count++]=="DIST1")
@@ -3170,7 +3238,7 @@ const std::string SickNav350::SETPOSEID_COMMAND="mNPOSSetPoseID";
 		  }
 		  break;
 	  case 2:
-		  std::cout<<"Two output channels"<<std::endl;
+		  SICK_LOG_DEBUG("Two output channels");
 		  break;
 	  }
     if(arg[count++] == "1"){
@@ -24,6 +24,7 @@
 #include "sicktoolbox/SickNAV350BufferMonitor.hh"
 #include "sicktoolbox/SickNAV350Message.hh"
 #include "sicktoolbox/SickException.hh"
+#include "sicktoolbox/SickLogger.hh"
 #include "sicktoolbox/SickNAV350Utility.hh"
 
 /* Associate the namespace */
@@ -52,84 +53,66 @@ namespace SickToolbox {
     uint32_t payload_length = 0;
 	int8_t succ=0;
 
-    try {
-
-      /* Search for the header in the byte stream */
-      for (unsigned int i = 0; i < sizeof(sick_response_header);) {
-    	  /* Acquire the next byte from the stream */
-    	  _readBytes(&byte_buffer,1,DEFAULT_SICK_BYTE_TIMEOUT);
-//    	  std::cout<<byte_buffer<<" test"<<std::endl;
-    	  /* Check if the current byte matches the expected header byte */
-
+    /* Search for the header in the byte stream */
+    unsigned int bytes_searched = 0;
+    for (unsigned int i = 0; i < sizeof(sick_response_header); bytes_searched++) {
+      /* Acquire the next byte from the stream (a timeout is ok!) */
+      if (_readTimedOut(_tryReadBytes(&byte_buffer,1,DEFAULT_SICK_BYTE_TIMEOUT))) {
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched);
+	return;
+      }
 
-    	  if (byte_buffer == sick_response_header[i]) {
-    		  i++;
-    	  }
-    	  else {
-    		  i = 0;
-    	  }
+      /* Check if the current byte matches the expected header byte */
+      if (byte_buffer == sick_response_header[i]) {
+	i++;
+      }
+      else {
+	i = 0;
+      }
 	
-      }  
-      /* Populate message buffer w/ response header */
-      memcpy(message_buffer,sick_response_header,1);
+    }  
+    /* Anything ahead of the header was skipped */
+    _sick_metrics.Increment(SickMetrics::SICK_METRICS_RESYNC_BYTES,bytes_searched - sizeof(sick_response_header));
 
+    /* Populate message buffer w/ response header */
+    memcpy(message_buffer,sick_response_header,1);
 
-      /* Search for the header in the byte stream */
-      for (unsigned int i = 0; i <SICK_NAV350_MSG_PAYLOAD_MAX_LEN+1;i++) {
-//		std::cout<<i<<std::endl;
-    	  /* Acquire the next byte from the stream */
-    	  _readBytes(&byte_buffer,1,DEFAULT_SICK_BYTE_TIMEOUT*10);
- //   	  if (i%100==0)
-//    	  std::cout<<byte_buffer<<" "<<i<<" ";
-	
-    	  /* Check if the current byte matches the expected header byte */
-    	  message_buffer[i+1]=byte_buffer;
-    	  if (byte_buffer == sick_response_trailer[0]) {
-    		  succ=1;
-    		  break;
-    	  }
-    	  payload_length++;
 
+    /* Search for the trailer in the byte stream */
+    for (unsigned int i = 0; i < SICK_NAV350_MSG_PAYLOAD_MAX_LEN-1; i++) {
+      /* Acquire the next byte from the stream */
+      if (_readTimedOut(_tryReadBytes(&byte_buffer,1,DEFAULT_SICK_BYTE_TIMEOUT*10))) {
+	return;
       }
-      if (succ==0)
-      {
-    	  std::cout<<"Incorrect message"<<std::endl;
-    	  return;
+	
+      /* Check if the current byte matches the expected trailer byte */
+      message_buffer[i+1]=byte_buffer;
+      if (byte_buffer == sick_response_trailer[0]) {
+	succ=1;
+	break;
       }
-      
-      /* Build the return message object based upon the received payload
-       * and compute the associated checksum.
-       *
-       * NOTE: In constructing this message we ignore the header bytes
-       *       buffered since the BuildMessage routine will insert the
-       *       correct header automatically and compute the payload's
-       *       checksum for us. We could probably get away with using
-       *       just ParseMessage here and not computing the checksum as
-       *       we are using TCP.  However, its safer this way.
-       */
-      sick_message.BuildMessage(&message_buffer[SickNav350Message::MESSAGE_HEADER_LENGTH],payload_length);
-      
-//      std::cout<<"success"<<std::endl;
-      /* Success */
+      payload_length++;
 
     }
-
-    catch(SickTimeoutException &sick_timeout) { /* This is ok! */ }
-    
-    /* Catch a bad checksum! */
-    catch(SickBadChecksumException &sick_checksum_exception) {
-      sick_message.Clear(); // Clear the message container
-    }
-    
-    /* Catch any serious IO buffer exceptions */
-    catch(SickIOException &sick_io_exception) {
-      throw;
-    }
-
-    /* A sanity check */
-    catch (...) {
-      throw;
+    if (succ==0)
+    {
+      SICK_LOG_WARN("SickNav350BufferMonitor::GetNextMessageFromDataStream: Incorrect message");
+      return;
     }
+      
+    /* Build the return message object based upon the received payload
+     * and compute the associated checksum.
+     *
+     * NOTE: In constructing this message we ignore the header bytes
+     *       buffered since the BuildMessage routine will insert the
+     *       correct header automatically and compute the payload's
+     *       checksum for us. We could probably get away with using
+     *       just ParseMessage here and not computing the checksum as
+     *       we are using TCP.  However, its safer this way.
+     */
+    sick_message.BuildMessage(&message_buffer[SickNav350Message::MESSAGE_HEADER_LENGTH],payload_length);
+      
+    /* Success */
     
   }
   
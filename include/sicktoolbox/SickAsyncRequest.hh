@@ -0,0 +1,569 @@
+/*!
+ * \file SickAsyncRequest.hh
+ * \brief Defines a simple completion object for issuing Sick
+ *        driver requests without blocking the calling thread.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_ASYNC_REQUEST
+#define SICK_ASYNC_REQUEST
+
+/* Dependencies */
+#include <string>
+#include <iostream>
+#include <pthread.h>
+#include <errno.h>
+#include <sys/time.h>
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  class SickAsyncRequest;
+
+  /**
+   * \typedef sick_async_callback_t
+   * \brief Signature of the (optional) completion callback. The callback
+   *        is invoked from the request thread once the request is done.
+   */
+  typedef void (*sick_async_callback_t)( SickAsyncRequest &sick_request, void * const user_data );
+
+  /**
+   * \class SickAsyncRequest
+   * \brief Runs a single blocking driver request (e.g. a configuration call
+   *        that goes through _sendMessageAndGetReply) on its own thread. The
+   *        device's buffer monitor keeps collecting replies, so the caller can
+   *        poll, wait or be notified via callback while the request retries.
+   *
+   * NOTE: Requests against the same device are not serialized against each
+   *       other. Issue at most one outstanding request per device and do not
+   *       touch the device from other threads until it completes.
+   */
+  class SickAsyncRequest {
+
+  public:
+
+    /** Request states */
+    enum sick_async_status_t {
+      SICK_ASYNC_STATUS_IDLE,                                        ///< Request has not been started
+      SICK_ASYNC_STATUS_PENDING,                                     ///< Request is in flight
+      SICK_ASYNC_STATUS_SUCCEEDED,                                   ///< Request completed w/o error
+      SICK_ASYNC_STATUS_FAILED                                       ///< Request threw an exception
+    };
+
+    /** Exception type captured from a failed request */
+    enum sick_async_error_t {
+      SICK_ASYNC_ERROR_NONE,                                         ///< No error
+      SICK_ASYNC_ERROR_TIMEOUT,                                      ///< SickTimeoutException
+      SICK_ASYNC_ERROR_IO,                                           ///< SickIOException
+      SICK_ASYNC_ERROR_CONFIG,                                       ///< SickConfigException
+      SICK_ASYNC_ERROR_ERROR,                                        ///< SickErrorException
+      SICK_ASYNC_ERROR_THREAD,                                       ///< SickThreadException
+      SICK_ASYNC_ERROR_CHECKSUM,                                     ///< SickBadChecksumException
+      SICK_ASYNC_ERROR_UNKNOWN                                       ///< Anything else
+    };
+
+    /** A standard constructor */
+    SickAsyncRequest( ) throw( SickThreadException );
+
+    /** Launch the request (optionally registering a completion callback) */
+    void Start( sick_async_callback_t callback = NULL, void * const user_data = NULL ) throw( SickThreadException );
+
+    /** Returns true once the request has finished (successfully or not) */
+    bool IsDone( ) throw( SickThreadException );
+
+    /** Block until the request finishes or the timeout (usecs, 0 = forever) expires */
+    bool Wait( const unsigned int timeout_value = 0 ) throw( SickThreadException );
+
+    /** Wait for completion and rethrow any exception raised by the request */
+    void Get( ) throw( SickTimeoutException, SickIOException, SickConfigException, SickErrorException, SickThreadException, SickBadChecksumException );
+
+    /** Get the current status of the request */
+    sick_async_status_t GetStatus( ) throw( SickThreadException );
+
+    /** Get the type of exception captured (if any) */
+    sick_async_error_t GetError( ) throw( SickThreadException );
+
+    /** Get the message of the captured exception (if any, w/o the exception's own prefix) */
+    std::string GetErrorString( ) throw( SickThreadException );
+
+    /** A standard destructor (joins the request thread) */
+    virtual ~SickAsyncRequest( );
+
+  protected:
+
+    /** The actual blocking request, executed on the request thread */
+    virtual void _execute( ) = 0;
+
+    /** Join the request thread (derived destructors must call this) */
+    void _joinRequestThread( );
+
+  private:
+
+    /** Request thread ID */
+    pthread_t _request_thread_id;
+
+    /** Indicates whether the request thread needs to be joined */
+    bool _request_thread_running;
+
+    /** A mutex guarding the request state */
+    pthread_mutex_t _request_mutex;
+
+    /** Signalled when the request completes */
+    pthread_cond_t _request_cond;
+
+    /** The current status */
+    sick_async_status_t _request_status;
+
+    /** The captured error type */
+    sick_async_error_t _request_error;
+
+    /** The captured error string */
+    std::string _request_error_str;
+
+    /** The completion callback */
+    sick_async_callback_t _request_callback;
+
+    /** User data passed to the completion callback */
+    void *_request_user_data;
+
+    /** Record completion and wake any waiters */
+    void _complete( const sick_async_error_t error, const std::string &error_str );
+
+    /** Entry point for the request thread */
+    static void * _requestThread( void * thread_args );
+
+    /** The message of an exception w/o the prefix its type adds */
+    template < class SICK_EXCEPTION_CLASS >
+    static std::string _detailedMessage( const SICK_EXCEPTION_CLASS &sick_exception );
+
+  };
+
+  /**
+   * \class SickAsyncMethod0
+   * \brief Asynchronously invokes a zero-argument driver method
+   */
+  template < class SICK_DEVICE_CLASS >
+  class SickAsyncMethod0 : public SickAsyncRequest {
+
+  public:
+
+    /** Type of the wrapped driver method */
+    typedef void (SICK_DEVICE_CLASS::*method_t)( );
+
+    /** Primary constructor */
+    SickAsyncMethod0( SICK_DEVICE_CLASS * const sick_device, const method_t method ) :
+      SickAsyncRequest(), _sick_device(sick_device), _method(method) { }
+
+    /** Destructor */
+    ~SickAsyncMethod0( ) { _joinRequestThread(); }
+
+  protected:
+
+    /** Invoke the method */
+    void _execute( ) { (_sick_device->*_method)(); }
+
+  private:
+
+    SICK_DEVICE_CLASS * const _sick_device;
+    const method_t _method;
+
+  };
+
+  /**
+   * \class SickAsyncMethod1
+   * \brief Asynchronously invokes a one-argument driver method
+   */
+  template < class SICK_DEVICE_CLASS, class ARG1 >
+  class SickAsyncMethod1 : public SickAsyncRequest {
+
+  public:
+
+    /** Type of the wrapped driver method */
+    typedef void (SICK_DEVICE_CLASS::*method_t)( ARG1 );
+
+    /** Primary constructor */
+    SickAsyncMethod1( SICK_DEVICE_CLASS * const sick_device, const method_t method, const ARG1 arg1 ) :
+      SickAsyncRequest(), _sick_device(sick_device), _method(method), _arg1(arg1) { }
+
+    /** Destructor */
+    ~SickAsyncMethod1( ) { _joinRequestThread(); }
+
+  protected:
+
+    /** Invoke the method */
+    void _execute( ) { (_sick_device->*_method)(_arg1); }
+
+  private:
+
+    SICK_DEVICE_CLASS * const _sick_device;
+    const method_t _method;
+    const ARG1 _arg1;
+
+  };
+
+  /**
+   * \class SickAsyncMethod2
+   * \brief Asynchronously invokes a two-argument driver method
+   */
+  template < class SICK_DEVICE_CLASS, class ARG1, class ARG2 >
+  class SickAsyncMethod2 : public SickAsyncRequest {
+
+  public:
+
+    /** Type of the wrapped driver method */
+    typedef void (SICK_DEVICE_CLASS::*method_t)( ARG1, ARG2 );
+
+    /** Primary constructor */
+    SickAsyncMethod2( SICK_DEVICE_CLASS * const sick_device, const method_t method, const ARG1 arg1, const ARG2 arg2 ) :
+      SickAsyncRequest(), _sick_device(sick_device), _method(method), _arg1(arg1), _arg2(arg2) { }
+
+    /** Destructor */
+    ~SickAsyncMethod2( ) { _joinRequestThread(); }
+
+  protected:
+
+    /** Invoke the method */
+    void _execute( ) { (_sick_device->*_method)(_arg1,_arg2); }
+
+  private:
+
+    SICK_DEVICE_CLASS * const _sick_device;
+    const method_t _method;
+    const ARG1 _arg1;
+    const ARG2 _arg2;
+
+  };
+
+  /**
+   * \class SickAsyncMethod3
+   * \brief Asynchronously invokes a three-argument driver method
+   *
+   * NOTE: Pointer arguments (e.g. sector angle arrays) are not copied and
+   *       must remain valid until the request completes.
+   */
+  template < class SICK_DEVICE_CLASS, class ARG1, class ARG2, class ARG3 >
+  class SickAsyncMethod3 : public SickAsyncRequest {
+
+  public:
+
+    /** Type of the wrapped driver method */
+    typedef void (SICK_DEVICE_CLASS::*method_t)( ARG1, ARG2, ARG3 );
+
+    /** Primary constructor */
+    SickAsyncMethod3( SICK_DEVICE_CLASS * const sick_device, const method_t method, const ARG1 arg1, const ARG2 arg2, const ARG3 arg3 ) :
+      SickAsyncRequest(), _sick_device(sick_device), _method(method), _arg1(arg1), _arg2(arg2), _arg3(arg3) { }
+
+    /** Destructor */
+    ~SickAsyncMethod3( ) { _joinRequestThread(); }
+
+  protected:
+
+    /** Invoke the method */
+    void _execute( ) { (_sick_device->*_method)(_arg1,_arg2,_arg3); }
+
+  private:
+
+    SICK_DEVICE_CLASS * const _sick_device;
+    const method_t _method;
+    const ARG1 _arg1;
+    const ARG2 _arg2;
+    const ARG3 _arg3;
+
+  };
+
+  /**
+   * \brief Primary constructor
+   */
+  inline SickAsyncRequest::SickAsyncRequest( ) throw( SickThreadException ) :
+    _request_thread_id(0), _request_thread_running(false), _request_status(SICK_ASYNC_STATUS_IDLE),
+    _request_error(SICK_ASYNC_ERROR_NONE), _request_callback(NULL), _request_user_data(NULL) {
+
+    /* Initialize the request state mutex */
+    if (pthread_mutex_init(&_request_mutex,NULL) != 0) {
+      throw SickThreadException("SickAsyncRequest::SickAsyncRequest: pthread_mutex_init() failed!");
+    }
+
+    /* Initialize the completion condition */
+    if (pthread_cond_init(&_request_cond,NULL) != 0) {
+      pthread_mutex_destroy(&_request_mutex);
+      throw SickThreadException("SickAsyncRequest::SickAsyncRequest: pthread_cond_init() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Launches the request thread
+   * \param callback An optional function invoked (on the request thread) upon completion
+   * \param user_data An opaque pointer handed to the callback
+   */
+  inline void SickAsyncRequest::Start( sick_async_callback_t callback, void * const user_data ) throw( SickThreadException ) {
+
+    /* Reap a previously completed run */
+    _joinRequestThread();
+
+    if (pthread_mutex_lock(&_request_mutex) != 0) {
+      throw SickThreadException("SickAsyncRequest::Start: pthread_mutex_lock() failed!");
+    }
+
+    _request_callback = callback;
+    _request_user_data = user_data;
+    _request_status = SICK_ASYNC_STATUS_PENDING;
+    _request_error = SICK_ASYNC_ERROR_NONE;
+    _request_error_str.clear();
+
+    pthread_mutex_unlock(&_request_mutex);
+
+    /* Spawn the request thread */
+    if (pthread_create(&_request_thread_id,NULL,SickAsyncRequest::_requestThread,this) != 0) {
+      _complete(SICK_ASYNC_ERROR_THREAD,"SickAsyncRequest::Start: pthread_create() failed!");
+      throw SickThreadException("SickAsyncRequest::Start: pthread_create() failed!");
+    }
+
+    _request_thread_running = true;
+
+  }
+
+  /**
+   * \brief Indicates whether the request has finished
+   * \return True if the request succeeded or failed, false otherwise
+   */
+  inline bool SickAsyncRequest::IsDone( ) throw( SickThreadException ) {
+    sick_async_status_t status = GetStatus();
+    return status == SICK_ASYNC_STATUS_SUCCEEDED || status == SICK_ASYNC_STATUS_FAILED;
+  }
+
+  /**
+   * \brief Blocks until the request completes
+   * \param timeout_value Max time to wait (usecs). A value of 0 waits forever.
+   * \return True if the request completed, false if the wait timed out
+   */
+  inline bool SickAsyncRequest::Wait( const unsigned int timeout_value ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_request_mutex) != 0) {
+      throw SickThreadException("SickAsyncRequest::Wait: pthread_mutex_lock() failed!");
+    }
+
+    /* Compute the absolute deadline */
+    struct timeval now;
+    struct timespec deadline;
+    gettimeofday(&now,NULL);
+    unsigned long long deadline_usecs = (unsigned long long)now.tv_sec*1000000 + now.tv_usec + timeout_value;
+    deadline.tv_sec = deadline_usecs/1000000;
+    deadline.tv_nsec = (deadline_usecs%1000000)*1000;
+
+    int ret = 0;
+    while (_request_status == SICK_ASYNC_STATUS_PENDING && ret != ETIMEDOUT) {
+      ret = (timeout_value > 0) ? pthread_cond_timedwait(&_request_cond,&_request_mutex,&deadline) :
+	                          pthread_cond_wait(&_request_cond,&_request_mutex);
+    }
+
+    bool done = (_request_status == SICK_ASYNC_STATUS_SUCCEEDED || _request_status == SICK_ASYNC_STATUS_FAILED);
+
+    pthread_mutex_unlock(&_request_mutex);
+
+    return done;
+
+  }
+
+  /**
+   * \brief Waits for the request and rethrows the captured exception (if any)
+   */
+  inline void SickAsyncRequest::Get( ) throw( SickTimeoutException, SickIOException, SickConfigException, SickErrorException, SickThreadException, SickBadChecksumException ) {
+
+    if (GetStatus() == SICK_ASYNC_STATUS_IDLE) {
+      throw SickThreadException("SickAsyncRequest::Get: Request was never started!");
+    }
+
+    Wait();
+
+    /* Rethrow as the original exception type */
+    switch (GetError()) {
+    case SICK_ASYNC_ERROR_NONE:
+      return;
+    case SICK_ASYNC_ERROR_TIMEOUT:
+      throw SickTimeoutException(GetErrorString());
+    case SICK_ASYNC_ERROR_IO:
+      throw SickIOException(GetErrorString());
+    case SICK_ASYNC_ERROR_CONFIG:
+      throw SickConfigException(GetErrorString());
+    case SICK_ASYNC_ERROR_ERROR:
+      throw SickErrorException(GetErrorString());
+    case SICK_ASYNC_ERROR_CHECKSUM:
+      throw SickBadChecksumException(GetErrorString());
+    default:
+      throw SickThreadException(GetErrorString());
+    }
+
+  }
+
+  /**
+   * \brief Returns the current request status
+   */
+  inline SickAsyncRequest::sick_async_status_t SickAsyncRequest::GetStatus( ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_request_mutex) != 0) {
+      throw SickThreadException("SickAsyncRequest::GetStatus: pthread_mutex_lock() failed!");
+    }
+
+    sick_async_status_t status = _request_status;
+    pthread_mutex_unlock(&_request_mutex);
+    return status;
+
+  }
+
+  /**
+   * \brief Returns the type of exception captured from the request
+   */
+  inline SickAsyncRequest::sick_async_error_t SickAsyncRequest::GetError( ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_request_mutex) != 0) {
+      throw SickThreadException("SickAsyncRequest::GetError: pthread_mutex_lock() failed!");
+    }
+
+    sick_async_error_t error = _request_error;
+    pthread_mutex_unlock(&_request_mutex);
+    return error;
+
+  }
+
+  /**
+   * \brief Returns the message of the exception captured from the request
+   */
+  inline std::string SickAsyncRequest::GetErrorString( ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_request_mutex) != 0) {
+      throw SickThreadException("SickAsyncRequest::GetErrorString: pthread_mutex_lock() failed!");
+    }
+
+    std::string error_str = _request_error_str;
+    pthread_mutex_unlock(&_request_mutex);
+    return error_str;
+
+  }
+
+  /**
+   * \brief The destructor
+   */
+  inline SickAsyncRequest::~SickAsyncRequest( ) {
+
+    /* Should already be joined by the derived class, this is a safety net */
+    _joinRequestThread();
+
+    pthread_cond_destroy(&_request_cond);
+    pthread_mutex_destroy(&_request_mutex);
+
+  }
+
+  /**
+   * \brief Joins the request thread if it has been started
+   */
+  inline void SickAsyncRequest::_joinRequestThread( ) {
+
+    if (_request_thread_running) {
+      pthread_join(_request_thread_id,NULL);
+      _request_thread_running = false;
+    }
+
+  }
+
+  /**
+   * \brief Records the request outcome, signals waiters and fires the callback
+   */
+  inline void SickAsyncRequest::_complete( const sick_async_error_t error, const std::string &error_str ) {
+
+    pthread_mutex_lock(&_request_mutex);
+    _request_error = error;
+    _request_error_str = error_str;
+    _request_status = (error == SICK_ASYNC_ERROR_NONE) ? SICK_ASYNC_STATUS_SUCCEEDED : SICK_ASYNC_STATUS_FAILED;
+    sick_async_callback_t callback = _request_callback;
+    void *user_data = _request_user_data;
+    pthread_cond_broadcast(&_request_cond);
+    pthread_mutex_unlock(&_request_mutex);
+
+    /* Notify the user (outside of the lock) */
+    if (callback) {
+      callback(*this,user_data);
+    }
+
+  }
+
+  /**
+   * \brief The request thread
+   * \param *thread_args The request instance
+   */
+  inline void * SickAsyncRequest::_requestThread( void * thread_args ) {
+
+    SickAsyncRequest *sick_request = (SickAsyncRequest *)thread_args;
+
+    try {
+      sick_request->_execute();
+      sick_request->_complete(SICK_ASYNC_ERROR_NONE,"");
+    }
+
+    /* Capture the exception so it can be rethrown by Get() */
+    catch(SickTimeoutException &sick_timeout_exception) {
+      sick_request->_complete(SICK_ASYNC_ERROR_TIMEOUT,_detailedMessage(sick_timeout_exception));
+    }
+
+    catch(SickIOException &sick_io_exception) {
+      sick_request->_complete(SICK_ASYNC_ERROR_IO,_detailedMessage(sick_io_exception));
+    }
+
+    catch(SickConfigException &sick_config_exception) {
+      sick_request->_complete(SICK_ASYNC_ERROR_CONFIG,_detailedMessage(sick_config_exception));
+    }
+
+    catch(SickErrorException &sick_error_exception) {
+      sick_request->_complete(SICK_ASYNC_ERROR_ERROR,_detailedMessage(sick_error_exception));
+    }
+
+    catch(SickThreadException &sick_thread_exception) {
+      sick_request->_complete(SICK_ASYNC_ERROR_THREAD,_detailedMessage(sick_thread_exception));
+    }
+
+    catch(SickBadChecksumException &sick_checksum_exception) {
+      sick_request->_complete(SICK_ASYNC_ERROR_CHECKSUM,_detailedMessage(sick_checksum_exception));
+    }
+
+    /* A safety net */
+    catch(...) {
+      sick_request->_complete(SICK_ASYNC_ERROR_UNKNOWN,"SickAsyncRequest::_requestThread: Unknown exception!");
+    }
+
+    return NULL;
+
+  }
+
+  /**
+   * \brief The message of an exception w/o the prefix its type adds
+   * \param &sick_exception The captured exception
+   *
+   * Get() rethrows through the same constructor, which adds the prefix again.
+   */
+  template < class SICK_EXCEPTION_CLASS >
+  inline std::string SickAsyncRequest::_detailedMessage( const SICK_EXCEPTION_CLASS &sick_exception ) {
+
+    const std::string prefix = SICK_EXCEPTION_CLASS("").what();
+    const std::string message = sick_exception.what();
+
+    if (message.compare(0,prefix.size(),prefix) == 0) {
+      return message.substr(prefix.size());
+    }
+
+    return message;
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_ASYNC_REQUEST */
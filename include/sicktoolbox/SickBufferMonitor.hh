@@ -16,15 +16,41 @@
 #ifndef SICK_BUFFER_MONITOR
 #define SICK_BUFFER_MONITOR
 
+/* Macros */
+#define DEFAULT_SICK_MONITOR_PREFAULT_STACK_SIZE (64*1024)  ///< Stack touched by the monitor thread on startup (when prefaulting)
+
 /* Dependencies */
 #include <iostream>
+#include <sstream>
+#include <string.h>
+#include <sched.h>
+#include <alloca.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <sys/time.h>
 #include "SickException.hh"
+#include "SickLogger.hh"
+#include "SickMetrics.hh"
+#include "SickTrace.hh"
 
 /* Associate the namespace */
 namespace SickToolbox {
 
+  /*!
+   * \struct sick_monitor_thread_config_tag
+   * \brief Scheduling configuration of a buffer monitor thread
+   *
+   * The defaults (see DefaultThreadConfig) match the original behaviour: an
+   * inherited policy, no pinning and the default stack.
+   */
+  typedef struct sick_monitor_thread_config_tag {
+    uint64_t sick_cpu_mask;                                            ///< CPUs the thread may run on (bit i => CPU i, 0 => inherit)
+    int sick_sched_policy;                                             ///< SCHED_OTHER, SCHED_FIFO or SCHED_RR
+    int sick_sched_priority;                                           ///< Static priority (SCHED_FIFO/SCHED_RR only)
+    size_t sick_stack_size;                                            ///< Thread stack size in bytes (0 => default)
+    bool sick_prefault;                                                ///< Touch the stack and message buffers before acquiring
+  } sick_monitor_thread_config_t;
+
   /**
    * \class SickBufferMonitor
    */
@@ -38,16 +64,39 @@ namespace SickToolbox {
 
     /** A method for setting the target data stream */
     void SetDataStream( const unsigned int sick_fd ) throw( SickThreadException );
+
+    /** Configure the scheduling of the monitor thread */
+    void SetThreadConfig( const sick_monitor_thread_config_t &thread_config ) throw( SickThreadException );
+
+    /** Get the scheduling configuration of the monitor thread */
+    sick_monitor_thread_config_t GetThreadConfig( ) const { return _thread_config; }
+
+    /** The default (inherited) scheduling configuration */
+    static sick_monitor_thread_config_t DefaultThreadConfig( );
     
     /** Start the buffer monitor for the device */
     void StartMonitor( const unsigned int sick_fd ) throw( SickThreadException );
 
     /** Acquire the most recent message buffered by the monitor */
-    bool GetNextMessageFromMonitor( SICK_MSG_CLASS &sick_message ) throw( SickThreadException );
+    bool GetNextMessageFromMonitor( SICK_MSG_CLASS &sick_message, struct timeval * const recv_time = NULL ) throw( SickThreadException );
+
+    /** Enable (depth > 0) or disable (depth = 0) the FIFO of received messages */
+    void SetMessageQueueDepth( const unsigned int queue_depth ) throw( SickThreadException );
+
+    /** Get the current depth of the message FIFO (0 => disabled) */
+    unsigned int GetMessageQueueDepth( ) const { return _recv_msg_queue_depth; }
+
+    /** Drain up to max_num_messages queued messages (oldest first) */
+    unsigned int GetMessagesFromMonitor( SICK_MSG_CLASS * const sick_messages,
+					 struct timeval * const recv_times,
+					 const unsigned int max_num_messages ) throw( SickThreadException );
     
     /** Stop the buffer monitor for the device */
     void StopMonitor( ) throw( SickThreadException );
 
+    /** Access the (live) metrics of the acquisition path */
+    SickMetrics & GetMetrics( ) { return _sick_metrics; }
+
     /** Locks access to the data stream */
     void AcquireDataStream( ) throw( SickThreadException );
 
@@ -62,11 +111,30 @@ namespace SickToolbox {
 
   protected:
 
+    /*!
+     * \enum sick_read_status_t
+     * \brief Outcome of a non-throwing stream read
+     */
+    enum sick_read_status_t {
+      SICK_READ_OK,                                                    ///< All requested bytes were read
+      SICK_READ_TIMEOUT,                                               ///< Timed out waiting on the next byte
+      SICK_READ_ERROR                                                  ///< select() or read() failed
+    };
+
     /** Sick data stream file descriptor */
     unsigned int _sick_fd;   
+
+    /** Counters and histograms of the acquisition path */
+    mutable SickMetrics _sick_metrics;
     
     /** Reads n bytes into the destination buffer */
     void _readBytes( uint8_t * const dest_buffer, const int num_bytes_to_read, const unsigned int timeout_value = 0 ) const throw ( SickTimeoutException, SickIOException );       
+
+    /** Reads n bytes into the destination buffer (reports failures w/o throwing) */
+    sick_read_status_t _tryReadBytes( uint8_t * const dest_buffer, const int num_bytes_to_read, const unsigned int timeout_value = 0 ) const throw ( );
+
+    /** Indicates whether framing should stop on a timeout (throws only on an I/O failure) */
+    bool _readTimedOut( const sick_read_status_t read_status ) const throw ( SickIOException );
     
   private:
 
@@ -79,6 +147,12 @@ namespace SickToolbox {
     /** Buffer monitor thread ID */
     pthread_t _monitor_thread_id;
 
+    /** Indicates whether the monitor thread is running */
+    bool _monitor_thread_running;
+
+    /** Scheduling configuration of the monitor thread */
+    sick_monitor_thread_config_t _thread_config;
+
     /** A mutex for guarding the message container */
     pthread_mutex_t _container_mutex;
 
@@ -88,12 +162,39 @@ namespace SickToolbox {
     /** A container to hold the most recent message */
     SICK_MSG_CLASS _recv_msg_container;      
 
+    /** Host time at which the contained message was framed */
+    struct timeval _recv_msg_container_time;
+
+    /** Optional FIFO of received messages (guarded by the container mutex) */
+    SICK_MSG_CLASS *_recv_msg_queue;
+
+    /** Host receive times of the queued messages */
+    struct timeval *_recv_msg_queue_times;
+
+    /** Capacity of the message FIFO */
+    unsigned int _recv_msg_queue_depth;
+
+    /** Index of the oldest queued message */
+    unsigned int _recv_msg_queue_head;
+
+    /** Number of queued messages */
+    unsigned int _recv_msg_queue_count;
+
     /** Locks access to the message container */
     void _acquireMessageContainer( ) throw( SickThreadException );
 
     /** Unlocks access to the message container */
     void _releaseMessageContainer( ) throw( SickThreadException );   
 
+    /** Applies the scheduling policy and affinity to a running thread */
+    void _applyThreadConfig( const pthread_t thread_id ) const throw( SickThreadException );
+
+    /** Fills in a CPU set from the configured mask */
+    void _buildCpuSet( cpu_set_t &cpu_set ) const;
+
+    /** Touches the stack and message buffers so acquisition doesn't page fault */
+    void _prefaultMemory( ) throw( SickThreadException );
+
     /** Entry point for the monitor thread */
     static void * _bufferMonitorThread( void * thread_args );    
     
@@ -105,7 +206,12 @@ namespace SickToolbox {
    */
   template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
   SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::SickBufferMonitor( SICK_MONITOR_CLASS * const monitor_instance ) throw( SickThreadException ) :
-    _sick_monitor_instance(monitor_instance), _continue_grabbing(true), _monitor_thread_id(0) {
+    _sick_monitor_instance(monitor_instance), _continue_grabbing(true), _monitor_thread_id(0), _monitor_thread_running(false),
+    _thread_config(DefaultThreadConfig()),
+    _recv_msg_queue(NULL), _recv_msg_queue_times(NULL), _recv_msg_queue_depth(0), _recv_msg_queue_head(0), _recv_msg_queue_count(0) {
+
+    /* Nothing has been framed yet */
+    memset(&_recv_msg_container_time,0,sizeof(_recv_msg_container_time));
     
     /* Initialize the shared message buffer mutex */
     if (pthread_mutex_init(&_container_mutex,NULL) != 0) {
@@ -141,17 +247,52 @@ namespace SickToolbox {
 
     /* Handle thread exception */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
     }
     
     /* A safety net */
     catch(...) {
-      std::cerr << "SickBufferMonitor::SetDataStream: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickBufferMonitor::SetDataStream: Unknown exception!");
       throw;
     }
     
   }
   
+  /**
+   * \brief Sets the scheduling configuration of the monitor thread
+   * \param &thread_config The new configuration
+   *
+   * NOTE: The policy, priority and affinity are applied to a running monitor
+   *       immediately. The stack size (and prefaulting) take effect the next
+   *       time the monitor is started (i.e. on Initialize).
+   */
+  template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  void SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::SetThreadConfig( const sick_monitor_thread_config_t &thread_config ) throw( SickThreadException ) {
+
+    _thread_config = thread_config;
+
+    if (_monitor_thread_running) {
+      _applyThreadConfig(_monitor_thread_id);
+    }
+
+  }
+
+  /**
+   * \brief The default scheduling configuration (inherit everything)
+   */
+  template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  sick_monitor_thread_config_t SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::DefaultThreadConfig( ) {
+
+    sick_monitor_thread_config_t thread_config;
+    thread_config.sick_cpu_mask = 0;
+    thread_config.sick_sched_policy = SCHED_OTHER;
+    thread_config.sick_sched_priority = 0;
+    thread_config.sick_stack_size = 0;
+    thread_config.sick_prefault = false;
+    return thread_config;
+
+  }
+
   /**
    * \brief Creates and starts the buffer monitor thread
    * \return True upon success, False otherwise
@@ -161,28 +302,79 @@ namespace SickToolbox {
 
     /* Assign the fd associated with the data stream */
     _sick_fd = sick_fd;
+
+    /* Set the flag to continue grabbing data (before the thread can check it) */
+    _continue_grabbing = true;
+
+    /* Build the thread attributes */
+    pthread_attr_t thread_attr;
+    if (pthread_attr_init(&thread_attr) != 0) {
+      throw SickThreadException("SickBufferMonitor::StartMonitor: pthread_attr_init() failed!");
+    }
+
+    /* The stack has to hold a few full messages */
+    if (_thread_config.sick_stack_size > 0 && pthread_attr_setstacksize(&thread_attr,_thread_config.sick_stack_size) != 0) {
+      pthread_attr_destroy(&thread_attr);
+      throw SickThreadException("SickBufferMonitor::StartMonitor: pthread_attr_setstacksize() failed!");
+    }
+
+    /* Start w/ the requested policy rather than the inherited one */
+    if (_thread_config.sick_sched_policy != SCHED_OTHER || _thread_config.sick_sched_priority != 0) {
+
+      struct sched_param sched_params;
+      memset(&sched_params,0,sizeof(sched_params));
+      sched_params.sched_priority = _thread_config.sick_sched_priority;
+
+      if (pthread_attr_setinheritsched(&thread_attr,PTHREAD_EXPLICIT_SCHED) != 0 ||
+	  pthread_attr_setschedpolicy(&thread_attr,_thread_config.sick_sched_policy) != 0 ||
+	  pthread_attr_setschedparam(&thread_attr,&sched_params) != 0) {
+	pthread_attr_destroy(&thread_attr);
+	throw SickThreadException("SickBufferMonitor::StartMonitor: Invalid scheduling policy/priority!");
+      }
+
+    }
+
+    /* Start on the requested CPUs */
+    if (_thread_config.sick_cpu_mask != 0) {
+
+      cpu_set_t cpu_set;
+      _buildCpuSet(cpu_set);
+
+      if (pthread_attr_setaffinity_np(&thread_attr,sizeof(cpu_set),&cpu_set) != 0) {
+	pthread_attr_destroy(&thread_attr);
+	throw SickThreadException("SickBufferMonitor::StartMonitor: pthread_attr_setaffinity_np() failed!");
+      }
+
+    }
     
-    /* Start the buffer monitor */
-    if (pthread_create(&_monitor_thread_id,NULL,SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_bufferMonitorThread,_sick_monitor_instance) != 0) {
-      throw SickThreadException("SickBufferMonitor::StartMonitor: pthread_create() failed!");
+    /* Start the buffer monitor (real-time policies typically need CAP_SYS_NICE) */
+    int create_result = pthread_create(&_monitor_thread_id,&thread_attr,SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_bufferMonitorThread,_sick_monitor_instance);
+    pthread_attr_destroy(&thread_attr);
+
+    if (create_result != 0) {
+      std::ostringstream error_stream;
+      error_stream << "SickBufferMonitor::StartMonitor: pthread_create() failed! (" << strerror(create_result) << ")";
+      throw SickThreadException(error_stream.str());
     }
 
-    /* Set the flag to continue grabbing data */
-    _continue_grabbing = true;
+    _monitor_thread_running = true;
     
   }
 
   /**
    * \brief Checks the message container for the next available Sick message
    * \param &sick_message The message object that is to be populated with the results
+   * \param *recv_time Set to the host time at which the message was framed (Default: NULL => Not wanted)
    * \return True if the current contents were acquired, false otherwise
    */
   template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
-  bool SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::GetNextMessageFromMonitor( SICK_MSG_CLASS &sick_message ) throw( SickThreadException ) {
+  bool SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::GetNextMessageFromMonitor( SICK_MSG_CLASS &sick_message, struct timeval * const recv_time ) throw( SickThreadException ) {
 
     bool acquired_message = false;
 
     try {
+
+      SICK_TRACE_SCOPE_ARG("SickBufferMonitor::GetNextMessageFromMonitor (container)",_sick_fd);
     
       /* Acquire a lock on the message buffer */
       _acquireMessageContainer();
@@ -193,6 +385,15 @@ namespace SickToolbox {
 	/* Copy the shared message */
 	sick_message = _recv_msg_container;
 	_recv_msg_container.Clear();
+
+	if (recv_time) {
+	  *recv_time = _recv_msg_container_time;
+	}
+
+	/* Record how long it waited to be picked up */
+	struct timeval curr_time;
+	gettimeofday(&curr_time,NULL);
+	_sick_metrics.DeliveryLatency().RecordInterval(_recv_msg_container_time,curr_time);
 	
 	/* Set the flag indicating success */
 	acquired_message = true;      
@@ -205,13 +406,13 @@ namespace SickToolbox {
 
     /* Handle a thread exception */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle an unknown exception */
     catch(...) {
-      std::cerr << "SickBufferMonitor::CheckMessageContainer: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickBufferMonitor::CheckMessageContainer: Unknown exception!");
       throw;
     }
     
@@ -219,6 +420,123 @@ namespace SickToolbox {
     return acquired_message;    
   }
   
+  /**
+   * \brief Enables/disables the FIFO of received messages. When enabled, the
+   *        monitor additionally queues every message it receives (dropping the
+   *        oldest when full) so that consumers can drain them in batches.
+   * \param queue_depth The capacity of the FIFO (0 => disabled)
+   *
+   * NOTE: Queued messages are carried over (oldest first), except that a
+   *       shallower queue keeps only the newest queue_depth of them.
+   */
+  template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  void SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::SetMessageQueueDepth( const unsigned int queue_depth ) throw( SickThreadException ) {
+
+    /* Allocate the new queue outside of the lock */
+    SICK_MSG_CLASS *new_queue = (queue_depth > 0) ? new SICK_MSG_CLASS[queue_depth] : NULL;
+    struct timeval *new_queue_times = (queue_depth > 0) ? new struct timeval[queue_depth] : NULL;
+    
+    SICK_MSG_CLASS *old_queue = NULL;
+    struct timeval *old_queue_times = NULL;
+    
+    try {
+
+      /* Swap in the new queue */
+      _acquireMessageContainer();
+
+      old_queue = _recv_msg_queue;
+      old_queue_times = _recv_msg_queue_times;
+
+      /* Carry over the newest queued messages */
+      const unsigned int num_kept = (_recv_msg_queue_count < queue_depth) ? _recv_msg_queue_count : queue_depth;
+      for (unsigned int i = 0; i < num_kept; i++) {
+	const unsigned int j = (_recv_msg_queue_head + _recv_msg_queue_count - num_kept + i) % _recv_msg_queue_depth;
+	new_queue[i] = old_queue[j];
+	new_queue_times[i] = old_queue_times[j];
+      }
+      
+      _recv_msg_queue = new_queue;
+      _recv_msg_queue_times = new_queue_times;
+      _recv_msg_queue_depth = queue_depth;
+      _recv_msg_queue_head = 0;
+      _recv_msg_queue_count = num_kept;
+
+      _releaseMessageContainer();
+
+    }
+
+    /* Handle a thread exception */
+    catch(SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      delete [] new_queue;
+      delete [] new_queue_times;
+      throw;
+    }
+
+    /* Release the old queue */
+    delete [] old_queue;
+    delete [] old_queue_times;
+    
+  }
+
+  /**
+   * \brief Drains queued messages from the monitor (oldest first)
+   * \param *sick_messages Destination array (at least max_num_messages long)
+   * \param *recv_times Destination array for the host receive times (NULL => Not wanted)
+   * \param max_num_messages The maximum number of messages to drain
+   * \return The number of messages copied into sick_messages
+   */
+  template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  unsigned int SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::GetMessagesFromMonitor( SICK_MSG_CLASS * const sick_messages,
+												   struct timeval * const recv_times,
+												   const unsigned int max_num_messages ) throw( SickThreadException ) {
+
+    unsigned int num_messages = 0;
+
+    struct timeval curr_time;
+    gettimeofday(&curr_time,NULL);
+
+    try {
+
+      /* Acquire a lock on the message buffer */
+      _acquireMessageContainer();
+
+      /* Copy out the oldest messages */
+      while (num_messages < max_num_messages && _recv_msg_queue_count > 0) {
+
+	sick_messages[num_messages] = _recv_msg_queue[_recv_msg_queue_head];
+	if (recv_times) {
+	  recv_times[num_messages] = _recv_msg_queue_times[_recv_msg_queue_head];
+	}
+	_sick_metrics.DeliveryLatency().RecordInterval(_recv_msg_queue_times[_recv_msg_queue_head],curr_time);
+
+	_recv_msg_queue_head = (_recv_msg_queue_head + 1) % _recv_msg_queue_depth;
+	_recv_msg_queue_count--;
+	num_messages++;
+
+      }
+
+      /* Release message container */
+      _releaseMessageContainer();
+
+    }
+
+    /* Handle a thread exception */
+    catch(SickThreadException &sick_thread_exception) {
+      SICK_LOG_ERROR(sick_thread_exception.what());
+      throw;
+    }
+
+    /* Handle an unknown exception */
+    catch(...) {
+      SICK_LOG_ERROR("SickBufferMonitor::GetMessagesFromMonitor: Unknown exception!");
+      throw;
+    }
+
+    /* Return the count */
+    return num_messages;
+  }
+  
   /**
    * \brief Cancels the buffer monitor thread
    * \return True if the thread was properly canceled, false otherwise
@@ -241,16 +559,18 @@ namespace SickToolbox {
       	throw SickThreadException("SickBufferMonitor::StopMonitor: pthread_join() failed!");      
       }
 
+      _monitor_thread_running = false;
+
     }
 
     /* Handle thread exception */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
     }
     
     /* A safety net */
     catch(...) {
-      std::cerr << "SickBufferMonitor::StopMonitor: Unknown exception!" << std::endl;
+      SICK_LOG_ERROR("SickBufferMonitor::StopMonitor: Unknown exception!");
       throw;
     }
     
@@ -288,6 +608,10 @@ namespace SickToolbox {
   template < class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
   SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::~SickBufferMonitor( ) throw( SickThreadException ) {
 
+    /* Release the message queue */
+    delete [] _recv_msg_queue;
+    delete [] _recv_msg_queue_times;
+
     /* Destroy the message container mutex */
     if (pthread_mutex_destroy(&_container_mutex) != 0) {
       throw SickThreadException("SickBufferMonitor::~SickBufferMonitor: pthread_mutex_destroy() failed!");
@@ -331,11 +655,39 @@ namespace SickToolbox {
    * \param *dest_buffer A pointer to the destination buffer
    * \param num_bytes_to_read The number of bytes to read into the buffer
    * \param timeout_value The number of microseconds allowed between subsequent bytes in a message
-   * \return True if the number of requested bytes were successfully read
    */
   template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
   void SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_readBytes( uint8_t * const dest_buffer, const int num_bytes_to_read, const unsigned int timeout_value ) const
     throw ( SickTimeoutException, SickIOException ) {
+
+    /* Translate the read status into the exception API */
+    switch (_tryReadBytes(dest_buffer,num_bytes_to_read,timeout_value)) {
+    case SICK_READ_OK:
+      break;
+    case SICK_READ_TIMEOUT:
+      throw SickTimeoutException("SickBufferMonitor::_readBytes: select() timeout!");
+    default:
+      throw SickIOException("SickBufferMonitor::_readBytes: select()/read() failed!");
+    }
+    
+  }
+
+  /**
+   * \brief Attempt to read a certain number of bytes from the stream w/o throwing
+   * \param *dest_buffer A pointer to the destination buffer
+   * \param num_bytes_to_read The number of bytes to read into the buffer
+   * \param timeout_value The number of microseconds allowed between subsequent bytes in a message
+   * \return SICK_READ_OK if the number of requested bytes were successfully read
+   *
+   * NOTE: This is the steady-state path of the buffer monitors, where an
+   *       idle stream times out on every poll. Reporting by status keeps
+   *       the unwinder out of that loop.
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  typename SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::sick_read_status_t
+  SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_tryReadBytes( uint8_t * const dest_buffer, const int num_bytes_to_read, const unsigned int timeout_value ) const throw ( ) {
+
+    SICK_TRACE_SCOPE_ARG("SickBufferMonitor::_readBytes",_sick_fd);
     
     /* Some helpful variables */
     int num_bytes_read = 0;
@@ -354,7 +706,7 @@ namespace SickToolbox {
       
       /* Setup the timeout structure */
       memset(&timeout_val,0,sizeof(timeout_val));   // Initialize the buffer
-      timeout_val.tv_usec = timeout_value;          // Wait for specified time before throwing a timeout
+      timeout_val.tv_usec = timeout_value;          // Wait for specified time before reporting a timeout
 
       /* Wait for the OS to tell us that data is waiting! */
       num_active_files = select(getdtablesize(),&file_desc_set,0,0,(timeout_value > 0) ? &timeout_val : 0);
@@ -379,7 +731,8 @@ namespace SickToolbox {
   	  }
   	  else {
   	    /* If this happens, something is wrong */
-  	    throw SickIOException("SickBufferMonitor::_readBytes: read() failed!");
+	    _sick_metrics.Increment(SickMetrics::SICK_METRICS_BYTES_READ,total_num_bytes_read);
+  	    return SICK_READ_ERROR;
   	  }	  
 	  
   	}
@@ -388,20 +741,128 @@ namespace SickToolbox {
       else if (num_active_files == 0) {
 	
 	/* A timeout has occurred! */
-	throw SickTimeoutException("SickBufferMonitor::_readBytes: select() timeout!");	
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_BYTES_READ,total_num_bytes_read);
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_READ_TIMEOUTS);
+	return SICK_READ_TIMEOUT;
 
       }
       else {
 	
 	/* An error has occurred! */
-	throw SickIOException("SickBufferMonitor::_readBytes: select() failed!");	
+	_sick_metrics.Increment(SickMetrics::SICK_METRICS_BYTES_READ,total_num_bytes_read);
+	return SICK_READ_ERROR;
 
       }
       
     }
+
+    /* Success */
+    _sick_metrics.Increment(SickMetrics::SICK_METRICS_BYTES_READ,total_num_bytes_read);
+    return SICK_READ_OK;
     
   }
   
+  /**
+   * \brief Applies the scheduling policy, priority and CPU affinity to a running thread
+   * \param thread_id The monitor thread
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  void SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_applyThreadConfig( const pthread_t thread_id ) const throw( SickThreadException ) {
+
+    /* Set the policy/priority (real-time policies typically need CAP_SYS_NICE) */
+    struct sched_param sched_params;
+    memset(&sched_params,0,sizeof(sched_params));
+    sched_params.sched_priority = _thread_config.sick_sched_priority;
+
+    int sched_result = pthread_setschedparam(thread_id,_thread_config.sick_sched_policy,&sched_params);
+    if (sched_result != 0) {
+      std::ostringstream error_stream;
+      error_stream << "SickBufferMonitor::_applyThreadConfig: pthread_setschedparam() failed! (" << strerror(sched_result) << ")";
+      throw SickThreadException(error_stream.str());
+    }
+
+    /* Pin the thread */
+    if (_thread_config.sick_cpu_mask != 0) {
+
+      cpu_set_t cpu_set;
+      _buildCpuSet(cpu_set);
+
+      int affinity_result = pthread_setaffinity_np(thread_id,sizeof(cpu_set),&cpu_set);
+      if (affinity_result != 0) {
+	std::ostringstream error_stream;
+	error_stream << "SickBufferMonitor::_applyThreadConfig: pthread_setaffinity_np() failed! (" << strerror(affinity_result) << ")";
+	throw SickThreadException(error_stream.str());
+      }
+
+    }
+
+  }
+
+  /**
+   * \brief Fills in a CPU set from the configured mask
+   * \param &cpu_set The set to be filled in
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  void SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_buildCpuSet( cpu_set_t &cpu_set ) const {
+
+    CPU_ZERO(&cpu_set);
+    for (unsigned int i = 0; i < 64; i++) {
+      if (_thread_config.sick_cpu_mask & ((uint64_t)1 << i)) {
+	CPU_SET(i,&cpu_set);
+      }
+    }
+
+  }
+
+  /**
+   * \brief Touches the monitor's stack and message buffers. Called on the
+   *        monitor thread before it starts acquiring so that, together w/
+   *        mlockall(MCL_CURRENT | MCL_FUTURE) in the application, the
+   *        acquisition path never takes a page fault.
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  void SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_prefaultMemory( ) throw( SickThreadException ) {
+
+    /* Touch the stack (bounded by the configured stack size) */
+    size_t prefault_size = DEFAULT_SICK_MONITOR_PREFAULT_STACK_SIZE;
+    if (_thread_config.sick_stack_size > 0 && _thread_config.sick_stack_size/2 < prefault_size) {
+      prefault_size = _thread_config.sick_stack_size/2;
+    }
+
+    volatile uint8_t *stack_buffer = (volatile uint8_t *)alloca(prefault_size);
+    for (size_t i = 0; i < prefault_size; i += 512) {
+      stack_buffer[i] = 0;
+    }
+
+    /* Touch the container and the queue */
+    _acquireMessageContainer();
+
+    _recv_msg_container.Clear();
+    for (unsigned int i = _recv_msg_queue_count; i < _recv_msg_queue_depth; i++) {
+      _recv_msg_queue[(_recv_msg_queue_head + i) % _recv_msg_queue_depth].Clear(); // only the free slots
+    }
+
+    _releaseMessageContainer();
+
+  }
+
+  /**
+   * \brief Maps a read status onto the framing control flow
+   * \param read_status The status returned by _tryReadBytes
+   * \return True if the read timed out (i.e. framing should stop), false otherwise
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  bool SickBufferMonitor< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_readTimedOut( const sick_read_status_t read_status ) const throw ( SickIOException ) {
+
+    /* Only a failed select()/read() is exceptional */
+    if (read_status == SICK_READ_ERROR) {
+      throw SickIOException("SickBufferMonitor::_readTimedOut: select()/read() failed!");
+    }
+
+    return read_status == SICK_READ_TIMEOUT;
+
+  }
+  
   /**
    * \brief The monitor thread
    * \param *args The thread arguments
@@ -411,10 +872,28 @@ namespace SickToolbox {
     
     /* Declare a Sick LD receive object */
     SICK_MSG_CLASS curr_message;
+
+    /* Host times of the current and the previous frame */
+    struct timeval curr_frame_time = {0,0}, last_frame_time = {0,0};
+    bool have_last_frame = false;
     
     /* Acquire the Sick device instance */
     SICK_MONITOR_CLASS *buffer_monitor = (SICK_MONITOR_CLASS *)thread_args;
 
+    /* Fault in the acquisition path up front */
+    if (buffer_monitor->_thread_config.sick_prefault) {
+
+      try {
+	buffer_monitor->_prefaultMemory();
+      }
+
+      /* Catch any thread exceptions */
+      catch(SickThreadException &sick_thread_exception) {
+	SICK_LOG_ERROR(sick_thread_exception.what());
+      }
+
+    }
+
     /* The main thread control loop */
     for (;;) {
 
@@ -431,29 +910,72 @@ namespace SickToolbox {
 	  break;
 	}
 
-	buffer_monitor->GetNextMessageFromDataStream(curr_message);
+	{
+	  SICK_TRACE_SCOPE_ARG("SickBufferMonitor::GetNextMessageFromDataStream",buffer_monitor->_sick_fd);
+	  buffer_monitor->GetNextMessageFromDataStream(curr_message);
+	}
 	buffer_monitor->ReleaseDataStream();
+
+	/* Account for the frame */
+	if (curr_message.IsPopulated()) {
+
+	  gettimeofday(&curr_frame_time,NULL);
+	  buffer_monitor->_sick_metrics.Increment(SickMetrics::SICK_METRICS_FRAMES_RECEIVED);
+
+	  if (have_last_frame) {
+	    buffer_monitor->_sick_metrics.FrameInterArrival().RecordInterval(last_frame_time,curr_frame_time);
+	  }
+
+	  last_frame_time = curr_frame_time;
+	  have_last_frame = true;
+
+	}
 	
 	/* Update message container contents */
+	SICK_TRACE_SCOPE_ARG("SickBufferMonitor::_bufferMonitorThread (container)",buffer_monitor->_sick_fd);
 	buffer_monitor->_acquireMessageContainer();	
+
+	/* The previous frame is lost if it was never picked up */
+	if (buffer_monitor->_recv_msg_container.IsPopulated()) {
+	  buffer_monitor->_sick_metrics.Increment(SickMetrics::SICK_METRICS_FRAMES_OVERWRITTEN);
+	}
+
 	buffer_monitor->_recv_msg_container = curr_message;
+	buffer_monitor->_recv_msg_container_time = curr_frame_time;
+
+	/* Queue the message (dropping the oldest when full) */
+	if (buffer_monitor->_recv_msg_queue_depth > 0 && curr_message.IsPopulated()) {
+
+	  if (buffer_monitor->_recv_msg_queue_count == buffer_monitor->_recv_msg_queue_depth) {
+	    buffer_monitor->_recv_msg_queue_head = (buffer_monitor->_recv_msg_queue_head + 1) % buffer_monitor->_recv_msg_queue_depth;
+	    buffer_monitor->_recv_msg_queue_count--;
+	    buffer_monitor->_sick_metrics.Increment(SickMetrics::SICK_METRICS_FRAMES_DROPPED);
+	  }
+
+	  unsigned int tail = (buffer_monitor->_recv_msg_queue_head + buffer_monitor->_recv_msg_queue_count) % buffer_monitor->_recv_msg_queue_depth;
+	  buffer_monitor->_recv_msg_queue[tail] = curr_message;
+	  buffer_monitor->_recv_msg_queue_times[tail] = curr_frame_time;
+	  buffer_monitor->_recv_msg_queue_count++;
+
+	}
+	
  	buffer_monitor->_releaseMessageContainer();
 
       }
 
       /* Make sure there wasn't a serious error reading from the buffer */
       catch(SickIOException &sick_io_exception) {
-	std::cerr << sick_io_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_exception.what());
       }
 
       /* Catch any thread exceptions */
       catch(SickThreadException &sick_thread_exception) {
-	std::cerr << sick_thread_exception.what() << std::endl;
+	SICK_LOG_ERROR(sick_thread_exception.what());
       }
       
       /* A failsafe */
       catch(...) {
-	std::cerr << "SickBufferMonitor::_bufferMonitorThread: Unknown exception!" << std::endl;
+	SICK_LOG_ERROR("SickBufferMonitor::_bufferMonitorThread: Unknown exception!");
       }
 
       /* sleep a bit! */
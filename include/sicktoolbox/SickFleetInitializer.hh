@@ -0,0 +1,254 @@
+/*!
+ * \file SickFleetInitializer.hh
+ * \brief Defines a helper for bringing up many Sick devices concurrently.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_FLEET_INITIALIZER
+#define SICK_FLEET_INITIALIZER
+
+/* Dependencies */
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <pthread.h>
+#include "SickAsyncRequest.hh"
+#include "SickException.hh"
+#include "SickLogger.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickFleetInitializer
+   * \brief Initializes a set of (possibly heterogeneous) Sick devices in
+   *        parallel, running at most max_parallel Initialize calls at once.
+   *        Failures do not stop the remaining devices; they are collected
+   *        and reported once every device has been attempted.
+   *
+   * Example:
+   *   SickFleetInitializer fleet;
+   *   fleet.AddDevice(&sick_ld,"front");
+   *   fleet.AddDevice(&sick_lms_1xx,false,"rear");
+   *   fleet.AddDevice(&sick_lms_2xx,SickLMS2xx::SICK_BAUD_38400,(uint32_t)0,"side");
+   *   if (fleet.Run(4) > 0) { std::cerr << fleet.GetErrorSummary(); }
+   */
+  class SickFleetInitializer {
+
+  public:
+
+    /** A standard constructor */
+    SickFleetInitializer( ) throw( SickThreadException );
+
+    /** Adds an arbitrary request (ownership is taken) */
+    void AddRequest( SickAsyncRequest * const sick_request, const std::string &sick_name );
+
+    /** Adds a device whose Initialize takes no arguments (e.g. SickLD, SickNav350) */
+    template < class SICK_DEVICE_CLASS >
+    void AddDevice( SICK_DEVICE_CLASS * const sick_device, const std::string &sick_name ) {
+      AddRequest(new SickAsyncMethod0< SICK_DEVICE_CLASS >(sick_device,&SICK_DEVICE_CLASS::Initialize),sick_name);
+    }
+
+    /** Adds a device whose Initialize takes one argument (e.g. SickLMS1xx) */
+    template < class SICK_DEVICE_CLASS, class ARG1 >
+    void AddDevice( SICK_DEVICE_CLASS * const sick_device, const ARG1 arg1, const std::string &sick_name ) {
+      AddRequest(new SickAsyncMethod1< SICK_DEVICE_CLASS, ARG1 >(sick_device,&SICK_DEVICE_CLASS::Initialize,arg1),sick_name);
+    }
+
+    /** Adds a device whose Initialize takes two arguments (e.g. SickLMS2xx) */
+    template < class SICK_DEVICE_CLASS, class ARG1, class ARG2 >
+    void AddDevice( SICK_DEVICE_CLASS * const sick_device, const ARG1 arg1, const ARG2 arg2, const std::string &sick_name ) {
+      AddRequest(new SickAsyncMethod2< SICK_DEVICE_CLASS, ARG1, ARG2 >(sick_device,&SICK_DEVICE_CLASS::Initialize,arg1,arg2),sick_name);
+    }
+
+    /** Runs every request with bounded parallelism, returns the number of failures */
+    unsigned int Run( const unsigned int max_parallel ) throw( SickThreadException );
+
+    /** Number of devices in the fleet */
+    unsigned int GetNumDevices( ) const { return _sick_requests.size(); }
+
+    /** Name of the i-th device */
+    std::string GetDeviceName( const unsigned int index ) const { return _sick_names[index]; }
+
+    /** Whether the i-th device initialized successfully */
+    bool GetDeviceSucceeded( const unsigned int index ) throw( SickThreadException ) {
+      return _sick_requests[index]->GetStatus() == SickAsyncRequest::SICK_ASYNC_STATUS_SUCCEEDED;
+    }
+
+    /** The exception type captured for the i-th device */
+    SickAsyncRequest::sick_async_error_t GetDeviceError( const unsigned int index ) throw( SickThreadException ) {
+      return _sick_requests[index]->GetError();
+    }
+
+    /** A summary of every failure (one line per device) */
+    std::string GetErrorSummary( ) throw( SickThreadException );
+
+    /** A standard destructor */
+    ~SickFleetInitializer( );
+
+  private:
+
+    /** The queued requests */
+    std::vector< SickAsyncRequest * > _sick_requests;
+
+    /** Names associated w/ the requests */
+    std::vector< std::string > _sick_names;
+
+    /** Guards the completion count */
+    pthread_mutex_t _fleet_mutex;
+
+    /** Signalled whenever a request completes */
+    pthread_cond_t _fleet_cond;
+
+    /** Number of requests completed in the current run */
+    unsigned int _num_completed;
+
+    /** Completion callback (called on the request threads) */
+    static void _requestDone( SickAsyncRequest &sick_request, void * const user_data );
+
+  };
+
+  /**
+   * \brief Primary constructor
+   */
+  inline SickFleetInitializer::SickFleetInitializer( ) throw( SickThreadException ) : _num_completed(0) {
+
+    if (pthread_mutex_init(&_fleet_mutex,NULL) != 0) {
+      throw SickThreadException("SickFleetInitializer::SickFleetInitializer: pthread_mutex_init() failed!");
+    }
+
+    if (pthread_cond_init(&_fleet_cond,NULL) != 0) {
+      pthread_mutex_destroy(&_fleet_mutex);
+      throw SickThreadException("SickFleetInitializer::SickFleetInitializer: pthread_cond_init() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Adds a request to the fleet
+   * \param *sick_request The request (deleted by the fleet)
+   * \param &sick_name A name used when reporting errors
+   */
+  inline void SickFleetInitializer::AddRequest( SickAsyncRequest * const sick_request, const std::string &sick_name ) {
+    _sick_requests.push_back(sick_request);
+    _sick_names.push_back(sick_name);
+  }
+
+  /**
+   * \brief Runs the requests, keeping at most max_parallel in flight
+   * \param max_parallel Max number of concurrent requests (0 => all at once)
+   * \return The number of requests that failed
+   */
+  inline unsigned int SickFleetInitializer::Run( const unsigned int max_parallel ) throw( SickThreadException ) {
+
+    const unsigned int num_requests = _sick_requests.size();
+    const unsigned int window = (max_parallel == 0 || max_parallel > num_requests) ? num_requests : max_parallel;
+
+    _num_completed = 0;
+
+    unsigned int num_started = 0;
+    unsigned int num_reaped = 0;
+
+    while (num_reaped < num_requests) {
+
+      /* Fill the window */
+      while (num_started < num_requests && num_started - num_reaped < window) {
+
+	try {
+	  _sick_requests[num_started]->Start(SickFleetInitializer::_requestDone,this);
+	}
+
+	/* The request is marked failed (and counted) by Start */
+	catch(SickThreadException &sick_thread_exception) {
+	  SICK_LOG_ERROR(sick_thread_exception.what());
+	}
+
+	num_started++;
+
+      }
+
+      /* Wait for at least one more completion */
+      if (pthread_mutex_lock(&_fleet_mutex) != 0) {
+	throw SickThreadException("SickFleetInitializer::Run: pthread_mutex_lock() failed!");
+      }
+
+      while (_num_completed == num_reaped) {
+	pthread_cond_wait(&_fleet_cond,&_fleet_mutex);
+      }
+
+      num_reaped = _num_completed;
+      pthread_mutex_unlock(&_fleet_mutex);
+
+    }
+
+    /* Count the failures */
+    unsigned int num_failed = 0;
+    for (unsigned int i = 0; i < num_requests; i++) {
+      _sick_requests[i]->Wait();
+      if (_sick_requests[i]->GetStatus() != SickAsyncRequest::SICK_ASYNC_STATUS_SUCCEEDED) {
+	num_failed++;
+      }
+    }
+
+    return num_failed;
+
+  }
+
+  /**
+   * \brief Builds a report of the failed devices
+   */
+  inline std::string SickFleetInitializer::GetErrorSummary( ) throw( SickThreadException ) {
+
+    std::ostringstream summary;
+
+    for (unsigned int i = 0; i < _sick_requests.size(); i++) {
+      if (_sick_requests[i]->GetStatus() == SickAsyncRequest::SICK_ASYNC_STATUS_FAILED) {
+	summary << _sick_names[i] << ": " << _sick_requests[i]->GetErrorString() << std::endl;
+      }
+    }
+
+    return summary.str();
+
+  }
+
+  /**
+   * \brief Destructor (joins and releases the requests)
+   */
+  inline SickFleetInitializer::~SickFleetInitializer( ) {
+
+    for (unsigned int i = 0; i < _sick_requests.size(); i++) {
+      delete _sick_requests[i];
+    }
+
+    pthread_cond_destroy(&_fleet_cond);
+    pthread_mutex_destroy(&_fleet_mutex);
+
+  }
+
+  /**
+   * \brief Counts a completed request and wakes up Run
+   */
+  inline void SickFleetInitializer::_requestDone( SickAsyncRequest & /* sick_request */, void * const user_data ) {
+
+    SickFleetInitializer *fleet = (SickFleetInitializer *)user_data;
+
+    pthread_mutex_lock(&fleet->_fleet_mutex);
+    fleet->_num_completed++;
+    pthread_cond_signal(&fleet->_fleet_cond);
+    pthread_mutex_unlock(&fleet->_fleet_mutex);
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_FLEET_INITIALIZER */
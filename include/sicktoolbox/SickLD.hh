@@ -24,6 +24,9 @@
 #define DEFAULT_SICK_CONNECT_TIMEOUT                (unsigned int)(1e6)  ///< The max time to wait before considering a connection attempt as failed (usecs)
 #define DEFAULT_SICK_NUM_SCAN_PROFILES                              (0)  ///< Setting this value to 0 will tell the Sick LD to stream measurements when measurement data is requested (NOTE: A profile is a single scans worth of range measurements)
 #define DEFAULT_SICK_SIGNAL_SET                                     (0)  ///< Default Sick signal configuration
+#define DEFAULT_SICK_PIPELINE_DRAIN_DELAY         (unsigned int)(2.5e5)  ///< Time to wait for late replies before falling back to sequential queries (usecs)
+#define DEFAULT_SICK_CLOCK_SYNC_PERIOD              (unsigned int)(1e6)  ///< Time between sync clock samples taken by the clock sync thread (usecs)
+#define DEFAULT_SICK_PROFILE_RING_SIZE                             (16)  ///< Profiles held by the continuous profile stream
 
 /**
  * \def SWAP_VALUES(x,y,t)
@@ -40,6 +43,10 @@
 #include "SickLIDAR.hh"
 #include "SickLDBufferMonitor.hh"
 #include "SickLDMessage.hh"
+#include "SickProjection.hh"
+#include "SickScan.hh"
+#include "SickScanROI.hh"
+#include "SickLDClockSync.hh"
 #include "SickException.hh"
 
 /**
@@ -60,6 +67,7 @@ namespace SickToolbox {
     /* Some constants for the developer/end-user */
     static const uint16_t SICK_MAX_NUM_MEASUREMENTS = 2881;                             ///< Maximum number of measurements per sector
     static const uint16_t SICK_MAX_NUM_SECTORS = 8;                                     ///< Maximum number of scan sectors (NOTE: This value must be even)
+    static const uint16_t SICK_LD_NUM_ID_STRINGS = 11;                                  ///< Number of identification strings making up the Sick LD identity
     static const uint16_t SICK_MAX_NUM_MEASURING_SECTORS = 4;                           ///< Maximum number of active/measuring scan sectors
     static const uint16_t SICK_MAX_SCAN_AREA = 360;                                     ///< Maximum area that can be covered in a single scan (deg)
     static const uint16_t SICK_MIN_MOTOR_SPEED = 5;                                     ///< Minimum motor speed in Hz
@@ -335,14 +343,15 @@ namespace SickToolbox {
     typedef struct sick_ld_sector_data_tag {
       unsigned int sector_num;                                                            ///< The sector number in the scan area
       unsigned int num_data_points;                                                       ///< The number of data points in the scan area
-      unsigned int timestamp_start;                                                       ///< The timestamp (in ms) corresponding to the time the first measurement in the sector was taken 
-      unsigned int timestamp_stop;                                                        ///< The timestamp (in ms) corresponding to the time the last measurement in the sector was taken
+      unsigned int timestamp_start;                                                       ///< The timestamp (in ms) corresponding to the time the first measurement in the sector was taken (unwrapped against the profile's first sector, so it may exceed 65535)
+      unsigned int timestamp_stop;                                                        ///< The timestamp (in ms) corresponding to the time the last measurement in the sector was taken (unwrapped likewise)
       unsigned int echo_values[SICK_MAX_NUM_MEASUREMENTS];                                ///< The corresponding echo/reflectivity values
       double angle_step;                                                                  ///< The angle step used for the given sector (this should be the same for all sectors)
       double angle_start;                                                                 ///< The angle at which the first measurement in the sector was acquired
       double angle_stop;                                                                  ///< The angle at which the last measurement in the sector was acquired
       double range_values[SICK_MAX_NUM_MEASUREMENTS];                                     ///< The corresponding range values (NOTE: The size of this array is intended to be large enough to accomodate various sector configs.)
       double scan_angles[SICK_MAX_NUM_MEASUREMENTS];                                      ///< The scan angles corresponding to the respective measurements
+      double scan_timestamps[SICK_MAX_NUM_MEASUREMENTS];                                  ///< The times (in ms, interpolated from TSTART/TEND) at which the respective measurements were taken
     } sick_ld_sector_data_t;
     
     /**
@@ -364,6 +373,39 @@ namespace SickToolbox {
       unsigned int num_sectors;                                                           ///< The number of sectors returned in the profile
       sick_ld_sector_data_t sector_data[SICK_MAX_NUM_SECTORS];                            ///< The sectors associated with the scan profile 
     } sick_ld_scan_profile_t;
+
+    /**
+     * \struct sick_ld_pose_tag
+     * \brief A planar pose of the Sick LD, expressed in a fixed (e.g. odometry)
+     *        frame whose axes match the sensor's at theta = 0 (x toward 0 deg,
+     *        y toward 90 deg).
+     */
+    /**
+     * \typedef sick_ld_pose_t
+     * \brief Adopt c-style convention
+     */
+    typedef struct sick_ld_pose_tag {
+      double x;                                                                           ///< Position along x (in m)
+      double y;                                                                           ///< Position along y (in m)
+      double theta;                                                                       ///< Heading (in deg)
+    } sick_ld_pose_t;
+
+    /**
+     * \typedef sick_ld_pose_callback_t
+     * \brief Looks up the sensor pose at a device timestamp (in ms), returning false if unavailable
+     */
+    typedef bool (*sick_ld_pose_callback_t)( const double sick_timestamp, sick_ld_pose_t &sick_pose, void * const user_data );
+
+    /**
+     * \typedef sick_ld_sector_callback_t
+     * \brief Receives a sector as soon as it has been parsed out of a profile (along with the profile's PROFILECOUNT).
+     *        It runs on the thread parsing the profile, before the profile's sensor/motor status has been checked,
+     *        so a sector may come from a profile that is then rejected.
+     *
+     * NOTE: The unit sends a whole revolution in one message, so this does not cut acquisition latency. It only
+     *       saves the host the time spent parsing the remaining sectors of the profile.
+     */
+    typedef void (*sick_ld_sector_callback_t)( const sick_ld_sector_data_t &sector_data, const unsigned int profile_counter, void * const user_data );
     
     /** Primary constructor */
     SickLD( const std::string sick_ip_address = DEFAULT_SICK_IP_ADDRESS,
@@ -392,6 +434,16 @@ namespace SickToolbox {
     /** Gets the internal clock time of the Sick LD unit */
     void GetSickTime( uint16_t &sick_time )
       throw( SickIOException, SickTimeoutException, SickErrorException );
+
+    /** Starts sampling the internal clock in the background to map device time to host time */
+    void StartSickClockSync( const unsigned int sample_period = DEFAULT_SICK_CLOCK_SYNC_PERIOD )
+      throw( SickIOException, SickThreadException );
+
+    /** Stops the background clock sampling (the current mapping is kept) */
+    void StopSickClockSync( ) throw( SickThreadException );
+
+    /** The device to host clock mapping (e.g. for converting sector/measurement timestamps) */
+    const SickLDClockSync & GetSickClockSync( ) const { return _sick_clock_sync; }
   
     /** Sets the signal LEDs and switches */
     void SetSickSignals( const uint8_t sick_signal_flags = DEFAULT_SICK_SIGNAL_SET )
@@ -416,7 +468,62 @@ namespace SickToolbox {
 			      double * const sector_start_angles = NULL,
 			      double * const sector_stop_angles = NULL,
 			      unsigned int * const sector_start_timestamps = NULL,
-			      unsigned int * const sector_stop_timestamps = NULL )
+			      unsigned int * const sector_stop_timestamps = NULL,
+			      double * const scan_angles = NULL,
+			      double * const scan_timestamps = NULL )
+      throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException );
+
+    /** Sets the region of interest/decimation applied while parsing profiles */
+    void SetSickScanROI( const SickScanROI &sick_scan_roi ) { _sick_scan_roi = sick_scan_roi; }
+
+    /** Gets the region of interest/decimation applied while parsing profiles */
+    const SickScanROI & GetSickScanROI( ) const { return _sick_scan_roi; }
+
+    /** Starts a continuous data stream feeding a ring of pre-sized profiles */
+    void StartSickProfileStream( const bool want_echo = false, const unsigned int ring_size = DEFAULT_SICK_PROFILE_RING_SIZE )
+      throw( SickErrorException, SickIOException, SickConfigException, SickTimeoutException, SickThreadException );
+
+    /** Parses the profiles received since the last call into the ring (oldest first) */
+    unsigned int DrainSickProfiles( const sick_ld_scan_profile_t ** const profiles,
+				    const unsigned int max_num_profiles,
+				    unsigned int * const num_lost_profiles = NULL,
+				    const unsigned int timeout_value = 0 )
+      throw( SickConfigException, SickTimeoutException, SickThreadException );
+
+    /** Stops the continuous data stream */
+    void StopSickProfileStream( ) throw( SickErrorException, SickIOException, SickTimeoutException, SickThreadException );
+
+    /** Profiles sent by the unit but never drained since the stream was started (PROFILESENT gaps) */
+    unsigned int GetSickProfileStreamNumLost( ) const { return _sick_profile_stream_num_lost; }
+
+    /** Scans the unit took but did not send since the stream was started (PROFILECOUNT gaps) */
+    unsigned int GetSickProfileStreamNumSkipped( ) const { return _sick_profile_stream_num_skipped; }
+
+    /** Sets the pose lookup used to deskew profiles while they are parsed (NULL => no deskew) */
+    void SetSickPoseCallback( const sick_ld_pose_callback_t sick_pose_callback, void * const user_data = NULL ) {
+      _sick_pose_callback = sick_pose_callback;
+      _sick_pose_user_data = user_data;
+    }
+
+    /** Subscribes to individual sectors, delivered as they are parsed ahead of the status check (NULL => unsubscribe) */
+    void SetSickSectorCallback( const sick_ld_sector_callback_t sick_sector_callback, const uint8_t sector_mask = 0xFF, void * const user_data = NULL ) {
+      _sick_sector_callback = sick_sector_callback;
+      _sick_sector_mask = sector_mask;
+      _sick_sector_user_data = user_data;
+    }
+
+    /** Acquires the measurements of the active sectors as a SickScan */
+    void GetSickScan( SickScan &sick_scan, const bool with_echo = false )
+      throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException );
+
+    /** Acquires the measurements of the active sectors as Cartesian points (m) */
+    void GetSickScanAsPoints( float * const x_values,
+			      float * const y_values,
+			      float * const z_values,
+			      unsigned int & num_points,
+			      unsigned int * const num_sector_points = NULL,
+			      unsigned int * const sector_ids = NULL,
+			      unsigned int * const sector_data_offsets = NULL )
       throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException );
 
     /** Attempts to set a new senor ID for the device (in flash) */
@@ -567,6 +674,90 @@ namespace SickToolbox {
 
     /** Indicates whether the Sick LD is currently streaming range and echo data */
     bool _sick_streaming_range_and_echo_data;
+
+    /** Cached cos/sin tables, one per active sector */
+    SickProjectionTable _sick_projection_tables[SICK_MAX_NUM_MEASURING_SECTORS];
+
+    /** Region of interest/decimation applied while parsing profiles */
+    SickScanROI _sick_scan_roi;
+
+    /** Pose lookup used to deskew profiles (NULL => no deskew) */
+    sick_ld_pose_callback_t _sick_pose_callback;
+
+    /** User data handed to the pose lookup */
+    void * _sick_pose_user_data;
+
+    /** Maps the internal clock to host time */
+    SickLDClockSync _sick_clock_sync;
+
+    /** Clock sync thread ID */
+    pthread_t _sick_clock_sync_thread_id;
+
+    /** Indicates whether the clock sync thread is running */
+    bool _sick_clock_sync_running;
+
+    /** Time between clock samples (usecs) */
+    unsigned int _sick_clock_sync_period;
+
+    /** Host time at which the outstanding streamed GET_SYNC_CLOCK was sent (0 => none) */
+    uint64_t _sick_clock_sync_send_time;
+
+    /** Indicates a profile was received since the clock sync thread last checked */
+    bool _sick_clock_sync_profile_recvd;
+
+    /** Guards the clock sync state */
+    pthread_mutex_t _sick_clock_sync_mutex;
+
+    /** Signalled when the clock sync thread should wake up (profile received/stop) */
+    pthread_cond_t _sick_clock_sync_cond;
+
+    /** Serializes request/reply exchanges with the device (recursive) */
+    pthread_mutex_t _sick_device_mutex;
+
+    /** Profile filled by GetSickMeasurements/GetSickScan (NULL => not yet allocated) */
+    sick_ld_scan_profile_t * _sick_scan_profile;
+
+    /** Pre-sized profiles filled by DrainSickProfiles (NULL => no continuous stream) */
+    sick_ld_scan_profile_t * _sick_profile_ring;
+
+    /** Raw messages pulled from the monitor queue by DrainSickProfiles */
+    SickLDMessage * _sick_profile_messages;
+
+    /** Arrival times of the raw messages */
+    struct timeval * _sick_profile_recv_times;
+
+    /** Number of profiles in the ring */
+    unsigned int _sick_profile_ring_size;
+
+    /** Next ring slot to fill */
+    unsigned int _sick_profile_ring_head;
+
+    /** Indicates whether a profile has been drained since the stream was started */
+    bool _sick_profile_stream_synced;
+
+    /** Indicates a drained profile reported a bad sensor/motor status (thrown by the next drain) */
+    bool _sick_profile_stream_fault;
+
+    /** PROFILESENT of the last drained profile */
+    unsigned int _sick_profile_stream_last_number;
+
+    /** PROFILECOUNT of the last drained profile */
+    unsigned int _sick_profile_stream_last_counter;
+
+    /** Profiles lost since the stream was started */
+    unsigned int _sick_profile_stream_num_lost;
+
+    /** Scans skipped by the unit since the stream was started */
+    unsigned int _sick_profile_stream_num_skipped;
+
+    /** Receives subscribed sectors as soon as they are parsed (NULL => none) */
+    sick_ld_sector_callback_t _sick_sector_callback;
+
+    /** Subscribed sectors (bit i => sector i) */
+    uint8_t _sick_sector_mask;
+
+    /** User data handed to the sector callback */
+    void * _sick_sector_user_data;
   
     /** The identity structure for the Sick */
     sick_ld_identity_t _sick_identity;
@@ -615,6 +806,35 @@ namespace SickToolbox {
     /** Parses a sequence of bytes and populates the profile_data struct w/ the results */
     void _parseScanProfile( uint8_t * const src_buffer, sick_ld_scan_profile_t &profile_data ) const;
 
+    /** Moves the measurements of a parsed sector into the sensor frame at the reference pose */
+    bool _deskewScanSector( sick_ld_sector_data_t &sector_data, const sick_ld_pose_t &ref_pose ) const;
+
+    /** Makes sure the requested data stream is active (switching stream types if needed) */
+    void _setupSickScanProfileStream( const bool want_echo )
+      throw( SickErrorException, SickIOException, SickTimeoutException );
+
+    /** Gets the profile filled by GetSickMeasurements/GetSickScan (allocated on first use) */
+    sick_ld_scan_profile_t & _getSickScanProfile( ) throw( SickIOException );
+
+    /** Receives the next scan profile, setting up the data stream if needed */
+    void _recvSickScanProfile( sick_ld_scan_profile_t &profile_data, const bool want_echo )
+      throw( SickErrorException, SickIOException, SickTimeoutException, SickConfigException );
+
+    /** Hands a streamed GET_SYNC_CLOCK reply to the clock sync (returns false for any other message) */
+    bool _handleSickClockSyncReply( const SickLDMessage &sick_message, const struct timeval &recv_time );
+
+    /** Drops the clock mapping and any outstanding sample (e.g. after the device clock was set) */
+    void _resetSickClockSync( );
+
+    /** Tells the clock sync thread a profile was just received */
+    void _signalSickProfileRecvd( );
+
+    /** Takes one clock sample */
+    void _sampleSickClock( );
+
+    /** The clock sync thread */
+    static void * _clockSyncThread( void * thread_args );
+
     /** Cancels the active data stream */
     void _cancelSickScanProfiles( ) throw( SickErrorException, SickTimeoutException, SickIOException );
 
@@ -641,6 +861,22 @@ namespace SickToolbox {
     /** Acquires the configuration (function and stop angle) for each sector */
     void _getSickSectorConfig( ) throw( SickErrorException, SickTimeoutException, SickIOException );
   
+    /** Acquires identity and config w/ a single batch of pipelined requests */
+    void _getSickIdentityAndConfig( ) throw( SickErrorException, SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Parses a global config reply */
+    void _parseSickGlobalConfig( const uint8_t * const payload_buffer ) throw( SickErrorException );
+
+    /** Parses an Ethernet config reply */
+    void _parseSickEthernetConfig( const uint8_t * const payload_buffer ) throw( SickErrorException );
+
+    /** Parses a sector function reply */
+    void _parseSickSectorFunction( const uint8_t * const payload_buffer, const uint8_t sector_num,
+				   uint8_t &sector_function, double &sector_stop_angle ) const throw( SickErrorException );
+
+    /** Buffers the sector config given each sector's function and stop angle */
+    void _buildSickSectorConfig( const uint8_t * const sector_functions, const double * const sector_stop_angles );
+  
     /** Query the Sick for ID information */
     void _getIdentificationString( const uint8_t id_request_code, std::string &id_return_string )
       throw( SickTimeoutException, SickIOException );
@@ -705,6 +941,13 @@ namespace SickToolbox {
 				  const unsigned int timeout_value = DEFAULT_SICK_MESSAGE_TIMEOUT ) 
       throw( SickIOException, SickTimeoutException );
 
+    /** Send a batch of requests back to back and match the replies */
+    void _sendMessagesAndGetReplies( const SickLDMessage * const send_messages,
+				     SickLDMessage * const recv_messages,
+				     const unsigned int num_messages,
+				     const unsigned int timeout_value = DEFAULT_SICK_MESSAGE_TIMEOUT )
+      throw( SickIOException, SickTimeoutException, SickThreadException );
+
     /** Flushed the TCP receive buffer */
     void _flushTCPRecvBuffer( ) throw ( SickIOException, SickThreadException );
     
@@ -772,7 +1015,7 @@ namespace SickToolbox {
     void _printSectorProfileData( const sick_ld_sector_data_t &sector_data ) const;
 
     /** Prints the data corresponding to the given scan profile (for debugging purposes) */
-    void _printSickScanProfile( const sick_ld_scan_profile_t profile_data, const bool print_sector_data = true ) const;
+    void _printSickScanProfile( const sick_ld_scan_profile_t &profile_data, const bool print_sector_data = true ) const;
 
     /** Returns the corresponding work service subcode required to transition the Sick LD to the given sensor mode. */
     uint8_t _sickSensorModeToWorkServiceSubcode( const uint8_t sick_sensor_mode ) const;
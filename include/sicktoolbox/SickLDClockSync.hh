@@ -0,0 +1,379 @@
+/*!
+ * \file SickLDClockSync.hh
+ * \brief Defines an estimator mapping the Sick LD sync clock to host time.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_LD_CLOCK_SYNC
+#define SICK_LD_CLOCK_SYNC
+
+/* Macros */
+#define SICK_LD_CLOCK_SYNC_NUM_SAMPLES                (32)  ///< Round trips kept for the fit
+#define SICK_LD_CLOCK_SYNC_MAX_RTT_RATIO             (2.0)  ///< Round trips slower than this times the fastest one are not fit
+#define SICK_LD_CLOCK_SYNC_WRAP                    (65536)  ///< Period of the 16-bit sync clock (ms)
+#define SICK_LD_CLOCK_SYNC_NOMINAL_RATE           (1000.0)  ///< Host usecs per device ms for an ideal clock
+
+/* Dependencies */
+#include <math.h>
+#include <time.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickLDClockSync
+   * \brief Estimates the offset and drift of the Sick LD sync clock.
+   *
+   * Each sample is a GET_SYNC_CLOCK round trip: the device time (16-bit ms)
+   * is taken to have been read at the midpoint of the host send/receive
+   * times. Device times are unwrapped against the current estimate and a
+   * line (host usecs vs. device ms) is fit through the most recent round
+   * trips, ignoring those that took much longer than the fastest one.
+   *
+   * Host times are CLOCK_MONOTONIC usecs (see GetHostTime()). Conversions
+   * only take a mutex and do arithmetic, so they are cheap enough to run
+   * on the scan path. The object is thread-safe.
+   */
+  class SickLDClockSync {
+
+  public:
+
+    /** A standard constructor */
+    SickLDClockSync( ) throw( SickThreadException );
+
+    /** Adds a round trip (host send/recv times in usecs, device time in ms) */
+    void AddSample( const uint64_t host_send_time, const uint16_t sick_time, const uint64_t host_recv_time ) throw( SickThreadException );
+
+    /** Converts a device timestamp (ms, e.g. a sector/measurement timestamp) to host usecs */
+    uint64_t ToHostTime( const double sick_timestamp ) const throw( SickThreadException );
+
+    /** Whether a mapping is available (i.e. at least one round trip was added) */
+    bool IsSynchronized( ) const throw( SickThreadException );
+
+    /** Host time (usecs) of device time 0 on the current wrap */
+    double GetOffset( ) const throw( SickThreadException );
+
+    /** Relative drift of the device clock (0 => ideal, > 0 => device runs slow) */
+    double GetDrift( ) const throw( SickThreadException );
+
+    /** Fastest round trip in the window (usecs) */
+    uint64_t GetMinRoundTrip( ) const throw( SickThreadException );
+
+    /** Forgets all samples */
+    void Reset( ) throw( SickThreadException );
+
+    /** Current host time (CLOCK_MONOTONIC usecs) */
+    static uint64_t GetHostTime( );
+
+    /** Host time (CLOCK_MONOTONIC usecs) of a recent gettimeofday() stamp, e.g. a monitor arrival time */
+    static uint64_t GetHostTime( const struct timeval &wall_time );
+
+    /** A standard destructor */
+    ~SickLDClockSync( ) { pthread_mutex_destroy(&_sync_mutex); }
+
+  private:
+
+    /** Unwrapped device times (ms) */
+    double _sick_times[SICK_LD_CLOCK_SYNC_NUM_SAMPLES];
+
+    /** Host round trip midpoints (usecs) */
+    double _host_times[SICK_LD_CLOCK_SYNC_NUM_SAMPLES];
+
+    /** Round trip times (usecs) */
+    uint64_t _round_trips[SICK_LD_CLOCK_SYNC_NUM_SAMPLES];
+
+    /** Total number of samples added */
+    unsigned int _num_samples;
+
+    /** Fit: device time of the reference point (ms) */
+    double _ref_sick_time;
+
+    /** Fit: host time of the reference point (usecs) */
+    double _ref_host_time;
+
+    /** Fit: host usecs per device ms */
+    double _rate;
+
+    /** Guards the samples and the fit */
+    mutable pthread_mutex_t _sync_mutex;
+
+    /** Unwraps a 16-bit device time against the fit at the given host time */
+    double _unwrap( const double sick_time, const double host_time ) const;
+
+    /** Refits the line through the current window */
+    void _fit( );
+
+    /** Not copyable */
+    SickLDClockSync( const SickLDClockSync & );
+    SickLDClockSync & operator=( const SickLDClockSync & );
+
+  };
+
+  /**
+   * \brief A standard constructor
+   */
+  inline SickLDClockSync::SickLDClockSync( ) throw( SickThreadException ) :
+    _num_samples(0), _ref_sick_time(0), _ref_host_time(0), _rate(SICK_LD_CLOCK_SYNC_NOMINAL_RATE) {
+
+    if (pthread_mutex_init(&_sync_mutex,NULL) != 0) {
+      throw SickThreadException("SickLDClockSync::SickLDClockSync: pthread_mutex_init() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Adds a round trip
+   * \param host_send_time Host time at which GET_SYNC_CLOCK was sent (usecs)
+   * \param sick_time The returned device time (ms)
+   * \param host_recv_time Host time at which the reply was received (usecs)
+   */
+  inline void SickLDClockSync::AddSample( const uint64_t host_send_time, const uint16_t sick_time, const uint64_t host_recv_time ) throw( SickThreadException ) {
+
+    if (host_recv_time < host_send_time) {
+      return;
+    }
+
+    const double host_time = host_send_time + 0.5*(host_recv_time - host_send_time);
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::AddSample: pthread_mutex_lock() failed!");
+    }
+
+    const unsigned int i = _num_samples % SICK_LD_CLOCK_SYNC_NUM_SAMPLES;
+    _sick_times[i] = (_num_samples > 0) ? _unwrap(sick_time,host_time) : sick_time;
+    _host_times[i] = host_time;
+    _round_trips[i] = host_recv_time - host_send_time;
+    _num_samples++;
+
+    _fit();
+
+    pthread_mutex_unlock(&_sync_mutex);
+
+  }
+
+  /**
+   * \brief Converts a device timestamp to host time
+   * \param sick_timestamp Device time (ms), taken modulo 65536 and assumed to lie within +/-32 s of now
+   * \return The corresponding host time (CLOCK_MONOTONIC usecs, 0 if not synchronized)
+   */
+  inline uint64_t SickLDClockSync::ToHostTime( const double sick_timestamp ) const throw( SickThreadException ) {
+
+    const double host_time = GetHostTime();
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::ToHostTime: pthread_mutex_lock() failed!");
+    }
+
+    double result = 0;
+    if (_num_samples > 0) {
+      result = _ref_host_time + _rate*(_unwrap(sick_timestamp,host_time) - _ref_sick_time);
+    }
+
+    pthread_mutex_unlock(&_sync_mutex);
+
+    return (result > 0) ? (uint64_t)(result + 0.5) : 0;
+
+  }
+
+  /**
+   * \brief Whether a mapping is available
+   */
+  inline bool SickLDClockSync::IsSynchronized( ) const throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::IsSynchronized: pthread_mutex_lock() failed!");
+    }
+
+    const bool is_synchronized = _num_samples > 0;
+    pthread_mutex_unlock(&_sync_mutex);
+
+    return is_synchronized;
+
+  }
+
+  /**
+   * \brief Host time (usecs) of device time 0 on the current wrap
+   */
+  inline double SickLDClockSync::GetOffset( ) const throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::GetOffset: pthread_mutex_lock() failed!");
+    }
+
+    const double offset = _ref_host_time - _rate*fmod(_ref_sick_time,SICK_LD_CLOCK_SYNC_WRAP);
+    pthread_mutex_unlock(&_sync_mutex);
+
+    return offset;
+
+  }
+
+  /**
+   * \brief Relative drift of the device clock
+   */
+  inline double SickLDClockSync::GetDrift( ) const throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::GetDrift: pthread_mutex_lock() failed!");
+    }
+
+    const double drift = _rate/SICK_LD_CLOCK_SYNC_NOMINAL_RATE - 1.0;
+    pthread_mutex_unlock(&_sync_mutex);
+
+    return drift;
+
+  }
+
+  /**
+   * \brief Fastest round trip in the window (usecs)
+   */
+  inline uint64_t SickLDClockSync::GetMinRoundTrip( ) const throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::GetMinRoundTrip: pthread_mutex_lock() failed!");
+    }
+
+    uint64_t min_round_trip = 0;
+    const unsigned int num_window_samples = (_num_samples < SICK_LD_CLOCK_SYNC_NUM_SAMPLES) ? _num_samples : SICK_LD_CLOCK_SYNC_NUM_SAMPLES;
+    for (unsigned int i = 0; i < num_window_samples; i++) {
+      if (i == 0 || _round_trips[i] < min_round_trip) {
+	min_round_trip = _round_trips[i];
+      }
+    }
+
+    pthread_mutex_unlock(&_sync_mutex);
+
+    return min_round_trip;
+
+  }
+
+  /**
+   * \brief Forgets all samples
+   */
+  inline void SickLDClockSync::Reset( ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sync_mutex) != 0) {
+      throw SickThreadException("SickLDClockSync::Reset: pthread_mutex_lock() failed!");
+    }
+
+    _num_samples = 0;
+    _ref_sick_time = _ref_host_time = 0;
+    _rate = SICK_LD_CLOCK_SYNC_NOMINAL_RATE;
+
+    pthread_mutex_unlock(&_sync_mutex);
+
+  }
+
+  /**
+   * \brief Current host time
+   * \return CLOCK_MONOTONIC time (usecs)
+   */
+  inline uint64_t SickLDClockSync::GetHostTime( ) {
+    struct timespec curr_time;
+    clock_gettime(CLOCK_MONOTONIC,&curr_time);
+    return (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_nsec/1000;
+  }
+
+  /**
+   * \brief Host time of a recent gettimeofday() stamp
+   * \param &wall_time The stamp (e.g. the time the buffer monitor framed a message)
+   * \return The corresponding host time (CLOCK_MONOTONIC usecs)
+   *
+   * NOTE: The stamp's age is measured on the wall clock and taken back from the
+   *       current monotonic time, so a wall clock step in between shows up as error.
+   */
+  inline uint64_t SickLDClockSync::GetHostTime( const struct timeval &wall_time ) {
+
+    struct timeval curr_wall_time;
+    gettimeofday(&curr_wall_time,NULL);
+    const uint64_t host_time = GetHostTime();
+
+    const int64_t age = ((int64_t)curr_wall_time.tv_sec - wall_time.tv_sec)*1000000 + (curr_wall_time.tv_usec - wall_time.tv_usec);
+    if (age <= 0) {
+      return host_time;
+    }
+
+    return ((uint64_t)age < host_time) ? host_time - age : 0;
+
+  }
+
+  /**
+   * \brief Unwraps a 16-bit device time against the fit
+   * \param sick_time Device time (ms, taken modulo 65536)
+   * \param host_time Host time (usecs) near which the device time was read
+   * \return The unwrapped device time closest to the fit's prediction
+   */
+  inline double SickLDClockSync::_unwrap( const double sick_time, const double host_time ) const {
+
+    const double predicted_sick_time = _ref_sick_time + (host_time - _ref_host_time)/_rate;
+    const double num_wraps = floor((predicted_sick_time - sick_time)/SICK_LD_CLOCK_SYNC_WRAP + 0.5);
+
+    return sick_time + num_wraps*SICK_LD_CLOCK_SYNC_WRAP;
+
+  }
+
+  /**
+   * \brief Refits the line through the current window
+   *
+   * NOTE: A single usable round trip only sets the offset (nominal rate).
+   */
+  inline void SickLDClockSync::_fit( ) {
+
+    const unsigned int num_window_samples = (_num_samples < SICK_LD_CLOCK_SYNC_NUM_SAMPLES) ? _num_samples : SICK_LD_CLOCK_SYNC_NUM_SAMPLES;
+
+    /* Only fit round trips close to the fastest one */
+    uint64_t min_round_trip = _round_trips[0];
+    for (unsigned int i = 1; i < num_window_samples; i++) {
+      if (_round_trips[i] < min_round_trip) {
+	min_round_trip = _round_trips[i];
+      }
+    }
+
+    /* Allow 1 ms of slack so fast links do not reject nearly every sample */
+    const double max_round_trip = SICK_LD_CLOCK_SYNC_MAX_RTT_RATIO*(min_round_trip + 1000);
+
+    /* Center the samples to keep the sums well conditioned */
+    double mean_sick_time = 0, mean_host_time = 0;
+    unsigned int num_fit_samples = 0;
+    for (unsigned int i = 0; i < num_window_samples; i++) {
+      if (_round_trips[i] <= max_round_trip) {
+	mean_sick_time += _sick_times[i];
+	mean_host_time += _host_times[i];
+	num_fit_samples++;
+      }
+    }
+
+    mean_sick_time /= num_fit_samples;
+    mean_host_time /= num_fit_samples;
+
+    double sum_xx = 0, sum_xy = 0;
+    for (unsigned int i = 0; i < num_window_samples; i++) {
+      if (_round_trips[i] <= max_round_trip) {
+	const double dx = _sick_times[i] - mean_sick_time;
+	sum_xx += dx*dx;
+	sum_xy += dx*(_host_times[i] - mean_host_time);
+      }
+    }
+
+    /* Need at least a second's spread before trusting a rate */
+    _rate = (sum_xx > 1e6*(num_fit_samples - 1) && num_fit_samples > 1) ? sum_xy/sum_xx : SICK_LD_CLOCK_SYNC_NOMINAL_RATE;
+    _ref_sick_time = mean_sick_time;
+    _ref_host_time = mean_host_time;
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_LD_CLOCK_SYNC */
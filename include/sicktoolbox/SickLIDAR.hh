@@ -41,6 +41,10 @@
 #include <sys/time.h>
 #include <unistd.h>
 #include "SickException.hh"
+#include "SickLogger.hh"
+#include "SickMetrics.hh"
+#include "SickTrace.hh"
+#include "SickBufferMonitor.hh"
 
 /* Associate the namespace */
 namespace SickToolbox {
@@ -59,7 +63,21 @@ namespace SickToolbox {
 
     /** Indicates whether device is initialized */
     bool IsInitialized() { return _sick_initialized; }
-    
+
+    /** Take a snapshot of the acquisition path metrics */
+    void GetSickMetrics( SickMetrics &sick_metrics ) const { _sick_buffer_monitor->GetMetrics().Snapshot(sick_metrics); }
+
+    /** Clear the acquisition path metrics */
+    void ResetSickMetrics( ) { _sick_buffer_monitor->GetMetrics().Reset(); }
+
+    /** Configure the scheduling of the monitor thread (stack size/prefault apply on the next Initialize) */
+    void SetSickMonitorThreadConfig( const sick_monitor_thread_config_t &thread_config ) throw( SickThreadException ) {
+      _sick_buffer_monitor->SetThreadConfig(thread_config);
+    }
+
+    /** Get the scheduling configuration of the monitor thread */
+    sick_monitor_thread_config_t GetSickMonitorThreadConfig( ) const { return _sick_buffer_monitor->GetThreadConfig(); }
+
     /** A virtual destructor */
     virtual ~SickLIDAR( );
 
@@ -105,11 +123,20 @@ namespace SickToolbox {
     /** Acquire the next message from the message container */
     void _recvMessage( SICK_MSG_CLASS &sick_message, const unsigned int timeout_value ) const throw ( SickTimeoutException );
 
+    /** Acquire the next message from the message container along w/ its arrival time */
+    void _recvMessage( SICK_MSG_CLASS &sick_message, struct timeval &recv_time, const unsigned int timeout_value ) const throw ( SickTimeoutException );
+
     /** Search the stream for a payload with a particular "header" byte string */
     void _recvMessage( SICK_MSG_CLASS &sick_message,
 		       const uint8_t * const byte_sequence,
 		       const unsigned int byte_sequence_length,
 		       const unsigned int timeout_value ) const throw ( SickTimeoutException );
+
+    /** Drain a batch of queued messages (waits for at least one) */
+    unsigned int _recvMessages( SICK_MSG_CLASS * const sick_messages,
+				struct timeval * const recv_times,
+				const unsigned int max_num_messages,
+				const unsigned int timeout_value ) const throw ( SickTimeoutException, SickThreadException );
     
     /** An inline function for computing elapsed time */
     double _computeElapsedTime( const struct timeval &beg_time, const struct timeval &end_time ) const { return ((end_time.tv_sec*1e6)+(end_time.tv_usec))-((beg_time.tv_sec*1e6)+beg_time.tv_usec); }
@@ -137,7 +164,7 @@ namespace SickToolbox {
       _sick_buffer_monitor = new SICK_MONITOR_CLASS;
     }
     catch ( std::bad_alloc &allocation_exception ) {
-      std::cerr << "SickLIDAR::SickLIDAR: Allocation error - " << allocation_exception.what() << std::endl;
+      SICK_LOG_ERROR("SickLIDAR::SickLIDAR: Allocation error - " << allocation_exception.what());
     }
     
   }
@@ -168,13 +195,13 @@ namespace SickToolbox {
 
     /* Handle a thread exception */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle a thread exception */
     catch(...) {
-      std::cerr << "SickLIDAR::_startListening: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLIDAR::_startListening: Unknown exception!!!");
       throw;
     }    
 
@@ -196,13 +223,13 @@ namespace SickToolbox {
 
     /* Handle a thread exception */
     catch(SickThreadException &sick_thread_exception) {
-      std::cerr << sick_thread_exception.what() << std::endl;
+      SICK_LOG_ERROR(sick_thread_exception.what());
       throw;
     }
 
     /* Handle a thread exception */
     catch(...) {
-      std::cerr << "SickLIDAR::_stopListening: Unknown exception!!!" << std::endl;
+      SICK_LOG_ERROR("SickLIDAR::_stopListening: Unknown exception!!!");
       throw;
     }
 
@@ -301,6 +328,22 @@ namespace SickToolbox {
   void SickLIDAR< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_recvMessage( SICK_MSG_CLASS &sick_message,
 								      const unsigned int timeout_value ) const throw ( SickTimeoutException ) {
 
+    struct timeval recv_time;
+    _recvMessage(sick_message,recv_time,timeout_value);
+
+  }
+
+  /**
+   * \brief Attempt to acquire the latest available message from the device
+   * \param &sick_message A reference to the container that will hold the most recent message
+   * \param &recv_time Set to the host time (gettimeofday) at which the monitor framed the message
+   * \param timeout_value The time in usecs to wait before throwing a timeout error
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  void SickLIDAR< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_recvMessage( SICK_MSG_CLASS &sick_message,
+								      struct timeval &recv_time,
+								      const unsigned int timeout_value ) const throw ( SickTimeoutException ) {
+
     /* Timeval structs for handling timeouts */
     struct timeval beg_time, end_time;
 
@@ -308,7 +351,7 @@ namespace SickToolbox {
     gettimeofday(&beg_time,NULL);
     
     /* Check the shared object */
-    while(!_sick_buffer_monitor->GetNextMessageFromMonitor(sick_message)) {    
+    while(!_sick_buffer_monitor->GetNextMessageFromMonitor(sick_message,&recv_time)) {    
       
       /* Sleep a little bit */
       usleep(1000);
@@ -316,6 +359,7 @@ namespace SickToolbox {
       /* Check whether the allowed time has expired */
       gettimeofday(&end_time,NULL);    
       if (_computeElapsedTime(beg_time,end_time) > timeout_value) {
+	_sick_buffer_monitor->GetMetrics().Increment(SickMetrics::SICK_METRICS_RECV_TIMEOUTS);
 	throw SickTimeoutException("SickLIDAR::_recvMessage: Timeout occurred!");
       }
       
@@ -323,6 +367,53 @@ namespace SickToolbox {
     
   }
 
+  /**
+   * \brief Drain up to max_num_messages messages queued by the buffer monitor
+   * \param *sick_messages Destination array (at least max_num_messages long)
+   * \param *recv_times Destination array for the host receive times (NULL => Not wanted)
+   * \param max_num_messages The maximum number of messages to acquire
+   * \param timeout_value The time in usecs to wait for the first message before throwing a timeout error
+   * \return The number of messages acquired (at least one)
+   *
+   * NOTE: Enables the monitor's message queue on first use
+   */
+  template< class SICK_MONITOR_CLASS, class SICK_MSG_CLASS >
+  unsigned int SickLIDAR< SICK_MONITOR_CLASS, SICK_MSG_CLASS >::_recvMessages( SICK_MSG_CLASS * const sick_messages,
+									       struct timeval * const recv_times,
+									       const unsigned int max_num_messages,
+									       const unsigned int timeout_value ) const throw ( SickTimeoutException, SickThreadException ) {
+
+    /* Make sure the monitor is queueing messages */
+    if (_sick_buffer_monitor->GetMessageQueueDepth() < max_num_messages) {
+      _sick_buffer_monitor->SetMessageQueueDepth(max_num_messages);
+    }
+    
+    /* Timeval structs for handling timeouts */
+    struct timeval beg_time, end_time;
+
+    /* Acquire the elapsed time since epoch */
+    gettimeofday(&beg_time,NULL);
+
+    /* Check the queue */
+    unsigned int num_messages = 0;
+    while((num_messages = _sick_buffer_monitor->GetMessagesFromMonitor(sick_messages,recv_times,max_num_messages)) == 0) {
+
+      /* Sleep a little bit */
+      usleep(1000);
+    
+      /* Check whether the allowed time has expired */
+      gettimeofday(&end_time,NULL);    
+      if (_computeElapsedTime(beg_time,end_time) > timeout_value) {
+	_sick_buffer_monitor->GetMetrics().Increment(SickMetrics::SICK_METRICS_RECV_TIMEOUTS);
+	throw SickTimeoutException("SickLIDAR::_recvMessages: Timeout occurred!");
+      }
+
+    }
+
+    return num_messages;
+    
+  }
+
   /**
    * \brief Attempt to acquire a message having a payload beginning w/ the given byte sequence
    * \param &sick_message A reference to the container that will hold the most recent message
@@ -378,6 +469,7 @@ namespace SickToolbox {
       /* Check whether the allowed time has expired */
       gettimeofday(&end_time,NULL);        
       if (_computeElapsedTime(beg_time,end_time) > timeout_value) {
+	_sick_buffer_monitor->GetMetrics().Increment(SickMetrics::SICK_METRICS_RECV_TIMEOUTS);
       	throw SickTimeoutException();
       }      
       
@@ -401,6 +493,8 @@ namespace SickToolbox {
 										 const unsigned int timeout_value,
 										 const unsigned int num_tries ) 
 										 throw( SickTimeoutException, SickIOException ) {
+
+    SICK_TRACE_SCOPE_ARG("SickLIDAR::_sendMessageAndGetReply",_sick_fd);
     
     /* Send the message for at most num_tries number of times */
     for(unsigned int i = 0; i < num_tries; i++) {
@@ -427,19 +521,20 @@ namespace SickToolbox {
 	}
 	
 	/* Display the number of tries remaining! */
-	std::cerr << sick_timeout.what() << " " << num_tries - i - 1  << " tries remaining" <<  std::endl;
+	_sick_buffer_monitor->GetMetrics().Increment(SickMetrics::SICK_METRICS_REQUEST_RETRIES);
+	SICK_LOG_WARN(sick_timeout.what() << " " << num_tries - i - 1  << " tries remaining");
 	
       }
       
       /* Handle write buffer exceptions */
       catch (SickIOException &sick_io_error) {
-	std::cerr << sick_io_error.what() << std::endl;
+	SICK_LOG_ERROR(sick_io_error.what());
 	throw;
       }
       
       /* A safety net */
       catch (...) {
-	std::cerr << "SickLIDAR::_sendMessageAndGetReply: Unknown exception!!!" << std::endl;
+	SICK_LOG_ERROR("SickLIDAR::_sendMessageAndGetReply: Unknown exception!!!");
 	throw;
       }
       
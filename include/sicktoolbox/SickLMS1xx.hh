@@ -34,6 +34,9 @@
 #include "SickLIDAR.hh"
 #include "SickLMS1xxBufferMonitor.hh"
 #include "SickLMS1xxMessage.hh"
+#include "SickProjection.hh"
+#include "SickScan.hh"
+#include "SickScanROI.hh"
 #include "SickException.hh"
 
 /**
@@ -148,6 +151,23 @@ namespace SickToolbox {
 			      unsigned int & num_measurements,
 			      unsigned int * const dev_status = NULL ) throw ( SickIOException, SickConfigException, SickTimeoutException );
 
+    /** Sets the region of interest/decimation applied while parsing scans */
+    void SetSickScanROI( const SickScanROI &sick_scan_roi ) { _sick_scan_roi = sick_scan_roi; }
+
+    /** Gets the region of interest/decimation applied while parsing scans */
+    const SickScanROI & GetSickScanROI( ) const { return _sick_scan_roi; }
+
+    /** Get the Sick range measurements as a SickScan */
+    void GetSickScan( SickScan &sick_scan ) throw ( SickIOException, SickConfigException, SickTimeoutException );
+
+    /** Get the Sick range measurements as Cartesian points (m) */
+    void GetSickScanAsPoints( float * const x_values,
+			      float * const y_values,
+			      float * const z_values,
+			      unsigned int & num_points,
+			      unsigned int * const reflect_vals = NULL,
+			      unsigned int * const dev_status = NULL ) throw ( SickIOException, SickConfigException, SickTimeoutException );
+
     /** Uninitializes the Sick LD unit */
     void Uninitialize( const bool disp_banner = true ) throw( SickIOException, SickTimeoutException, SickErrorException, SickThreadException );
 
@@ -207,6 +227,12 @@ namespace SickToolbox {
     
     /** Sick LMS 1xx streaming status */
     bool _sick_streaming;
+
+    /** Cached cos/sin tables for the current scan area/resolution */
+    SickProjectionTable _sick_projection_table;
+
+    /** Region of interest/decimation applied while parsing scans */
+    SickScanROI _sick_scan_roi;
     
     /** Setup the connection parameters and establish TCP connection! */
     void _setupConnection( ) throw( SickIOException, SickTimeoutException );
@@ -302,6 +328,13 @@ namespace SickToolbox {
 
     /** Utility function for extracting next integer from tokenized string */
     char * _convertNextTokenToUInt( char * const str_buffer, unsigned int & num_val, const char * const delimeter = " " ) const;
+
+    /** Utility function for skipping the next token of a tokenized string */
+    char * _skipNextToken( char * const str_buffer, const char * const delimeter = " " ) const;
+
+    /** Extracts the values of a scan data channel (DIST1, RSSI1, ...) through the scan ROI */
+    char * _extractSickChannelValues( char * const str_buffer, unsigned int * const values, unsigned int & num_values,
+				      const bool range_channel ) const;
     
   };
 
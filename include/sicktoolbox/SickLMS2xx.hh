@@ -25,6 +25,9 @@
 
 #include "SickLMS2xxBufferMonitor.hh"
 #include "SickLMS2xxMessage.hh"
+#include "SickProjection.hh"
+#include "SickScan.hh"
+#include "SickScanROI.hh"
 
 /* Macro definitions */
 #define DEFAULT_SICK_LMS_2XX_SICK_BAUD                                       (B9600)  ///< Initial baud rate of the LMS (whatever is set in flash)
@@ -37,10 +40,16 @@
 #define DEFAULT_SICK_LMS_2XX_SICK_CONFIG_MESSAGE_TIMEOUT        (unsigned int)(15e6)  ///< The sick can take some time to respond to config commands (usecs)
 #define DEFAULT_SICK_LMS_2XX_BYTE_INTERVAL                                      (55)  ///< Minimum time in microseconds between transmitted bytes
 #define DEFAULT_SICK_LMS_2XX_NUM_TRIES                                           (3)  ///< The max number of tries before giving up on a request
+#define DEFAULT_SICK_LMS_2XX_SCAN_QUEUE_DEPTH                                   (32)  ///< Number of messages buffered by the monitor for batch retrieval
+#define SICK_LMS_2XX_PARTIAL_SCAN_ANGLE_STEP                                  (0.25)  ///< Angular offset per partial scan index (deg)
+#define SICK_LMS_2XX_MAX_NUM_PARTIAL_SCANS                                       (4)  ///< Maximum number of partial scans interlaced into one scan
     
 /* Associate the namespace */
 namespace SickToolbox {
 
+  class SickLMS2xxStreamSession;
+  class SickLMS2xxInterlacedScanAssembler;
+
   /*!
    * \brief A general class for interfacing w/ SickLMS2xx2xx laser range finders
    *
@@ -50,11 +59,20 @@ namespace SickToolbox {
   class SickLMS2xx : public SickLIDAR< SickLMS2xxBufferMonitor, SickLMS2xxMessage >
   { 
 
+    /** Stream sessions pin the operating mode and parse profiles directly */
+    friend class SickLMS2xxStreamSession;
+
+    /** The interlaced scan assembler drains and parses partial scans directly */
+    friend class SickLMS2xxInterlacedScanAssembler;
+
   public:
     
     /** Define the maximum number of measurements */
     static const uint16_t SICK_MAX_NUM_MEASUREMENTS = 721;                     ///< Maximum number of measurements returned by the Sick LMS
 
+    /** Define the mirror rotation frequency */
+    static const uint16_t SICK_MIRROR_FREQUENCY = 75;                          ///< Rotation frequency of the Sick LMS mirror (Hz)
+
     /*!
      * \enum sick_lms_2xx_type_t 
      * \brief Defines the Sick LMS 2xx types.
@@ -520,6 +538,9 @@ namespace SickToolbox {
     /** Uninitializes the Sick */
     void Uninitialize( ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException );
 
+    /** Enables the persistent init cache (baud) stored at the given path */
+    void SetSickInitCache( const std::string sick_init_cache_path );
+
     /** Gets the Sick LMS 2xx device path */
     std::string GetSickDevicePath( ) const;
     
@@ -594,6 +615,32 @@ namespace SickToolbox {
 		      unsigned int * const sick_telegram_index = NULL,
 		      unsigned int * const sick_real_time_scan_index = NULL ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException);
 
+    /** Sets the region of interest/decimation applied while parsing scans */
+    void SetSickScanROI( const SickScanROI &sick_scan_roi ) { _sick_scan_roi = sick_scan_roi; }
+
+    /** Gets the region of interest/decimation applied while parsing scans */
+    const SickScanROI & GetSickScanROI( ) const { return _sick_scan_roi; }
+
+    /** Gets a range scan from the Sick as a SickScan */
+    void GetSickScan( SickScan &sick_scan ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException);
+
+    /** Gets a range scan from the Sick as Cartesian points (m) */
+    void GetSickScanAsPoints( float * const x_values,
+			      float * const y_values,
+			      float * const z_values,
+			      unsigned int & num_points,
+			      unsigned int * const sick_telegram_index = NULL,
+			      unsigned int * const sick_real_time_scan_index = NULL ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException);
+
+    /** Drains up to max_num_scans buffered scans into a contiguous, strided block */
+    unsigned int GetSickScans( const unsigned int max_num_scans,
+			       unsigned int * const measurement_values,
+			       const unsigned int measurement_stride,
+			       unsigned int * const num_measurement_values,
+			       unsigned int * const sick_telegram_indices = NULL,
+			       unsigned int * const sick_real_time_scan_indices = NULL,
+			       struct timeval * const sick_recv_times = NULL ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException);
+
     /** Gets measurement data from the Sick. NOTE: Data can be either range or reflectivity given the Sick mode. */
     void GetSickScanSubrange( const uint16_t sick_subrange_start_index,
 			      const uint16_t sick_subrange_stop_index,
@@ -752,6 +799,27 @@ namespace SickToolbox {
     /** Stores information about the original terminal settings */
     struct termios _old_term;
 
+    /** Scratch messages used by GetSickScans */
+    SickLMS2xxMessage *_sick_scan_batch_messages;
+
+    /** Scratch receive times used by GetSickScans */
+    struct timeval *_sick_scan_batch_times;
+
+    /** Number of entries in the scratch buffers */
+    unsigned int _sick_scan_batch_size;
+
+    /** The stream session currently pinning the operating mode (NULL => none) */
+    SickLMS2xxStreamSession *_sick_stream_session;
+
+    /** Path of the persistent init cache (empty => disabled) */
+    std::string _sick_init_cache_path;
+
+    /** Cached cos/sin tables for the current scan angle/resolution */
+    SickProjectionTable _sick_projection_table;
+
+    /** Region of interest/decimation applied while parsing scans */
+    SickScanROI _sick_scan_roi;
+
     /** Opens the terminal for serial communication. */
     void _setupConnection() throw( SickIOException, SickThreadException );
     void _setupConnection(const uint32_t delay ) throw( SickIOException, SickThreadException );
@@ -792,6 +860,12 @@ namespace SickToolbox {
 
     /** Sets the Sick configuration in flash */
     void _setSickConfig( const sick_lms_2xx_device_config_t &sick_config ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Looks up the init cache entry for this device */
+    bool _readSickInitCache( sick_lms_2xx_baud_t &sick_baud ) const;
+
+    /** Stores the current baud in the init cache */
+    void _writeSickInitCache( ) const;
     
     /** Gets the status of the LMS */
     void _getSickStatus( ) throw( SickTimeoutException, SickIOException, SickThreadException );
@@ -860,8 +934,14 @@ namespace SickToolbox {
     void _parseSickConfigProfile( const uint8_t * const src_buffer, sick_lms_2xx_device_config_t &sick_device_config ) const;
 
     /** Acquires the bit mask to extract the field bit values returned with each range measurement */
-    void _extractSickMeasurementValues( const uint8_t * const byte_sequence, const uint16_t num_measurements, uint16_t * const measured_values,
-					uint8_t * const field_a_values = NULL, uint8_t * const field_b_values = NULL, uint8_t * const field_c_values = NULL ) const;
+    uint16_t _extractSickMeasurementValues( const uint8_t * const byte_sequence, const uint16_t num_measurements, uint16_t * const measured_values,
+					    uint8_t * const field_a_values = NULL, uint8_t * const field_b_values = NULL, uint8_t * const field_c_values = NULL,
+					    const double start_angle = 0, const double step_angle = 0, const unsigned int first_beam_index = 0,
+					    const bool apply_roi = false ) const;
+
+    /** Acquires the angular layout of a scan with the given number of values */
+    void _getSickBeamLayout( const unsigned int num_measurements, const unsigned int partial_scan_index,
+			     double &start_angle, double &step_angle ) const;
     
     /** Tells whether the device is returning real-time indices */
     bool _returningRealTimeIndices( ) const { return _sick_device_config.sick_availability_level & SICK_FLAG_AVAILABILITY_REAL_TIME_INDICES; }
@@ -0,0 +1,184 @@
+/*!
+ * \file SickLMS2xxInterlacedScanAssembler.hh
+ * \brief Definition of class SickLMS2xxInterlacedScanAssembler.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_LMS_2XX_INTERLACED_SCAN_ASSEMBLER_HH
+#define SICK_LMS_2XX_INTERLACED_SCAN_ASSEMBLER_HH
+
+/* Definition dependencies */
+#include <sys/time.h>
+
+#include "SickLMS2xx.hh"
+#include "SickLMS2xxStreamSession.hh"
+#include "SickScan.hh"
+#include "SickException.hh"
+
+/* Macro definitions */
+#define DEFAULT_SICK_LMS_2XX_INTERLACED_NUM_SCAN_BUFFERS                         (4)  ///< Completed scans held until they are fetched
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickLMS2xxInterlacedScanAssembler
+   * \brief Reassembles the interlaced partial scans of a Sick LMS 2xx.
+   *
+   * In the 0.25/0.5 deg modes the device streams one 1 deg partial scan per
+   * mirror revolution, each offset by its partial scan index. The assembler
+   * pins the partial scan stream (see SickLMS2xxStreamSession), drains the
+   * buffered telegrams in batches so that no partial scan is missed at the
+   * full 75 Hz rate, and interleaves the partial scans of consecutive
+   * revolutions into full-resolution scans held in pre-allocated buffers.
+   *
+   * Consecutive partial scans must have consecutive telegram indices. A lost
+   * telegram or a repeated position discards the scan being assembled and
+   * assembly restarts at the partial scan that revealed it, so a scan always
+   * comes from a single run of telegrams. Below 500 kBd the device cannot
+   * send a partial scan every revolution, so real-time scan indices (when
+   * enabled) skip. They are then only used to place each partial scan in
+   * time; without them one revolution per partial scan is assumed. Full-
+   * resolution (1 deg) scans pass straight through.
+   */
+  class SickLMS2xxInterlacedScanAssembler {
+
+  public:
+
+    /** Primary constructor */
+    SickLMS2xxInterlacedScanAssembler( SickLMS2xx &sick_lms,
+				       const unsigned int num_scan_buffers = DEFAULT_SICK_LMS_2XX_INTERLACED_NUM_SCAN_BUFFERS ) throw( SickConfigException );
+
+    /** Switch the device into the partial scan stream and reset the assembly */
+    void Begin( ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Get the next complete scan (measured values) */
+    void GetNextScan( unsigned int * const measurement_values,
+		      unsigned int & num_measurement_values,
+		      unsigned int * const sick_scan_index = NULL,
+		      struct timeval * const sick_recv_time = NULL,
+		      const unsigned int timeout_value = DEFAULT_SICK_LMS_2XX_SICK_MESSAGE_TIMEOUT ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Get the next complete scan as a SickScan */
+    void GetNextScan( SickScan &sick_scan,
+		      const unsigned int timeout_value = DEFAULT_SICK_LMS_2XX_SICK_MESSAGE_TIMEOUT ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Unpin the operating mode (the device keeps streaming) */
+    void End( );
+
+    /** Indicates whether the assembler currently pins the device */
+    bool IsActive( ) const { return _sick_stream_session.IsActive(); }
+
+    /** Number of partial scans making up the scans assembled last (0 => none yet) */
+    unsigned int GetNumPartialScans( ) const { return _sick_num_partial_scans; }
+
+    /** Number of partial scans found missing from the index sequence */
+    unsigned int GetNumLostPartialScans( ) const { return _sick_num_lost_partial_scans; }
+
+    /** Number of incomplete scans that were discarded */
+    unsigned int GetNumDiscardedScans( ) const { return _sick_num_discarded_scans; }
+
+    /** Number of complete scans overwritten before they were fetched */
+    unsigned int GetNumDroppedScans( ) const { return _sick_num_dropped_scans; }
+
+    /** Destructor (ends the session) */
+    ~SickLMS2xxInterlacedScanAssembler( );
+
+  private:
+
+    /*!
+     * \struct sick_lms_2xx_interlaced_scan_tag
+     * \brief A full-resolution scan interleaved from partial scans
+     */
+    /*!
+     * \typedef sick_lms_2xx_interlaced_scan_t
+     * \brief Adopt c-style convention
+     */
+    typedef struct sick_lms_2xx_interlaced_scan_tag {
+      uint16_t sick_num_measurements;                                                    ///< Number of measurements
+      uint16_t sick_measurements[SickLMS2xx::SICK_MAX_NUM_MEASUREMENTS];                 ///< Range/reflectivity measurement buffer
+      uint8_t sick_field_values[SickLMS2xx::SICK_MAX_NUM_MEASUREMENTS];                  ///< Field A/B/C bits (bits 0/1/2)
+      uint8_t sick_num_partial_scans;                                                    ///< Number of interleaved partial scans
+      uint16_t sick_revolution_offsets[SICK_LMS_2XX_MAX_NUM_PARTIAL_SCANS];              ///< Revolutions between the first partial scan and each position
+      uint8_t sick_scan_index;                                                           ///< Index (real-time or telegram) of the first partial scan
+      struct timeval sick_recv_time;                                                     ///< Receive time of the last partial scan
+    } sick_lms_2xx_interlaced_scan_t;
+
+    /** The device being streamed */
+    SickLMS2xx &_sick_lms;
+
+    /** Pins the partial scan stream */
+    SickLMS2xxStreamSession _sick_stream_session;
+
+    /** Scan buffers (one more than can be pending, for assembly) */
+    sick_lms_2xx_interlaced_scan_t *_sick_scans;
+
+    /** Number of scan buffers */
+    unsigned int _sick_num_scan_buffers;
+
+    /** Oldest pending scan */
+    unsigned int _sick_scan_head;
+
+    /** Number of pending scans */
+    unsigned int _sick_num_pending_scans;
+
+    /** Bit k is set once partial scan position k has been assembled */
+    unsigned int _sick_assembly_mask;
+
+    /** Partial scans assembled into the current scan */
+    unsigned int _sick_num_assembled;
+
+    /** Telegram index of the last assembled partial scan */
+    uint8_t _sick_last_telegram_index;
+
+    /** Real-time scan index of the last assembled partial scan */
+    uint8_t _sick_last_real_time_index;
+
+    /** Revolutions between the first and the last assembled partial scans */
+    unsigned int _sick_revolution_offset;
+
+    /** Number of partial scans per scan */
+    unsigned int _sick_num_partial_scans;
+
+    /** Assembly statistics */
+    unsigned int _sick_num_lost_partial_scans;
+    unsigned int _sick_num_discarded_scans;
+    unsigned int _sick_num_dropped_scans;
+
+    /** Receive messages/times (reused across batches) */
+    SickLMS2xxMessage *_sick_messages;
+    struct timeval *_sick_recv_times;
+
+    /** Payload buffer (reused across partial scans) */
+    uint8_t _sick_payload_buffer[SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH];
+
+    /** Profile (reused across partial scans) */
+    SickLMS2xx::sick_lms_2xx_scan_profile_b0_t _sick_profile_b0;
+
+    /** Drain the buffered partial scans until a scan is complete */
+    void _assembleNextScan( const unsigned int timeout_value ) throw( SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Interleave one partial scan into the scan being assembled */
+    void _addPartialScan( const SickLMS2xx::sick_lms_2xx_scan_profile_b0_t &sick_scan_profile, const struct timeval &recv_time );
+
+    /** Restart the assembly */
+    void _resetAssembly( ) { _sick_assembly_mask = _sick_num_assembled = 0; }
+
+    /** Not copyable */
+    SickLMS2xxInterlacedScanAssembler( const SickLMS2xxInterlacedScanAssembler & );
+    SickLMS2xxInterlacedScanAssembler & operator=( const SickLMS2xxInterlacedScanAssembler & );
+
+  };
+
+} //namespace SickToolbox
+
+#endif /* SICK_LMS_2XX_INTERLACED_SCAN_ASSEMBLER_HH */
@@ -0,0 +1,115 @@
+/*!
+ * \file SickLMS2xxStreamSession.hh
+ * \brief Definition of class SickLMS2xxStreamSession.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_LMS_2XX_STREAM_SESSION_HH
+#define SICK_LMS_2XX_STREAM_SESSION_HH
+
+/* Definition dependencies */
+#include "SickLMS2xx.hh"
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickLMS2xxStreamSession
+   * \brief Pins a Sick LMS 2xx to a single streaming operating mode.
+   *
+   * The operating mode is switched once by Begin() and is then tracked
+   * locally, so GetNextScan() is a plain receive/parse loop w/o any mode
+   * checks or device queries. While a session is active, any driver call
+   * that would switch the operating mode throws a SickConfigException;
+   * call End() (or destroy the session) first.
+   */
+  class SickLMS2xxStreamSession {
+
+  public:
+
+    /*!
+     * \enum sick_lms_2xx_stream_type_t
+     * \brief The streams that can be pinned by a session
+     */
+    enum sick_lms_2xx_stream_type_t {
+      SICK_LMS_2XX_STREAM_VALUES,                                      ///< Measured values (GetSickScan)
+      SICK_LMS_2XX_STREAM_RANGE_AND_REFLECT,                           ///< Range and reflectivity (LMS 211/221/291-S14 only)
+      SICK_LMS_2XX_STREAM_PARTIAL_SCAN,                                ///< Interlaced partial scans (GetSickPartialScan)
+      SICK_LMS_2XX_STREAM_MEAN_VALUES,                                 ///< Mean values (GetSickMeanValues)
+      SICK_LMS_2XX_STREAM_VALUES_SUBRANGE,                             ///< Measured value subrange (GetSickScanSubrange)
+      SICK_LMS_2XX_STREAM_MEAN_VALUES_SUBRANGE                         ///< Mean value subrange (GetSickMeanValuesSubrange)
+    };
+
+    /** Primary constructor */
+    SickLMS2xxStreamSession( SickLMS2xx &sick_lms );
+
+    /** Switch the device into the given stream (once) and pin it */
+    void Begin( const sick_lms_2xx_stream_type_t stream_type,
+		const uint8_t sick_sample_size = 0,
+		const uint16_t sick_subrange_start_index = 0,
+		const uint16_t sick_subrange_stop_index = 0 ) throw( SickConfigException, SickTimeoutException, SickIOException, SickThreadException );
+
+    /** Receive and parse the next scan of the pinned stream */
+    void GetNextScan( unsigned int * const measurement_values,
+		      unsigned int & num_measurement_values,
+		      unsigned int * const reflect_values = NULL,
+		      unsigned int * const num_reflect_values = NULL,
+		      unsigned int * const sick_telegram_index = NULL,
+		      unsigned int * const sick_real_time_scan_index = NULL,
+		      unsigned int * const sick_partial_scan_index = NULL,
+		      const unsigned int timeout_value = DEFAULT_SICK_LMS_2XX_SICK_MESSAGE_TIMEOUT ) throw( SickConfigException, SickTimeoutException, SickIOException );
+
+    /** Unpin the operating mode (the device keeps streaming) */
+    void End( );
+
+    /** Indicates whether this session currently pins the device */
+    bool IsActive( ) const { return _sick_lms._sick_stream_session == this; }
+
+    /** Get the pinned stream type */
+    sick_lms_2xx_stream_type_t GetStreamType( ) const { return _sick_stream_type; }
+
+    /** Destructor (ends the session) */
+    ~SickLMS2xxStreamSession( );
+
+  private:
+
+    /** The device being streamed */
+    SickLMS2xx &_sick_lms;
+
+    /** The pinned stream */
+    sick_lms_2xx_stream_type_t _sick_stream_type;
+
+    /** The reply command code expected from the pinned stream */
+    uint8_t _sick_expected_command_code;
+
+    /** Receive message (reused across scans) */
+    SickLMS2xxMessage _sick_response;
+
+    /** Payload buffer (reused across scans) */
+    uint8_t _sick_payload_buffer[SickLMS2xxMessage::MESSAGE_PAYLOAD_MAX_LENGTH];
+
+    /** Profiles (reused across scans) */
+    SickLMS2xx::sick_lms_2xx_scan_profile_b0_t _sick_profile_b0;
+    SickLMS2xx::sick_lms_2xx_scan_profile_b6_t _sick_profile_b6;
+    SickLMS2xx::sick_lms_2xx_scan_profile_b7_t _sick_profile_b7;
+    SickLMS2xx::sick_lms_2xx_scan_profile_bf_t _sick_profile_bf;
+    SickLMS2xx::sick_lms_2xx_scan_profile_c4_t _sick_profile_c4;
+
+    /** Copy a parsed profile into the caller's buffers */
+    void _copyValues( const uint16_t * const src_values, const unsigned int num_values, unsigned int * const dest_values ) const;
+
+  };
+
+} //namespace SickToolbox
+
+#endif /* SICK_LMS_2XX_STREAM_SESSION_HH */
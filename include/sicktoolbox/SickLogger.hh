@@ -0,0 +1,503 @@
+/*!
+ * \file SickLogger.hh
+ * \brief Defines an asynchronous, rate-limited logger for the Sick drivers.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_LOGGER
+#define SICK_LOGGER
+
+/* Macros */
+#define DEFAULT_SICK_LOG_QUEUE_LENGTH                (256)  ///< Number of buffered log records (must be a power of 2)
+#define DEFAULT_SICK_LOG_MSG_MAX_LENGTH              (256)  ///< Max length of a single log message (longer ones are truncated)
+#define DEFAULT_SICK_LOG_RATE_LIMIT                    (5)  ///< Max messages per call site per rate period
+#define DEFAULT_SICK_LOG_RATE_PERIOD    (unsigned int)(1e6) ///< Rate limiting period (usecs)
+#define DEFAULT_SICK_LOG_FLUSH_TIMEOUT  (unsigned int)(5e5) ///< Max time spent flushing at exit (usecs)
+
+/* Dependencies */
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+/**
+ * \def SICK_LOG
+ * \brief Logs a streamed message (e.g. SICK_LOG_ERROR("Bad reply: " << code))
+ *
+ * Each call site carries its own rate limiter, so a fault that repeats on
+ * every scan is reported a few times per period (w/ a count of what was
+ * suppressed) instead of once per scan. The message is only formatted when
+ * it is going to be queued.
+ */
+#define SICK_LOG(sick_log_severity,sick_log_message)			\
+  do {									\
+    static SickToolbox::sick_log_site_t sick_log_site = {0,0,0};	\
+    SickToolbox::SickLogger &sick_logger = SickToolbox::SickLogger::Instance(); \
+    unsigned int sick_log_num_suppressed = 0;				\
+    if (sick_logger.IsEnabled(sick_log_severity) &&			\
+	sick_logger.AllowMessage(sick_log_site,sick_log_num_suppressed)) { \
+      std::ostringstream sick_log_stream;				\
+      sick_log_stream << sick_log_message;				\
+      sick_logger.Log(sick_log_severity,sick_log_stream.str(),sick_log_num_suppressed); \
+    }									\
+  } while (0)
+
+#define SICK_LOG_DEBUG(sick_log_message) SICK_LOG(SickToolbox::SICK_LOG_SEVERITY_DEBUG,sick_log_message)
+#define SICK_LOG_INFO(sick_log_message) SICK_LOG(SickToolbox::SICK_LOG_SEVERITY_INFO,sick_log_message)
+#define SICK_LOG_WARN(sick_log_message) SICK_LOG(SickToolbox::SICK_LOG_SEVERITY_WARN,sick_log_message)
+#define SICK_LOG_ERROR(sick_log_message) SICK_LOG(SickToolbox::SICK_LOG_SEVERITY_ERROR,sick_log_message)
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /*!
+   * \enum sick_log_severity_t
+   * \brief Severity of a log record
+   */
+  enum sick_log_severity_t {
+    SICK_LOG_SEVERITY_DEBUG,                                           ///< Diagnostic chatter
+    SICK_LOG_SEVERITY_INFO,                                            ///< Informational
+    SICK_LOG_SEVERITY_WARN,                                            ///< Something is off, but the driver copes
+    SICK_LOG_SEVERITY_ERROR,                                           ///< An operation failed
+    SICK_LOG_SEVERITY_NONE                                             ///< Use w/ SetMinSeverity to silence the logger
+  };
+
+  /*!
+   * \struct sick_log_site_tag
+   * \brief Per call site rate limiting state (see SICK_LOG)
+   */
+  typedef struct sick_log_site_tag {
+    uint64_t sick_log_period_start;                                    ///< Start of the current period (usecs)
+    unsigned int sick_log_num_logged;                                  ///< Messages logged during the current period
+    unsigned int sick_log_num_suppressed;                              ///< Messages suppressed since the last logged one
+  } sick_log_site_t;
+
+  /**
+   * \class SickLogSink
+   * \brief Receives formatted log records on the logger thread
+   */
+  class SickLogSink {
+
+  public:
+
+    /** Writes a single record */
+    virtual void Write( const sick_log_severity_t severity, const struct timeval &log_time, const char * const message ) = 0;
+
+    /** A virtual destructor */
+    virtual ~SickLogSink( ) { }
+
+  };
+
+  /**
+   * \class SickLogConsoleSink
+   * \brief The default sink (debug/info => std::cout, otherwise => std::cerr)
+   */
+  class SickLogConsoleSink : public SickLogSink {
+
+  public:
+
+    /** Writes a single record to the console */
+    void Write( const sick_log_severity_t severity, const struct timeval & /* log_time */, const char * const message ) {
+      std::ostream &log_stream = (severity < SICK_LOG_SEVERITY_WARN) ? std::cout : std::cerr;
+      log_stream << message << std::endl;
+    }
+
+  };
+
+  /**
+   * \class SickLogger
+   * \brief A process-wide asynchronous logger.
+   *
+   * Log() never waits on the sink: records go into a fixed size lock-free
+   * queue and are written to the sink by a background thread. When the queue
+   * is full the record is dropped and counted (see GetNumDropped). This keeps
+   * terminal (or any other sink) I/O off the acquisition threads. The writer
+   * sleeps on a condition variable while the queue is empty, and a producer
+   * only takes the (uncontended) wake mutex when it finds the writer asleep.
+   */
+  class SickLogger {
+
+  public:
+
+    /** Get the process-wide logger */
+    static SickLogger & Instance( );
+
+    /** Set the sink (not owned, NULL => console) */
+    void SetSink( SickLogSink * const sick_log_sink );
+
+    /** Records below this severity are discarded */
+    void SetMinSeverity( const sick_log_severity_t min_severity ) { _min_severity = min_severity; }
+
+    /** Get the current minimum severity */
+    sick_log_severity_t GetMinSeverity( ) const { return _min_severity; }
+
+    /** Indicates whether records of the given severity are logged */
+    bool IsEnabled( const sick_log_severity_t severity ) const { return severity >= _min_severity && severity != SICK_LOG_SEVERITY_NONE; }
+
+    /** Set the per call site rate limit (max_messages = 0 => unlimited) */
+    void SetRateLimit( const unsigned int max_messages, const unsigned int period_usecs ) { _rate_limit = max_messages; _rate_period = period_usecs; }
+
+    /** Applies the rate limit of a call site */
+    bool AllowMessage( sick_log_site_t &sick_log_site, unsigned int &num_suppressed );
+
+    /** Queues a record (returns false if it had to be dropped) */
+    bool Log( const sick_log_severity_t severity, const std::string &message, const unsigned int num_suppressed = 0 );
+
+    /** Number of records dropped because the queue was full */
+    unsigned int GetNumDropped( ) const { return _num_dropped; }
+
+    /** Wait (up to timeout_value usecs) for the queued records to be written */
+    bool Flush( const unsigned int timeout_value = DEFAULT_SICK_LOG_FLUSH_TIMEOUT );
+
+  private:
+
+    /*!
+     * \struct sick_log_record_tag
+     * \brief A queued log record
+     */
+    typedef struct sick_log_record_tag {
+      volatile unsigned int sick_log_sequence;                         ///< Queue slot sequence number
+      sick_log_severity_t sick_log_severity;                           ///< Severity
+      struct timeval sick_log_time;                                    ///< Time the record was queued
+      unsigned int sick_log_num_suppressed;                            ///< Similar messages suppressed before this one
+      char sick_log_message[DEFAULT_SICK_LOG_MSG_MAX_LENGTH];          ///< The (truncated) message
+    } sick_log_record_t;
+
+    /** The queue slots */
+    sick_log_record_t _log_queue[DEFAULT_SICK_LOG_QUEUE_LENGTH];
+
+    /** Next slot to be claimed by a producer */
+    volatile unsigned int _enqueue_pos;
+
+    /** Next slot to be written out */
+    volatile unsigned int _dequeue_pos;
+
+    /** Number of dropped records */
+    volatile unsigned int _num_dropped;
+
+    /** Minimum logged severity */
+    volatile sick_log_severity_t _min_severity;
+
+    /** Max messages per call site per period */
+    volatile unsigned int _rate_limit;
+
+    /** Rate limiting period (usecs) */
+    volatile unsigned int _rate_period;
+
+    /** The current sink */
+    SickLogSink *_log_sink;
+
+    /** The default sink */
+    SickLogConsoleSink _console_sink;
+
+    /** Guards the sink (never taken by producers) */
+    pthread_mutex_t _sink_mutex;
+
+    /** Guards the writer's sleep/wake handshake */
+    pthread_mutex_t _wake_mutex;
+
+    /** Signalled when a record is published while the writer is asleep */
+    pthread_cond_t _wake_cond;
+
+    /** Indicates whether the writer is (about to be) waiting on _wake_cond */
+    volatile unsigned int _writer_waiting;
+
+    /** Log writer thread ID */
+    pthread_t _log_thread_id;
+
+    /** Indicates whether the writer thread is running */
+    bool _log_thread_running;
+
+    /** A private constructor (see Instance) */
+    SickLogger( );
+
+    /** Writes out every queued record, returns the number written */
+    unsigned int _drainQueue( );
+
+    /** Indicates whether the next record to be written has been published */
+    bool _recordReady( ) const;
+
+    /** Entry point for the log writer thread */
+    static void * _logThread( void * thread_args );
+
+    /** Flushes the queue when the process exits */
+    static void _flushAtExit( );
+
+  };
+
+  /**
+   * \brief Gets the process-wide logger (the writer thread is started on first use)
+   */
+  inline SickLogger & SickLogger::Instance( ) {
+
+    /* Intentionally leaked so it outlives any static driver objects */
+    static SickLogger *sick_logger = new SickLogger();
+    return *sick_logger;
+
+  }
+
+  /**
+   * \brief Primary constructor
+   */
+  inline SickLogger::SickLogger( ) :
+    _enqueue_pos(0), _dequeue_pos(0), _num_dropped(0), _min_severity(SICK_LOG_SEVERITY_DEBUG),
+    _rate_limit(DEFAULT_SICK_LOG_RATE_LIMIT), _rate_period(DEFAULT_SICK_LOG_RATE_PERIOD), _log_sink(&_console_sink), _writer_waiting(0), _log_thread_running(false) {
+
+    /* Each slot starts out free for the lap that begins at its index */
+    for (unsigned int i = 0; i < DEFAULT_SICK_LOG_QUEUE_LENGTH; i++) {
+      _log_queue[i].sick_log_sequence = i;
+    }
+
+    pthread_mutex_init(&_sink_mutex,NULL);
+    pthread_mutex_init(&_wake_mutex,NULL);
+    pthread_cond_init(&_wake_cond,NULL);
+
+    /* Start the writer (if this fails, records are written synchronously by Flush) */
+    if (pthread_create(&_log_thread_id,NULL,SickLogger::_logThread,this) == 0) {
+      pthread_detach(_log_thread_id);
+      _log_thread_running = true;
+    }
+
+    atexit(SickLogger::_flushAtExit);
+
+  }
+
+  /**
+   * \brief Sets the sink records are written to
+   * \param *sick_log_sink The new sink (NULL => console)
+   */
+  inline void SickLogger::SetSink( SickLogSink * const sick_log_sink ) {
+
+    pthread_mutex_lock(&_sink_mutex);
+    _log_sink = (sick_log_sink != NULL) ? sick_log_sink : &_console_sink;
+    pthread_mutex_unlock(&_sink_mutex);
+
+  }
+
+  /**
+   * \brief Applies the rate limit of a call site
+   * \param &sick_log_site The rate limiting state of the call site
+   * \param &num_suppressed Set to the number of messages suppressed since the last allowed one
+   * \return True if the message should be logged
+   *
+   * NOTE: Concurrent callers may race on the period reset. The worst case is
+   *       a message or two over the limit, which is an acceptable trade for
+   *       keeping this lock free.
+   */
+  inline bool SickLogger::AllowMessage( sick_log_site_t &sick_log_site, unsigned int &num_suppressed ) {
+
+    if (_rate_limit == 0) {
+      num_suppressed = 0;
+      return true;
+    }
+
+    struct timeval curr_time;
+    gettimeofday(&curr_time,NULL);
+    uint64_t curr_usecs = (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_usec;
+
+    /* Start a new period */
+    if (curr_usecs - sick_log_site.sick_log_period_start >= _rate_period) {
+      sick_log_site.sick_log_period_start = curr_usecs;
+      sick_log_site.sick_log_num_logged = 0;
+    }
+
+    /* Over the limit? */
+    if (__sync_fetch_and_add(&sick_log_site.sick_log_num_logged,1) >= _rate_limit) {
+      __sync_fetch_and_add(&sick_log_site.sick_log_num_suppressed,1);
+      return false;
+    }
+
+    num_suppressed = __sync_lock_test_and_set(&sick_log_site.sick_log_num_suppressed,0);
+    return true;
+
+  }
+
+  /**
+   * \brief Queues a record for the writer thread
+   * \param severity The record severity
+   * \param &message The message (truncated to DEFAULT_SICK_LOG_MSG_MAX_LENGTH-1 chars)
+   * \param num_suppressed Number of similar messages suppressed before this one
+   * \return True if queued, false if the queue was full
+   */
+  inline bool SickLogger::Log( const sick_log_severity_t severity, const std::string &message, const unsigned int num_suppressed ) {
+
+    sick_log_record_t *log_record = NULL;
+    unsigned int pos = _enqueue_pos;
+
+    /* Claim a slot (bounded MPMC queue, after D. Vyukov) */
+    for (;;) {
+
+      log_record = &_log_queue[pos & (DEFAULT_SICK_LOG_QUEUE_LENGTH - 1)];
+      unsigned int sequence = log_record->sick_log_sequence;
+      __sync_synchronize();
+
+      int diff = (int)sequence - (int)pos;
+      if (diff == 0) {
+	if (__sync_bool_compare_and_swap(&_enqueue_pos,pos,pos+1)) {
+	  break;
+	}
+	pos = _enqueue_pos;
+      }
+      else if (diff < 0) {
+	__sync_fetch_and_add(&_num_dropped,1);
+	return false;
+      }
+      else {
+	pos = _enqueue_pos;
+      }
+
+    }
+
+    /* Fill it in */
+    log_record->sick_log_severity = severity;
+    log_record->sick_log_num_suppressed = num_suppressed;
+    gettimeofday(&log_record->sick_log_time,NULL);
+    strncpy(log_record->sick_log_message,message.c_str(),DEFAULT_SICK_LOG_MSG_MAX_LENGTH-1);
+    log_record->sick_log_message[DEFAULT_SICK_LOG_MSG_MAX_LENGTH-1] = '\0';
+
+    /* Publish it */
+    __sync_synchronize();
+    log_record->sick_log_sequence = pos + 1;
+
+    /* Wake the writer if it is asleep (pairs w/ the fence in _logThread) */
+    __sync_synchronize();
+    if (_writer_waiting) {
+      pthread_mutex_lock(&_wake_mutex);
+      pthread_cond_signal(&_wake_cond);
+      pthread_mutex_unlock(&_wake_mutex);
+    }
+
+    return true;
+
+  }
+
+  /**
+   * \brief Waits for the queued records to be written
+   * \param timeout_value Max time to wait (usecs)
+   * \return True if the queue was emptied
+   */
+  inline bool SickLogger::Flush( const unsigned int timeout_value ) {
+
+    /* No writer thread, so write them out here */
+    if (!_log_thread_running) {
+      _drainQueue();
+      return true;
+    }
+
+    for (unsigned int waited = 0; _dequeue_pos != _enqueue_pos; waited += 1000) {
+      if (waited >= timeout_value) {
+	return false;
+      }
+      usleep(1000);
+    }
+
+    return true;
+
+  }
+
+  /**
+   * \brief Indicates whether the next record to be written has been published
+   */
+  inline bool SickLogger::_recordReady( ) const {
+    return _log_queue[_dequeue_pos & (DEFAULT_SICK_LOG_QUEUE_LENGTH - 1)].sick_log_sequence == _dequeue_pos + 1;
+  }
+
+  /**
+   * \brief Writes out every queued record
+   * \return The number of records written
+   */
+  inline unsigned int SickLogger::_drainQueue( ) {
+
+    unsigned int num_written = 0;
+
+    pthread_mutex_lock(&_sink_mutex);
+
+    for (;;) {
+
+      sick_log_record_t &log_record = _log_queue[_dequeue_pos & (DEFAULT_SICK_LOG_QUEUE_LENGTH - 1)];
+
+      /* Has the slot been published? */
+      if (log_record.sick_log_sequence != _dequeue_pos + 1) {
+	break;
+      }
+      __sync_synchronize();
+
+      if (log_record.sick_log_num_suppressed > 0) {
+	std::ostringstream log_stream;
+	log_stream << log_record.sick_log_message << " [" << log_record.sick_log_num_suppressed << " similar messages suppressed]";
+	_log_sink->Write(log_record.sick_log_severity,log_record.sick_log_time,log_stream.str().c_str());
+      }
+      else {
+	_log_sink->Write(log_record.sick_log_severity,log_record.sick_log_time,log_record.sick_log_message);
+      }
+
+      /* Hand the slot back to the producers for the next lap */
+      __sync_synchronize();
+      log_record.sick_log_sequence = _dequeue_pos + DEFAULT_SICK_LOG_QUEUE_LENGTH;
+      _dequeue_pos = _dequeue_pos + 1;
+      num_written++;
+
+    }
+
+    pthread_mutex_unlock(&_sink_mutex);
+
+    return num_written;
+
+  }
+
+  /**
+   * \brief The log writer thread
+   * \param *thread_args The logger instance
+   */
+  inline void * SickLogger::_logThread( void * thread_args ) {
+
+    SickLogger *sick_logger = (SickLogger *)thread_args;
+
+    for (;;) {
+
+      sick_logger->_drainQueue();
+
+      /*
+       * Announce the wait, then re-check the queue. A producer publishes and
+       * then checks the flag, so either it sees the flag (and signals once we
+       * are in the wait, as we hold the mutex until then) or we see its record.
+       */
+      pthread_mutex_lock(&sick_logger->_wake_mutex);
+      sick_logger->_writer_waiting = 1;
+      __sync_synchronize();
+      while (!sick_logger->_recordReady()) {
+	pthread_cond_wait(&sick_logger->_wake_cond,&sick_logger->_wake_mutex);
+      }
+      sick_logger->_writer_waiting = 0;
+      pthread_mutex_unlock(&sick_logger->_wake_mutex);
+
+    }
+
+    return NULL;
+
+  }
+
+  /**
+   * \brief Gives the writer thread a chance to empty the queue at exit
+   */
+  inline void SickLogger::_flushAtExit( ) {
+    Instance().Flush();
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_LOGGER */
@@ -0,0 +1,405 @@
+/*!
+ * \file SickMetrics.hh
+ * \brief Defines lock-free counters and latency histograms for the Sick drivers.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_METRICS
+#define SICK_METRICS
+
+/* Macros */
+#define SICK_HISTOGRAM_SUB_BUCKET_BITS                 (4)  ///< log2 of the linear sub-buckets per power of 2 (~6% resolution)
+#define SICK_HISTOGRAM_MAX_VALUE_BITS                 (40)  ///< Values are clamped to 2^40 - 1 usecs (~12 days)
+
+/* Dependencies */
+#include <string>
+#include <sstream>
+#include <stdint.h>
+#include <sys/time.h>
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickHistogram
+   * \brief An HDR-style (log-linear) histogram of usec values.
+   *
+   * Values below 2^(SUB_BUCKET_BITS+1) get a bucket of their own, larger
+   * values are binned into 2^SUB_BUCKET_BITS linear sub-buckets per power
+   * of 2. Recording is lock-free, so it is safe to call from the buffer
+   * monitor while another thread takes snapshots.
+   */
+  class SickHistogram {
+
+  public:
+
+    /** Number of linear sub-buckets per power of 2 */
+    static const unsigned int SUB_BUCKET_COUNT = 1 << SICK_HISTOGRAM_SUB_BUCKET_BITS;
+
+    /** Total number of buckets */
+    static const unsigned int BUCKET_COUNT = (SICK_HISTOGRAM_MAX_VALUE_BITS - SICK_HISTOGRAM_SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /** A standard constructor */
+    SickHistogram( ) { Reset(); }
+
+    /** Records a value (usecs) */
+    void Record( const uint64_t value );
+
+    /** Records the elapsed time between two timestamps */
+    void RecordInterval( const struct timeval &beg_time, const struct timeval &end_time );
+
+    /** Copies the current contents into snapshot */
+    void Snapshot( SickHistogram &snapshot ) const;
+
+    /** Clears the histogram */
+    void Reset( );
+
+    /** Number of recorded values */
+    uint64_t GetCount( ) const { return _count; }
+
+    /** Smallest recorded value (0 if empty) */
+    uint64_t GetMin( ) const { return (_count > 0) ? _min : 0; }
+
+    /** Largest recorded value */
+    uint64_t GetMax( ) const { return _max; }
+
+    /** Mean of the recorded values */
+    double GetMean( ) const { return (_count > 0) ? (double)_sum/_count : 0; }
+
+    /** Value at the given percentile in [0,100] (upper edge of the bucket) */
+    uint64_t GetValueAtPercentile( const double percentile ) const;
+
+    /** A one-line summary (count, min, p50, p90, p99, p99.9, max) */
+    std::string ToString( ) const;
+
+  private:
+
+    /** Bucket counts */
+    volatile uint64_t _buckets[BUCKET_COUNT];
+
+    /** Number of recorded values */
+    volatile uint64_t _count;
+
+    /** Sum of the recorded values */
+    volatile uint64_t _sum;
+
+    /** Smallest recorded value */
+    volatile uint64_t _min;
+
+    /** Largest recorded value */
+    volatile uint64_t _max;
+
+    /** Maps a value to its bucket */
+    static unsigned int _bucketIndex( const uint64_t value );
+
+    /** Largest value mapped to the given bucket */
+    static uint64_t _bucketUpperValue( const unsigned int index );
+
+  };
+
+  /**
+   * \class SickMetrics
+   * \brief Health counters and latency histograms of an acquisition path.
+   *
+   * One instance is owned by each buffer monitor and is updated by both the
+   * monitor thread (framing) and the driver (requests). Every update is a
+   * single atomic operation; use Snapshot() to take a copy for reporting.
+   */
+  class SickMetrics {
+
+  public:
+
+    /*!
+     * \enum sick_metrics_counter_t
+     * \brief The available counters
+     */
+    enum sick_metrics_counter_t {
+      SICK_METRICS_BYTES_READ,                                         ///< Bytes read from the data stream
+      SICK_METRICS_FRAMES_RECEIVED,                                    ///< Complete frames framed by the monitor
+      SICK_METRICS_CHECKSUM_FAILURES,                                  ///< Frames discarded due to a bad checksum
+      SICK_METRICS_RESYNC_BYTES,                                       ///< Bytes discarded while searching for a frame header
+      SICK_METRICS_FRAMES_OVERWRITTEN,                                 ///< Frames replaced in the container before being consumed
+      SICK_METRICS_FRAMES_DROPPED,                                     ///< Frames dropped from a full message queue
+      SICK_METRICS_READ_TIMEOUTS,                                      ///< Stream reads that timed out (includes idle polls)
+      SICK_METRICS_REQUEST_RETRIES,                                    ///< Requests re-sent by _sendMessageAndGetReply
+      SICK_METRICS_RECV_TIMEOUTS,                                      ///< Driver receives that timed out
+      SICK_METRICS_NUM_COUNTERS                                        ///< Number of counters (not a counter)
+    };
+
+    /** A standard constructor */
+    SickMetrics( ) { Reset(); }
+
+    /** Adds to a counter */
+    void Increment( const sick_metrics_counter_t counter, const uint64_t amount = 1 ) { __sync_fetch_and_add(&_counters[counter],amount); }
+
+    /** Reads a counter */
+    uint64_t GetCount( const sick_metrics_counter_t counter ) const { return _counters[counter]; }
+
+    /** Time between consecutive frames (usecs) */
+    SickHistogram & FrameInterArrival( ) { return _frame_inter_arrival; }
+    const SickHistogram & FrameInterArrival( ) const { return _frame_inter_arrival; }
+
+    /** Time from a frame being framed to it being handed to the driver (usecs) */
+    SickHistogram & DeliveryLatency( ) { return _delivery_latency; }
+    const SickHistogram & DeliveryLatency( ) const { return _delivery_latency; }
+
+    /** Copies the current contents into snapshot */
+    void Snapshot( SickMetrics &snapshot ) const;
+
+    /** Clears every counter and histogram */
+    void Reset( );
+
+    /** A multi-line summary */
+    std::string ToString( ) const;
+
+    /** Name of a counter */
+    static std::string CounterToString( const sick_metrics_counter_t counter );
+
+  private:
+
+    /** The counters */
+    volatile uint64_t _counters[SICK_METRICS_NUM_COUNTERS];
+
+    /** Frame inter-arrival times */
+    SickHistogram _frame_inter_arrival;
+
+    /** Frame delivery latencies */
+    SickHistogram _delivery_latency;
+
+  };
+
+  /**
+   * \brief Records a value
+   * \param value The value (usecs)
+   */
+  inline void SickHistogram::Record( const uint64_t value ) {
+
+    __sync_fetch_and_add(&_buckets[_bucketIndex(value)],1);
+    __sync_fetch_and_add(&_sum,value);
+
+    /* Track the extremes */
+    uint64_t curr_value;
+    while (value < (curr_value = _min) && !__sync_bool_compare_and_swap(&_min,curr_value,value));
+    while (value > (curr_value = _max) && !__sync_bool_compare_and_swap(&_max,curr_value,value));
+
+    /* Publish the sample last so readers never see a count w/o its bucket */
+    __sync_fetch_and_add(&_count,1);
+
+  }
+
+  /**
+   * \brief Records the elapsed time between two timestamps (negative intervals count as 0)
+   */
+  inline void SickHistogram::RecordInterval( const struct timeval &beg_time, const struct timeval &end_time ) {
+
+    int64_t elapsed = ((int64_t)end_time.tv_sec - beg_time.tv_sec)*1000000 + ((int64_t)end_time.tv_usec - beg_time.tv_usec);
+    Record((elapsed > 0) ? (uint64_t)elapsed : 0);
+
+  }
+
+  /**
+   * \brief Copies the histogram (each bucket is read atomically)
+   */
+  inline void SickHistogram::Snapshot( SickHistogram &snapshot ) const {
+
+    snapshot._count = _count;
+    snapshot._sum = _sum;
+    snapshot._min = _min;
+    snapshot._max = _max;
+
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      snapshot._buckets[i] = _buckets[i];
+    }
+
+  }
+
+  /**
+   * \brief Clears the histogram
+   */
+  inline void SickHistogram::Reset( ) {
+
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      _buckets[i] = 0;
+    }
+
+    _count = _sum = _max = 0;
+    _min = (uint64_t)-1;
+
+  }
+
+  /**
+   * \brief Value at a percentile
+   * \param percentile The percentile in [0,100]
+   * \return The upper edge of the bucket holding the percentile (clamped to the max)
+   */
+  inline uint64_t SickHistogram::GetValueAtPercentile( const double percentile ) const {
+
+    /* Count from the buckets (the total may be mid-update) */
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      total += _buckets[i];
+    }
+
+    if (total == 0) {
+      return 0;
+    }
+
+    uint64_t target = (uint64_t)((percentile/100.0)*total + 0.5);
+    if (target < 1) {
+      target = 1;
+    }
+
+    uint64_t cumulative = 0;
+    for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+      cumulative += _buckets[i];
+      if (cumulative >= target) {
+	uint64_t upper_value = _bucketUpperValue(i);
+	return (upper_value < _max) ? upper_value : (uint64_t)_max;
+      }
+    }
+
+    return _max;
+
+  }
+
+  /**
+   * \brief A one-line summary of the histogram
+   */
+  inline std::string SickHistogram::ToString( ) const {
+
+    std::ostringstream str_stream;
+    str_stream << "count=" << GetCount()
+	       << " min=" << GetMin()
+	       << " p50=" << GetValueAtPercentile(50)
+	       << " p90=" << GetValueAtPercentile(90)
+	       << " p99=" << GetValueAtPercentile(99)
+	       << " p99.9=" << GetValueAtPercentile(99.9)
+	       << " max=" << GetMax()
+	       << " (usecs)";
+    return str_stream.str();
+
+  }
+
+  /**
+   * \brief Maps a value to its bucket
+   */
+  inline unsigned int SickHistogram::_bucketIndex( const uint64_t value ) {
+
+    const uint64_t max_value = ((uint64_t)1 << SICK_HISTOGRAM_MAX_VALUE_BITS) - 1;
+    const uint64_t clamped_value = (value < max_value) ? value : max_value;
+
+    /* Values below 2*SUB_BUCKET_COUNT are exact */
+    if (clamped_value < 2*SUB_BUCKET_COUNT) {
+      return (unsigned int)clamped_value;
+    }
+
+    /* Keep the top SUB_BUCKET_BITS+1 significant bits */
+    unsigned int msb = 63 - __builtin_clzll(clamped_value);
+    unsigned int shift = msb - SICK_HISTOGRAM_SUB_BUCKET_BITS;
+    return shift*SUB_BUCKET_COUNT + (unsigned int)(clamped_value >> shift);
+
+  }
+
+  /**
+   * \brief Largest value mapped to the given bucket
+   */
+  inline uint64_t SickHistogram::_bucketUpperValue( const unsigned int index ) {
+
+    if (index < 2*SUB_BUCKET_COUNT) {
+      return index;
+    }
+
+    unsigned int shift = index/SUB_BUCKET_COUNT - 1;
+    uint64_t sub_bucket = index%SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((sub_bucket + 1) << shift) - 1;
+
+  }
+
+  /**
+   * \brief Copies the metrics (each value is read atomically)
+   */
+  inline void SickMetrics::Snapshot( SickMetrics &snapshot ) const {
+
+    for (unsigned int i = 0; i < SICK_METRICS_NUM_COUNTERS; i++) {
+      snapshot._counters[i] = _counters[i];
+    }
+
+    _frame_inter_arrival.Snapshot(snapshot._frame_inter_arrival);
+    _delivery_latency.Snapshot(snapshot._delivery_latency);
+
+  }
+
+  /**
+   * \brief Clears every counter and histogram
+   */
+  inline void SickMetrics::Reset( ) {
+
+    for (unsigned int i = 0; i < SICK_METRICS_NUM_COUNTERS; i++) {
+      _counters[i] = 0;
+    }
+
+    _frame_inter_arrival.Reset();
+    _delivery_latency.Reset();
+
+  }
+
+  /**
+   * \brief A multi-line summary of the metrics
+   */
+  inline std::string SickMetrics::ToString( ) const {
+
+    std::ostringstream str_stream;
+
+    for (unsigned int i = 0; i < SICK_METRICS_NUM_COUNTERS; i++) {
+      str_stream << "\t" << CounterToString((sick_metrics_counter_t)i) << ": " << GetCount((sick_metrics_counter_t)i) << std::endl;
+    }
+
+    str_stream << "\tFrame inter-arrival: " << _frame_inter_arrival.ToString() << std::endl;
+    str_stream << "\tDelivery latency: " << _delivery_latency.ToString() << std::endl;
+
+    return str_stream.str();
+
+  }
+
+  /**
+   * \brief Name of a counter
+   */
+  inline std::string SickMetrics::CounterToString( const sick_metrics_counter_t counter ) {
+
+    switch (counter) {
+    case SICK_METRICS_BYTES_READ:
+      return "Bytes read";
+    case SICK_METRICS_FRAMES_RECEIVED:
+      return "Frames received";
+    case SICK_METRICS_CHECKSUM_FAILURES:
+      return "Checksum failures";
+    case SICK_METRICS_RESYNC_BYTES:
+      return "Resync bytes";
+    case SICK_METRICS_FRAMES_OVERWRITTEN:
+      return "Frames overwritten";
+    case SICK_METRICS_FRAMES_DROPPED:
+      return "Frames dropped";
+    case SICK_METRICS_READ_TIMEOUTS:
+      return "Read timeouts";
+    case SICK_METRICS_REQUEST_RETRIES:
+      return "Request retries";
+    case SICK_METRICS_RECV_TIMEOUTS:
+      return "Receive timeouts";
+    default:
+      return "Unknown";
+    }
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_METRICS */
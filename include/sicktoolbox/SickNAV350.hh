@@ -41,6 +41,8 @@
 #include "sicktoolbox/SickLIDAR.hh"
 #include "sicktoolbox/SickNAV350BufferMonitor.hh"
 #include "sicktoolbox/SickNAV350Message.hh"
+#include "sicktoolbox/SickProjection.hh"
+#include "sicktoolbox/SickScan.hh"
 #include "sicktoolbox/SickException.hh"
 #define SICK_MAX_NUM_REFLECTORS 50
 
@@ -440,6 +442,12 @@ class SickNav350 : public SickLIDAR< SickNav350BufferMonitor, SickNav350Message
         		unsigned int *sector_start_timestamp,
         		unsigned int *sector_stop_timestamp);
 
+    /**Get the last measurements as a SickScan*/
+    void GetSickScan(SickScan &sick_scan,const bool with_remission=false);
+
+    /**Get the last measurements as Cartesian points (m)*/
+    void GetSickScanAsPoints(float* x_values,float* y_values,float* z_values,unsigned int *num_points);
+
     /**Send custom message and get response*/
     void GetResponseFromCustomMessage(uint8_t *req,int req_size,uint8_t *res,int *res_size);
 
@@ -452,6 +460,9 @@ class SickNav350 : public SickLIDAR< SickNav350BufferMonitor, SickNav350Message
 	  std::string* arg;
 	  int argumentcount_;
 
+    /** Cached cos/sin tables for the last measured sector */
+    SickProjectionTable _sick_projection_table;
+
     /** The Sick LD IP address */
     std::string _sick_ip_address;
 
@@ -0,0 +1,226 @@
+/*!
+ * \file SickProjection.hh
+ * \brief Defines cached polar-to-Cartesian projection tables for the Sick drivers.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_PROJECTION
+#define SICK_PROJECTION
+
+/* Macros */
+#define SICK_PROJECTION_TABLE_ALIGNMENT               (64)  ///< Table/cache-line alignment (bytes)
+
+/* Dependencies */
+#include <new>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickProjectionTable
+   * \brief Aligned cos/sin tables for one beam layout.
+   *
+   * The table is keyed on (start angle, angular step, number of beams) and
+   * is only rebuilt by Update() when that key changes, so a driver can call
+   * Update() with its current configuration before every projection and
+   * pay for the trig only after a reconfiguration. Beam i lies at
+   * start + i*step deg, with each angle computed directly (not accumulated).
+   */
+  class SickProjectionTable {
+
+  public:
+
+    /** A standard constructor */
+    SickProjectionTable( ) : _cos_table(NULL), _sin_table(NULL), _capacity(0),
+                             _start_angle(0), _step_angle(0), _num_beams(0) { }
+
+    /** Makes sure the table matches the given layout (returns true if rebuilt) */
+    bool Update( const double start_angle, const double step_angle, const unsigned int num_beams ) throw( std::bad_alloc );
+
+    /** Drops the cached layout, forcing a rebuild on the next Update() */
+    void Invalidate( ) { _num_beams = 0; }
+
+    /** Projects ranges into x/y (and z = 0) in a single pass */
+    template < class RANGE_T >
+    void Project( const RANGE_T * const range_values,
+                  const unsigned int num_values,
+                  const float range_scale,
+                  float * const x_values,
+                  float * const y_values,
+                  float * const z_values = NULL,
+                  const unsigned int * const beam_indices = NULL ) const;
+
+    /** Number of beams in the cached layout */
+    unsigned int GetNumBeams( ) const { return _num_beams; }
+
+    /** Start angle of the cached layout (deg) */
+    double GetStartAngle( ) const { return _start_angle; }
+
+    /** Angular step of the cached layout (deg) */
+    double GetStepAngle( ) const { return _step_angle; }
+
+    /** The cos table (GetNumBeams() entries) */
+    const float * GetCosTable( ) const { return _cos_table; }
+
+    /** The sin table (GetNumBeams() entries) */
+    const float * GetSinTable( ) const { return _sin_table; }
+
+    /** A standard destructor */
+    ~SickProjectionTable( ) { free(_cos_table); free(_sin_table); }
+
+  private:
+
+    /** Aligned cos(start + i*step) */
+    float * _cos_table;
+
+    /** Aligned sin(start + i*step) */
+    float * _sin_table;
+
+    /** Number of entries allocated */
+    unsigned int _capacity;
+
+    /** Cached start angle (deg) */
+    double _start_angle;
+
+    /** Cached angular step (deg) */
+    double _step_angle;
+
+    /** Cached number of beams (0 = invalid) */
+    unsigned int _num_beams;
+
+    /** Allocates an aligned float array */
+    static float * _allocTable( const unsigned int num_entries );
+
+    /** Not copyable */
+    SickProjectionTable( const SickProjectionTable & );
+    SickProjectionTable & operator=( const SickProjectionTable & );
+
+  };
+
+  /**
+   * \brief Makes sure the table matches the given layout
+   * \param start_angle Angle of the first beam (deg)
+   * \param step_angle Angle between consecutive beams (deg)
+   * \param num_beams Number of beams
+   * \return True if the tables were (re)computed
+   */
+  inline bool SickProjectionTable::Update( const double start_angle, const double step_angle, const unsigned int num_beams ) throw( std::bad_alloc ) {
+
+    if (_num_beams == num_beams && _start_angle == start_angle && _step_angle == step_angle) {
+      return false;
+    }
+
+    /* Only grow the storage, a shrinking layout reuses it */
+    if (num_beams > _capacity) {
+      float * const cos_table = _allocTable(num_beams);
+      float * const sin_table = _allocTable(num_beams);
+      if (!cos_table || !sin_table) {
+        free(cos_table);
+        free(sin_table);
+        throw std::bad_alloc();
+      }
+      free(_cos_table);
+      free(_sin_table);
+      _cos_table = cos_table;
+      _sin_table = sin_table;
+      _capacity = num_beams;
+    }
+
+    for (unsigned int i = 0; i < num_beams; i++) {
+      const double angle = (start_angle + i*step_angle)*M_PI/180.0;
+      _cos_table[i] = (float)cos(angle);
+      _sin_table[i] = (float)sin(angle);
+    }
+
+    _start_angle = start_angle;
+    _step_angle = step_angle;
+    _num_beams = num_beams;
+
+    return true;
+
+  }
+
+  /**
+   * \brief Projects ranges into x/y (and z = 0) in a single pass
+   * \param range_values Range per beam (device units)
+   * \param num_values Number of ranges (clamped to the table size)
+   * \param range_scale Scale from device units to output units
+   * \param x_values Destination x buffer
+   * \param y_values Destination y buffer
+   * \param z_values Destination z buffer (NULL to skip)
+   * \param beam_indices Table index of each range, for compacted (see SickScanROI) scans (NULL => range i is beam i)
+   *
+   * The loop has no dependencies between beams and the buffers are declared
+   * non-aliasing, so the compiler emits packed conversions/multiplies for it.
+   */
+  template < class RANGE_T >
+  inline void SickProjectionTable::Project( const RANGE_T * const range_values,
+                                            const unsigned int num_values,
+                                            const float range_scale,
+                                            float * const x_values,
+                                            float * const y_values,
+                                            float * const z_values,
+                                            const unsigned int * const beam_indices ) const {
+
+    const RANGE_T * __restrict__ r = range_values;
+    const float * __restrict__ c = _cos_table;
+    const float * __restrict__ s = _sin_table;
+    float * __restrict__ x = x_values;
+    float * __restrict__ y = y_values;
+
+    unsigned int n = 0;
+    if (!beam_indices) {
+
+      n = (num_values < _num_beams) ? num_values : _num_beams;
+      for (unsigned int i = 0; i < n; i++) {
+        const float range = (float)r[i]*range_scale;
+        x[i] = range*c[i];
+        y[i] = range*s[i];
+      }
+
+    }
+    else {
+
+      /* Gather the table entries of the selected beams */
+      for (n = 0; n < num_values && beam_indices[n] < _num_beams; n++) {
+        const float range = (float)r[n]*range_scale;
+        x[n] = range*c[beam_indices[n]];
+        y[n] = range*s[beam_indices[n]];
+      }
+
+    }
+
+    if (z_values) {
+      memset(z_values,0,n*sizeof(float));
+    }
+
+  }
+
+  /**
+   * \brief Allocates an aligned float array
+   * \param num_entries Number of floats
+   * \return The array (NULL on failure)
+   */
+  inline float * SickProjectionTable::_allocTable( const unsigned int num_entries ) {
+    void *table = NULL;
+    if (posix_memalign(&table,SICK_PROJECTION_TABLE_ALIGNMENT,num_entries*sizeof(float)) != 0) {
+      return NULL;
+    }
+    return (float *)table;
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_PROJECTION */
@@ -0,0 +1,496 @@
+/*!
+ * \file SickScan.hh
+ * \brief Defines a struct-of-arrays scan container shared by the Sick drivers.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN
+#define SICK_SCAN
+
+/* Macros */
+#define SICK_SCAN_ALIGNMENT                           (64)  ///< Alignment of each per-beam array (bytes)
+#define SICK_SCAN_POOL_MIN_CAPACITY                 (1024)  ///< Beams held by the smallest pooled block
+#define SICK_SCAN_POOL_NUM_CLASSES                     (8)  ///< Pooled block sizes (MIN_CAPACITY << 0..7 beams)
+#define SICK_SCAN_POOL_MAX_FREE_BLOCKS                 (8)  ///< Free blocks kept per size class
+
+/* Dependencies */
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickScanPool
+   * \brief A thread-safe pool of aligned scan storage blocks.
+   *
+   * Blocks are binned into power-of-2 size classes, so a scan that is
+   * refilled every cycle (or handed between threads) recycles the same
+   * memory instead of going through the allocator. Requests larger than
+   * the largest class are served (and freed) directly.
+   */
+  class SickScanPool {
+
+  public:
+
+    /** A standard constructor */
+    SickScanPool( const unsigned int max_free_blocks = SICK_SCAN_POOL_MAX_FREE_BLOCKS ) throw( SickThreadException );
+
+    /** Grabs a block for at least capacity beams (capacity is rounded up) */
+    void * Acquire( unsigned int &capacity ) throw( std::bad_alloc );
+
+    /** Returns a block obtained from Acquire */
+    void Release( void * const block, const unsigned int capacity );
+
+    /** Number of free blocks currently held */
+    unsigned int GetNumFreeBlocks( ) const;
+
+    /** Bytes needed for one per-beam array of capacity beams */
+    static size_t GetArrayStride( const unsigned int capacity ) {
+      return ((capacity*sizeof(float) + SICK_SCAN_ALIGNMENT - 1)/SICK_SCAN_ALIGNMENT)*SICK_SCAN_ALIGNMENT;
+    }
+
+    /** The process-wide pool used by default */
+    static SickScanPool & Default( );
+
+    /** A standard destructor */
+    ~SickScanPool( );
+
+  private:
+
+    /** Guards the free lists */
+    mutable pthread_mutex_t _pool_mutex;
+
+    /** Free blocks per size class */
+    std::vector< void * > _free_blocks[SICK_SCAN_POOL_NUM_CLASSES];
+
+    /** Free blocks kept per size class */
+    unsigned int _max_free_blocks;
+
+    /** Size class for the given capacity (-1 => not pooled) */
+    static int _sizeClass( const unsigned int capacity );
+
+    /** Not copyable */
+    SickScanPool( const SickScanPool & );
+    SickScanPool & operator=( const SickScanPool & );
+
+  };
+
+  /**
+   * \class SickScan
+   * \brief One scan as aligned, parallel per-beam arrays.
+   *
+   * Every driver fills the same layout: range (m), angle (deg, in the device
+   * frame), intensity (raw device units, 0 if not streamed), flags and the
+   * time offset (usecs) of each beam relative to the first one. Each array
+   * starts on a SICK_SCAN_ALIGNMENT boundary and all of them live in a single
+   * block drawn from a SickScanPool.
+   */
+  class SickScan {
+
+  public:
+
+    /*!
+     * \enum sick_scan_flag_t
+     * \brief Per-beam flag bits
+     */
+    enum sick_scan_flag_t {
+      SICK_SCAN_FLAG_NONE = 0x00,                                                       ///< Nothing to report
+      SICK_SCAN_FLAG_NO_RETURN = 0x01,                                                  ///< No echo was received (range is 0)
+      SICK_SCAN_FLAG_FIELD_A = 0x02,                                                    ///< LMS 2xx field A was set
+      SICK_SCAN_FLAG_FIELD_B = 0x04,                                                    ///< LMS 2xx field B was set
+      SICK_SCAN_FLAG_FIELD_C = 0x08,                                                    ///< LMS 2xx field C (or dazzle) was set
+      SICK_SCAN_FLAG_SECTOR_START = 0x10,                                               ///< First beam of a (LD) sector
+      SICK_SCAN_FLAG_FILTERED = 0x20                                                    ///< Range was zeroed by a SickScanFilter
+    };
+
+    /*!
+     * \struct sick_scan_header_tag
+     * \brief Per-scan metadata
+     */
+    /*!
+     * \typedef sick_scan_header_t
+     * \brief Adopt c-style convention
+     */
+    typedef struct sick_scan_header_tag {
+      uint32_t sick_scan_index;                                                         ///< Scan/telegram counter reported by the device
+      uint32_t sick_device_timestamp;                                                   ///< Device time of the first beam (device units, 0 => not reported)
+      struct timeval sick_host_time;                                                    ///< Host time at which the scan was filled
+      uint64_t sick_device_host_time;                                                   ///< Host time (CLOCK_MONOTONIC usecs) of sick_device_timestamp per a device clock sync (0 => not synchronized)
+      float sick_scan_period;                                                           ///< Nominal duration of one revolution (usecs, 0 => unknown)
+    } sick_scan_header_t;
+
+    /** A standard constructor */
+    SickScan( SickScanPool &sick_scan_pool = SickScanPool::Default() );
+
+    /** Makes room for num_beams beams (keeps the current contents) */
+    void Reserve( const unsigned int num_beams ) throw( std::bad_alloc );
+
+    /** Sets the number of beams (keeps the current contents) */
+    void Resize( const unsigned int num_beams ) throw( std::bad_alloc ) { Reserve(num_beams); _num_beams = num_beams; }
+
+    /** Drops all beams (keeps the storage) */
+    void Clear( ) { _num_beams = 0; }
+
+    /** Exchanges contents (and storage) with another scan */
+    void Swap( SickScan &sick_scan );
+
+    /** Copies the contents of another scan */
+    void CopyFrom( const SickScan &sick_scan ) throw( std::bad_alloc );
+
+    /** Fills angles[offset..offset+count) with start + i*step (deg) */
+    void FillAngles( const unsigned int offset, const unsigned int count, const double start_angle, const double step_angle );
+
+    /** Fills time_offsets[offset..offset+count) with start + i*step (usecs) */
+    void FillTimeOffsets( const unsigned int offset, const unsigned int count, const double start_offset, const double step_offset );
+
+    /** Number of beams */
+    unsigned int GetNumBeams( ) const { return _num_beams; }
+
+    /** Number of beams that fit without reallocating */
+    unsigned int GetCapacity( ) const { return _capacity; }
+
+    /** Range per beam (m) */
+    float * GetRangeValues( ) { return _range_values; }
+    const float * GetRangeValues( ) const { return _range_values; }
+
+    /** Angle per beam (deg) */
+    float * GetAngleValues( ) { return _angle_values; }
+    const float * GetAngleValues( ) const { return _angle_values; }
+
+    /** Intensity per beam (device units) */
+    float * GetIntensityValues( ) { return _intensity_values; }
+    const float * GetIntensityValues( ) const { return _intensity_values; }
+
+    /** Flags per beam (sick_scan_flag_t bits) */
+    uint32_t * GetFlagValues( ) { return _flag_values; }
+    const uint32_t * GetFlagValues( ) const { return _flag_values; }
+
+    /** Time offset per beam relative to the first beam (usecs) */
+    float * GetTimeOffsets( ) { return _time_offsets; }
+    const float * GetTimeOffsets( ) const { return _time_offsets; }
+
+    /** Per-scan metadata */
+    sick_scan_header_t & GetHeader( ) { return _header; }
+    const sick_scan_header_t & GetHeader( ) const { return _header; }
+
+    /** A standard destructor */
+    ~SickScan( ) { _releaseBlock(); }
+
+  private:
+
+    /** The pool backing this scan */
+    SickScanPool *_sick_scan_pool;
+
+    /** The storage block (NULL => none) */
+    void *_block;
+
+    /** Beams that fit in the block */
+    unsigned int _capacity;
+
+    /** Current number of beams */
+    unsigned int _num_beams;
+
+    /** Per-beam arrays (all inside _block) */
+    float *_range_values;
+    float *_angle_values;
+    float *_intensity_values;
+    uint32_t *_flag_values;
+    float *_time_offsets;
+
+    /** Per-scan metadata */
+    sick_scan_header_t _header;
+
+    /** Points the per-beam arrays into the given block */
+    void _assignBlock( void * const block, const unsigned int capacity );
+
+    /** Hands the block back to the pool */
+    void _releaseBlock( );
+
+    /** Not copyable (use CopyFrom/Swap) */
+    SickScan( const SickScan & );
+    SickScan & operator=( const SickScan & );
+
+  };
+
+  /**
+   * \brief A standard constructor
+   * \param max_free_blocks Free blocks kept per size class
+   */
+  inline SickScanPool::SickScanPool( const unsigned int max_free_blocks ) throw( SickThreadException ) : _max_free_blocks(max_free_blocks) {
+    if (pthread_mutex_init(&_pool_mutex,NULL) != 0) {
+      throw SickThreadException("SickScanPool::SickScanPool: pthread_mutex_init() failed!");
+    }
+  }
+
+  /**
+   * \brief Grabs a block for at least capacity beams
+   * \param capacity Requested number of beams (set to the block's actual capacity)
+   * \return The block (SICK_SCAN_ALIGNMENT aligned)
+   */
+  inline void * SickScanPool::Acquire( unsigned int &capacity ) throw( std::bad_alloc ) {
+
+    const int size_class = _sizeClass(capacity);
+    if (size_class >= 0) {
+
+      capacity = SICK_SCAN_POOL_MIN_CAPACITY << size_class;
+
+      pthread_mutex_lock(&_pool_mutex);
+      if (!_free_blocks[size_class].empty()) {
+        void * const block = _free_blocks[size_class].back();
+        _free_blocks[size_class].pop_back();
+        pthread_mutex_unlock(&_pool_mutex);
+        return block;
+      }
+      pthread_mutex_unlock(&_pool_mutex);
+
+    }
+
+    void *block = NULL;
+    if (posix_memalign(&block,SICK_SCAN_ALIGNMENT,5*GetArrayStride(capacity)) != 0) {
+      throw std::bad_alloc();
+    }
+
+    return block;
+
+  }
+
+  /**
+   * \brief Returns a block obtained from Acquire
+   * \param block The block
+   * \param capacity The capacity reported by Acquire
+   */
+  inline void SickScanPool::Release( void * const block, const unsigned int capacity ) {
+
+    const int size_class = _sizeClass(capacity);
+    if (size_class >= 0) {
+
+      pthread_mutex_lock(&_pool_mutex);
+      if (_free_blocks[size_class].size() < _max_free_blocks) {
+        _free_blocks[size_class].push_back(block);
+        pthread_mutex_unlock(&_pool_mutex);
+        return;
+      }
+      pthread_mutex_unlock(&_pool_mutex);
+
+    }
+
+    free(block);
+
+  }
+
+  /**
+   * \brief Number of free blocks currently held
+   */
+  inline unsigned int SickScanPool::GetNumFreeBlocks( ) const {
+
+    unsigned int num_free_blocks = 0;
+
+    pthread_mutex_lock(&_pool_mutex);
+    for (unsigned int i = 0; i < SICK_SCAN_POOL_NUM_CLASSES; i++) {
+      num_free_blocks += _free_blocks[i].size();
+    }
+    pthread_mutex_unlock(&_pool_mutex);
+
+    return num_free_blocks;
+
+  }
+
+  /**
+   * \brief The process-wide pool used by default
+   */
+  inline SickScanPool & SickScanPool::Default( ) {
+    static SickScanPool sick_scan_pool;
+    return sick_scan_pool;
+  }
+
+  /**
+   * \brief A standard destructor
+   */
+  inline SickScanPool::~SickScanPool( ) {
+
+    for (unsigned int i = 0; i < SICK_SCAN_POOL_NUM_CLASSES; i++) {
+      for (unsigned int j = 0; j < _free_blocks[i].size(); j++) {
+        free(_free_blocks[i][j]);
+      }
+    }
+
+    pthread_mutex_destroy(&_pool_mutex);
+
+  }
+
+  /**
+   * \brief Size class for the given capacity
+   * \param capacity Requested number of beams
+   * \return The smallest class that fits (-1 => too large to pool)
+   */
+  inline int SickScanPool::_sizeClass( const unsigned int capacity ) {
+    for (int i = 0; i < SICK_SCAN_POOL_NUM_CLASSES; i++) {
+      if (capacity <= ((unsigned int)SICK_SCAN_POOL_MIN_CAPACITY << i)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * \brief A standard constructor
+   * \param sick_scan_pool The pool to draw storage from
+   */
+  inline SickScan::SickScan( SickScanPool &sick_scan_pool ) : _sick_scan_pool(&sick_scan_pool), _block(NULL), _capacity(0), _num_beams(0),
+                                                             _range_values(NULL), _angle_values(NULL), _intensity_values(NULL),
+                                                             _flag_values(NULL), _time_offsets(NULL) {
+    memset(&_header,0,sizeof(sick_scan_header_t));
+  }
+
+  /**
+   * \brief Makes room for num_beams beams
+   * \param num_beams Required number of beams
+   */
+  inline void SickScan::Reserve( const unsigned int num_beams ) throw( std::bad_alloc ) {
+
+    if (num_beams <= _capacity) {
+      return;
+    }
+
+    unsigned int capacity = num_beams;
+    void * const block = _sick_scan_pool->Acquire(capacity);
+
+    /* Carry over the current beams */
+    const size_t old_stride = SickScanPool::GetArrayStride(_capacity);
+    const size_t new_stride = SickScanPool::GetArrayStride(capacity);
+    for (unsigned int i = 0; _block && i < 5; i++) {
+      memcpy((uint8_t *)block + i*new_stride,(uint8_t *)_block + i*old_stride,_num_beams*sizeof(float));
+    }
+
+    const unsigned int num_kept_beams = _num_beams;
+    _releaseBlock();
+    _assignBlock(block,capacity);
+    _num_beams = num_kept_beams;
+
+  }
+
+  /**
+   * \brief Exchanges contents (and storage) with another scan
+   * \param sick_scan The other scan
+   */
+  inline void SickScan::Swap( SickScan &sick_scan ) {
+
+    std::swap(_sick_scan_pool,sick_scan._sick_scan_pool);
+    std::swap(_block,sick_scan._block);
+    std::swap(_capacity,sick_scan._capacity);
+    std::swap(_num_beams,sick_scan._num_beams);
+    std::swap(_range_values,sick_scan._range_values);
+    std::swap(_angle_values,sick_scan._angle_values);
+    std::swap(_intensity_values,sick_scan._intensity_values);
+    std::swap(_flag_values,sick_scan._flag_values);
+    std::swap(_time_offsets,sick_scan._time_offsets);
+    std::swap(_header,sick_scan._header);
+
+  }
+
+  /**
+   * \brief Copies the contents of another scan
+   * \param sick_scan The scan to copy
+   */
+  inline void SickScan::CopyFrom( const SickScan &sick_scan ) throw( std::bad_alloc ) {
+
+    if (&sick_scan == this) {
+      return;
+    }
+
+    Resize(sick_scan._num_beams);
+
+    const size_t num_bytes = _num_beams*sizeof(float);
+    memcpy(_range_values,sick_scan._range_values,num_bytes);
+    memcpy(_angle_values,sick_scan._angle_values,num_bytes);
+    memcpy(_intensity_values,sick_scan._intensity_values,num_bytes);
+    memcpy(_flag_values,sick_scan._flag_values,num_bytes);
+    memcpy(_time_offsets,sick_scan._time_offsets,num_bytes);
+
+    _header = sick_scan._header;
+
+  }
+
+  /**
+   * \brief Fills a run of angles with start + i*step
+   * \param offset Index of the first beam
+   * \param count Number of beams
+   * \param start_angle Angle of the first beam (deg)
+   * \param step_angle Angle between consecutive beams (deg)
+   */
+  inline void SickScan::FillAngles( const unsigned int offset, const unsigned int count, const double start_angle, const double step_angle ) {
+    float * __restrict__ angle_values = &_angle_values[offset];
+    for (unsigned int i = 0; i < count; i++) {
+      angle_values[i] = (float)(start_angle + i*step_angle);
+    }
+  }
+
+  /**
+   * \brief Fills a run of time offsets with start + i*step
+   * \param offset Index of the first beam
+   * \param count Number of beams
+   * \param start_offset Time offset of the first beam (usecs)
+   * \param step_offset Time between consecutive beams (usecs)
+   */
+  inline void SickScan::FillTimeOffsets( const unsigned int offset, const unsigned int count, const double start_offset, const double step_offset ) {
+    float * __restrict__ time_offsets = &_time_offsets[offset];
+    for (unsigned int i = 0; i < count; i++) {
+      time_offsets[i] = (float)(start_offset + i*step_offset);
+    }
+  }
+
+  /**
+   * \brief Points the per-beam arrays into the given block
+   * \param block The storage block
+   * \param capacity Beams that fit in the block
+   */
+  inline void SickScan::_assignBlock( void * const block, const unsigned int capacity ) {
+
+    const size_t stride = SickScanPool::GetArrayStride(capacity);
+
+    _block = block;
+    _capacity = capacity;
+    _range_values = (float *)block;
+    _angle_values = (float *)((uint8_t *)block + stride);
+    _intensity_values = (float *)((uint8_t *)block + 2*stride);
+    _flag_values = (uint32_t *)((uint8_t *)block + 3*stride);
+    _time_offsets = (float *)((uint8_t *)block + 4*stride);
+
+  }
+
+  /**
+   * \brief Hands the block back to the pool
+   */
+  inline void SickScan::_releaseBlock( ) {
+
+    if (_block) {
+      _sick_scan_pool->Release(_block,_capacity);
+    }
+
+    _block = NULL;
+    _capacity = _num_beams = 0;
+    _range_values = _angle_values = _intensity_values = _time_offsets = NULL;
+    _flag_values = NULL;
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN */
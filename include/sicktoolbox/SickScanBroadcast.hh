@@ -0,0 +1,438 @@
+/*!
+ * \file SickScanBroadcast.hh
+ * \brief Defines an in-process broadcast queue for decoded scans.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_BROADCAST
+#define SICK_SCAN_BROADCAST
+
+/* Macros */
+#define DEFAULT_SICK_BROADCAST_NUM_SLOTS                         (16)  ///< Number of scans retained for subscribers
+
+/* Dependencies */
+#include <vector>
+#include <errno.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  class SickScanBroadcast;
+
+  /**
+   * \class SickScanPayload
+   * \brief A decoded scan shared (by reference) between subscribers.
+   *
+   * Payloads come from SickScanBroadcast::AcquirePayload and are recycled
+   * once the last reference is dropped, so the vectors keep their capacity
+   * and steady-state publishing does not allocate.
+   */
+  class SickScanPayload {
+
+    friend class SickScanBroadcast;
+    friend class SickScanSubscriber;
+    friend class SickScanRef;
+
+  public:
+
+    uint64_t sick_timestamp;                                           ///< Acquisition time (usecs since the epoch)
+    unsigned int sick_sensor_id;                                       ///< Application-defined sensor id
+    double sick_start_angle;                                           ///< Angle of the first value (deg)
+    double sick_angle_step;                                            ///< Angular step between values (deg)
+    std::vector< double > sick_range_values;                           ///< Range values (units are up to the producer)
+    std::vector< unsigned int > sick_reflect_values;                   ///< Reflectivity values (may be empty)
+
+  private:
+
+    /** The broadcast the payload is recycled into */
+    SickScanBroadcast *_sick_broadcast;
+
+    /** Number of outstanding references */
+    volatile int _sick_ref_count;
+
+    /** Payloads are created by the broadcast */
+    SickScanPayload( SickScanBroadcast * const sick_broadcast ) :
+      sick_timestamp(0), sick_sensor_id(0), sick_start_angle(0), sick_angle_step(0),
+      _sick_broadcast(sick_broadcast), _sick_ref_count(0) { }
+
+    /** Adds a reference */
+    void _addRef( ) { __sync_fetch_and_add(&_sick_ref_count,1); }
+
+    /** Drops a reference (recycling the payload on the last one) */
+    void _release( );
+
+  };
+
+  /**
+   * \class SickScanRef
+   * \brief A counted reference to a (read-only) payload
+   */
+  class SickScanRef {
+
+    friend class SickScanSubscriber;
+
+  public:
+
+    /** An empty reference */
+    SickScanRef( ) : _sick_payload(NULL) { }
+
+    /** Shares another reference */
+    SickScanRef( const SickScanRef &sick_ref ) : _sick_payload(sick_ref._sick_payload) {
+      if (_sick_payload) {
+	_sick_payload->_addRef();
+      }
+    }
+
+    /** Shares another reference */
+    SickScanRef & operator=( const SickScanRef &sick_ref ) {
+      if (sick_ref._sick_payload) {
+	sick_ref._sick_payload->_addRef();
+      }
+      Reset();
+      _sick_payload = sick_ref._sick_payload;
+      return *this;
+    }
+
+    /** Drops the reference */
+    void Reset( ) {
+      if (_sick_payload) {
+	_sick_payload->_release();
+	_sick_payload = NULL;
+      }
+    }
+
+    /** Indicates whether a payload is referenced */
+    bool IsValid( ) const { return _sick_payload != NULL; }
+
+    /** The payload */
+    const SickScanPayload & operator*( ) const { return *_sick_payload; }
+
+    /** The payload */
+    const SickScanPayload * operator->( ) const { return _sick_payload; }
+
+    /** A standard destructor */
+    ~SickScanRef( ) { Reset(); }
+
+  private:
+
+    /** The payload */
+    SickScanPayload *_sick_payload;
+
+    /** Takes over an existing reference */
+    void _adopt( SickScanPayload * const sick_payload ) {
+      Reset();
+      _sick_payload = sick_payload;
+    }
+
+  };
+
+  /**
+   * \class SickScanBroadcast
+   * \brief Delivers every published scan to every subscriber.
+   *
+   * The producer never waits on a subscriber: the broadcast retains the last
+   * num_slots scans, and a subscriber that falls further behind skips ahead
+   * (see SickScanSubscriber::GetNumLost). Each scan is stored once and shared
+   * by reference, so adding subscribers costs no copies.
+   *
+   * Example:
+   *   SickScanPayload *payload = sick_broadcast.AcquirePayload();
+   *   payload->sick_range_values.resize(num_values);
+   *   sick_ld.GetSickMeasurements(&payload->sick_range_values[0],...);
+   *   sick_broadcast.Publish(payload);
+   *
+   * NOTE: The broadcast must outlive its subscribers and any SickScanRef.
+   */
+  class SickScanBroadcast {
+
+    friend class SickScanPayload;
+    friend class SickScanSubscriber;
+
+  public:
+
+    /** A standard constructor */
+    SickScanBroadcast( const unsigned int num_slots = DEFAULT_SICK_BROADCAST_NUM_SLOTS ) throw( SickThreadException );
+
+    /** Gets an empty payload for the producer to fill in */
+    SickScanPayload * AcquirePayload( ) throw( SickThreadException );
+
+    /** Publishes a filled payload (ownership passes to the broadcast) */
+    void Publish( SickScanPayload * const sick_payload ) throw( SickThreadException );
+
+    /** Number of scans published so far */
+    uint64_t GetNumPublished( ) throw( SickThreadException );
+
+    /** A standard destructor */
+    ~SickScanBroadcast( );
+
+  private:
+
+    /** The retained scans (scan n lives in slot n % num_slots) */
+    std::vector< SickScanPayload * > _sick_slots;
+
+    /** Number of scans published */
+    uint64_t _sick_num_published;
+
+    /** Recycled payloads */
+    std::vector< SickScanPayload * > _sick_free_payloads;
+
+    /** Guards the slots and the publish count */
+    pthread_mutex_t _sick_slot_mutex;
+
+    /** Signalled on every publish */
+    pthread_cond_t _sick_slot_cond;
+
+    /** Guards the free list */
+    pthread_mutex_t _sick_free_mutex;
+
+    /** Returns a payload to the free list */
+    void _recycle( SickScanPayload * const sick_payload );
+
+  };
+
+  /**
+   * \class SickScanSubscriber
+   * \brief A cursor into a SickScanBroadcast (one per consuming thread)
+   */
+  class SickScanSubscriber {
+
+  public:
+
+    /** Subscribes to the scans published from now on */
+    SickScanSubscriber( SickScanBroadcast &sick_broadcast ) throw( SickThreadException );
+
+    /** Gets the next scan for this subscriber (waits up to timeout_value usecs) */
+    void GetNextScan( SickScanRef &sick_scan, const unsigned int timeout_value ) throw( SickTimeoutException, SickThreadException );
+
+    /** Number of scans skipped because this subscriber fell behind */
+    uint64_t GetNumLost( ) const { return _sick_num_lost; }
+
+  private:
+
+    /** The broadcast */
+    SickScanBroadcast &_sick_broadcast;
+
+    /** Next scan wanted */
+    uint64_t _sick_next_scan_index;
+
+    /** Number of scans skipped */
+    uint64_t _sick_num_lost;
+
+  };
+
+  /**
+   * \brief Drops a reference
+   */
+  inline void SickScanPayload::_release( ) {
+
+    if (__sync_sub_and_fetch(&_sick_ref_count,1) == 0) {
+      _sick_broadcast->_recycle(this);
+    }
+
+  }
+
+  /**
+   * \brief Primary constructor
+   * \param num_slots Number of scans retained for slow subscribers
+   */
+  inline SickScanBroadcast::SickScanBroadcast( const unsigned int num_slots ) throw( SickThreadException ) :
+    _sick_slots(num_slots > 0 ? num_slots : 1,(SickScanPayload *)NULL), _sick_num_published(0) {
+
+    if (pthread_mutex_init(&_sick_slot_mutex,NULL) != 0) {
+      throw SickThreadException("SickScanBroadcast::SickScanBroadcast: pthread_mutex_init() failed!");
+    }
+
+    if (pthread_cond_init(&_sick_slot_cond,NULL) != 0) {
+      pthread_mutex_destroy(&_sick_slot_mutex);
+      throw SickThreadException("SickScanBroadcast::SickScanBroadcast: pthread_cond_init() failed!");
+    }
+
+    if (pthread_mutex_init(&_sick_free_mutex,NULL) != 0) {
+      pthread_cond_destroy(&_sick_slot_cond);
+      pthread_mutex_destroy(&_sick_slot_mutex);
+      throw SickThreadException("SickScanBroadcast::SickScanBroadcast: pthread_mutex_init() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Gets an empty payload (recycled if possible)
+   * \return A payload holding one reference, owned by the caller until published
+   */
+  inline SickScanPayload * SickScanBroadcast::AcquirePayload( ) throw( SickThreadException ) {
+
+    SickScanPayload *sick_payload = NULL;
+
+    if (pthread_mutex_lock(&_sick_free_mutex) != 0) {
+      throw SickThreadException("SickScanBroadcast::AcquirePayload: pthread_mutex_lock() failed!");
+    }
+
+    if (!_sick_free_payloads.empty()) {
+      sick_payload = _sick_free_payloads.back();
+      _sick_free_payloads.pop_back();
+    }
+
+    pthread_mutex_unlock(&_sick_free_mutex);
+
+    if (!sick_payload) {
+      sick_payload = new SickScanPayload(this);
+    }
+
+    /* Clear the old contents (the capacity is kept) */
+    sick_payload->sick_timestamp = 0;
+    sick_payload->sick_sensor_id = 0;
+    sick_payload->sick_start_angle = 0;
+    sick_payload->sick_angle_step = 0;
+    sick_payload->sick_range_values.clear();
+    sick_payload->sick_reflect_values.clear();
+    sick_payload->_sick_ref_count = 1;
+
+    return sick_payload;
+
+  }
+
+  /**
+   * \brief Publishes a payload and wakes up the subscribers
+   * \param *sick_payload A payload from AcquirePayload
+   */
+  inline void SickScanBroadcast::Publish( SickScanPayload * const sick_payload ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sick_slot_mutex) != 0) {
+      sick_payload->_release();
+      throw SickThreadException("SickScanBroadcast::Publish: pthread_mutex_lock() failed!");
+    }
+
+    /* Replace the oldest scan */
+    SickScanPayload *&sick_slot = _sick_slots[_sick_num_published % _sick_slots.size()];
+    SickScanPayload *old_payload = sick_slot;
+    sick_slot = sick_payload;
+    _sick_num_published++;
+
+    pthread_cond_broadcast(&_sick_slot_cond);
+    pthread_mutex_unlock(&_sick_slot_mutex);
+
+    /* Subscribers still holding the old scan keep it alive */
+    if (old_payload) {
+      old_payload->_release();
+    }
+
+  }
+
+  /**
+   * \brief Number of scans published so far
+   */
+  inline uint64_t SickScanBroadcast::GetNumPublished( ) throw( SickThreadException ) {
+
+    if (pthread_mutex_lock(&_sick_slot_mutex) != 0) {
+      throw SickThreadException("SickScanBroadcast::GetNumPublished: pthread_mutex_lock() failed!");
+    }
+
+    uint64_t num_published = _sick_num_published;
+    pthread_mutex_unlock(&_sick_slot_mutex);
+
+    return num_published;
+
+  }
+
+  /**
+   * \brief Destructor
+   */
+  inline SickScanBroadcast::~SickScanBroadcast( ) {
+
+    /* Drop the retained scans (they land on the free list) */
+    for (unsigned int i = 0; i < _sick_slots.size(); i++) {
+      if (_sick_slots[i]) {
+	_sick_slots[i]->_release();
+      }
+    }
+
+    for (unsigned int i = 0; i < _sick_free_payloads.size(); i++) {
+      delete _sick_free_payloads[i];
+    }
+
+    pthread_mutex_destroy(&_sick_free_mutex);
+    pthread_cond_destroy(&_sick_slot_cond);
+    pthread_mutex_destroy(&_sick_slot_mutex);
+
+  }
+
+  /**
+   * \brief Returns a payload to the free list
+   */
+  inline void SickScanBroadcast::_recycle( SickScanPayload * const sick_payload ) {
+
+    pthread_mutex_lock(&_sick_free_mutex);
+    _sick_free_payloads.push_back(sick_payload);
+    pthread_mutex_unlock(&_sick_free_mutex);
+
+  }
+
+  /**
+   * \brief Primary constructor
+   * \param &sick_broadcast The broadcast to follow
+   */
+  inline SickScanSubscriber::SickScanSubscriber( SickScanBroadcast &sick_broadcast ) throw( SickThreadException ) :
+    _sick_broadcast(sick_broadcast), _sick_next_scan_index(sick_broadcast.GetNumPublished()), _sick_num_lost(0) { }
+
+  /**
+   * \brief Gets the next scan for this subscriber
+   * \param &sick_scan Set to reference the scan
+   * \param timeout_value Max time to wait (usecs)
+   */
+  inline void SickScanSubscriber::GetNextScan( SickScanRef &sick_scan, const unsigned int timeout_value ) throw( SickTimeoutException, SickThreadException ) {
+
+    /* Compute the deadline */
+    struct timeval curr_time;
+    gettimeofday(&curr_time,NULL);
+
+    struct timespec deadline;
+    uint64_t deadline_usecs = (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_usec + timeout_value;
+    deadline.tv_sec = deadline_usecs/1000000;
+    deadline.tv_nsec = (deadline_usecs%1000000)*1000;
+
+    if (pthread_mutex_lock(&_sick_broadcast._sick_slot_mutex) != 0) {
+      throw SickThreadException("SickScanSubscriber::GetNextScan: pthread_mutex_lock() failed!");
+    }
+
+    /* Wait for something new */
+    while (_sick_next_scan_index >= _sick_broadcast._sick_num_published) {
+      if (pthread_cond_timedwait(&_sick_broadcast._sick_slot_cond,&_sick_broadcast._sick_slot_mutex,&deadline) == ETIMEDOUT &&
+	  _sick_next_scan_index >= _sick_broadcast._sick_num_published) {
+	pthread_mutex_unlock(&_sick_broadcast._sick_slot_mutex);
+	throw SickTimeoutException("SickScanSubscriber::GetNextScan: No scan was published in time!");
+      }
+    }
+
+    /* Skip whatever has been replaced */
+    const uint64_t num_slots = _sick_broadcast._sick_slots.size();
+    if (_sick_broadcast._sick_num_published - _sick_next_scan_index > num_slots) {
+      _sick_num_lost += _sick_broadcast._sick_num_published - num_slots - _sick_next_scan_index;
+      _sick_next_scan_index = _sick_broadcast._sick_num_published - num_slots;
+    }
+
+    SickScanPayload *sick_payload = _sick_broadcast._sick_slots[_sick_next_scan_index % num_slots];
+    sick_payload->_addRef();
+    _sick_next_scan_index++;
+
+    pthread_mutex_unlock(&_sick_broadcast._sick_slot_mutex);
+
+    sick_scan._adopt(sick_payload);
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_BROADCAST */
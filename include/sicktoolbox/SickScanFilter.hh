@@ -0,0 +1,562 @@
+/*!
+ * \file SickScanFilter.hh
+ * \brief Defines a chainable in-place filter pipeline for SickScan buffers.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_FILTER
+#define SICK_SCAN_FILTER
+
+/* Macros */
+#define SICK_SCAN_FILTER_ARENA_NUM_BUFFERS             (2)  ///< Scratch arrays held by an arena
+#define SICK_SCAN_FILTER_MAX_MEDIAN_WINDOW             (9)  ///< Largest supported median window
+#define SICK_SCAN_FILTER_SHADOW_MAX_GAP_STEPS        (2.0)  ///< Neighbours more than this many nominal steps apart are not compared
+#define SICK_SCAN_FILTER_SHADOW_MAX_GAP              (5.0)  ///< Neighbours more than this far apart are never compared (deg)
+
+/* Dependencies */
+#include <new>
+#include <vector>
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "SickScan.hh"
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickScanFilterArena
+   * \brief Pre-sized, aligned scratch arrays shared by the filters of a chain.
+   *
+   * The arena only ever grows, so once it has been reserved for a sensor's
+   * scan size filtering never touches the allocator.
+   */
+  class SickScanFilterArena {
+
+  public:
+
+    /** A standard constructor */
+    SickScanFilterArena( ) : _block(NULL), _capacity(0) { }
+
+    /** Makes sure each scratch array holds at least num_beams floats */
+    void Reserve( const unsigned int num_beams ) throw( std::bad_alloc );
+
+    /** Beams held by each scratch array */
+    unsigned int GetCapacity( ) const { return _capacity; }
+
+    /** The given scratch array (0 .. SICK_SCAN_FILTER_ARENA_NUM_BUFFERS-1) */
+    float * GetBuffer( const unsigned int buffer_index ) { return _block + buffer_index*_stride(_capacity); }
+
+    /** A standard destructor */
+    ~SickScanFilterArena( ) { free(_block); }
+
+  private:
+
+    /** Single block holding all scratch arrays */
+    float * _block;
+
+    /** Beams held by each scratch array */
+    unsigned int _capacity;
+
+    /** Floats between consecutive (aligned) scratch arrays */
+    static size_t _stride( const unsigned int capacity ) {
+      const size_t floats_per_line = SICK_SCAN_ALIGNMENT/sizeof(float);
+      return ((capacity + floats_per_line - 1)/floats_per_line)*floats_per_line;
+    }
+
+    /** Not copyable */
+    SickScanFilterArena( const SickScanFilterArena & );
+    SickScanFilterArena & operator=( const SickScanFilterArena & );
+
+  };
+
+  /**
+   * \class SickScanFilter
+   * \brief Interface of a filter operating in place on a SickScan.
+   *
+   * Filters never remove beams (so indices, angles and time offsets stay
+   * valid). A rejected beam has its range set to 0 and is flagged with
+   * SICK_SCAN_FLAG_FILTERED; beams without a return are left alone.
+   */
+  class SickScanFilter {
+
+  public:
+
+    /** Filters the scan in place (the arena is reserved for the scan's size) */
+    virtual void Apply( SickScan &sick_scan, SickScanFilterArena &sick_scan_arena ) const = 0;
+
+    /** A standard destructor */
+    virtual ~SickScanFilter( ) { }
+
+  };
+
+  /**
+   * \class SickScanRangeClipFilter
+   * \brief Rejects ranges outside [min,max].
+   */
+  class SickScanRangeClipFilter : public SickScanFilter {
+
+  public:
+
+    /** A standard constructor (m, max_range = 0 => no upper limit) */
+    SickScanRangeClipFilter( const double min_range, const double max_range ) throw( SickConfigException );
+
+    /** Filters the scan in place */
+    void Apply( SickScan &sick_scan, SickScanFilterArena &sick_scan_arena ) const;
+
+  private:
+
+    /** Minimum range (m) */
+    float _min_range;
+
+    /** Maximum range (m) */
+    float _max_range;
+
+  };
+
+  /**
+   * \class SickScanMedianFilter
+   * \brief Replaces each range by the median of its window.
+   *
+   * Windows of 3 and 5 beams use branch-free min/max networks, larger ones
+   * a small sort. The first and last window/2 beams are left as they are.
+   * Beams without a return count as 0 within a window (so isolated returns
+   * are suppressed) but are never filled in.
+   */
+  class SickScanMedianFilter : public SickScanFilter {
+
+  public:
+
+    /** A standard constructor (odd window of 3 .. SICK_SCAN_FILTER_MAX_MEDIAN_WINDOW beams) */
+    SickScanMedianFilter( const unsigned int window_size = 3 ) throw( SickConfigException );
+
+    /** Filters the scan in place */
+    void Apply( SickScan &sick_scan, SickScanFilterArena &sick_scan_arena ) const;
+
+  private:
+
+    /** Beams per window */
+    unsigned int _window_size;
+
+    /** Median of 3 over beams [begin,end) */
+    static void _median3( const float * __restrict__ src, float * __restrict__ r, uint32_t * __restrict__ f,
+			  const unsigned int begin, const unsigned int end );
+
+    /** Median of 5 over beams [begin,end) */
+    static void _median5( const float * __restrict__ src, float * __restrict__ r, uint32_t * __restrict__ f,
+			  const unsigned int begin, const unsigned int end );
+
+  };
+
+  /**
+   * \class SickScanShadowFilter
+   * \brief Rejects mixed-pixel/veiling-edge returns.
+   *
+   * Two neighbouring returns are treated as a veiling edge when the surface
+   * through them is seen at less than min_angle from the beam. The farther
+   * return and the num_neighbors beams behind it are then rejected. The
+   * test uses the beam angles of the scan, so it also applies to LD and
+   * ROI-compacted scans. Neighbours separated by a gap (more than
+   * SICK_SCAN_FILTER_SHADOW_MAX_GAP_STEPS times the scan's smallest step, or
+   * more than SICK_SCAN_FILTER_SHADOW_MAX_GAP deg, e.g. LD sector boundaries
+   * and the 360/0 seam) are not compared, as nothing is known between them.
+   */
+  class SickScanShadowFilter : public SickScanFilter {
+
+  public:
+
+    /** A standard constructor (deg, 0 < min_angle < 90) */
+    SickScanShadowFilter( const double min_angle = 10.0, const unsigned int num_neighbors = 0 ) throw( SickConfigException );
+
+    /** Filters the scan in place */
+    void Apply( SickScan &sick_scan, SickScanFilterArena &sick_scan_arena ) const;
+
+  private:
+
+    /** tan(min_angle) */
+    float _tan_min_angle;
+
+    /** Beams rejected behind a veiling edge */
+    unsigned int _num_neighbors;
+
+    /** Smallest nonzero angle between neighbouring beams (deg, 0 => none) */
+    static float _nominalStep( const float * __restrict__ a, const unsigned int num_edges );
+
+    /** Marks the veiling edges between beams i and i+1 (1 => edge) for i in [0,num_edges) */
+    static void _markEdges( const float * __restrict__ r, const float * __restrict__ a, float * __restrict__ edge,
+			    const unsigned int num_edges, const float tan_min_angle, const float max_step );
+
+  };
+
+  /**
+   * \class SickScanFilterChain
+   * \brief An ordered list of filters with its own scratch arena.
+   *
+   * Keep one chain per sensor. The chain does not own its filters, which
+   * must outlive it, and it is not thread-safe.
+   */
+  class SickScanFilterChain {
+
+  public:
+
+    /** A standard constructor */
+    SickScanFilterChain( ) { }
+
+    /** Appends a filter to the chain */
+    void AddFilter( const SickScanFilter &sick_scan_filter ) { _sick_scan_filters.push_back(&sick_scan_filter); }
+
+    /** Removes all filters */
+    void ClearFilters( ) { _sick_scan_filters.clear(); }
+
+    /** Number of filters in the chain */
+    unsigned int GetNumFilters( ) const { return _sick_scan_filters.size(); }
+
+    /** Pre-sizes the scratch arena for scans of up to num_beams */
+    void Reserve( const unsigned int num_beams ) throw( std::bad_alloc ) { _sick_scan_arena.Reserve(num_beams); }
+
+    /** Runs the filters over the scan in order */
+    void Apply( SickScan &sick_scan ) throw( std::bad_alloc );
+
+  private:
+
+    /** The filters (not owned) */
+    std::vector< const SickScanFilter * > _sick_scan_filters;
+
+    /** Scratch arrays shared by the filters */
+    SickScanFilterArena _sick_scan_arena;
+
+    /** Not copyable */
+    SickScanFilterChain( const SickScanFilterChain & );
+    SickScanFilterChain & operator=( const SickScanFilterChain & );
+
+  };
+
+  /**
+   * \brief Makes sure each scratch array holds at least num_beams floats
+   * \param num_beams Required capacity (beams)
+   */
+  inline void SickScanFilterArena::Reserve( const unsigned int num_beams ) throw( std::bad_alloc ) {
+
+    if (num_beams <= _capacity) {
+      return;
+    }
+
+    void *block = NULL;
+    if (posix_memalign(&block,SICK_SCAN_ALIGNMENT,SICK_SCAN_FILTER_ARENA_NUM_BUFFERS*_stride(num_beams)*sizeof(float)) != 0) {
+      throw std::bad_alloc();
+    }
+
+    /* Scratch contents are never carried across scans */
+    free(_block);
+    _block = (float *)block;
+    _capacity = num_beams;
+
+  }
+
+  /**
+   * \brief A standard constructor
+   * \param min_range Minimum range (m)
+   * \param max_range Maximum range (m, 0 => no upper limit)
+   */
+  inline SickScanRangeClipFilter::SickScanRangeClipFilter( const double min_range, const double max_range ) throw( SickConfigException ) {
+
+    if (min_range < 0 || max_range < 0 || (max_range > 0 && max_range < min_range)) {
+      throw SickConfigException("SickScanRangeClipFilter::SickScanRangeClipFilter: Invalid range limits!");
+    }
+
+    _min_range = (float)min_range;
+    _max_range = (max_range > 0) ? (float)max_range : FLT_MAX;
+
+  }
+
+  /**
+   * \brief Filters the scan in place
+   * \param sick_scan The scan
+   */
+  inline void SickScanRangeClipFilter::Apply( SickScan &sick_scan, SickScanFilterArena & /* sick_scan_arena */ ) const {
+
+    const unsigned int num_beams = sick_scan.GetNumBeams();
+    float * __restrict__ r = sick_scan.GetRangeValues();
+    uint32_t * __restrict__ f = sick_scan.GetFlagValues();
+    const float min_range = _min_range, max_range = _max_range;
+
+    /* Branch-free so that GCC can vectorize it (-O3, or -O2 -ftree-vectorize) */
+    for (unsigned int i = 0; i < num_beams; i++) {
+      const float range = r[i];
+      const bool reject = (range != 0) & ((range < min_range) | (range > max_range));
+      r[i] = reject ? 0.0f : range;
+      f[i] |= reject ? (uint32_t)SickScan::SICK_SCAN_FLAG_FILTERED : 0;
+    }
+
+  }
+
+  /**
+   * \brief A standard constructor
+   * \param window_size Beams per window (odd, 3 .. SICK_SCAN_FILTER_MAX_MEDIAN_WINDOW)
+   */
+  inline SickScanMedianFilter::SickScanMedianFilter( const unsigned int window_size ) throw( SickConfigException ) : _window_size(window_size) {
+
+    if (window_size < 3 || window_size > SICK_SCAN_FILTER_MAX_MEDIAN_WINDOW || window_size % 2 == 0) {
+      throw SickConfigException("SickScanMedianFilter::SickScanMedianFilter: Invalid window size!");
+    }
+
+  }
+
+  /**
+   * \brief Filters the scan in place
+   * \param sick_scan The scan
+   * \param sick_scan_arena Scratch arrays (buffer 0 holds the unfiltered ranges)
+   */
+  inline void SickScanMedianFilter::Apply( SickScan &sick_scan, SickScanFilterArena &sick_scan_arena ) const {
+
+    const unsigned int num_beams = sick_scan.GetNumBeams();
+    const unsigned int half_window = _window_size/2;
+    if (num_beams < _window_size) {
+      return;
+    }
+
+    /* Medians are taken over the unfiltered ranges */
+    float * __restrict__ r = sick_scan.GetRangeValues();
+    uint32_t * __restrict__ f = sick_scan.GetFlagValues();
+    const float * __restrict__ src = sick_scan_arena.GetBuffer(0);
+    memcpy(sick_scan_arena.GetBuffer(0),r,num_beams*sizeof(float));
+
+    const unsigned int end = num_beams - half_window;
+    if (_window_size == 3) {
+      _median3(src,r,f,1,end);
+    }
+    else if (_window_size == 5) {
+      _median5(src,r,f,2,end);
+    }
+    else {
+
+      float window[SICK_SCAN_FILTER_MAX_MEDIAN_WINDOW];
+      for (unsigned int i = half_window; i < end; i++) {
+
+	/* Insertion sort (the windows are tiny) */
+	for (unsigned int j = 0; j < _window_size; j++) {
+	  const float value = src[i-half_window+j];
+	  unsigned int k = j;
+	  for (; k > 0 && window[k-1] > value; k--) {
+	    window[k] = window[k-1];
+	  }
+	  window[k] = value;
+	}
+
+	const float median = window[half_window];
+	if (src[i] != 0) {
+	  r[i] = median;
+	  f[i] |= (median == 0) ? (uint32_t)SickScan::SICK_SCAN_FLAG_FILTERED : 0;
+	}
+
+      }
+
+    }
+
+  }
+
+  /**
+   * \brief Median of 3 over beams [begin,end)
+   *
+   * NOTE: The kernels take restrict pointers and use only selects, so GCC
+   *       vectorizes them (-O3, or -O2 -ftree-vectorize).
+   */
+  inline void SickScanMedianFilter::_median3( const float * __restrict__ src, float * __restrict__ r, uint32_t * __restrict__ f,
+					      const unsigned int begin, const unsigned int end ) {
+
+    for (unsigned int i = begin; i < end; i++) {
+      const float a = src[i-1], b = src[i], c = src[i+1];
+      const float lo = (a < b) ? a : b, hi = (a < b) ? b : a;
+      const float m = (hi < c) ? hi : c;
+      const float median = (lo > m) ? lo : m;
+      r[i] = (b != 0) ? median : 0.0f;
+      f[i] |= (b != 0 && median == 0) ? (uint32_t)SickScan::SICK_SCAN_FLAG_FILTERED : 0;
+    }
+
+  }
+
+  /**
+   * \brief Median of 5 over beams [begin,end)
+   *
+   * NOTE: med5(a,b,c,d,e) = med3(e, max(min(a,b),min(c,d)), min(max(a,b),max(c,d)))
+   */
+  inline void SickScanMedianFilter::_median5( const float * __restrict__ src, float * __restrict__ r, uint32_t * __restrict__ f,
+					      const unsigned int begin, const unsigned int end ) {
+
+    for (unsigned int i = begin; i < end; i++) {
+      const float a = src[i-2], b = src[i-1], c = src[i], d = src[i+1], e = src[i+2];
+      const float min_ab = (a < b) ? a : b, max_ab = (a < b) ? b : a;
+      const float min_cd = (c < d) ? c : d, max_cd = (c < d) ? d : c;
+      const float g = (min_ab > min_cd) ? min_ab : min_cd;
+      const float h = (max_ab < max_cd) ? max_ab : max_cd;
+      const float lo = (g < h) ? g : h, hi = (g < h) ? h : g;
+      const float m = (hi < e) ? hi : e;
+      const float median = (lo > m) ? lo : m;
+      r[i] = (c != 0) ? median : 0.0f;
+      f[i] |= (c != 0 && median == 0) ? (uint32_t)SickScan::SICK_SCAN_FLAG_FILTERED : 0;
+    }
+
+  }
+
+  /**
+   * \brief A standard constructor
+   * \param min_angle Smallest accepted angle between a beam and the surface it hits (deg)
+   * \param num_neighbors Beams rejected behind a veiling edge, besides the farther return
+   */
+  inline SickScanShadowFilter::SickScanShadowFilter( const double min_angle, const unsigned int num_neighbors ) throw( SickConfigException )
+    : _num_neighbors(num_neighbors) {
+
+    if (min_angle <= 0 || min_angle >= 90) {
+      throw SickConfigException("SickScanShadowFilter::SickScanShadowFilter: Invalid minimum angle!");
+    }
+
+    _tan_min_angle = (float)tan(min_angle*M_PI/180.0);
+
+  }
+
+  /**
+   * \brief Filters the scan in place
+   * \param sick_scan The scan
+   * \param sick_scan_arena Scratch arrays (buffer 0 holds the unfiltered ranges, buffer 1 the edge mask)
+   */
+  inline void SickScanShadowFilter::Apply( SickScan &sick_scan, SickScanFilterArena &sick_scan_arena ) const {
+
+    const unsigned int num_beams = sick_scan.GetNumBeams();
+    if (num_beams < 2) {
+      return;
+    }
+
+    float * const range_values = sick_scan.GetRangeValues();
+    uint32_t * const flag_values = sick_scan.GetFlagValues();
+    float * const src_values = sick_scan_arena.GetBuffer(0);
+    float * const edge_values = sick_scan_arena.GetBuffer(1);
+    memcpy(src_values,range_values,num_beams*sizeof(float));
+
+    /* Only compare neighbours that are nominally adjacent */
+    const float * const angle_values = sick_scan.GetAngleValues();
+    const float nominal_step = _nominalStep(angle_values,num_beams - 1);
+    const float max_step = (nominal_step*SICK_SCAN_FILTER_SHADOW_MAX_GAP_STEPS < SICK_SCAN_FILTER_SHADOW_MAX_GAP) ?
+      (float)(nominal_step*SICK_SCAN_FILTER_SHADOW_MAX_GAP_STEPS) : (float)SICK_SCAN_FILTER_SHADOW_MAX_GAP;
+
+    _markEdges(src_values,angle_values,edge_values,num_beams - 1,_tan_min_angle,max_step);
+
+    /* Reject the farther return of each edge (and the beams behind it); edges are sparse */
+    for (unsigned int i = 0; i < num_beams - 1; i++) {
+
+      if (edge_values[i] == 0) {
+	continue;
+      }
+
+      /* Walk away from the edge on the far side */
+      const bool far_is_first = src_values[i] > src_values[i+1];
+      unsigned int j = far_is_first ? i : i + 1;
+      for (unsigned int k = 0; k <= _num_neighbors; k++) {
+
+	if (range_values[j] != 0) {
+	  range_values[j] = 0;
+	  flag_values[j] |= SickScan::SICK_SCAN_FLAG_FILTERED;
+	}
+
+	if (far_is_first) {
+	  if (j == 0) {
+	    break;
+	  }
+	  j--;
+	}
+	else if (++j == num_beams) {
+	  break;
+	}
+
+      }
+
+    }
+
+  }
+
+  /**
+   * \brief Finds the smallest nonzero angle between neighbouring beams
+   * \param *a Angles (deg)
+   * \param num_edges Number of neighbouring pairs (beams - 1)
+   * \return The step (deg, 0 if all neighbours share an angle)
+   */
+  inline float SickScanShadowFilter::_nominalStep( const float * __restrict__ a, const unsigned int num_edges ) {
+
+    float nominal_step = FLT_MAX;
+    for (unsigned int i = 0; i < num_edges; i++) {
+      const float da = a[i+1] - a[i];
+      const float abs_da = (da < 0) ? -da : da;
+      nominal_step = (abs_da > 0 && abs_da < nominal_step) ? abs_da : nominal_step;
+    }
+
+    return (nominal_step < FLT_MAX) ? nominal_step : 0.0f;
+
+  }
+
+  /**
+   * \brief Marks the veiling edges between neighbouring beams
+   * \param *r Ranges (m)
+   * \param *a Angles (deg)
+   * \param *edge Set to 1 where beams i and i+1 form an edge, 0 otherwise
+   * \param num_edges Number of neighbouring pairs (beams - 1)
+   * \param tan_min_angle tan of the minimum angle
+   * \param max_step Neighbours farther apart than this are never an edge (deg)
+   *
+   * For neighbours (r1,t1) and (r2,t2) the surface through them is seen at
+   * less than min_angle from beam 1 when r2*|sin(dt)| < tan(min_angle)*|r1 - r2*cos(dt)|.
+   * As only neighbours within max_step (at most SICK_SCAN_FILTER_SHADOW_MAX_GAP)
+   * are compared, sin/cos are expanded, and the absolute values and the
+   * gap/no-return tests are float selects, which keeps the loop vectorizable
+   * (-O3, or -O2 -ftree-vectorize).
+   */
+  inline void SickScanShadowFilter::_markEdges( const float * __restrict__ r, const float * __restrict__ a, float * __restrict__ edge,
+						const unsigned int num_edges, const float tan_min_angle, const float max_step ) {
+
+    const float degs_to_rads = (float)(M_PI/180.0);
+    const float max_dt = max_step*degs_to_rads;
+
+    for (unsigned int i = 0; i < num_edges; i++) {
+      const float r1 = r[i], r2 = r[i+1];
+      const float dt = (a[i+1] - a[i])*degs_to_rads;
+      const float abs_dt = (dt < 0) ? -dt : dt;
+      const float dt2 = dt*dt;
+      const float sin_dt = dt*(1.0f - dt2*(1.0f/6.0f));
+      const float cos_dt = 1.0f - dt2*(0.5f - dt2*(1.0f/24.0f));
+      const float diff = r1 - r2*cos_dt;
+      const float abs_sin_dt = (sin_dt < 0) ? -sin_dt : sin_dt;
+      const float abs_diff = (diff < 0) ? -diff : diff;
+      float is_edge = (r2*abs_sin_dt < tan_min_angle*abs_diff) ? 1.0f : 0.0f;
+      is_edge = (r1 == 0) ? 0.0f : is_edge;
+      is_edge = (abs_dt > max_dt) ? 0.0f : is_edge;
+      edge[i] = (r2 == 0) ? 0.0f : is_edge;
+    }
+
+  }
+
+  /**
+   * \brief Runs the filters over the scan in order
+   * \param sick_scan The scan
+   */
+  inline void SickScanFilterChain::Apply( SickScan &sick_scan ) throw( std::bad_alloc ) {
+
+    _sick_scan_arena.Reserve(sick_scan.GetNumBeams());
+    for (unsigned int i = 0; i < _sick_scan_filters.size(); i++) {
+      _sick_scan_filters[i]->Apply(sick_scan,_sick_scan_arena);
+    }
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_FILTER */
@@ -0,0 +1,950 @@
+/*!
+ * \file SickScanLog.hh
+ * \brief Defines a compact, compressed binary log of decoded scans.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_LOG
+#define SICK_SCAN_LOG
+
+/* Macros */
+#define DEFAULT_SICK_LOG_SCANS_PER_BLOCK                         (64)  ///< Scans compressed together (a block decodes on its own)
+#define DEFAULT_SICK_LOG_SEGMENT_SIZE           ((uint64_t)1 << 30)  ///< Bytes per segment file before rolling over
+#define DEFAULT_SICK_LOG_VERSION                                  (1)  ///< Bumped whenever the format changes
+#define DEFAULT_SICK_LOG_SEGMENT_MAGIC                  (0x474C4B53U)  ///< "SKLG"
+#define DEFAULT_SICK_LOG_BLOCK_MAGIC                    (0x4B4C4253U)  ///< "SBLK"
+#define DEFAULT_SICK_LOG_INDEX_MAGIC                    (0x58494B53U)  ///< "SKIX"
+#define DEFAULT_SICK_LOG_RANS_SCALE_BITS                         (12)  ///< Probability resolution of the entropy coder
+#define DEFAULT_SICK_LOG_RANS_LOWER_BOUND               ((uint32_t)1 << 23)  ///< Renormalization bound of the entropy coder
+
+/* Dependencies */
+#include <map>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "SickException.hh"
+#include "SickLogger.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * A log is a series of segment files (<base>.000000.sklog, <base>.000001.sklog,
+   * ...). Each segment holds:
+   *
+   *   [segment header][block][block] ... [block index][index trailer]
+   *
+   * A block holds up to DEFAULT_SICK_LOG_SCANS_PER_BLOCK scans and decodes on
+   * its own. Within a block each scan's ranges are delta-encoded against the
+   * previous scan of the same sensor (or against the previous range for the
+   * first scan of a sensor), zigzag/varint coded, and echo/RSSI values are
+   * bit-packed at the narrowest width that fits. The block is then passed
+   * through an order-0 rANS coder and protected by a CRC-32. The index at the
+   * end of each segment lists every block's time/sequence span and offset. A
+   * segment whose writer died has no index; its blocks can still be found by
+   * walking the block headers.
+   *
+   * All multi-byte fields are stored little-endian (the host order on the
+   * platforms the toolbox targets).
+   */
+
+  /** Block encodings */
+  enum sick_log_encoding_t {
+    SICK_LOG_ENCODING_RAW = 0,                                         ///< Stored as is (entropy coding didn't help)
+    SICK_LOG_ENCODING_RANS = 1                                         ///< Order-0 rANS coded
+  };
+
+  /*!
+   * \struct sick_log_scan_tag
+   * \brief Metadata of a logged scan
+   */
+  typedef struct sick_log_scan_tag {
+    uint64_t sick_timestamp;                                           ///< Acquisition time (usecs since the epoch)
+    uint64_t sick_sequence;                                            ///< Position in the log (assigned by the writer)
+    uint32_t sick_sensor_id;                                           ///< Application-defined sensor id
+    float sick_start_angle;                                            ///< Angle of the first value (deg)
+    float sick_angle_step;                                             ///< Angular step between values (deg)
+    float sick_range_scale;                                            ///< Meters per range unit (e.g. 0.001 for mm)
+    uint32_t sick_num_ranges;                                          ///< Number of range values
+    uint32_t sick_num_reflect;                                         ///< Number of echo/RSSI values (0 => none)
+  } sick_log_scan_t;
+
+  /*!
+   * \struct sick_log_segment_header_tag
+   * \brief Header at the start of each segment file
+   */
+  typedef struct sick_log_segment_header_tag {
+    uint32_t sick_magic;                                               ///< DEFAULT_SICK_LOG_SEGMENT_MAGIC
+    uint32_t sick_version;                                             ///< DEFAULT_SICK_LOG_VERSION
+    uint32_t sick_segment_number;                                      ///< Position of the segment in the log
+    uint32_t sick_reserved;                                            ///< Unused (0)
+    uint64_t sick_first_sequence;                                      ///< Sequence number of the segment's first scan
+  } sick_log_segment_header_t;
+
+  /*!
+   * \struct sick_log_block_header_tag
+   * \brief Header preceding each block
+   */
+  typedef struct sick_log_block_header_tag {
+    uint32_t sick_magic;                                               ///< DEFAULT_SICK_LOG_BLOCK_MAGIC
+    uint32_t sick_encoding;                                            ///< A sick_log_encoding_t
+    uint32_t sick_num_scans;                                           ///< Number of scans in the block
+    uint32_t sick_raw_size;                                            ///< Size of the block before entropy coding
+    uint32_t sick_stored_size;                                         ///< Size of the block as stored (follows the header)
+    uint32_t sick_checksum;                                            ///< CRC-32 of the stored bytes
+    uint64_t sick_first_timestamp;                                     ///< Timestamp of the first scan
+    uint64_t sick_last_timestamp;                                      ///< Timestamp of the last scan
+    uint64_t sick_first_sequence;                                      ///< Sequence number of the first scan
+  } sick_log_block_header_t;
+
+  /*!
+   * \struct sick_log_index_entry_tag
+   * \brief An entry of a segment's block index
+   */
+  typedef struct sick_log_index_entry_tag {
+    uint64_t sick_first_timestamp;                                     ///< Timestamp of the block's first scan
+    uint64_t sick_last_timestamp;                                      ///< Timestamp of the block's last scan
+    uint64_t sick_first_sequence;                                      ///< Sequence number of the block's first scan
+    uint64_t sick_offset;                                              ///< File offset of the block header
+    uint32_t sick_num_scans;                                           ///< Number of scans in the block
+    uint32_t sick_reserved;                                            ///< Unused (0)
+  } sick_log_index_entry_t;
+
+  /*!
+   * \struct sick_log_index_trailer_tag
+   * \brief The last bytes of a finished segment
+   */
+  typedef struct sick_log_index_trailer_tag {
+    uint32_t sick_magic;                                               ///< DEFAULT_SICK_LOG_INDEX_MAGIC
+    uint32_t sick_num_entries;                                         ///< Number of index entries
+    uint64_t sick_index_offset;                                        ///< File offset of the first index entry
+  } sick_log_index_trailer_t;
+
+  /**
+   * \brief Builds the name of a segment file
+   * \param &base_path The log's base path
+   * \param segment_number The segment
+   */
+  inline std::string sick_log_segment_path( const std::string &base_path, const unsigned int segment_number ) {
+    char suffix[32];
+    snprintf(suffix,sizeof(suffix),".%06u.sklog",segment_number);
+    return base_path + suffix;
+  }
+
+  /** The slicing-by-8 CRC-32 tables (one definition shared by all translation units) */
+  typedef uint32_t sick_log_crc32_tables_t[8][256];
+  inline sick_log_crc32_tables_t & sick_log_crc32_tables( ) {
+    static sick_log_crc32_tables_t crc_tables;
+    return crc_tables;
+  }
+
+  /**
+   * \brief Fills the CRC-32 tables (run once through pthread_once)
+   */
+  inline void sick_log_crc32_build_tables( ) {
+
+    sick_log_crc32_tables_t &crc_tables = sick_log_crc32_tables();
+
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (unsigned int j = 0; j < 8; j++) {
+	crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320U : (crc >> 1);
+      }
+      crc_tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+      for (unsigned int t = 1; t < 8; t++) {
+	crc_tables[t][i] = (crc_tables[t-1][i] >> 8) ^ crc_tables[0][crc_tables[t-1][i] & 0xFF];
+      }
+    }
+
+  }
+
+  /**
+   * \brief Computes the CRC-32 (IEEE 802.3) of a buffer
+   * \param *buffer The bytes
+   * \param buffer_length Number of bytes
+   *
+   * Uses slicing-by-8 (8 table lookups per 8 bytes), so verifying a block
+   * costs little next to decoding it.
+   */
+  inline uint32_t sick_log_crc32( const uint8_t * const buffer, const size_t buffer_length ) {
+
+    /* Build the tables on first use */
+    static pthread_once_t crc_tables_once = PTHREAD_ONCE_INIT;
+    pthread_once(&crc_tables_once,sick_log_crc32_build_tables);
+    const sick_log_crc32_tables_t &crc_tables = sick_log_crc32_tables();
+
+    uint32_t crc = 0xFFFFFFFFU;
+    const uint8_t *byte_ptr = buffer;
+    size_t num_bytes = buffer_length;
+
+    while (num_bytes >= 8) {
+      uint32_t low_word, high_word;
+      memcpy(&low_word,byte_ptr,4);
+      memcpy(&high_word,byte_ptr + 4,4);
+      low_word ^= crc;
+      crc = crc_tables[7][low_word & 0xFF] ^ crc_tables[6][(low_word >> 8) & 0xFF] ^
+	    crc_tables[5][(low_word >> 16) & 0xFF] ^ crc_tables[4][low_word >> 24] ^
+	    crc_tables[3][high_word & 0xFF] ^ crc_tables[2][(high_word >> 8) & 0xFF] ^
+	    crc_tables[1][(high_word >> 16) & 0xFF] ^ crc_tables[0][high_word >> 24];
+      byte_ptr += 8;
+      num_bytes -= 8;
+    }
+
+    while (num_bytes-- > 0) {
+      crc = crc_tables[0][(crc ^ *byte_ptr++) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFFU;
+
+  }
+
+  /**
+   * \brief Appends an unsigned LEB128 varint
+   */
+  inline void sick_log_put_varint( std::vector< uint8_t > &buffer, uint64_t value ) {
+    while (value >= 0x80) {
+      buffer.push_back((uint8_t)(value | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back((uint8_t)value);
+  }
+
+  /**
+   * \brief Writes an unsigned LEB128 varint to a buffer w/ room for at least 10 bytes
+   * \return The end of the varint
+   */
+  inline uint8_t * sick_log_write_varint( uint8_t *buffer, uint64_t value ) {
+    while (value >= 0x80) {
+      *buffer++ = (uint8_t)(value | 0x80);
+      value >>= 7;
+    }
+    *buffer++ = (uint8_t)value;
+    return buffer;
+  }
+
+  /**
+   * \brief Reads an unsigned LEB128 varint
+   * \return False if the buffer ends mid-varint
+   */
+  inline bool sick_log_get_varint( const uint8_t *&buffer, const uint8_t * const buffer_end, uint64_t &value ) {
+    value = 0;
+    for (unsigned int shift = 0; buffer < buffer_end && shift < 64; shift += 7) {
+      uint8_t byte = *buffer++;
+      value |= (uint64_t)(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * \brief Maps a signed delta onto an unsigned value (small magnitudes => small values)
+   */
+  inline uint64_t sick_log_zigzag_encode( const int64_t value ) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+  }
+
+  /**
+   * \brief Inverts sick_log_zigzag_encode
+   */
+  inline int64_t sick_log_zigzag_decode( const uint64_t value ) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+  }
+
+  /**
+   * \brief Appends raw bytes (e.g. a float) to a buffer
+   */
+  inline void sick_log_put_bytes( std::vector< uint8_t > &buffer, const void * const bytes, const size_t num_bytes ) {
+    const uint8_t *byte_ptr = (const uint8_t *)bytes;
+    buffer.insert(buffer.end(),byte_ptr,byte_ptr + num_bytes);
+  }
+
+  /**
+   * \brief Compresses a buffer w/ an order-0 rANS coder
+   * \param &raw_buffer The input
+   * \param &coded_buffer The output: a frequency table followed by the rANS stream
+   *
+   * The symbol frequencies are normalized to 2^DEFAULT_SICK_LOG_RANS_SCALE_BITS
+   * and stored as (symbol, frequency) pairs ahead of the stream.
+   */
+  inline void sick_log_rans_encode( const std::vector< uint8_t > &raw_buffer, std::vector< uint8_t > &coded_buffer ) {
+
+    const uint32_t prob_scale = 1U << DEFAULT_SICK_LOG_RANS_SCALE_BITS;
+
+    coded_buffer.clear();
+
+    /* Count the symbols */
+    uint32_t counts[256] = {0};
+    for (size_t i = 0; i < raw_buffer.size(); i++) {
+      counts[raw_buffer[i]]++;
+    }
+
+    /* Normalize (every symbol that occurs keeps a frequency >= 1) */
+    uint32_t freqs[256] = {0};
+    uint32_t freq_sum = 0;
+    for (unsigned int s = 0; s < 256; s++) {
+      if (counts[s] > 0) {
+	freqs[s] = (uint32_t)(((uint64_t)counts[s]*prob_scale)/raw_buffer.size());
+	if (freqs[s] == 0) {
+	  freqs[s] = 1;
+	}
+	freq_sum += freqs[s];
+      }
+    }
+
+    /* Fix up the rounding by adjusting the most frequent symbols (the sum always exceeds the number of symbols, so this terminates) */
+    while (freq_sum != prob_scale) {
+      unsigned int max_symbol = 0;
+      for (unsigned int s = 1; s < 256; s++) {
+	if (freqs[s] > freqs[max_symbol]) {
+	  max_symbol = s;
+	}
+      }
+      if (freq_sum < prob_scale) {
+	freqs[max_symbol] += prob_scale - freq_sum;
+	freq_sum = prob_scale;
+      }
+      else {
+	uint32_t excess = freq_sum - prob_scale;
+	uint32_t removed = (excess < freqs[max_symbol] - 1) ? excess : freqs[max_symbol] - 1;
+	freqs[max_symbol] -= removed;
+	freq_sum -= removed;
+      }
+    }
+
+    uint32_t cum_freqs[257] = {0};
+    for (unsigned int s = 0; s < 256; s++) {
+      cum_freqs[s+1] = cum_freqs[s] + freqs[s];
+    }
+
+    /* Store the table */
+    unsigned int num_symbols = 0;
+    for (unsigned int s = 0; s < 256; s++) {
+      num_symbols += (freqs[s] > 0);
+    }
+
+    sick_log_put_varint(coded_buffer,num_symbols);
+    for (unsigned int s = 0; s < 256; s++) {
+      if (freqs[s] > 0) {
+	coded_buffer.push_back((uint8_t)s);
+	sick_log_put_varint(coded_buffer,freqs[s]);
+      }
+    }
+
+    /* Per-symbol reciprocals, so encoding needs no division (see F. Giesen's rans_byte.h) */
+    uint32_t state_maxs[256], rcp_freqs[256], rcp_shifts[256], biases[256], cmpl_freqs[256];
+    for (unsigned int s = 0; s < 256; s++) {
+
+      state_maxs[s] = ((DEFAULT_SICK_LOG_RANS_LOWER_BOUND >> DEFAULT_SICK_LOG_RANS_SCALE_BITS) << 8)*freqs[s];
+      cmpl_freqs[s] = prob_scale - freqs[s];
+
+      if (freqs[s] < 2) {
+	rcp_freqs[s] = ~0U;
+	rcp_shifts[s] = 0;
+	biases[s] = cum_freqs[s] + prob_scale - 1;
+      }
+      else {
+	uint32_t shift = 0;
+	while (freqs[s] > (1U << shift)) {
+	  shift++;
+	}
+	rcp_freqs[s] = (uint32_t)((((uint64_t)1 << (shift + 31)) + freqs[s] - 1)/freqs[s]);
+	rcp_shifts[s] = shift - 1;
+	biases[s] = cum_freqs[s];
+      }
+
+    }
+
+    /* Encode back to front (rANS is LIFO), so the decoder runs forward */
+    std::vector< uint8_t > stream_buffer(raw_buffer.size() + raw_buffer.size()/2 + 16); // <= 12 bits/symbol
+    uint8_t *stream_ptr = &stream_buffer[0] + stream_buffer.size();
+
+    uint32_t rans_state = DEFAULT_SICK_LOG_RANS_LOWER_BOUND;
+    for (size_t i = raw_buffer.size(); i > 0; i--) {
+
+      const uint8_t symbol = raw_buffer[i-1];
+
+      /* Renormalize */
+      while (rans_state >= state_maxs[symbol]) {
+	*--stream_ptr = (uint8_t)(rans_state & 0xFF);
+	rans_state >>= 8;
+      }
+
+      /* state = (state/freq)*M + state%freq + cum_freq */
+      const uint32_t quotient = (uint32_t)(((uint64_t)rans_state*rcp_freqs[symbol]) >> 32) >> rcp_shifts[symbol];
+      rans_state += biases[symbol] + quotient*cmpl_freqs[symbol];
+
+    }
+
+    /* Flush the final state */
+    stream_ptr -= 4;
+    stream_ptr[0] = (uint8_t)(rans_state);
+    stream_ptr[1] = (uint8_t)(rans_state >> 8);
+    stream_ptr[2] = (uint8_t)(rans_state >> 16);
+    stream_ptr[3] = (uint8_t)(rans_state >> 24);
+
+    coded_buffer.insert(coded_buffer.end(),stream_ptr,&stream_buffer[0] + stream_buffer.size());
+
+  }
+
+  /*!
+   * \struct sick_log_rans_slot_tag
+   * \brief Decoder lookup entry for a probability slot
+   */
+  typedef struct sick_log_rans_slot_tag {
+    uint16_t sick_freq;                                                ///< Frequency of the slot's symbol
+    uint16_t sick_offset;                                              ///< Slot - cumulative frequency of the symbol
+    uint8_t sick_symbol;                                               ///< The symbol
+  } sick_log_rans_slot_t;
+
+  /*!
+   * \struct sick_log_rans_decoder_tag
+   * \brief State of an incremental rANS decoder (lets a reader stop once it has the bytes it needs)
+   */
+  typedef struct sick_log_rans_decoder_tag {
+    sick_log_rans_slot_t sick_slots[1 << DEFAULT_SICK_LOG_RANS_SCALE_BITS]; ///< Slot => (symbol, freq, offset)
+    const uint8_t *sick_coded_ptr;                                     ///< Next coded byte
+    const uint8_t *sick_coded_end;                                     ///< End of the coded bytes
+    uint32_t sick_state;                                               ///< The rANS state
+  } sick_log_rans_decoder_t;
+
+  /**
+   * \brief Prepares to decode a buffer produced by sick_log_rans_encode
+   * \param &rans_decoder The decoder
+   * \param *coded_buffer The coded bytes
+   * \param coded_length Number of coded bytes
+   * \return False if the input is malformed
+   */
+  inline bool sick_log_rans_decoder_init( sick_log_rans_decoder_t &rans_decoder, const uint8_t *coded_buffer, const size_t coded_length ) {
+
+    const uint32_t prob_scale = 1U << DEFAULT_SICK_LOG_RANS_SCALE_BITS;
+    const uint8_t *coded_end = coded_buffer + coded_length;
+
+    /* Read the table */
+    uint64_t num_symbols = 0;
+    if (!sick_log_get_varint(coded_buffer,coded_end,num_symbols) || num_symbols > 256) {
+      return false;
+    }
+
+    uint32_t cum_freq = 0;
+    for (uint64_t i = 0; i < num_symbols; i++) {
+
+      uint64_t freq = 0;
+      if (coded_buffer >= coded_end) {
+	return false;
+      }
+
+      uint8_t symbol = *coded_buffer++;
+      if (!sick_log_get_varint(coded_buffer,coded_end,freq) || freq == 0 || cum_freq + freq > prob_scale) {
+	return false;
+      }
+
+      for (uint32_t j = 0; j < freq; j++) {
+	rans_decoder.sick_slots[cum_freq + j].sick_freq = (uint16_t)freq;
+	rans_decoder.sick_slots[cum_freq + j].sick_offset = (uint16_t)j;
+	rans_decoder.sick_slots[cum_freq + j].sick_symbol = symbol;
+      }
+
+      cum_freq += (uint32_t)freq;
+
+    }
+
+    if (cum_freq != prob_scale || coded_end - coded_buffer < 4) {
+      return false;
+    }
+
+    rans_decoder.sick_state = (uint32_t)coded_buffer[0] | ((uint32_t)coded_buffer[1] << 8) | ((uint32_t)coded_buffer[2] << 16) | ((uint32_t)coded_buffer[3] << 24);
+    rans_decoder.sick_coded_ptr = coded_buffer + 4;
+    rans_decoder.sick_coded_end = coded_end;
+
+    return true;
+
+  }
+
+  /**
+   * \brief Decodes the next raw_length bytes
+   * \param &rans_decoder An initialized decoder
+   * \param *raw_buffer Destination (must hold raw_length bytes)
+   * \param raw_length Number of bytes to decode
+   * \return False if the input is malformed
+   */
+  inline bool sick_log_rans_decoder_decode( sick_log_rans_decoder_t &rans_decoder, uint8_t * const raw_buffer, const size_t raw_length ) {
+
+    const uint32_t slot_mask = (1U << DEFAULT_SICK_LOG_RANS_SCALE_BITS) - 1;
+
+    uint32_t rans_state = rans_decoder.sick_state;
+    const uint8_t *coded_ptr = rans_decoder.sick_coded_ptr;
+    const uint8_t * const coded_end = rans_decoder.sick_coded_end;
+
+    for (size_t i = 0; i < raw_length; i++) {
+
+      const sick_log_rans_slot_t &rans_slot = rans_decoder.sick_slots[rans_state & slot_mask];
+      raw_buffer[i] = rans_slot.sick_symbol;
+
+      rans_state = rans_slot.sick_freq*(rans_state >> DEFAULT_SICK_LOG_RANS_SCALE_BITS) + rans_slot.sick_offset;
+
+      /* Renormalize */
+      while (rans_state < DEFAULT_SICK_LOG_RANS_LOWER_BOUND) {
+	if (coded_ptr >= coded_end) {
+	  return false;
+	}
+	rans_state = (rans_state << 8) | *coded_ptr++;
+      }
+
+    }
+
+    rans_decoder.sick_state = rans_state;
+    rans_decoder.sick_coded_ptr = coded_ptr;
+
+    return true;
+
+  }
+
+  /**
+   * \brief Decompresses a buffer produced by sick_log_rans_encode in one go
+   * \param *coded_buffer The coded bytes
+   * \param coded_length Number of coded bytes
+   * \param *raw_buffer Destination (must hold raw_length bytes)
+   * \param raw_length Size of the original buffer
+   * \return False if the input is malformed
+   */
+  inline bool sick_log_rans_decode( const uint8_t *coded_buffer, const size_t coded_length, uint8_t * const raw_buffer, const size_t raw_length ) {
+
+    sick_log_rans_decoder_t *rans_decoder = new sick_log_rans_decoder_t;
+
+    bool decoded = sick_log_rans_decoder_init(*rans_decoder,coded_buffer,coded_length) &&
+      sick_log_rans_decoder_decode(*rans_decoder,raw_buffer,raw_length);
+
+    delete rans_decoder;
+    return decoded;
+
+  }
+
+  /**
+   * \class SickScanLogWriter
+   * \brief Appends decoded scans to a compressed, segmented log.
+   *
+   * Scans are encoded as they arrive (a few microseconds each); the entropy
+   * coder and the write run once per block. Several sensors may share one
+   * log, each is delta-encoded against its own previous scan.
+   *
+   * Example:
+   *   SickScanLogWriter sick_log;
+   *   sick_log.Open("/data/run_42");
+   *   sick_lms_1xx.GetSickMeasurements(range_values,NULL,reflect_values,NULL,num_values);
+   *   scan.sick_timestamp = ...; scan.sick_num_ranges = scan.sick_num_reflect = num_values; ...
+   *   sick_log.WriteScan(scan,range_values,reflect_values);
+   *   ...
+   *   sick_log.Close();
+   */
+  class SickScanLogWriter {
+
+  public:
+
+    /** A standard constructor */
+    SickScanLogWriter( ) : _log_file(NULL), _log_segment_size(DEFAULT_SICK_LOG_SEGMENT_SIZE), _log_scans_per_block(DEFAULT_SICK_LOG_SCANS_PER_BLOCK),
+			   _log_segment_number(0), _log_segment_offset(0), _log_num_scans(0), _log_bytes_in(0), _log_bytes_out(0),
+			   _block_num_scans(0), _block_first_timestamp(0), _block_last_timestamp(0), _block_first_sequence(0) { }
+
+    /** Starts a new log */
+    void Open( const std::string &base_path,
+	       const uint64_t segment_size = DEFAULT_SICK_LOG_SEGMENT_SIZE,
+	       const unsigned int scans_per_block = DEFAULT_SICK_LOG_SCANS_PER_BLOCK ) throw( SickConfigException, SickIOException );
+
+    /** Appends a scan (the sequence number is assigned by the writer) */
+    void WriteScan( const sick_log_scan_t &sick_scan,
+		    const unsigned int * const range_values,
+		    const unsigned int * const reflect_values = NULL ) throw( SickConfigException, SickIOException );
+
+    /** Writes out the current (partial) block */
+    void Flush( ) throw( SickIOException );
+
+    /** Flushes, writes the index and closes the current segment */
+    void Close( ) throw( SickIOException );
+
+    /** Number of scans logged */
+    uint64_t GetNumScans( ) const { return _log_num_scans; }
+
+    /** Size of the logged scans before compression (bytes) */
+    uint64_t GetBytesIn( ) const { return _log_bytes_in; }
+
+    /** Size of the log on disk (bytes) */
+    uint64_t GetBytesOut( ) const { return _log_bytes_out; }
+
+    /** A standard destructor */
+    ~SickScanLogWriter( );
+
+  private:
+
+    /** Base path of the log */
+    std::string _log_base_path;
+
+    /** The open segment */
+    FILE *_log_file;
+
+    /** Bytes per segment before rolling over */
+    uint64_t _log_segment_size;
+
+    /** Scans per block */
+    unsigned int _log_scans_per_block;
+
+    /** Number of the open segment */
+    unsigned int _log_segment_number;
+
+    /** Write offset in the open segment */
+    uint64_t _log_segment_offset;
+
+    /** Scans logged so far */
+    uint64_t _log_num_scans;
+
+    /** Uncompressed bytes logged so far */
+    uint64_t _log_bytes_in;
+
+    /** Bytes written so far */
+    uint64_t _log_bytes_out;
+
+    /** Index of the open segment */
+    std::vector< sick_log_index_entry_t > _log_index;
+
+    /** The block being built */
+    std::vector< uint8_t > _block_buffer;
+
+    /** The entropy-coded block */
+    std::vector< uint8_t > _block_coded_buffer;
+
+    /** Number of scans in the block being built */
+    unsigned int _block_num_scans;
+
+    /** Timestamp of the block's first scan */
+    uint64_t _block_first_timestamp;
+
+    /** Timestamp of the block's last scan */
+    uint64_t _block_last_timestamp;
+
+    /** Sequence number of the block's first scan */
+    uint64_t _block_first_sequence;
+
+    /** Previous ranges of each sensor in the current block */
+    std::map< uint32_t, std::vector< unsigned int > > _block_prev_ranges;
+
+    /** Opens the next segment */
+    void _openSegment( ) throw( SickIOException );
+
+    /** Writes the index and closes the segment */
+    void _closeSegment( ) throw( SickIOException );
+
+    /** Writes bytes to the segment */
+    void _write( const void * const bytes, const size_t num_bytes ) throw( SickIOException );
+
+  };
+
+  /**
+   * \brief Starts a new log (closing any open one)
+   * \param &base_path Base path of the segment files
+   * \param segment_size Bytes per segment before rolling over
+   * \param scans_per_block Scans per block (larger => better compression, coarser seeks)
+   */
+  inline void SickScanLogWriter::Open( const std::string &base_path,
+				       const uint64_t segment_size,
+				       const unsigned int scans_per_block ) throw( SickConfigException, SickIOException ) {
+
+    if (base_path.empty() || scans_per_block == 0) {
+      throw SickConfigException("SickScanLogWriter::Open: Invalid log parameters!");
+    }
+
+    Close();
+
+    _log_base_path = base_path;
+    _log_segment_size = segment_size;
+    _log_scans_per_block = scans_per_block;
+    _log_segment_number = 0;
+    _log_num_scans = 0;
+    _log_bytes_in = 0;
+    _log_bytes_out = 0;
+
+    _openSegment();
+
+  }
+
+  /**
+   * \brief Appends a scan
+   * \param &sick_scan The scan metadata
+   * \param *range_values The range values (sick_scan.sick_num_ranges of them)
+   * \param *reflect_values The echo/RSSI values (sick_scan.sick_num_reflect of them)
+   */
+  inline void SickScanLogWriter::WriteScan( const sick_log_scan_t &sick_scan,
+					    const unsigned int * const range_values,
+					    const unsigned int * const reflect_values ) throw( SickConfigException, SickIOException ) {
+
+    if (!_log_file) {
+      throw SickConfigException("SickScanLogWriter::WriteScan: Log is not open!");
+    }
+
+    if ((sick_scan.sick_num_ranges > 0 && !range_values) || (sick_scan.sick_num_reflect > 0 && !reflect_values)) {
+      throw SickConfigException("SickScanLogWriter::WriteScan: Missing scan values!");
+    }
+
+    /* Start a block */
+    if (_block_num_scans == 0) {
+      _block_buffer.clear();
+      _block_prev_ranges.clear();
+      _block_first_timestamp = sick_scan.sick_timestamp;
+      _block_last_timestamp = sick_scan.sick_timestamp;
+      _block_first_sequence = _log_num_scans;
+    }
+
+    /* Time relative to the previous scan */
+    sick_log_put_varint(_block_buffer,sick_log_zigzag_encode((int64_t)(sick_scan.sick_timestamp - _block_last_timestamp)));
+    _block_last_timestamp = sick_scan.sick_timestamp;
+
+    sick_log_put_varint(_block_buffer,sick_scan.sick_sensor_id);
+    sick_log_put_bytes(_block_buffer,&sick_scan.sick_start_angle,sizeof(float));
+    sick_log_put_bytes(_block_buffer,&sick_scan.sick_angle_step,sizeof(float));
+    sick_log_put_bytes(_block_buffer,&sick_scan.sick_range_scale,sizeof(float));
+    sick_log_put_varint(_block_buffer,sick_scan.sick_num_ranges);
+    sick_log_put_varint(_block_buffer,sick_scan.sick_num_reflect);
+
+    /* Ranges: against the sensor's previous scan if it lines up, otherwise against the previous range */
+    std::vector< unsigned int > &prev_ranges = _block_prev_ranges[sick_scan.sick_sensor_id];
+    const bool inter_scan = (prev_ranges.size() == sick_scan.sick_num_ranges && sick_scan.sick_num_ranges > 0);
+    _block_buffer.push_back(inter_scan ? 1 : 0);
+
+    /* Write in place (a 32-bit delta needs at most 5 varint bytes) */
+    const size_t range_offset = _block_buffer.size();
+    _block_buffer.resize(range_offset + 5*sick_scan.sick_num_ranges);
+    uint8_t *range_ptr = &_block_buffer[0] + range_offset;
+
+    if (inter_scan) {
+      for (unsigned int i = 0; i < sick_scan.sick_num_ranges; i++) {
+	range_ptr = sick_log_write_varint(range_ptr,sick_log_zigzag_encode((int64_t)range_values[i] - (int64_t)prev_ranges[i]));
+      }
+    }
+    else {
+      int64_t prev_range = 0;
+      for (unsigned int i = 0; i < sick_scan.sick_num_ranges; i++) {
+	range_ptr = sick_log_write_varint(range_ptr,sick_log_zigzag_encode((int64_t)range_values[i] - prev_range));
+	prev_range = range_values[i];
+      }
+    }
+
+    _block_buffer.resize(range_ptr - &_block_buffer[0]);
+
+    prev_ranges.assign(range_values,range_values + sick_scan.sick_num_ranges);
+
+    /* Echo/RSSI: bit-packed at the narrowest width */
+    if (sick_scan.sick_num_reflect > 0) {
+
+      unsigned int max_reflect = 0;
+      for (unsigned int i = 0; i < sick_scan.sick_num_reflect; i++) {
+	max_reflect |= reflect_values[i];
+      }
+
+      uint8_t bit_width = 0;
+      while (bit_width < 32 && (max_reflect >> bit_width) != 0) {
+	bit_width++;
+      }
+      _block_buffer.push_back(bit_width);
+
+      uint64_t bit_buffer = 0;
+      unsigned int num_bits = 0;
+      for (unsigned int i = 0; i < sick_scan.sick_num_reflect; i++) {
+	bit_buffer |= (uint64_t)reflect_values[i] << num_bits;
+	num_bits += bit_width;
+	while (num_bits >= 8) {
+	  _block_buffer.push_back((uint8_t)bit_buffer);
+	  bit_buffer >>= 8;
+	  num_bits -= 8;
+	}
+      }
+
+      if (num_bits > 0) {
+	_block_buffer.push_back((uint8_t)bit_buffer);
+      }
+
+    }
+
+    _log_bytes_in += sizeof(sick_log_scan_t) + (sick_scan.sick_num_ranges + sick_scan.sick_num_reflect)*sizeof(unsigned int);
+    _log_num_scans++;
+
+    if (++_block_num_scans >= _log_scans_per_block) {
+      Flush();
+    }
+
+  }
+
+  /**
+   * \brief Compresses and writes the current block
+   */
+  inline void SickScanLogWriter::Flush( ) throw( SickIOException ) {
+
+    if (!_log_file || _block_num_scans == 0) {
+      return;
+    }
+
+    sick_log_block_header_t block_header;
+    memset(&block_header,0,sizeof(block_header));
+    block_header.sick_magic = DEFAULT_SICK_LOG_BLOCK_MAGIC;
+    block_header.sick_num_scans = _block_num_scans;
+    block_header.sick_raw_size = _block_buffer.size();
+    block_header.sick_first_timestamp = _block_first_timestamp;
+    block_header.sick_last_timestamp = _block_last_timestamp;
+    block_header.sick_first_sequence = _block_first_sequence;
+
+    /* Keep whichever is smaller */
+    sick_log_rans_encode(_block_buffer,_block_coded_buffer);
+
+    const std::vector< uint8_t > *stored_buffer = &_block_coded_buffer;
+    block_header.sick_encoding = SICK_LOG_ENCODING_RANS;
+    if (_block_coded_buffer.size() >= _block_buffer.size()) {
+      stored_buffer = &_block_buffer;
+      block_header.sick_encoding = SICK_LOG_ENCODING_RAW;
+    }
+
+    block_header.sick_stored_size = stored_buffer->size();
+    block_header.sick_checksum = sick_log_crc32(&(*stored_buffer)[0],stored_buffer->size());
+
+    /* Index the block */
+    sick_log_index_entry_t index_entry;
+    memset(&index_entry,0,sizeof(index_entry));
+    index_entry.sick_first_timestamp = _block_first_timestamp;
+    index_entry.sick_last_timestamp = _block_last_timestamp;
+    index_entry.sick_first_sequence = _block_first_sequence;
+    index_entry.sick_offset = _log_segment_offset;
+    index_entry.sick_num_scans = _block_num_scans;
+
+    _write(&block_header,sizeof(block_header));
+    _write(&(*stored_buffer)[0],stored_buffer->size());
+    _log_index.push_back(index_entry);
+
+    _block_num_scans = 0;
+
+    /* Roll over once the segment is full */
+    if (_log_segment_offset >= _log_segment_size) {
+      _closeSegment();
+      _log_segment_number++;
+      _openSegment();
+    }
+
+  }
+
+  /**
+   * \brief Flushes and closes the log
+   */
+  inline void SickScanLogWriter::Close( ) throw( SickIOException ) {
+
+    if (!_log_file) {
+      return;
+    }
+
+    Flush();
+    _closeSegment();
+
+  }
+
+  /**
+   * \brief Destructor (closes the log)
+   */
+  inline SickScanLogWriter::~SickScanLogWriter( ) {
+
+    try {
+      Close();
+    }
+
+    /* Handle any I/O exceptions */
+    catch(SickIOException &sick_io_exception) {
+      SICK_LOG_ERROR(sick_io_exception.what());
+    }
+
+  }
+
+  /**
+   * \brief Opens the next segment file and writes its header
+   */
+  inline void SickScanLogWriter::_openSegment( ) throw( SickIOException ) {
+
+    const std::string segment_path = sick_log_segment_path(_log_base_path,_log_segment_number);
+
+    if ((_log_file = fopen(segment_path.c_str(),"wb")) == NULL) {
+      throw SickIOException("SickScanLogWriter::_openSegment: Unable to create " + segment_path);
+    }
+
+    _log_segment_offset = 0;
+    _log_index.clear();
+
+    sick_log_segment_header_t segment_header;
+    memset(&segment_header,0,sizeof(segment_header));
+    segment_header.sick_magic = DEFAULT_SICK_LOG_SEGMENT_MAGIC;
+    segment_header.sick_version = DEFAULT_SICK_LOG_VERSION;
+    segment_header.sick_segment_number = _log_segment_number;
+    segment_header.sick_first_sequence = _log_num_scans;
+
+    _write(&segment_header,sizeof(segment_header));
+
+  }
+
+  /**
+   * \brief Writes the block index and closes the segment
+   */
+  inline void SickScanLogWriter::_closeSegment( ) throw( SickIOException ) {
+
+    sick_log_index_trailer_t index_trailer;
+    memset(&index_trailer,0,sizeof(index_trailer));
+    index_trailer.sick_magic = DEFAULT_SICK_LOG_INDEX_MAGIC;
+    index_trailer.sick_num_entries = _log_index.size();
+    index_trailer.sick_index_offset = _log_segment_offset;
+
+    try {
+      if (!_log_index.empty()) {
+	_write(&_log_index[0],_log_index.size()*sizeof(sick_log_index_entry_t));
+      }
+      _write(&index_trailer,sizeof(index_trailer));
+    }
+
+    /* Handle any I/O exceptions */
+    catch(SickIOException &) {
+      fclose(_log_file);
+      _log_file = NULL;
+      throw;
+    }
+
+    FILE *log_file = _log_file;
+    _log_file = NULL;
+
+    if (fclose(log_file) != 0) {
+      throw SickIOException("SickScanLogWriter::_closeSegment: fclose() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Writes bytes to the open segment
+   */
+  inline void SickScanLogWriter::_write( const void * const bytes, const size_t num_bytes ) throw( SickIOException ) {
+
+    if (fwrite(bytes,1,num_bytes,_log_file) != num_bytes) {
+      throw SickIOException("SickScanLogWriter::_write: fwrite() failed!");
+    }
+
+    _log_segment_offset += num_bytes;
+    _log_bytes_out += num_bytes;
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_LOG */
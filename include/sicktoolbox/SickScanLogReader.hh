@@ -0,0 +1,681 @@
+/*!
+ * \file SickScanLogReader.hh
+ * \brief Defines a memory-mapped, random-access reader for scan logs.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_LOG_READER
+#define SICK_SCAN_LOG_READER
+
+/* Dependencies */
+#include <map>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "SickScanLog.hh"
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickScanLogReader
+   * \brief Reads scans back from a log written by SickScanLogWriter.
+   *
+   * Every segment is memory-mapped and only its block index is touched on
+   * Open (segments w/o an index, e.g. from a writer that died, are indexed by
+   * walking their block headers). A seek is a binary search over the block
+   * index followed by decoding the one block holding the scan, so its cost is
+   * bounded by the block size rather than the log size. Sequential reads
+   * reuse the decoded block and ask the kernel to read ahead the next one.
+   *
+   * Example:
+   *   SickScanLogReader sick_log;
+   *   sick_log.Open("/data/run_42");
+   *   sick_log.SeekToTime(start_time);
+   *   while (sick_log.ReadNextScan(scan,range_values,reflect_values)) { ... }
+   */
+  class SickScanLogReader {
+
+  public:
+
+    /** A standard constructor */
+    SickScanLogReader( ) : _log_num_scans(0), _cursor_block(0), _cursor_scan(0),
+			   _decoded_block((size_t)-1), _decoded_ptr(NULL), _decoded_end(NULL), _decoded_raw_end(NULL), _decoded_raw(false), _decoded_num_scans(0), _decoded_last_timestamp(0) { }
+
+    /** Maps every segment of a log */
+    void Open( const std::string &base_path ) throw( SickConfigException, SickIOException );
+
+    /** Number of scans in the log */
+    uint64_t GetNumScans( ) const { return _log_num_scans; }
+
+    /** Timestamp of the first scan (0 if the log is empty) */
+    uint64_t GetFirstTimestamp( ) const { return _log_blocks.empty() ? 0 : _log_blocks.front().sick_index_entry.sick_first_timestamp; }
+
+    /** Timestamp of the last scan (0 if the log is empty) */
+    uint64_t GetLastTimestamp( ) const { return _log_blocks.empty() ? 0 : _log_blocks.back().sick_index_entry.sick_last_timestamp; }
+
+    /** Positions the reader at the first scan at or after the given time */
+    bool SeekToTime( const uint64_t timestamp ) throw( SickIOException, SickBadChecksumException );
+
+    /** Positions the reader at the scan w/ the given sequence number */
+    bool SeekToSequence( const uint64_t sequence ) throw( SickIOException, SickBadChecksumException );
+
+    /** Decodes the scan at the cursor and advances (false => end of log) */
+    bool ReadNextScan( sick_log_scan_t &sick_scan,
+		       std::vector< unsigned int > &range_values,
+		       std::vector< unsigned int > &reflect_values ) throw( SickIOException, SickBadChecksumException );
+
+    /** Unmaps the log */
+    void Close( );
+
+    /** A standard destructor */
+    ~SickScanLogReader( ) { Close(); }
+
+  private:
+
+    /*!
+     * \struct sick_log_segment_tag
+     * \brief A mapped segment
+     */
+    typedef struct sick_log_segment_tag {
+      const uint8_t *sick_data;                                        ///< The mapping
+      size_t sick_size;                                                ///< Size of the mapping
+    } sick_log_segment_t;
+
+    /*!
+     * \struct sick_log_block_tag
+     * \brief A block of the log
+     */
+    typedef struct sick_log_block_tag {
+      unsigned int sick_segment;                                       ///< Segment holding the block
+      sick_log_index_entry_t sick_index_entry;                         ///< Its index entry
+    } sick_log_block_t;
+
+    /** The mapped segments */
+    std::vector< sick_log_segment_t > _log_segments;
+
+    /** Every block of the log, in order */
+    std::vector< sick_log_block_t > _log_blocks;
+
+    /** Number of scans in the log */
+    uint64_t _log_num_scans;
+
+    /** Block holding the next scan */
+    size_t _cursor_block;
+
+    /** Position of the next scan within its block */
+    unsigned int _cursor_scan;
+
+    /** Block currently decoded into _decoded_buffer */
+    size_t _decoded_block;
+
+    /** The decoded block */
+    std::vector< uint8_t > _decoded_buffer;
+
+    /** Parse position in the decoded block */
+    const uint8_t *_decoded_ptr;
+
+    /** End of the bytes decoded so far */
+    const uint8_t *_decoded_end;
+
+    /** End of the block once fully decoded */
+    const uint8_t *_decoded_raw_end;
+
+    /** Indicates whether the block was stored w/o entropy coding */
+    bool _decoded_raw;
+
+    /** Decoder for the current block (blocks are decoded only as far as needed) */
+    sick_log_rans_decoder_t _rans_decoder;
+
+    /** Number of scans parsed from the decoded block */
+    unsigned int _decoded_num_scans;
+
+    /** Timestamp of the last parsed scan */
+    uint64_t _decoded_last_timestamp;
+
+    /** Previous ranges of each sensor (mirrors the writer) */
+    std::map< uint32_t, std::vector< unsigned int > > _decoded_prev_ranges;
+
+    /** Scratch space for skipped scans */
+    std::vector< unsigned int > _skip_range_values, _skip_reflect_values;
+
+    /** Loads (or rebuilds) the block index of a segment */
+    void _indexSegment( const unsigned int segment_number );
+
+    /** Decodes a block and rewinds the parser to its first scan */
+    void _decodeBlock( const size_t block_number ) throw( SickIOException, SickBadChecksumException );
+
+    /** Ensures the next num_bytes of the block (or the rest of it) are decoded */
+    void _ensureDecoded( const size_t num_bytes ) throw( SickIOException );
+
+    /** Parses the next scan of the decoded block */
+    void _parseScan( sick_log_scan_t &sick_scan,
+		     std::vector< unsigned int > &range_values,
+		     std::vector< unsigned int > &reflect_values ) throw( SickIOException );
+
+    /** Moves the cursor to a scan, decoding (and parsing up to) it */
+    void _seek( const size_t block_number, const unsigned int scan_number ) throw( SickIOException, SickBadChecksumException );
+
+    /** Asks the kernel to read ahead a block */
+    void _prefetchBlock( const size_t block_number ) const;
+
+  };
+
+  /**
+   * \brief Maps every segment of the log and loads the block indices
+   * \param &base_path Base path given to SickScanLogWriter::Open
+   */
+  inline void SickScanLogReader::Open( const std::string &base_path ) throw( SickConfigException, SickIOException ) {
+
+    Close();
+
+    for (unsigned int segment_number = 0; ; segment_number++) {
+
+      const std::string segment_path = sick_log_segment_path(base_path,segment_number);
+
+      int segment_fd = open(segment_path.c_str(),O_RDONLY);
+      if (segment_fd < 0) {
+	break;
+      }
+
+      struct stat segment_stat;
+      if (fstat(segment_fd,&segment_stat) != 0 || (size_t)segment_stat.st_size < sizeof(sick_log_segment_header_t)) {
+	close(segment_fd);
+	break;
+      }
+
+      /* The mapping outlives the descriptor */
+      void *segment_data = mmap(NULL,segment_stat.st_size,PROT_READ,MAP_SHARED,segment_fd,0);
+      close(segment_fd);
+
+      if (segment_data == MAP_FAILED) {
+	Close();
+	throw SickIOException("SickScanLogReader::Open: mmap() failed for " + segment_path);
+      }
+
+      /* Seeks touch the index and one block, not the whole file */
+      madvise(segment_data,segment_stat.st_size,MADV_RANDOM);
+
+      sick_log_segment_t sick_segment;
+      sick_segment.sick_data = (const uint8_t *)segment_data;
+      sick_segment.sick_size = segment_stat.st_size;
+      _log_segments.push_back(sick_segment);
+
+      const sick_log_segment_header_t *segment_header = (const sick_log_segment_header_t *)sick_segment.sick_data;
+      if (segment_header->sick_magic != DEFAULT_SICK_LOG_SEGMENT_MAGIC || segment_header->sick_version != DEFAULT_SICK_LOG_VERSION) {
+	Close();
+	throw SickConfigException("SickScanLogReader::Open: Not a scan log (or an incompatible version): " + segment_path);
+      }
+
+      _indexSegment(_log_segments.size() - 1);
+
+    }
+
+    if (_log_segments.empty()) {
+      throw SickIOException("SickScanLogReader::Open: No segments found for " + base_path);
+    }
+
+    if (!_log_blocks.empty()) {
+      const sick_log_index_entry_t &last_entry = _log_blocks.back().sick_index_entry;
+      _log_num_scans = last_entry.sick_first_sequence + last_entry.sick_num_scans;
+    }
+
+  }
+
+  /**
+   * \brief Positions the reader at the first scan at or after the given time
+   * \param timestamp The time (usecs since the epoch)
+   * \return False if every scan is older
+   *
+   * NOTE: Assumes the scans were logged in time order.
+   */
+  inline bool SickScanLogReader::SeekToTime( const uint64_t timestamp ) throw( SickIOException, SickBadChecksumException ) {
+
+    /* First block that ends at or after the time */
+    size_t lower = 0, upper = _log_blocks.size();
+    while (lower < upper) {
+      size_t middle = lower + (upper - lower)/2;
+      if (_log_blocks[middle].sick_index_entry.sick_last_timestamp < timestamp) {
+	lower = middle + 1;
+      }
+      else {
+	upper = middle;
+      }
+    }
+
+    if (lower == _log_blocks.size()) {
+      _cursor_block = _log_blocks.size();
+      _cursor_scan = 0;
+      return false;
+    }
+
+    /* Walk the block to the scan */
+    _seek(lower,0);
+
+    sick_log_scan_t sick_scan;
+    while (_cursor_scan < _log_blocks[lower].sick_index_entry.sick_num_scans) {
+
+      /* Peek at the next scan's time (the parser keeps the previous scan's) */
+      _ensureDecoded(16);
+      const uint8_t *scan_ptr = _decoded_ptr;
+      uint64_t time_delta = 0;
+      if (!sick_log_get_varint(scan_ptr,_decoded_end,time_delta)) {
+	throw SickIOException("SickScanLogReader::SeekToTime: Corrupt block!");
+      }
+
+      const uint64_t scan_timestamp = _decoded_last_timestamp + (uint64_t)sick_log_zigzag_decode(time_delta);
+
+      if (scan_timestamp >= timestamp) {
+	return true;
+      }
+
+      _parseScan(sick_scan,_skip_range_values,_skip_reflect_values);
+      _cursor_scan++;
+
+    }
+
+    /* Every scan of the block was older (out of order timestamps) */
+    _seek(lower + 1,0);
+    return _cursor_block < _log_blocks.size();
+
+  }
+
+  /**
+   * \brief Positions the reader at a scan
+   * \param sequence The scan's sequence number
+   * \return False if there is no such scan
+   */
+  inline bool SickScanLogReader::SeekToSequence( const uint64_t sequence ) throw( SickIOException, SickBadChecksumException ) {
+
+    if (sequence >= _log_num_scans) {
+      _cursor_block = _log_blocks.size();
+      _cursor_scan = 0;
+      return false;
+    }
+
+    /* Last block starting at or before the sequence */
+    size_t lower = 0, upper = _log_blocks.size();
+    while (upper - lower > 1) {
+      size_t middle = lower + (upper - lower)/2;
+      if (_log_blocks[middle].sick_index_entry.sick_first_sequence <= sequence) {
+	lower = middle;
+      }
+      else {
+	upper = middle;
+      }
+    }
+
+    _seek(lower,sequence - _log_blocks[lower].sick_index_entry.sick_first_sequence);
+    return true;
+
+  }
+
+  /**
+   * \brief Decodes the scan at the cursor and advances
+   * \param &sick_scan The scan metadata
+   * \param &range_values The range values
+   * \param &reflect_values The echo/RSSI values (empty if none were logged)
+   * \return False at the end of the log
+   */
+  inline bool SickScanLogReader::ReadNextScan( sick_log_scan_t &sick_scan,
+					       std::vector< unsigned int > &range_values,
+					       std::vector< unsigned int > &reflect_values ) throw( SickIOException, SickBadChecksumException ) {
+
+    if (_cursor_block >= _log_blocks.size()) {
+      return false;
+    }
+
+    /* Move on to the next block */
+    if (_cursor_scan >= _log_blocks[_cursor_block].sick_index_entry.sick_num_scans) {
+      _seek(_cursor_block + 1,0);
+      if (_cursor_block >= _log_blocks.size()) {
+	return false;
+      }
+    }
+
+    /* (Re)decode if the cursor was moved w/o decoding */
+    if (_decoded_block != _cursor_block || _decoded_num_scans != _cursor_scan) {
+      _seek(_cursor_block,_cursor_scan);
+    }
+
+    _parseScan(sick_scan,range_values,reflect_values);
+    _cursor_scan++;
+
+    return true;
+
+  }
+
+  /**
+   * \brief Unmaps the log
+   */
+  inline void SickScanLogReader::Close( ) {
+
+    for (unsigned int i = 0; i < _log_segments.size(); i++) {
+      munmap((void *)_log_segments[i].sick_data,_log_segments[i].sick_size);
+    }
+
+    _log_segments.clear();
+    _log_blocks.clear();
+    _log_num_scans = 0;
+    _cursor_block = 0;
+    _cursor_scan = 0;
+    _decoded_block = (size_t)-1;
+    _decoded_ptr = _decoded_end = _decoded_raw_end = NULL;
+
+  }
+
+  /**
+   * \brief Loads the block index of a segment, or rebuilds it if the segment
+   *        was never closed
+   * \param segment_number The (mapped) segment
+   */
+  inline void SickScanLogReader::_indexSegment( const unsigned int segment_number ) {
+
+    const sick_log_segment_t &sick_segment = _log_segments[segment_number];
+
+    sick_log_block_t sick_block;
+    sick_block.sick_segment = segment_number;
+
+    /* Use the index if the trailer checks out */
+    if (sick_segment.sick_size >= sizeof(sick_log_segment_header_t) + sizeof(sick_log_index_trailer_t)) {
+
+      const sick_log_index_trailer_t *index_trailer = (const sick_log_index_trailer_t *)(sick_segment.sick_data + sick_segment.sick_size - sizeof(sick_log_index_trailer_t));
+
+      if (index_trailer->sick_magic == DEFAULT_SICK_LOG_INDEX_MAGIC &&
+	  index_trailer->sick_index_offset + (uint64_t)index_trailer->sick_num_entries*sizeof(sick_log_index_entry_t) + sizeof(sick_log_index_trailer_t) == sick_segment.sick_size) {
+
+	const sick_log_index_entry_t *index_entries = (const sick_log_index_entry_t *)(sick_segment.sick_data + index_trailer->sick_index_offset);
+	for (uint32_t i = 0; i < index_trailer->sick_num_entries; i++) {
+	  sick_block.sick_index_entry = index_entries[i];
+	  _log_blocks.push_back(sick_block);
+	}
+
+	return;
+
+      }
+
+    }
+
+    /* Otherwise walk the blocks, stopping at the first incomplete one */
+    uint64_t block_offset = sizeof(sick_log_segment_header_t);
+    while (block_offset + sizeof(sick_log_block_header_t) <= sick_segment.sick_size) {
+
+      const sick_log_block_header_t *block_header = (const sick_log_block_header_t *)(sick_segment.sick_data + block_offset);
+      if (block_header->sick_magic != DEFAULT_SICK_LOG_BLOCK_MAGIC ||
+	  block_offset + sizeof(sick_log_block_header_t) + block_header->sick_stored_size > sick_segment.sick_size) {
+	break;
+      }
+
+      memset(&sick_block.sick_index_entry,0,sizeof(sick_block.sick_index_entry));
+      sick_block.sick_index_entry.sick_first_timestamp = block_header->sick_first_timestamp;
+      sick_block.sick_index_entry.sick_last_timestamp = block_header->sick_last_timestamp;
+      sick_block.sick_index_entry.sick_first_sequence = block_header->sick_first_sequence;
+      sick_block.sick_index_entry.sick_offset = block_offset;
+      sick_block.sick_index_entry.sick_num_scans = block_header->sick_num_scans;
+      _log_blocks.push_back(sick_block);
+
+      block_offset += sizeof(sick_log_block_header_t) + block_header->sick_stored_size;
+
+    }
+
+  }
+
+  /**
+   * \brief Verifies and decodes a block
+   * \param block_number The block
+   */
+  inline void SickScanLogReader::_decodeBlock( const size_t block_number ) throw( SickIOException, SickBadChecksumException ) {
+
+    const sick_log_block_t &sick_block = _log_blocks[block_number];
+    const sick_log_segment_t &sick_segment = _log_segments[sick_block.sick_segment];
+
+    _decoded_block = (size_t)-1;
+
+    /* Locate the block */
+    const uint64_t block_offset = sick_block.sick_index_entry.sick_offset;
+    if (block_offset + sizeof(sick_log_block_header_t) > sick_segment.sick_size) {
+      throw SickIOException("SickScanLogReader::_decodeBlock: Block is out of bounds!");
+    }
+
+    const sick_log_block_header_t *block_header = (const sick_log_block_header_t *)(sick_segment.sick_data + block_offset);
+    const uint8_t *stored_buffer = (const uint8_t *)(block_header + 1);
+
+    if (block_header->sick_magic != DEFAULT_SICK_LOG_BLOCK_MAGIC ||
+	block_offset + sizeof(sick_log_block_header_t) + block_header->sick_stored_size > sick_segment.sick_size) {
+      throw SickIOException("SickScanLogReader::_decodeBlock: Corrupt block header!");
+    }
+
+    if (sick_log_crc32(stored_buffer,block_header->sick_stored_size) != block_header->sick_checksum) {
+      throw SickBadChecksumException("SickScanLogReader::_decodeBlock: Block checksum mismatch!");
+    }
+
+    /* Prepare to undo the entropy coding (see _ensureDecoded) */
+    _decoded_buffer.resize(block_header->sick_raw_size + 1);
+    _decoded_raw = (block_header->sick_encoding == SICK_LOG_ENCODING_RAW);
+
+    if (_decoded_raw) {
+      if (block_header->sick_stored_size != block_header->sick_raw_size) {
+	throw SickIOException("SickScanLogReader::_decodeBlock: Corrupt block header!");
+      }
+      memcpy(&_decoded_buffer[0],stored_buffer,block_header->sick_raw_size);
+    }
+    else if (block_header->sick_encoding != SICK_LOG_ENCODING_RANS ||
+	     !sick_log_rans_decoder_init(_rans_decoder,stored_buffer,block_header->sick_stored_size)) {
+      throw SickIOException("SickScanLogReader::_decodeBlock: Unable to decode block!");
+    }
+
+    _decoded_block = block_number;
+    _decoded_ptr = &_decoded_buffer[0];
+    _decoded_raw_end = _decoded_ptr + block_header->sick_raw_size;
+    _decoded_end = _decoded_raw ? _decoded_raw_end : _decoded_ptr;
+    _decoded_num_scans = 0;
+    _decoded_last_timestamp = block_header->sick_first_timestamp;
+    _decoded_prev_ranges.clear();
+
+  }
+
+  /**
+   * \brief Ensures the next num_bytes of the block (or the rest of it) are decoded
+   *
+   * Decoding runs a little ahead so a seek into the start of a block pays
+   * for a fraction of it rather than the whole block.
+   */
+  inline void SickScanLogReader::_ensureDecoded( const size_t num_bytes ) throw( SickIOException ) {
+
+    const size_t min_chunk_size = 4096;
+
+    if ((size_t)(_decoded_end - _decoded_ptr) >= num_bytes || _decoded_end == _decoded_raw_end) {
+      return;
+    }
+
+    size_t decode_length = (_decoded_ptr + num_bytes) - _decoded_end;
+    if (decode_length < min_chunk_size) {
+      decode_length = min_chunk_size;
+    }
+    if (decode_length > (size_t)(_decoded_raw_end - _decoded_end)) {
+      decode_length = _decoded_raw_end - _decoded_end;
+    }
+
+    if (!sick_log_rans_decoder_decode(_rans_decoder,(uint8_t *)_decoded_end,decode_length)) {
+      throw SickIOException("SickScanLogReader::_ensureDecoded: Unable to decode block!");
+    }
+
+    _decoded_end += decode_length;
+
+  }
+
+  /**
+   * \brief Parses the next scan of the decoded block (mirrors SickScanLogWriter::WriteScan)
+   */
+  inline void SickScanLogReader::_parseScan( sick_log_scan_t &sick_scan,
+					     std::vector< unsigned int > &range_values,
+					     std::vector< unsigned int > &reflect_values ) throw( SickIOException ) {
+
+    const sick_log_index_entry_t &index_entry = _log_blocks[_decoded_block].sick_index_entry;
+
+    uint64_t time_delta = 0, sensor_id = 0, num_ranges = 0, num_reflect = 0;
+
+    /* Header: two varints, three floats, two varints and the delta mode */
+    _ensureDecoded(64);
+
+    if (!sick_log_get_varint(_decoded_ptr,_decoded_end,time_delta) ||
+	!sick_log_get_varint(_decoded_ptr,_decoded_end,sensor_id) ||
+	_decoded_end - _decoded_ptr < (ptrdiff_t)(3*sizeof(float))) {
+      throw SickIOException("SickScanLogReader::_parseScan: Corrupt block!");
+    }
+
+    sick_scan.sick_timestamp = _decoded_last_timestamp + (uint64_t)sick_log_zigzag_decode(time_delta);
+    sick_scan.sick_sequence = index_entry.sick_first_sequence + _decoded_num_scans;
+    sick_scan.sick_sensor_id = (uint32_t)sensor_id;
+
+    memcpy(&sick_scan.sick_start_angle,_decoded_ptr,sizeof(float));
+    memcpy(&sick_scan.sick_angle_step,_decoded_ptr + sizeof(float),sizeof(float));
+    memcpy(&sick_scan.sick_range_scale,_decoded_ptr + 2*sizeof(float),sizeof(float));
+    _decoded_ptr += 3*sizeof(float);
+
+    if (!sick_log_get_varint(_decoded_ptr,_decoded_end,num_ranges) ||
+	!sick_log_get_varint(_decoded_ptr,_decoded_end,num_reflect) ||
+	_decoded_ptr >= _decoded_end ||
+	num_ranges > (uint64_t)(_decoded_raw_end - _decoded_ptr) || num_reflect > 8*(uint64_t)(_decoded_raw_end - _decoded_ptr)) {
+      throw SickIOException("SickScanLogReader::_parseScan: Corrupt block!");
+    }
+
+    /* Ranges take at most 5 bytes each (plus the echo width byte) */
+    _ensureDecoded(1 + 5*num_ranges + 1);
+
+    sick_scan.sick_num_ranges = (uint32_t)num_ranges;
+    sick_scan.sick_num_reflect = (uint32_t)num_reflect;
+
+    /* Ranges */
+    std::vector< unsigned int > &prev_ranges = _decoded_prev_ranges[sick_scan.sick_sensor_id];
+    const bool inter_scan = (*_decoded_ptr++ != 0);
+
+    if (inter_scan && prev_ranges.size() != num_ranges) {
+      throw SickIOException("SickScanLogReader::_parseScan: Corrupt block!");
+    }
+
+    range_values.resize(num_ranges);
+
+    int64_t prev_range = 0;
+    for (unsigned int i = 0; i < num_ranges; i++) {
+
+      uint64_t range_delta = 0;
+      if (!sick_log_get_varint(_decoded_ptr,_decoded_end,range_delta)) {
+	throw SickIOException("SickScanLogReader::_parseScan: Corrupt block!");
+      }
+
+      const int64_t reference = inter_scan ? (int64_t)prev_ranges[i] : prev_range;
+      range_values[i] = (unsigned int)(reference + sick_log_zigzag_decode(range_delta));
+      prev_range = range_values[i];
+
+    }
+
+    prev_ranges = range_values;
+
+    /* Echo/RSSI */
+    reflect_values.resize(num_reflect);
+
+    if (num_reflect > 0) {
+
+      if (_decoded_ptr >= _decoded_end) {
+	throw SickIOException("SickScanLogReader::_parseScan: Corrupt block!");
+      }
+
+      const unsigned int bit_width = *_decoded_ptr++;
+      _ensureDecoded((num_reflect*bit_width + 7)/8);
+
+      if (bit_width > 32 || (num_reflect*bit_width + 7)/8 > (uint64_t)(_decoded_end - _decoded_ptr)) {
+	throw SickIOException("SickScanLogReader::_parseScan: Corrupt block!");
+      }
+
+      const uint64_t value_mask = (bit_width == 32) ? 0xFFFFFFFFULL : (((uint64_t)1 << bit_width) - 1);
+
+      uint64_t bit_buffer = 0;
+      unsigned int num_bits = 0;
+      for (unsigned int i = 0; i < num_reflect; i++) {
+	while (num_bits < bit_width) {
+	  bit_buffer |= (uint64_t)(*_decoded_ptr++) << num_bits;
+	  num_bits += 8;
+	}
+	reflect_values[i] = (unsigned int)(bit_buffer & value_mask);
+	bit_buffer >>= bit_width;
+	num_bits -= bit_width;
+      }
+
+    }
+
+    _decoded_last_timestamp = sick_scan.sick_timestamp;
+    _decoded_num_scans++;
+
+  }
+
+  /**
+   * \brief Moves the cursor to a scan
+   * \param block_number The block
+   * \param scan_number The scan within the block
+   */
+  inline void SickScanLogReader::_seek( const size_t block_number, const unsigned int scan_number ) throw( SickIOException, SickBadChecksumException ) {
+
+    _cursor_block = block_number;
+    _cursor_scan = scan_number;
+
+    if (block_number >= _log_blocks.size()) {
+      return;
+    }
+
+    /* Decode unless we can simply parse forward */
+    if (_decoded_block != block_number || _decoded_num_scans > scan_number) {
+      _decodeBlock(block_number);
+      _prefetchBlock(block_number + 1);
+    }
+
+    /* Deltas chain through the block, so earlier scans have to be parsed */
+    sick_log_scan_t sick_scan;
+    while (_decoded_num_scans < scan_number) {
+      _parseScan(sick_scan,_skip_range_values,_skip_reflect_values);
+    }
+
+  }
+
+  /**
+   * \brief Asks the kernel to read a block ahead of time
+   */
+  inline void SickScanLogReader::_prefetchBlock( const size_t block_number ) const {
+
+    if (block_number >= _log_blocks.size()) {
+      return;
+    }
+
+    const sick_log_block_t &sick_block = _log_blocks[block_number];
+    const sick_log_segment_t &sick_segment = _log_segments[sick_block.sick_segment];
+
+    /* madvise wants a page aligned start */
+    const uint64_t page_size = sysconf(_SC_PAGESIZE);
+    const uint64_t block_begin = sick_block.sick_index_entry.sick_offset & ~(page_size - 1);
+    const uint64_t block_end = (block_number + 1 < _log_blocks.size() && _log_blocks[block_number + 1].sick_segment == sick_block.sick_segment) ?
+      _log_blocks[block_number + 1].sick_index_entry.sick_offset : sick_segment.sick_size;
+
+    if (block_end > block_begin && block_end <= sick_segment.sick_size) {
+      madvise((void *)(sick_segment.sick_data + block_begin),block_end - block_begin,MADV_WILLNEED);
+    }
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_LOG_READER */
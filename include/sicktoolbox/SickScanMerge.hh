@@ -0,0 +1,894 @@
+/*!
+ * \file SickScanMerge.hh
+ * \brief Defines an engine fusing the scans of several Sick units into one 360 deg scan.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_MERGE
+#define SICK_SCAN_MERGE
+
+/* Macros */
+#define DEFAULT_SICK_SCAN_MERGE_BIN_SIZE                     (0.5)  ///< Angular width of a fused bin (deg)
+#define DEFAULT_SICK_SCAN_MERGE_MAX_SKEW                  (100000)  ///< Max start time difference of merged scans (usecs)
+#define SICK_SCAN_MERGE_ATAN_TABLE_SIZE                     (4096)  ///< Entries of the first octant atan table
+#define SICK_SCAN_MERGE_OFFSET_WINDOW                         (64)  ///< Scans over which a source's clock offset is estimated
+#define SICK_SCAN_MERGE_ERROR_BACKOFF                      (10000)  ///< Pause after a failed acquisition (usecs)
+
+/* Dependencies */
+#include <new>
+#include <vector>
+#include <math.h>
+#include <errno.h>
+#include <time.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "SickScan.hh"
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickScanMergeSource
+   * \brief Something that blocks until it can hand over the next scan.
+   */
+  class SickScanMergeSource {
+
+  public:
+
+    /** Fills the given scan with the next one from the device */
+    virtual void GetSickScan( SickScan &sick_scan ) = 0;
+
+    /** A standard destructor */
+    virtual ~SickScanMergeSource( ) { }
+
+  };
+
+  /**
+   * \class SickScanMergeDriverSource
+   * \brief Adapts any driver with a GetSickScan(SickScan &) (e.g. SickLD, SickLMS1xx).
+   *
+   * The driver must already be initialized (and, for the LD, streaming
+   * profiles for GetSickScan()). It is not owned.
+   */
+  template < class SICK_DRIVER_CLASS >
+  class SickScanMergeDriverSource : public SickScanMergeSource {
+
+  public:
+
+    /** A standard constructor */
+    SickScanMergeDriverSource( SICK_DRIVER_CLASS &sick_driver ) : _sick_driver(sick_driver) { }
+
+    /** Fills the given scan with the next one from the driver */
+    void GetSickScan( SickScan &sick_scan ) { _sick_driver.GetSickScan(sick_scan); }
+
+  private:
+
+    /** The driver */
+    SICK_DRIVER_CLASS &_sick_driver;
+
+  };
+
+  /**
+   * \class SickScanMerge
+   * \brief Fuses the scans of several units into a single angular-binned scan.
+   *
+   * Each source gets its own acquisition thread (driver calls block) and a
+   * dedicated worker fuses the newest scan of every source each time the
+   * first (master) source delivers one. Scans of the other sources are only
+   * used when their start time lies within max_skew of the master's.
+   *
+   * Scans are timed per source, in this order of preference:
+   *  - A source that maps its own device clock to host time (the header's
+   *    sick_device_host_time, e.g. filled by SickLD from its clock sync) is
+   *    taken at its word. That time is CLOCK_MONOTONIC and is moved onto the
+   *    wall clock (gettimeofday) the engine works in as the scan is aligned.
+   *  - Otherwise the device clock is unwrapped and offset by the minimum (host
+   *    fill time - device time of the last beam) seen over the last
+   *    SICK_SCAN_MERGE_OFFSET_WINDOW scans, i.e. by the lowest transport
+   *    latency. This envelope is only as good as the fastest recent delivery.
+   *  - Sources without a device clock fall back to the host fill time.
+   *
+   * Beams are transformed with the source extrinsics (x, y in m, yaw in deg)
+   * and binned by their angle about the vehicle origin; each bin keeps the
+   * nearest return. The per-beam unit vectors and bins of a source are
+   * cached and only rebuilt when its beam layout changes. Deskewed scans
+   * (e.g. an LD w/ a pose lookup) move their angles every revolution, so
+   * their tables are rebuilt per scan and the cache buys nothing. Sources that sit
+   * on the origin bin straight from that table; offset sources bin through
+   * a precomputed atan table instead of calling atan2 per beam.
+   *
+   * The fused scan has GetNumBins() beams: bin k is centered on (k + 0.5)*bin
+   * size deg, ranges are measured from the origin, empty bins are flagged
+   * SICK_SCAN_FLAG_NO_RETURN, and the time offsets are relative to the
+   * master scan's first beam, whose host time is in the header.
+   */
+  class SickScanMerge {
+
+  public:
+
+    /** A standard constructor */
+    SickScanMerge( const double bin_size = DEFAULT_SICK_SCAN_MERGE_BIN_SIZE,
+                   const unsigned int max_skew = DEFAULT_SICK_SCAN_MERGE_MAX_SKEW ) throw( SickConfigException, SickThreadException );
+
+    /** Adds a source (the first one added is the master) */
+    unsigned int AddSource( SickScanMergeSource &sick_source,
+                            const double x, const double y, const double yaw,
+                            const double device_tick_period = 0,
+                            const uint64_t device_clock_wrap = 0 ) throw( SickConfigException );
+
+    /** Starts acquiring and merging */
+    void Start( ) throw( SickConfigException, SickThreadException );
+
+    /** Stops acquiring and merging (waits for the pending driver calls) */
+    void Stop( ) throw( SickThreadException );
+
+    /** Gets the next fused scan (waits up to timeout_value usecs) */
+    void GetMergedScan( SickScan &sick_scan, const unsigned int timeout_value ) throw( SickTimeoutException, SickThreadException );
+
+    /** Number of fused bins */
+    unsigned int GetNumBins( ) const { return _sick_num_bins; }
+
+    /** Angular width of a fused bin (deg) */
+    double GetBinSize( ) const { return 360.0/_sick_num_bins; }
+
+    /** Number of sources */
+    unsigned int GetNumSources( ) const { return _sick_sources.size(); }
+
+    /** Estimated host - device clock offset of a source (usecs, envelope estimate only) */
+    double GetSourceClockOffset( const unsigned int source_id ) const throw( SickConfigException );
+
+    /** Number of failed acquisitions of a source */
+    unsigned int GetSourceNumErrors( const unsigned int source_id ) const throw( SickConfigException );
+
+    /** Number of fused scans overwritten before they were fetched */
+    unsigned int GetNumDropped( ) const { return _sick_num_dropped; }
+
+    /** A standard destructor */
+    ~SickScanMerge( );
+
+  private:
+
+    /*!
+     * \struct sick_scan_merge_source_tag
+     * \brief Per-source state
+     */
+    /*!
+     * \typedef sick_scan_merge_source_t
+     * \brief Adopt c-style convention
+     */
+    typedef struct sick_scan_merge_source_tag {
+
+      SickScanMergeSource *sick_source;                                                 ///< The scan source (not owned)
+      SickScanMerge *sick_merge;                                                        ///< The owning engine (thread argument)
+      double sick_x;                                                                    ///< Position in the vehicle frame (m)
+      double sick_y;                                                                    ///< Position in the vehicle frame (m)
+      double sick_yaw;                                                                  ///< Heading in the vehicle frame (deg)
+      double sick_device_tick_period;                                                   ///< Device clock tick (usecs, 0 => no device clock)
+      uint64_t sick_device_clock_wrap;                                                  ///< Device clock period (ticks, 0 => 2^32)
+      pthread_t sick_thread_id;                                                         ///< Acquisition thread
+
+      SickScan sick_acq_scan;                                                           ///< Being filled (acquisition thread only)
+      SickScan sick_latest_scan;                                                        ///< Newest complete scan (guarded)
+      SickScan sick_merge_scan;                                                         ///< Newest scan seen by the worker (worker only)
+      double sick_latest_time;                                                          ///< Host time of sick_latest_scan's first beam (usecs)
+      double sick_merge_time;                                                           ///< Host time of sick_merge_scan's first beam (usecs)
+      bool sick_latest_new;                                                             ///< sick_latest_scan has not been merged yet
+      bool sick_merge_valid;                                                            ///< sick_merge_scan holds a scan
+      unsigned int sick_num_errors;                                                     ///< Failed acquisitions
+
+      bool sick_clock_valid;                                                            ///< A device timestamp has been seen
+      uint32_t sick_last_device_time;                                                   ///< Last device timestamp (ticks)
+      uint64_t sick_device_time;                                                        ///< Unwrapped device time (ticks)
+      double sick_offsets[SICK_SCAN_MERGE_OFFSET_WINDOW];                               ///< Recent host - device offsets (usecs)
+      unsigned int sick_num_offsets;                                                    ///< Offsets recorded so far
+      double sick_clock_offset;                                                         ///< Current offset estimate (usecs)
+
+      std::vector< float > sick_table_angles;                                           ///< Beam layout the tables were built for (deg)
+      std::vector< float > sick_table_cos;                                              ///< cos of each beam in the vehicle frame
+      std::vector< float > sick_table_sin;                                              ///< sin of each beam in the vehicle frame
+      std::vector< unsigned int > sick_table_bins;                                      ///< Bin of each beam (sources on the origin)
+
+    } sick_scan_merge_source_t;
+
+    /** The sources */
+    std::vector< sick_scan_merge_source_t * > _sick_sources;
+
+    /** Number of fused bins */
+    unsigned int _sick_num_bins;
+
+    /** Bins per deg */
+    double _sick_bins_per_deg;
+
+    /** Max start time difference of merged scans (usecs) */
+    unsigned int _sick_max_skew;
+
+    /** atan(i/SICK_SCAN_MERGE_ATAN_TABLE_SIZE) (deg) */
+    float _sick_atan_table[SICK_SCAN_MERGE_ATAN_TABLE_SIZE + 1];
+
+    /** Fused scan being built (worker only) */
+    SickScan _sick_work_scan;
+
+    /** Newest fused scan (guarded) */
+    SickScan _sick_ready_scan;
+
+    /** _sick_ready_scan has not been fetched yet */
+    bool _sick_ready_new;
+
+    /** Fused scans overwritten before they were fetched */
+    unsigned int _sick_num_dropped;
+
+    /** Number of fused scans so far */
+    uint32_t _sick_num_merged;
+
+    /** Whether the threads should keep running */
+    volatile bool _sick_running;
+
+    /** Whether the threads were started */
+    bool _sick_started;
+
+    /** Worker thread */
+    pthread_t _sick_worker_thread_id;
+
+    /** Guards the latest/ready scans and the flags */
+    mutable pthread_mutex_t _sick_merge_mutex;
+
+    /** Signals a new master scan (to the worker) */
+    pthread_cond_t _sick_source_cond;
+
+    /** Signals a new fused scan (to GetMergedScan) */
+    pthread_cond_t _sick_ready_cond;
+
+    /** Acquisition thread entry point */
+    static void * _acquireThread( void * const thread_args );
+
+    /** Worker thread entry point */
+    static void * _mergeThread( void * const thread_args );
+
+    /** Timestamps a freshly acquired scan (acquisition thread only) */
+    static double _alignScan( sick_scan_merge_source_t &sick_source, const SickScan &sick_scan );
+
+    /** Current wall clock - CLOCK_MONOTONIC difference (usecs) */
+    static double _monotonicToWallOffset( );
+
+    /** Rebuilds the beam tables of a source if its layout changed */
+    void _updateBeamTables( sick_scan_merge_source_t &sick_source, const SickScan &sick_scan ) throw( std::bad_alloc );
+
+    /** Fuses the current source scans into _sick_work_scan */
+    void _mergeScans( const double reference_time ) throw( std::bad_alloc );
+
+    /** Bin of a point in the vehicle frame */
+    unsigned int _binIndex( const float x, const float y ) const;
+
+    /** Stops and joins the threads started so far */
+    void _joinThreads( const unsigned int num_acquire_threads, const bool worker_started );
+
+    /** Not copyable */
+    SickScanMerge( const SickScanMerge & );
+    SickScanMerge & operator=( const SickScanMerge & );
+
+  };
+
+  /**
+   * \brief A standard constructor
+   * \param bin_size Angular width of a fused bin (deg, must divide 360)
+   * \param max_skew Max start time difference of merged scans (usecs)
+   */
+  inline SickScanMerge::SickScanMerge( const double bin_size, const unsigned int max_skew ) throw( SickConfigException, SickThreadException ) :
+    _sick_num_bins(0), _sick_bins_per_deg(0), _sick_max_skew(max_skew), _sick_ready_new(false), _sick_num_dropped(0),
+    _sick_num_merged(0), _sick_running(false), _sick_started(false) {
+
+    if (bin_size <= 0 || bin_size > 360) {
+      throw SickConfigException("SickScanMerge::SickScanMerge: Invalid bin size!");
+    }
+
+    _sick_num_bins = (unsigned int)(360.0/bin_size + 0.5);
+    if (fabs(_sick_num_bins*bin_size - 360.0) > 1e-6) {
+      throw SickConfigException("SickScanMerge::SickScanMerge: Bin size must divide 360 deg!");
+    }
+    _sick_bins_per_deg = _sick_num_bins/360.0;
+
+    for (unsigned int i = 0; i <= SICK_SCAN_MERGE_ATAN_TABLE_SIZE; i++) {
+      _sick_atan_table[i] = (float)(atan((double)i/SICK_SCAN_MERGE_ATAN_TABLE_SIZE)*180.0/M_PI);
+    }
+
+    if (pthread_mutex_init(&_sick_merge_mutex,NULL) != 0) {
+      throw SickThreadException("SickScanMerge::SickScanMerge: pthread_mutex_init() failed!");
+    }
+
+    if (pthread_cond_init(&_sick_source_cond,NULL) != 0) {
+      pthread_mutex_destroy(&_sick_merge_mutex);
+      throw SickThreadException("SickScanMerge::SickScanMerge: pthread_cond_init() failed!");
+    }
+
+    if (pthread_cond_init(&_sick_ready_cond,NULL) != 0) {
+      pthread_cond_destroy(&_sick_source_cond);
+      pthread_mutex_destroy(&_sick_merge_mutex);
+      throw SickThreadException("SickScanMerge::SickScanMerge: pthread_cond_init() failed!");
+    }
+
+  }
+
+  /**
+   * \brief Adds a source
+   * \param sick_source The scan source (not owned, must outlive the engine)
+   * \param x Position of the unit in the vehicle frame (m)
+   * \param y Position of the unit in the vehicle frame (m)
+   * \param yaw Heading of the unit in the vehicle frame (deg)
+   * \param device_tick_period Duration of one device clock tick (usecs, 0 => use the host fill time)
+   * \param device_clock_wrap Period of the device clock (ticks, 0 => 2^32)
+   * \return The source id (0 => master)
+   *
+   * The LMS 1xx reports usecs (1, 0) and the LD reports 16-bit ms (1000, 65536).
+   */
+  inline unsigned int SickScanMerge::AddSource( SickScanMergeSource &sick_source,
+                                                const double x, const double y, const double yaw,
+                                                const double device_tick_period,
+                                                const uint64_t device_clock_wrap ) throw( SickConfigException ) {
+
+    if (_sick_started) {
+      throw SickConfigException("SickScanMerge::AddSource: Sources must be added before Start()!");
+    }
+
+    if (device_tick_period < 0) {
+      throw SickConfigException("SickScanMerge::AddSource: Invalid device tick period!");
+    }
+
+    sick_scan_merge_source_t *source = NULL;
+    try {
+      source = new sick_scan_merge_source_t;
+    }
+
+    catch (std::bad_alloc &sick_alloc_exception) {
+      throw SickConfigException("SickScanMerge::AddSource: Failed to allocate source!");
+    }
+
+    source->sick_source = &sick_source;
+    source->sick_merge = this;
+    source->sick_x = x;
+    source->sick_y = y;
+    source->sick_yaw = yaw;
+    source->sick_device_tick_period = device_tick_period;
+    source->sick_device_clock_wrap = device_clock_wrap;
+    source->sick_latest_time = source->sick_merge_time = 0;
+    source->sick_latest_new = source->sick_merge_valid = false;
+    source->sick_num_errors = 0;
+    source->sick_clock_valid = false;
+    source->sick_last_device_time = 0;
+    source->sick_device_time = 0;
+    source->sick_num_offsets = 0;
+    source->sick_clock_offset = 0;
+
+    _sick_sources.push_back(source);
+
+    return _sick_sources.size() - 1;
+
+  }
+
+  /**
+   * \brief Starts acquiring and merging
+   */
+  inline void SickScanMerge::Start( ) throw( SickConfigException, SickThreadException ) {
+
+    if (_sick_started) {
+      return;
+    }
+
+    if (_sick_sources.empty()) {
+      throw SickConfigException("SickScanMerge::Start: No sources were added!");
+    }
+
+    try {
+      _sick_work_scan.Reserve(_sick_num_bins);
+      _sick_ready_scan.Reserve(_sick_num_bins);
+    }
+
+    catch (std::bad_alloc &sick_alloc_exception) {
+      throw SickConfigException("SickScanMerge::Start: Failed to allocate fused scans!");
+    }
+
+    _sick_running = true;
+
+    if (pthread_create(&_sick_worker_thread_id,NULL,_mergeThread,this) != 0) {
+      _sick_running = false;
+      throw SickThreadException("SickScanMerge::Start: pthread_create() failed!");
+    }
+
+    for (unsigned int i = 0; i < _sick_sources.size(); i++) {
+      if (pthread_create(&_sick_sources[i]->sick_thread_id,NULL,_acquireThread,_sick_sources[i]) != 0) {
+        _joinThreads(i,true);
+        throw SickThreadException("SickScanMerge::Start: pthread_create() failed!");
+      }
+    }
+
+    _sick_started = true;
+
+  }
+
+  /**
+   * \brief Stops acquiring and merging
+   *
+   * The acquisition threads are joined once their pending driver call
+   * returns, so this may take up to the drivers' receive timeouts.
+   */
+  inline void SickScanMerge::Stop( ) throw( SickThreadException ) {
+
+    if (!_sick_started) {
+      return;
+    }
+
+    _joinThreads(_sick_sources.size(),true);
+    _sick_started = false;
+
+  }
+
+  /**
+   * \brief Gets the next fused scan
+   * \param sick_scan Destination (its storage is recycled by the engine)
+   * \param timeout_value Max time to wait (usecs)
+   */
+  inline void SickScanMerge::GetMergedScan( SickScan &sick_scan, const unsigned int timeout_value ) throw( SickTimeoutException, SickThreadException ) {
+
+    /* Compute the deadline */
+    struct timeval curr_time;
+    gettimeofday(&curr_time,NULL);
+
+    struct timespec deadline;
+    uint64_t deadline_usecs = (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_usec + timeout_value;
+    deadline.tv_sec = deadline_usecs/1000000;
+    deadline.tv_nsec = (deadline_usecs%1000000)*1000;
+
+    if (pthread_mutex_lock(&_sick_merge_mutex) != 0) {
+      throw SickThreadException("SickScanMerge::GetMergedScan: pthread_mutex_lock() failed!");
+    }
+
+    while (!_sick_ready_new) {
+      if (pthread_cond_timedwait(&_sick_ready_cond,&_sick_merge_mutex,&deadline) == ETIMEDOUT && !_sick_ready_new) {
+        pthread_mutex_unlock(&_sick_merge_mutex);
+        throw SickTimeoutException("SickScanMerge::GetMergedScan: No fused scan was produced in time!");
+      }
+    }
+
+    /* Hand over the fused scan, the caller's storage becomes the next ready buffer */
+    sick_scan.Swap(_sick_ready_scan);
+    _sick_ready_new = false;
+
+    pthread_mutex_unlock(&_sick_merge_mutex);
+
+  }
+
+  /**
+   * \brief Estimated host - device clock offset of a source
+   * \param source_id The source
+   */
+  inline double SickScanMerge::GetSourceClockOffset( const unsigned int source_id ) const throw( SickConfigException ) {
+
+    if (source_id >= _sick_sources.size()) {
+      throw SickConfigException("SickScanMerge::GetSourceClockOffset: Invalid source id!");
+    }
+
+    pthread_mutex_lock(&_sick_merge_mutex);
+    const double clock_offset = _sick_sources[source_id]->sick_clock_offset;
+    pthread_mutex_unlock(&_sick_merge_mutex);
+
+    return clock_offset;
+
+  }
+
+  /**
+   * \brief Number of failed acquisitions of a source
+   * \param source_id The source
+   */
+  inline unsigned int SickScanMerge::GetSourceNumErrors( const unsigned int source_id ) const throw( SickConfigException ) {
+
+    if (source_id >= _sick_sources.size()) {
+      throw SickConfigException("SickScanMerge::GetSourceNumErrors: Invalid source id!");
+    }
+
+    pthread_mutex_lock(&_sick_merge_mutex);
+    const unsigned int num_errors = _sick_sources[source_id]->sick_num_errors;
+    pthread_mutex_unlock(&_sick_merge_mutex);
+
+    return num_errors;
+
+  }
+
+  /**
+   * \brief A standard destructor
+   */
+  inline SickScanMerge::~SickScanMerge( ) {
+
+    try {
+      Stop();
+    }
+
+    catch (...) { }
+
+    for (unsigned int i = 0; i < _sick_sources.size(); i++) {
+      delete _sick_sources[i];
+    }
+
+    pthread_cond_destroy(&_sick_ready_cond);
+    pthread_cond_destroy(&_sick_source_cond);
+    pthread_mutex_destroy(&_sick_merge_mutex);
+
+  }
+
+  /**
+   * \brief Acquisition thread entry point
+   * \param thread_args The source
+   */
+  inline void * SickScanMerge::_acquireThread( void * const thread_args ) {
+
+    sick_scan_merge_source_t &sick_source = *(sick_scan_merge_source_t *)thread_args;
+    SickScanMerge &sick_merge = *sick_source.sick_merge;
+    const bool is_master = (&sick_source == sick_merge._sick_sources[0]);
+
+    while (sick_merge._sick_running) {
+
+      try {
+        sick_source.sick_source->GetSickScan(sick_source.sick_acq_scan);
+      }
+
+      /* Timeouts and bad telegrams are expected now and then, just keep going */
+      catch (...) {
+        pthread_mutex_lock(&sick_merge._sick_merge_mutex);
+        sick_source.sick_num_errors++;
+        pthread_mutex_unlock(&sick_merge._sick_merge_mutex);
+        usleep(SICK_SCAN_MERGE_ERROR_BACKOFF);
+        continue;
+      }
+
+      const double scan_time = _alignScan(sick_source,sick_source.sick_acq_scan);
+
+      pthread_mutex_lock(&sick_merge._sick_merge_mutex);
+      sick_source.sick_latest_scan.Swap(sick_source.sick_acq_scan);
+      sick_source.sick_latest_time = scan_time;
+      sick_source.sick_latest_new = true;
+      if (is_master) {
+        pthread_cond_signal(&sick_merge._sick_source_cond);
+      }
+      pthread_mutex_unlock(&sick_merge._sick_merge_mutex);
+
+    }
+
+    return NULL;
+
+  }
+
+  /**
+   * \brief Worker thread entry point
+   * \param thread_args The engine
+   */
+  inline void * SickScanMerge::_mergeThread( void * const thread_args ) {
+
+    SickScanMerge &sick_merge = *(SickScanMerge *)thread_args;
+    sick_scan_merge_source_t &sick_master = *sick_merge._sick_sources[0];
+
+    pthread_mutex_lock(&sick_merge._sick_merge_mutex);
+
+    while (sick_merge._sick_running) {
+
+      if (!sick_master.sick_latest_new) {
+        pthread_cond_wait(&sick_merge._sick_source_cond,&sick_merge._sick_merge_mutex);
+        continue;
+      }
+
+      /* Take the newest scan of every source (zero-copy, the worker's previous one goes back) */
+      for (unsigned int i = 0; i < sick_merge._sick_sources.size(); i++) {
+        sick_scan_merge_source_t &sick_source = *sick_merge._sick_sources[i];
+        if (sick_source.sick_latest_new) {
+          sick_source.sick_merge_scan.Swap(sick_source.sick_latest_scan);
+          sick_source.sick_merge_time = sick_source.sick_latest_time;
+          sick_source.sick_merge_valid = true;
+          sick_source.sick_latest_new = false;
+        }
+      }
+
+      pthread_mutex_unlock(&sick_merge._sick_merge_mutex);
+
+      bool merged = true;
+      try {
+        sick_merge._mergeScans(sick_master.sick_merge_time);
+      }
+
+      catch (std::bad_alloc &sick_alloc_exception) {
+        merged = false;
+      }
+
+      pthread_mutex_lock(&sick_merge._sick_merge_mutex);
+
+      if (merged) {
+        if (sick_merge._sick_ready_new) {
+          sick_merge._sick_num_dropped++;
+        }
+        sick_merge._sick_ready_scan.Swap(sick_merge._sick_work_scan);
+        sick_merge._sick_ready_new = true;
+        pthread_cond_broadcast(&sick_merge._sick_ready_cond);
+      }
+
+    }
+
+    pthread_mutex_unlock(&sick_merge._sick_merge_mutex);
+
+    return NULL;
+
+  }
+
+  /**
+   * \brief Timestamps a freshly acquired scan
+   * \param sick_source The source
+   * \param sick_scan The scan
+   * \return Host time of the scan's first beam (usecs since the epoch)
+   */
+  inline double SickScanMerge::_alignScan( sick_scan_merge_source_t &sick_source, const SickScan &sick_scan ) {
+
+    const SickScan::sick_scan_header_t &sick_scan_header = sick_scan.GetHeader();
+
+    /* The source's own clock mapping beats the latency envelope */
+    if (sick_scan_header.sick_device_host_time != 0) {
+      return sick_scan_header.sick_device_host_time + _monotonicToWallOffset();
+    }
+
+    const double host_time = (double)sick_scan_header.sick_host_time.tv_sec*1e6 + sick_scan_header.sick_host_time.tv_usec;
+    const unsigned int num_beams = sick_scan.GetNumBeams();
+    const double scan_duration = (num_beams > 0) ? sick_scan.GetTimeOffsets()[num_beams-1] : 0;
+
+    if (sick_source.sick_device_tick_period <= 0 || sick_scan_header.sick_device_timestamp == 0) {
+      return host_time - scan_duration;
+    }
+
+    /* Unwrap the device clock (scans arrive well within one wrap) */
+    const uint32_t device_timestamp = sick_scan_header.sick_device_timestamp;
+    if (!sick_source.sick_clock_valid) {
+      sick_source.sick_device_time = device_timestamp;
+      sick_source.sick_clock_valid = true;
+    }
+    else if (sick_source.sick_device_clock_wrap == 0) {
+      sick_source.sick_device_time += (uint32_t)(device_timestamp - sick_source.sick_last_device_time);
+    }
+    else {
+      const uint64_t wrap = sick_source.sick_device_clock_wrap;
+      sick_source.sick_device_time += ((uint64_t)device_timestamp % wrap + wrap - (uint64_t)sick_source.sick_last_device_time % wrap) % wrap;
+    }
+    sick_source.sick_last_device_time = device_timestamp;
+
+    const double device_time = sick_source.sick_device_time*sick_source.sick_device_tick_period;
+
+    /* The fill time trails the last beam by the transport latency, keep its lower envelope */
+    sick_source.sick_offsets[sick_source.sick_num_offsets % SICK_SCAN_MERGE_OFFSET_WINDOW] = host_time - (device_time + scan_duration);
+    sick_source.sick_num_offsets++;
+
+    const unsigned int num_offsets = (sick_source.sick_num_offsets < SICK_SCAN_MERGE_OFFSET_WINDOW) ?
+      sick_source.sick_num_offsets : SICK_SCAN_MERGE_OFFSET_WINDOW;
+
+    double clock_offset = sick_source.sick_offsets[0];
+    for (unsigned int i = 1; i < num_offsets; i++) {
+      if (sick_source.sick_offsets[i] < clock_offset) {
+        clock_offset = sick_source.sick_offsets[i];
+      }
+    }
+
+    pthread_mutex_lock(&sick_source.sick_merge->_sick_merge_mutex);
+    sick_source.sick_clock_offset = clock_offset;
+    pthread_mutex_unlock(&sick_source.sick_merge->_sick_merge_mutex);
+
+    return device_time + clock_offset;
+
+  }
+
+  /**
+   * \brief Current wall clock - CLOCK_MONOTONIC difference (usecs)
+   *
+   * NOTE: Sampled when a scan is aligned, so a wall clock step only affects
+   *       scans acquired around it.
+   */
+  inline double SickScanMerge::_monotonicToWallOffset( ) {
+
+    struct timespec monotonic_time;
+    struct timeval wall_time;
+    clock_gettime(CLOCK_MONOTONIC,&monotonic_time);
+    gettimeofday(&wall_time,NULL);
+
+    return ((double)wall_time.tv_sec*1e6 + wall_time.tv_usec) - ((double)monotonic_time.tv_sec*1e6 + monotonic_time.tv_nsec/1e3);
+
+  }
+
+  /**
+   * \brief Rebuilds the beam tables of a source if its layout changed
+   * \param sick_source The source
+   * \param sick_scan Its current scan
+   *
+   * NOTE: The cache is keyed on the exact beam angles. Deskewed scans change
+   *       them every revolution and so rebuild the tables on every scan.
+   */
+  inline void SickScanMerge::_updateBeamTables( sick_scan_merge_source_t &sick_source, const SickScan &sick_scan ) throw( std::bad_alloc ) {
+
+    const unsigned int num_beams = sick_scan.GetNumBeams();
+    const float * const angle_values = sick_scan.GetAngleValues();
+
+    if (sick_source.sick_table_angles.size() == num_beams &&
+        (num_beams == 0 || memcmp(&sick_source.sick_table_angles[0],angle_values,num_beams*sizeof(float)) == 0)) {
+      return;
+    }
+
+    sick_source.sick_table_angles.assign(angle_values,angle_values + num_beams);
+    sick_source.sick_table_cos.resize(num_beams);
+    sick_source.sick_table_sin.resize(num_beams);
+    sick_source.sick_table_bins.resize(num_beams);
+
+    for (unsigned int i = 0; i < num_beams; i++) {
+
+      double angle = fmod(angle_values[i] + sick_source.sick_yaw,360.0);
+      if (angle < 0) {
+        angle += 360.0;
+      }
+
+      sick_source.sick_table_cos[i] = (float)cos(angle*M_PI/180.0);
+      sick_source.sick_table_sin[i] = (float)sin(angle*M_PI/180.0);
+
+      unsigned int bin = (unsigned int)(angle*_sick_bins_per_deg);
+      sick_source.sick_table_bins[i] = (bin < _sick_num_bins) ? bin : bin - _sick_num_bins;
+
+    }
+
+  }
+
+  /**
+   * \brief Fuses the current source scans into _sick_work_scan
+   * \param reference_time Host time of the master scan's first beam (usecs)
+   */
+  inline void SickScanMerge::_mergeScans( const double reference_time ) throw( std::bad_alloc ) {
+
+    _sick_work_scan.Resize(_sick_num_bins);
+
+    float * const range_values = _sick_work_scan.GetRangeValues();
+    float * const intensity_values = _sick_work_scan.GetIntensityValues();
+    uint32_t * const flag_values = _sick_work_scan.GetFlagValues();
+    float * const time_offsets = _sick_work_scan.GetTimeOffsets();
+
+    _sick_work_scan.FillAngles(0,_sick_num_bins,0.5/_sick_bins_per_deg,1.0/_sick_bins_per_deg);
+    for (unsigned int k = 0; k < _sick_num_bins; k++) {
+      range_values[k] = intensity_values[k] = time_offsets[k] = 0;
+      flag_values[k] = SickScan::SICK_SCAN_FLAG_NO_RETURN;
+    }
+
+    const uint32_t skip_flags = SickScan::SICK_SCAN_FLAG_NO_RETURN | SickScan::SICK_SCAN_FLAG_FILTERED;
+    const uint32_t keep_flags = ~(uint32_t)(SickScan::SICK_SCAN_FLAG_NO_RETURN | SickScan::SICK_SCAN_FLAG_SECTOR_START);
+
+    for (unsigned int s = 0; s < _sick_sources.size(); s++) {
+
+      sick_scan_merge_source_t &sick_source = *_sick_sources[s];
+      if (!sick_source.sick_merge_valid || fabs(sick_source.sick_merge_time - reference_time) > _sick_max_skew) {
+        continue;
+      }
+
+      const SickScan &sick_scan = sick_source.sick_merge_scan;
+      _updateBeamTables(sick_source,sick_scan);
+
+      const unsigned int num_beams = sick_scan.GetNumBeams();
+      const float * const src_range_values = sick_scan.GetRangeValues();
+      const float * const src_intensity_values = sick_scan.GetIntensityValues();
+      const uint32_t * const src_flag_values = sick_scan.GetFlagValues();
+      const float * const src_time_offsets = sick_scan.GetTimeOffsets();
+      const float time_shift = (float)(sick_source.sick_merge_time - reference_time);
+
+      const bool on_origin = (sick_source.sick_x == 0 && sick_source.sick_y == 0);
+      const float x0 = (float)sick_source.sick_x, y0 = (float)sick_source.sick_y;
+      const float * const cos_table = &sick_source.sick_table_cos[0];
+      const float * const sin_table = &sick_source.sick_table_sin[0];
+      const unsigned int * const bin_table = &sick_source.sick_table_bins[0];
+
+      for (unsigned int i = 0; i < num_beams; i++) {
+
+        if (src_range_values[i] <= 0 || (src_flag_values[i] & skip_flags)) {
+          continue;
+        }
+
+        unsigned int bin = 0;
+        float range = src_range_values[i];
+        if (on_origin) {
+          bin = bin_table[i];
+        }
+        else {
+          const float x = x0 + range*cos_table[i];
+          const float y = y0 + range*sin_table[i];
+          bin = _binIndex(x,y);
+          range = sqrtf(x*x + y*y);
+        }
+
+        /* Keep the nearest return of each bin */
+        if (range_values[bin] == 0 || range < range_values[bin]) {
+          range_values[bin] = range;
+          intensity_values[bin] = src_intensity_values[i];
+          flag_values[bin] = src_flag_values[i] & keep_flags;
+          time_offsets[bin] = time_shift + src_time_offsets[i];
+        }
+
+      }
+
+    }
+
+    SickScan::sick_scan_header_t &sick_scan_header = _sick_work_scan.GetHeader();
+    sick_scan_header.sick_scan_index = _sick_num_merged++;
+    sick_scan_header.sick_device_timestamp = 0;
+    sick_scan_header.sick_device_host_time = 0;
+    sick_scan_header.sick_host_time.tv_sec = (time_t)(reference_time/1e6);
+    sick_scan_header.sick_host_time.tv_usec = (suseconds_t)(reference_time - sick_scan_header.sick_host_time.tv_sec*1e6);
+    sick_scan_header.sick_scan_period = _sick_sources[0]->sick_merge_scan.GetHeader().sick_scan_period;
+
+  }
+
+  /**
+   * \brief Bin of a point in the vehicle frame
+   * \param x The x coordinate (m)
+   * \param y The y coordinate (m)
+   *
+   * The first-octant angle comes from the atan table (indexed by the ratio of
+   * the smaller to the larger coordinate) and is mirrored into [0,360).
+   */
+  inline unsigned int SickScanMerge::_binIndex( const float x, const float y ) const {
+
+    const float ax = fabsf(x), ay = fabsf(y);
+    if (ax == 0 && ay == 0) {
+      return 0;
+    }
+
+    float angle = 0;
+    if (ay <= ax) {
+      angle = _sick_atan_table[(unsigned int)(ay/ax*SICK_SCAN_MERGE_ATAN_TABLE_SIZE + 0.5f)];
+    }
+    else {
+      angle = 90.0f - _sick_atan_table[(unsigned int)(ax/ay*SICK_SCAN_MERGE_ATAN_TABLE_SIZE + 0.5f)];
+    }
+
+    if (x < 0) {
+      angle = 180.0f - angle;
+    }
+
+    if (y < 0) {
+      angle = 360.0f - angle;
+    }
+
+    const unsigned int bin = (unsigned int)(angle*_sick_bins_per_deg);
+    return (bin < _sick_num_bins) ? bin : bin - _sick_num_bins;
+
+  }
+
+  /**
+   * \brief Stops and joins the threads started so far
+   * \param num_acquire_threads Number of acquisition threads to join
+   * \param worker_started Whether the worker has to be joined
+   */
+  inline void SickScanMerge::_joinThreads( const unsigned int num_acquire_threads, const bool worker_started ) {
+
+    pthread_mutex_lock(&_sick_merge_mutex);
+    _sick_running = false;
+    pthread_cond_broadcast(&_sick_source_cond);
+    pthread_mutex_unlock(&_sick_merge_mutex);
+
+    if (worker_started) {
+      pthread_join(_sick_worker_thread_id,NULL);
+    }
+
+    for (unsigned int i = 0; i < num_acquire_threads; i++) {
+      pthread_join(_sick_sources[i]->sick_thread_id,NULL);
+    }
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_MERGE */
@@ -0,0 +1,248 @@
+/*!
+ * \file SickScanROI.hh
+ * \brief Defines the region-of-interest/decimation stage applied while parsing scans.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_ROI
+#define SICK_SCAN_ROI
+
+/* Macros */
+#define SICK_SCAN_ROI_MAX_NUM_WINDOWS                  (8)  ///< Maximum number of angle windows
+
+/* Dependencies */
+#include <limits.h>
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickScanROI
+   * \brief Selects the beams a driver should decode.
+   *
+   * A beam is selected when its index within the scan (or LD sector) is a
+   * multiple of the decimation factor and its angle lies in one of the
+   * angle windows (no windows => every angle). The drivers evaluate this
+   * before converting a beam, so dropped beams are never converted or
+   * copied and the returned values are compacted. Since the selection only
+   * depends on the beam layout, SelectBeams() recovers the original beam
+   * indices of a compacted scan.
+   *
+   * Selected beams whose range falls outside [min,max] are reported as 0,
+   * i.e. the same way as a beam without a return, so compaction never
+   * depends on the data.
+   */
+  class SickScanROI {
+
+  public:
+
+    /** A standard constructor (selects everything) */
+    SickScanROI( ) { Reset(); }
+
+    /** Adds an angle window [min,max] (deg, min > max wraps through 360) */
+    void AddAngleWindow( const double min_angle, const double max_angle ) throw( SickConfigException );
+
+    /** Removes all angle windows */
+    void ClearAngleWindows( ) { _num_windows = 0; }
+
+    /** Sets the range limits (m, max_range = 0 => no upper limit) */
+    void SetRangeLimits( const double min_range, const double max_range ) throw( SickConfigException );
+
+    /** Keeps every decimation-th beam */
+    void SetDecimation( const unsigned int decimation ) throw( SickConfigException );
+
+    /** Restores the pass-through configuration */
+    void Reset( ) { _num_windows = 0; _min_range = _max_range = 0; _decimation = 1; }
+
+    /** Number of angle windows */
+    unsigned int GetNumAngleWindows( ) const { return _num_windows; }
+
+    /** Minimum range (m) */
+    double GetMinRange( ) const { return _min_range; }
+
+    /** Maximum range (m, 0 => no upper limit) */
+    double GetMaxRange( ) const { return _max_range; }
+
+    /** Decimation factor */
+    unsigned int GetDecimation( ) const { return _decimation; }
+
+    /** Whether every beam is selected (ranges may still be limited) */
+    bool SelectsAllBeams( ) const { return _num_windows == 0 && _decimation == 1; }
+
+    /** Whether range limits are set */
+    bool IsRangeLimited( ) const { return _min_range > 0 || _max_range > 0; }
+
+    /** Whether the stage does anything at all */
+    bool IsEnabled( ) const { return !SelectsAllBeams() || IsRangeLimited(); }
+
+    /** Whether the given beam is selected */
+    bool SelectBeam( const unsigned int beam_index, const double beam_angle ) const;
+
+    /** Range limits expressed in device units (value*range_scale = m) */
+    void GetRawRangeLimits( const double range_scale, unsigned int &min_raw_range, unsigned int &max_raw_range ) const;
+
+    /** Original indices of the beams selected from an evenly spaced scan */
+    unsigned int SelectBeams( const double start_angle, const double step_angle, const unsigned int num_beams,
+                              unsigned int * const beam_indices ) const;
+
+  private:
+
+    /** Angle windows as (min,max) pairs (deg) */
+    double _windows[SICK_SCAN_ROI_MAX_NUM_WINDOWS][2];
+
+    /** Number of angle windows */
+    unsigned int _num_windows;
+
+    /** Minimum range (m) */
+    double _min_range;
+
+    /** Maximum range (m, 0 => none) */
+    double _max_range;
+
+    /** Decimation factor */
+    unsigned int _decimation;
+
+  };
+
+  /**
+   * \brief Adds an angle window
+   * \param min_angle Lower bound (deg)
+   * \param max_angle Upper bound (deg), a window with min_angle > max_angle wraps through 360
+   */
+  inline void SickScanROI::AddAngleWindow( const double min_angle, const double max_angle ) throw( SickConfigException ) {
+
+    if (_num_windows >= SICK_SCAN_ROI_MAX_NUM_WINDOWS) {
+      throw SickConfigException("SickScanROI::AddAngleWindow: Too many angle windows!");
+    }
+
+    _windows[_num_windows][0] = min_angle;
+    _windows[_num_windows][1] = max_angle;
+    _num_windows++;
+
+  }
+
+  /**
+   * \brief Sets the range limits
+   * \param min_range Minimum range (m)
+   * \param max_range Maximum range (m, 0 => no upper limit)
+   */
+  inline void SickScanROI::SetRangeLimits( const double min_range, const double max_range ) throw( SickConfigException ) {
+
+    if (min_range < 0 || max_range < 0 || (max_range > 0 && max_range < min_range)) {
+      throw SickConfigException("SickScanROI::SetRangeLimits: Invalid range limits!");
+    }
+
+    _min_range = min_range;
+    _max_range = max_range;
+
+  }
+
+  /**
+   * \brief Keeps every decimation-th beam
+   * \param decimation The decimation factor (1 => keep all)
+   */
+  inline void SickScanROI::SetDecimation( const unsigned int decimation ) throw( SickConfigException ) {
+
+    if (decimation == 0) {
+      throw SickConfigException("SickScanROI::SetDecimation: Decimation must be at least 1!");
+    }
+
+    _decimation = decimation;
+
+  }
+
+  /**
+   * \brief Whether the given beam is selected
+   * \param beam_index Index of the beam in the scan/sector
+   * \param beam_angle Angle of the beam (deg)
+   */
+  inline bool SickScanROI::SelectBeam( const unsigned int beam_index, const double beam_angle ) const {
+
+    if (_decimation > 1 && beam_index % _decimation != 0) {
+      return false;
+    }
+
+    if (_num_windows == 0) {
+      return true;
+    }
+
+    for (unsigned int i = 0; i < _num_windows; i++) {
+      const double min_angle = _windows[i][0], max_angle = _windows[i][1];
+      if (min_angle <= max_angle) {
+        if (beam_angle >= min_angle && beam_angle <= max_angle) {
+          return true;
+        }
+      }
+      else if (beam_angle >= min_angle || beam_angle <= max_angle) {
+        return true;
+      }
+    }
+
+    return false;
+
+  }
+
+  /**
+   * \brief Range limits expressed in device units
+   * \param range_scale Device units to meters
+   * \param min_raw_range Smallest accepted raw value
+   * \param max_raw_range Largest accepted raw value
+   */
+  inline void SickScanROI::GetRawRangeLimits( const double range_scale, unsigned int &min_raw_range, unsigned int &max_raw_range ) const {
+
+    min_raw_range = 0;
+    max_raw_range = UINT_MAX;
+
+    if (range_scale <= 0) {
+      return;
+    }
+
+    /* Round inwards so that limits given in m are honored exactly */
+    const double min_raw = _min_range/range_scale;
+    min_raw_range = (unsigned int)min_raw;
+    if (min_raw_range < min_raw) {
+      min_raw_range++;
+    }
+
+    if (_max_range > 0) {
+      const double max_raw = _max_range/range_scale;
+      max_raw_range = (max_raw < UINT_MAX) ? (unsigned int)max_raw : UINT_MAX;
+    }
+
+  }
+
+  /**
+   * \brief Original indices of the beams selected from an evenly spaced scan
+   * \param start_angle Angle of beam 0 (deg)
+   * \param step_angle Angle between consecutive beams (deg)
+   * \param num_beams Number of beams in the scan
+   * \param beam_indices Destination for the selected indices (num_beams long)
+   * \return The number of selected beams
+   */
+  inline unsigned int SickScanROI::SelectBeams( const double start_angle, const double step_angle, const unsigned int num_beams,
+                                                unsigned int * const beam_indices ) const {
+
+    unsigned int num_selected_beams = 0;
+    for (unsigned int i = 0; i < num_beams; i++) {
+      if (SelectBeam(i,start_angle + i*step_angle)) {
+        beam_indices[num_selected_beams++] = i;
+      }
+    }
+
+    return num_selected_beams;
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_ROI */
@@ -0,0 +1,670 @@
+/*!
+ * \file SickScanShm.hh
+ * \brief Defines a shared-memory scan ring for sharing scans between processes.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_SCAN_SHM
+#define SICK_SCAN_SHM
+
+/* Macros */
+#define DEFAULT_SICK_SHM_NUM_SLOTS                               (16)  ///< Number of scans retained in the ring
+#define DEFAULT_SICK_SHM_MAX_NUM_VALUES                        (5760)  ///< Max values per scan (a full 2 sector Sick LD profile)
+#define DEFAULT_SICK_SHM_MAGIC                           (0x5349434BU)  ///< "SICK"
+#define DEFAULT_SICK_SHM_VERSION                                  (1)  ///< Bumped whenever the layout changes
+
+/* Dependencies */
+#include <string>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "SickException.hh"
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * The ring is a POSIX shared memory object (see shm_open(3); link w/ -lrt on
+   * older glibc) holding a header followed by a fixed number of scan slots:
+   *
+   *   [ring header][slot 0: scan header | ranges | reflect][slot 1] ...
+   *
+   * A single publisher (the process owning the driver) writes scan n into
+   * slot n % num_slots. Each slot carries a seqlock sequence number that is
+   * odd while the slot is being written. Readers map the object read-only,
+   * keep their own cursor, and validate the sequence number around every
+   * read, so they never block the publisher (or each other) and never make
+   * a syscall once mapped. A reader that falls more than num_slots scans
+   * behind loses the oldest scans and is told how many.
+   */
+
+  /*!
+   * \struct sick_shm_scan_header_tag
+   * \brief Per-scan header stored in each slot
+   */
+  typedef struct sick_shm_scan_header_tag {
+    volatile uint64_t sick_sequence;                                   ///< Seqlock sequence (odd => being written)
+    uint64_t sick_scan_index;                                          ///< Publisher scan number (0, 1, 2, ...)
+    uint64_t sick_timestamp;                                           ///< Acquisition time (usecs since the epoch)
+    uint32_t sick_sensor_id;                                           ///< Application-defined sensor id
+    uint32_t sick_sensor_type;                                         ///< Application-defined sensor type (e.g. LD, LMS 1xx, ...)
+    float sick_start_angle;                                            ///< Angle of the first value (deg)
+    float sick_angle_step;                                             ///< Angular step between values (deg)
+    uint32_t sick_num_ranges;                                          ///< Number of range values
+    uint32_t sick_num_reflect;                                         ///< Number of reflectivity values (0 => none)
+  } sick_shm_scan_header_t;
+
+  /*!
+   * \struct sick_shm_ring_header_tag
+   * \brief Ring header at the start of the shared memory object
+   */
+  typedef struct sick_shm_ring_header_tag {
+    volatile uint32_t sick_magic;                                      ///< DEFAULT_SICK_SHM_MAGIC once the ring is initialized
+    uint32_t sick_version;                                             ///< DEFAULT_SICK_SHM_VERSION
+    uint32_t sick_num_slots;                                           ///< Number of slots
+    uint32_t sick_max_num_values;                                      ///< Capacity of each slot's range/reflect arrays
+    uint64_t sick_slot_size;                                           ///< Bytes per slot
+    volatile uint64_t sick_generation;                                 ///< Changes each time a publisher (re)creates or detaches from the ring
+    volatile uint64_t sick_num_published;                              ///< Number of scans published so far
+    uint8_t sick_padding[24];                                          ///< Pads the header to a cache line
+  } sick_shm_ring_header_t;
+
+  /**
+   * \class SickScanShmPublisher
+   * \brief Writes decoded scans into a shared memory ring.
+   *
+   * Example (Sick LMS 1xx, ranges in mm):
+   *   SickScanShmPublisher shm_publisher;
+   *   shm_publisher.Create("/sick_front");
+   *   sick_lms_1xx.GetSickMeasurements(range_values,NULL,NULL,NULL,num_values);
+   *   shm_publisher.Publish(front_id,front_type,-45.0,0.5,range_values,num_values,0.001);
+   *
+   * The Sick LD and NAV350 return doubles, which are taken by the other
+   * Publish overload (e.g. w/ range_scale = 1.0 for the LD's meters).
+   */
+  class SickScanShmPublisher {
+
+  public:
+
+    /** A standard constructor */
+    SickScanShmPublisher( ) : _shm_fd(-1), _shm_size(0), _shm_ring(NULL) { }
+
+    /** Creates (or recreates) the named ring */
+    void Create( const std::string &shm_name,
+		 const unsigned int num_slots = DEFAULT_SICK_SHM_NUM_SLOTS,
+		 const unsigned int max_num_values = DEFAULT_SICK_SHM_MAX_NUM_VALUES ) throw( SickConfigException, SickIOException );
+
+    /** Publishes a scan of integer values (range_scale converts them to meters) */
+    void Publish( const uint32_t sensor_id, const uint32_t sensor_type,
+		  const double start_angle, const double angle_step,
+		  const unsigned int * const range_values, const unsigned int num_range_values, const double range_scale,
+		  const unsigned int * const reflect_values = NULL, const unsigned int num_reflect_values = 0,
+		  const uint64_t timestamp = 0 ) throw( SickConfigException );
+
+    /** Publishes a scan of floating point values (range_scale converts them to meters) */
+    void Publish( const uint32_t sensor_id, const uint32_t sensor_type,
+		  const double start_angle, const double angle_step,
+		  const double * const range_values, const unsigned int num_range_values, const double range_scale,
+		  const unsigned int * const reflect_values = NULL, const unsigned int num_reflect_values = 0,
+		  const uint64_t timestamp = 0 ) throw( SickConfigException );
+
+    /** Number of scans published so far */
+    uint64_t GetNumPublished( ) const { return _shm_ring ? _shm_ring->sick_num_published : 0; }
+
+    /** Unmaps and (optionally) removes the ring */
+    void Destroy( const bool unlink_ring = true );
+
+    /** A standard destructor (marks the ring stale but leaves it for late readers, call Destroy to remove it) */
+    ~SickScanShmPublisher( ) { Destroy(false); }
+
+  private:
+
+    /** Name of the shared memory object */
+    std::string _shm_name;
+
+    /** Descriptor of the shared memory object */
+    int _shm_fd;
+
+    /** Size of the mapping */
+    size_t _shm_size;
+
+    /** The mapped ring */
+    sick_shm_ring_header_t *_shm_ring;
+
+    /** Opens slot n for writing and fills in the header */
+    sick_shm_scan_header_t * _beginWrite( const uint32_t sensor_id, const uint32_t sensor_type,
+					   const double start_angle, const double angle_step,
+					   const unsigned int num_range_values, const unsigned int num_reflect_values,
+					   const uint64_t timestamp ) throw( SickConfigException );
+
+    /** Copies the reflectivity values and publishes the slot */
+    void _endWrite( sick_shm_scan_header_t * const scan_header, const unsigned int * const reflect_values, const unsigned int num_reflect_values );
+
+    /** Current time (usecs since the epoch) */
+    static uint64_t _now( ) {
+      struct timeval curr_time;
+      gettimeofday(&curr_time,NULL);
+      return (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_usec;
+    }
+
+  };
+
+  /**
+   * \class SickScanShmReader
+   * \brief Reads scans from a shared memory ring (any number of readers may
+   *        attach, each w/ its own cursor).
+   *
+   * Example:
+   *   SickScanShmReader shm_reader;
+   *   shm_reader.Open("/sick_front");
+   *   if (shm_reader.ReadNextScan(scan_header,ranges,reflect,max_values) == SickScanShmReader::SICK_SHM_READ_OK) { ... }
+   *
+   * For large scans the in-place view (BeginView/EndView) avoids even the
+   * copy out of shared memory; the view must be validated w/ EndView before
+   * anything computed from it is trusted.
+   */
+  class SickScanShmReader {
+
+  public:
+
+    /** Read results */
+    enum sick_shm_read_status_t {
+      SICK_SHM_READ_OK,                                               ///< A scan was read
+      SICK_SHM_READ_NO_DATA,                                          ///< No new scan has been published
+      SICK_SHM_READ_OVERRUN                                           ///< The scan was overwritten (the cursor has been advanced)
+    };
+
+    /*!
+     * \struct sick_shm_view_tag
+     * \brief An in-place view of a slot
+     */
+    typedef struct sick_shm_view_tag {
+      const sick_shm_scan_header_t *sick_scan_header;                 ///< The slot header (fields may change under the reader!)
+      const float *sick_ranges;                                       ///< Range values (m)
+      const float *sick_reflect;                                      ///< Reflectivity values
+      uint64_t sick_sequence;                                         ///< Sequence observed by BeginView
+      uint64_t sick_scan_index;                                       ///< Scan being viewed
+    } sick_shm_view_t;
+
+    /** A standard constructor */
+    SickScanShmReader( ) : _shm_fd(-1), _shm_size(0), _shm_ring(NULL), _shm_generation(0), _next_scan_index(0), _num_lost(0) { }
+
+    /** Attaches to the named ring (starting at the latest scan) */
+    void Open( const std::string &shm_name ) throw( SickConfigException, SickIOException );
+
+    /** Copies out the next scan for this reader */
+    sick_shm_read_status_t ReadNextScan( sick_shm_scan_header_t &scan_header,
+					 float * const range_values,
+					 float * const reflect_values,
+					 const unsigned int max_num_values );
+
+    /** Views the next scan for this reader in place */
+    sick_shm_read_status_t BeginView( sick_shm_view_t &shm_view );
+
+    /** Validates a view (false => it was overwritten while in use and must be discarded) */
+    bool EndView( const sick_shm_view_t &shm_view ) const;
+
+    /** Indicates whether the publisher has recreated, detached from or removed the ring since Open (reopen to follow it) */
+    bool IsStale( ) const;
+
+    /** Number of scans skipped because this reader fell behind */
+    uint64_t GetNumLost( ) const { return _num_lost; }
+
+    /** Detaches from the ring */
+    void Close( );
+
+    /** A standard destructor */
+    ~SickScanShmReader( ) { Close(); }
+
+  private:
+
+    /** Descriptor of the shared memory object */
+    int _shm_fd;
+
+    /** Size of the mapping */
+    size_t _shm_size;
+
+    /** The mapped ring */
+    const sick_shm_ring_header_t *_shm_ring;
+
+    /** Generation of the ring when opened */
+    uint64_t _shm_generation;
+
+    /** Next scan this reader wants */
+    uint64_t _next_scan_index;
+
+    /** Number of scans skipped */
+    uint64_t _num_lost;
+
+    /** Locates the next readable scan, advancing the cursor past lost scans */
+    sick_shm_read_status_t _nextScan( const sick_shm_scan_header_t *&scan_header, uint64_t &sequence );
+
+  };
+
+  /**
+   * \brief Locates slot i of a ring
+   */
+  inline sick_shm_scan_header_t * sick_shm_get_slot( const sick_shm_ring_header_t * const shm_ring, const uint64_t slot_index ) {
+    return (sick_shm_scan_header_t *)((uint8_t *)shm_ring + sizeof(sick_shm_ring_header_t) + slot_index*shm_ring->sick_slot_size);
+  }
+
+  /**
+   * \brief Creates the ring, replacing any previous ring of the same name
+   * \param &shm_name Name of the shared memory object (e.g. "/sick_front")
+   * \param num_slots Number of scans retained
+   * \param max_num_values Max range (and reflectivity) values per scan
+   *
+   * NOTE: Readers attached to a previous ring keep their old mapping. Its
+   *       generation is bumped before it is unmapped and its object is
+   *       unlinked, so those readers see SickScanShmReader::IsStale and
+   *       reopen to follow the new ring.
+   */
+  inline void SickScanShmPublisher::Create( const std::string &shm_name,
+					    const unsigned int num_slots,
+					    const unsigned int max_num_values ) throw( SickConfigException, SickIOException ) {
+
+    /* Ensure the ring is usable */
+    if (num_slots < 2 || max_num_values == 0) {
+      throw SickConfigException("SickScanShmPublisher::Create: Invalid ring dimensions!");
+    }
+
+    Destroy(false);
+
+    /* Slots are rounded up to a cache line */
+    const uint64_t slot_size = ((sizeof(sick_shm_scan_header_t) + 2*max_num_values*sizeof(float) + 63)/64)*64;
+
+    /* Start from a fresh object so old readers don't see a resized one */
+    shm_unlink(shm_name.c_str());
+
+    if ((_shm_fd = shm_open(shm_name.c_str(),O_RDWR | O_CREAT | O_EXCL,0644)) < 0) {
+      throw SickIOException("SickScanShmPublisher::Create: shm_open() failed!");
+    }
+
+    _shm_name = shm_name;
+    _shm_size = sizeof(sick_shm_ring_header_t) + num_slots*slot_size;
+
+    if (ftruncate(_shm_fd,_shm_size) != 0) {
+      Destroy(true);
+      throw SickIOException("SickScanShmPublisher::Create: ftruncate() failed!");
+    }
+
+    void *shm_buffer = mmap(NULL,_shm_size,PROT_READ | PROT_WRITE,MAP_SHARED,_shm_fd,0);
+    if (shm_buffer == MAP_FAILED) {
+      Destroy(true);
+      throw SickIOException("SickScanShmPublisher::Create: mmap() failed!");
+    }
+
+    /* Fill in the header (the new object is zeroed, so every slot sequence starts at 0) */
+    _shm_ring = (sick_shm_ring_header_t *)shm_buffer;
+    _shm_ring->sick_version = DEFAULT_SICK_SHM_VERSION;
+    _shm_ring->sick_num_slots = num_slots;
+    _shm_ring->sick_max_num_values = max_num_values;
+    _shm_ring->sick_slot_size = slot_size;
+    _shm_ring->sick_generation = ((uint64_t)getpid() << 32) ^ _now();
+    _shm_ring->sick_num_published = 0;
+
+    /* Readers accept the ring once the magic is visible */
+    __sync_synchronize();
+    _shm_ring->sick_magic = DEFAULT_SICK_SHM_MAGIC;
+
+  }
+
+  /**
+   * \brief Publishes a scan of integer values
+   * \param sensor_id An application-defined sensor id
+   * \param sensor_type An application-defined sensor type
+   * \param start_angle Angle of the first value (deg)
+   * \param angle_step Angular step between values (deg)
+   * \param *range_values The range values
+   * \param num_range_values Number of range values
+   * \param range_scale Converts a range value to meters (e.g. 0.001 for mm)
+   * \param *reflect_values The reflectivity values (Default: NULL => None)
+   * \param num_reflect_values Number of reflectivity values
+   * \param timestamp Acquisition time in usecs since the epoch (Default: 0 => now)
+   */
+  inline void SickScanShmPublisher::Publish( const uint32_t sensor_id, const uint32_t sensor_type,
+					     const double start_angle, const double angle_step,
+					     const unsigned int * const range_values, const unsigned int num_range_values, const double range_scale,
+					     const unsigned int * const reflect_values, const unsigned int num_reflect_values,
+					     const uint64_t timestamp ) throw( SickConfigException ) {
+
+    sick_shm_scan_header_t *scan_header = _beginWrite(sensor_id,sensor_type,start_angle,angle_step,num_range_values,num_reflect_values,timestamp);
+
+    float *ranges = (float *)(scan_header + 1);
+    for (unsigned int i = 0; i < num_range_values; i++) {
+      ranges[i] = (float)(range_values[i]*range_scale);
+    }
+
+    _endWrite(scan_header,reflect_values,num_reflect_values);
+
+  }
+
+  /**
+   * \brief Publishes a scan of floating point values (see the integer overload)
+   */
+  inline void SickScanShmPublisher::Publish( const uint32_t sensor_id, const uint32_t sensor_type,
+					     const double start_angle, const double angle_step,
+					     const double * const range_values, const unsigned int num_range_values, const double range_scale,
+					     const unsigned int * const reflect_values, const unsigned int num_reflect_values,
+					     const uint64_t timestamp ) throw( SickConfigException ) {
+
+    sick_shm_scan_header_t *scan_header = _beginWrite(sensor_id,sensor_type,start_angle,angle_step,num_range_values,num_reflect_values,timestamp);
+
+    float *ranges = (float *)(scan_header + 1);
+    for (unsigned int i = 0; i < num_range_values; i++) {
+      ranges[i] = (float)(range_values[i]*range_scale);
+    }
+
+    _endWrite(scan_header,reflect_values,num_reflect_values);
+
+  }
+
+  /**
+   * \brief Unmaps the ring
+   * \param unlink_ring Also remove the shared memory object
+   *
+   * NOTE: The ring's generation is bumped first, so attached readers find
+   *       it stale even if it is left in place.
+   */
+  inline void SickScanShmPublisher::Destroy( const bool unlink_ring ) {
+
+    if (_shm_ring) {
+      _shm_ring->sick_generation++;
+      __sync_synchronize();
+      munmap(_shm_ring,_shm_size);
+      _shm_ring = NULL;
+    }
+
+    if (_shm_fd >= 0) {
+      close(_shm_fd);
+      _shm_fd = -1;
+    }
+
+    if (unlink_ring && !_shm_name.empty()) {
+      shm_unlink(_shm_name.c_str());
+      _shm_name.clear();
+    }
+
+  }
+
+  /**
+   * \brief Marks the next slot as being written and fills in its header
+   */
+  inline sick_shm_scan_header_t * SickScanShmPublisher::_beginWrite( const uint32_t sensor_id, const uint32_t sensor_type,
+								     const double start_angle, const double angle_step,
+								     const unsigned int num_range_values, const unsigned int num_reflect_values,
+								     const uint64_t timestamp ) throw( SickConfigException ) {
+
+    /* Ensure the ring exists */
+    if (!_shm_ring) {
+      throw SickConfigException("SickScanShmPublisher::Publish: Ring has not been created!");
+    }
+
+    /* Ensure the scan fits */
+    if (num_range_values > _shm_ring->sick_max_num_values || num_reflect_values > _shm_ring->sick_max_num_values) {
+      throw SickConfigException("SickScanShmPublisher::Publish: Scan exceeds the slot capacity!");
+    }
+
+    const uint64_t scan_index = _shm_ring->sick_num_published;
+    sick_shm_scan_header_t *scan_header = sick_shm_get_slot(_shm_ring,scan_index % _shm_ring->sick_num_slots);
+
+    /* Odd => readers must not trust the slot */
+    scan_header->sick_sequence++;
+    __sync_synchronize();
+
+    scan_header->sick_scan_index = scan_index;
+    scan_header->sick_timestamp = (timestamp != 0) ? timestamp : _now();
+    scan_header->sick_sensor_id = sensor_id;
+    scan_header->sick_sensor_type = sensor_type;
+    scan_header->sick_start_angle = (float)start_angle;
+    scan_header->sick_angle_step = (float)angle_step;
+    scan_header->sick_num_ranges = num_range_values;
+    scan_header->sick_num_reflect = num_reflect_values;
+
+    return scan_header;
+
+  }
+
+  /**
+   * \brief Copies the reflectivity values and makes the slot visible
+   */
+  inline void SickScanShmPublisher::_endWrite( sick_shm_scan_header_t * const scan_header, const unsigned int * const reflect_values, const unsigned int num_reflect_values ) {
+
+    float *reflect = (float *)(scan_header + 1) + _shm_ring->sick_max_num_values;
+    for (unsigned int i = 0; reflect_values && i < num_reflect_values; i++) {
+      reflect[i] = (float)reflect_values[i];
+    }
+
+    /* Even => consistent */
+    __sync_synchronize();
+    scan_header->sick_sequence++;
+
+    /* Make the scan available */
+    __sync_synchronize();
+    _shm_ring->sick_num_published = scan_header->sick_scan_index + 1;
+
+  }
+
+  /**
+   * \brief Maps the named ring read-only
+   * \param &shm_name Name of the shared memory object
+   */
+  inline void SickScanShmReader::Open( const std::string &shm_name ) throw( SickConfigException, SickIOException ) {
+
+    Close();
+
+    if ((_shm_fd = shm_open(shm_name.c_str(),O_RDONLY,0)) < 0) {
+      throw SickIOException("SickScanShmReader::Open: shm_open() failed!");
+    }
+
+    struct stat shm_stat;
+    if (fstat(_shm_fd,&shm_stat) != 0 || (size_t)shm_stat.st_size < sizeof(sick_shm_ring_header_t)) {
+      Close();
+      throw SickIOException("SickScanShmReader::Open: Ring is not initialized!");
+    }
+
+    _shm_size = shm_stat.st_size;
+
+    void *shm_buffer = mmap(NULL,_shm_size,PROT_READ,MAP_SHARED,_shm_fd,0);
+    if (shm_buffer == MAP_FAILED) {
+      Close();
+      throw SickIOException("SickScanShmReader::Open: mmap() failed!");
+    }
+
+    _shm_ring = (const sick_shm_ring_header_t *)shm_buffer;
+
+    /* Validate the layout */
+    if (_shm_ring->sick_magic != DEFAULT_SICK_SHM_MAGIC || _shm_ring->sick_version != DEFAULT_SICK_SHM_VERSION) {
+      Close();
+      throw SickConfigException("SickScanShmReader::Open: Not a Sick scan ring (or an incompatible version)!");
+    }
+    __sync_synchronize();
+
+    if (sizeof(sick_shm_ring_header_t) + _shm_ring->sick_num_slots*_shm_ring->sick_slot_size > _shm_size) {
+      Close();
+      throw SickConfigException("SickScanShmReader::Open: Ring is truncated!");
+    }
+
+    /* Start at the latest scan (if any) */
+    _shm_generation = _shm_ring->sick_generation;
+    const uint64_t num_published = _shm_ring->sick_num_published;
+    _next_scan_index = (num_published > 0) ? num_published - 1 : 0;
+    _num_lost = 0;
+
+  }
+
+  /**
+   * \brief Copies out the next scan
+   * \param &scan_header Destination for the scan header
+   * \param *range_values Destination for the range values (m)
+   * \param *reflect_values Destination for the reflectivity values (Default: NULL => Not wanted)
+   * \param max_num_values Capacity of the destination buffers
+   * \return The read status
+   */
+  inline SickScanShmReader::sick_shm_read_status_t SickScanShmReader::ReadNextScan( sick_shm_scan_header_t &scan_header,
+										   float * const range_values,
+										   float * const reflect_values,
+										   const unsigned int max_num_values ) {
+
+    for (;;) {
+
+      sick_shm_view_t shm_view;
+      sick_shm_read_status_t read_status = BeginView(shm_view);
+      if (read_status != SICK_SHM_READ_OK) {
+	return read_status;
+      }
+
+      /* Copy (the counts are clamped since they may be torn) */
+      scan_header = *shm_view.sick_scan_header;
+      const unsigned int num_ranges = (scan_header.sick_num_ranges < max_num_values) ? scan_header.sick_num_ranges : max_num_values;
+      const unsigned int num_reflect = (scan_header.sick_num_reflect < max_num_values) ? scan_header.sick_num_reflect : max_num_values;
+
+      memcpy(range_values,shm_view.sick_ranges,num_ranges*sizeof(float));
+      if (reflect_values) {
+	memcpy(reflect_values,shm_view.sick_reflect,num_reflect*sizeof(float));
+      }
+
+      /* Done if the slot was left alone, otherwise pick up from the oldest available scan */
+      if (EndView(shm_view)) {
+	scan_header.sick_num_ranges = num_ranges;
+	scan_header.sick_num_reflect = num_reflect;
+	return SICK_SHM_READ_OK;
+      }
+
+      _num_lost++;
+
+    }
+
+  }
+
+  /**
+   * \brief Views the next scan in place and advances the cursor
+   * \param &shm_view The view
+   * \return The read status (the view is only set on SICK_SHM_READ_OK)
+   */
+  inline SickScanShmReader::sick_shm_read_status_t SickScanShmReader::BeginView( sick_shm_view_t &shm_view ) {
+
+    const sick_shm_scan_header_t *scan_header = NULL;
+    uint64_t sequence = 0;
+
+    sick_shm_read_status_t read_status = _nextScan(scan_header,sequence);
+    if (read_status != SICK_SHM_READ_OK) {
+      return read_status;
+    }
+
+    shm_view.sick_scan_header = scan_header;
+    shm_view.sick_ranges = (const float *)(scan_header + 1);
+    shm_view.sick_reflect = shm_view.sick_ranges + _shm_ring->sick_max_num_values;
+    shm_view.sick_sequence = sequence;
+    shm_view.sick_scan_index = _next_scan_index;
+
+    _next_scan_index++;
+    return SICK_SHM_READ_OK;
+
+  }
+
+  /**
+   * \brief Checks that the viewed slot was not rewritten
+   * \param &shm_view A view from BeginView
+   */
+  inline bool SickScanShmReader::EndView( const sick_shm_view_t &shm_view ) const {
+
+    __sync_synchronize();
+    return shm_view.sick_scan_header->sick_sequence == shm_view.sick_sequence;
+
+  }
+
+  /**
+   * \brief Indicates whether the ring this reader is attached to is gone
+   *
+   * NOTE: Besides the generation check this takes an fstat() to catch a ring
+   *       whose object was unlinked, so poll it rather than calling it per scan.
+   */
+  inline bool SickScanShmReader::IsStale( ) const {
+
+    if (_shm_ring == NULL || _shm_ring->sick_generation != _shm_generation) {
+      return true;
+    }
+
+    struct stat shm_stat;
+    return fstat(_shm_fd,&shm_stat) != 0 || shm_stat.st_nlink == 0;
+
+  }
+
+  /**
+   * \brief Unmaps the ring
+   */
+  inline void SickScanShmReader::Close( ) {
+
+    if (_shm_ring) {
+      munmap((void *)_shm_ring,_shm_size);
+      _shm_ring = NULL;
+    }
+
+    if (_shm_fd >= 0) {
+      close(_shm_fd);
+      _shm_fd = -1;
+    }
+
+  }
+
+  /**
+   * \brief Finds the slot holding the next scan for this reader
+   * \param *&scan_header The slot
+   * \param &sequence The (even) sequence number of the slot
+   */
+  inline SickScanShmReader::sick_shm_read_status_t SickScanShmReader::_nextScan( const sick_shm_scan_header_t *&scan_header, uint64_t &sequence ) {
+
+    if (!_shm_ring) {
+      return SICK_SHM_READ_NO_DATA;
+    }
+
+    for (;;) {
+
+      const uint64_t num_published = _shm_ring->sick_num_published;
+      __sync_synchronize();
+
+      if (_next_scan_index >= num_published) {
+	return SICK_SHM_READ_NO_DATA;
+      }
+
+      /* Skip whatever has already been overwritten */
+      const uint64_t num_slots = _shm_ring->sick_num_slots;
+      if (num_published - _next_scan_index > num_slots) {
+	_num_lost += num_published - num_slots - _next_scan_index;
+	_next_scan_index = num_published - num_slots;
+      }
+
+      scan_header = sick_shm_get_slot(_shm_ring,_next_scan_index % num_slots);
+      sequence = scan_header->sick_sequence;
+      __sync_synchronize();
+
+      /* The slot must be stable and still hold our scan */
+      if ((sequence & 1) == 0 && scan_header->sick_scan_index == _next_scan_index) {
+	return SICK_SHM_READ_OK;
+      }
+
+      /* The publisher lapped us while we looked (or is writing the slot) */
+      _num_lost++;
+      _next_scan_index++;
+
+    }
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_SCAN_SHM */
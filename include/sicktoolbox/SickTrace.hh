@@ -0,0 +1,322 @@
+/*!
+ * \file SickTrace.hh
+ * \brief Defines optional trace points for profiling the Sick drivers.
+ *
+ * Code by Jason C. Derenick and Thomas H. Miller.
+ * Contact derenick(at)lehigh(dot)edu
+ *
+ * The Sick LIDAR Matlab/C++ Toolbox
+ * Copyright (c) 2008, Jason C. Derenick and Thomas H. Miller
+ * All rights reserved.
+ *
+ * This software is released under a BSD Open-Source License.
+ * See http://sicktoolbox.sourceforge.net
+ */
+
+#ifndef SICK_TRACE
+#define SICK_TRACE
+
+/**
+ * Trace points are compiled out unless SICK_ENABLE_TRACE is defined (see
+ * the SICK_ENABLE_TRACE option in CMakeLists.txt). When enabled, each
+ * SICK_TRACE_SCOPE records a complete event (begin time and duration) into
+ * a process-wide ring buffer, which can be written out as Chrome trace JSON
+ * (chrome://tracing, Perfetto) with SickTrace::Instance().WriteChromeTrace().
+ * Each monitor thread gets its own lane, so several sensors line up on a
+ * single timeline.
+ */
+#ifdef SICK_ENABLE_TRACE
+
+#define SICK_TRACE_CONCAT_(a,b) a##b
+#define SICK_TRACE_CONCAT(a,b) SICK_TRACE_CONCAT_(a,b)
+
+/** Traces the enclosing scope (name must be a string literal) */
+#define SICK_TRACE_SCOPE(sick_trace_name) \
+  SickToolbox::SickTraceScope SICK_TRACE_CONCAT(sick_trace_scope_,__LINE__)(sick_trace_name,0)
+
+/** Traces the enclosing scope, tagged w/ an integer argument (e.g. the fd of the sensor) */
+#define SICK_TRACE_SCOPE_ARG(sick_trace_name,sick_trace_arg) \
+  SickToolbox::SickTraceScope SICK_TRACE_CONCAT(sick_trace_scope_,__LINE__)(sick_trace_name,(int64_t)(sick_trace_arg))
+
+/** Records an instantaneous event */
+#define SICK_TRACE_INSTANT(sick_trace_name) \
+  SickToolbox::SickTrace::Instance().Record(sick_trace_name,'i',SickToolbox::SickTrace::Now(),0,0)
+
+#else
+
+#define SICK_TRACE_SCOPE(sick_trace_name)
+#define SICK_TRACE_SCOPE_ARG(sick_trace_name,sick_trace_arg)
+#define SICK_TRACE_INSTANT(sick_trace_name)
+
+#endif /* SICK_ENABLE_TRACE */
+
+#ifdef SICK_ENABLE_TRACE
+
+/* Macros */
+#define DEFAULT_SICK_TRACE_BUFFER_LENGTH         (1 << 16)  ///< Number of buffered trace events (must be a power of 2)
+
+/* Dependencies */
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/syscall.h>
+
+/* Associate the namespace */
+namespace SickToolbox {
+
+  /**
+   * \class SickTrace
+   * \brief A process-wide ring buffer of trace events.
+   *
+   * Recording is lock-free (a single atomic increment to claim a slot); once
+   * the ring wraps, the oldest events are overwritten.
+   */
+  class SickTrace {
+
+  public:
+
+    /** Get the process-wide trace buffer */
+    static SickTrace & Instance( );
+
+    /** Pause/resume recording */
+    void SetEnabled( const bool enabled ) { _enabled = enabled; }
+
+    /** Indicates whether events are being recorded */
+    bool IsEnabled( ) const { return _enabled; }
+
+    /** Records an event ('X' => complete, 'i' => instant) */
+    void Record( const char * const name, const char phase, const uint64_t ts, const uint64_t dur, const int64_t arg );
+
+    /** Discards every recorded event */
+    void Clear( );
+
+    /** Writes the buffered events as Chrome trace JSON */
+    void WriteChromeTrace( std::ostream &out_stream ) const;
+
+    /** Writes the buffered events as Chrome trace JSON to a file */
+    bool WriteChromeTrace( const std::string &file_path ) const;
+
+    /** Current time (usecs since the epoch) */
+    static uint64_t Now( ) {
+      struct timeval curr_time;
+      gettimeofday(&curr_time,NULL);
+      return (uint64_t)curr_time.tv_sec*1000000 + curr_time.tv_usec;
+    }
+
+    /** Kernel id of the calling thread (cached per thread) */
+    static int ThreadId( ) {
+      static __thread int thread_id = 0;
+      if (thread_id == 0) {
+	thread_id = (int)syscall(SYS_gettid);
+      }
+      return thread_id;
+    }
+
+  private:
+
+    /*!
+     * \struct sick_trace_event_tag
+     * \brief A buffered trace event
+     */
+    typedef struct sick_trace_event_tag {
+      volatile uint64_t sick_trace_sequence;                           ///< Claim number + 1 (0 => never written)
+      const char *sick_trace_name;                                     ///< Event name (string literal)
+      char sick_trace_phase;                                           ///< Chrome trace phase
+      int sick_trace_tid;                                              ///< Recording thread
+      uint64_t sick_trace_ts;                                          ///< Begin time (usecs)
+      uint64_t sick_trace_dur;                                         ///< Duration (usecs)
+      int64_t sick_trace_arg;                                          ///< Optional argument
+    } sick_trace_event_t;
+
+    /** The event ring */
+    sick_trace_event_t *_events;
+
+    /** Number of slots claimed so far */
+    volatile uint64_t _num_claimed;
+
+    /** Recording flag */
+    volatile bool _enabled;
+
+    /** A private constructor (see Instance) */
+    SickTrace( );
+
+  };
+
+  /**
+   * \class SickTraceScope
+   * \brief Records a complete event spanning its lifetime (see SICK_TRACE_SCOPE)
+   */
+  class SickTraceScope {
+
+  public:
+
+    /** Marks the beginning of the scope */
+    SickTraceScope( const char * const name, const int64_t arg ) : _name(name), _arg(arg), _beg_time(SickTrace::Now()) { }
+
+    /** Records the event */
+    ~SickTraceScope( ) {
+      SickTrace &sick_trace = SickTrace::Instance();
+      if (sick_trace.IsEnabled()) {
+	sick_trace.Record(_name,'X',_beg_time,SickTrace::Now() - _beg_time,_arg);
+      }
+    }
+
+  private:
+
+    /** Event name */
+    const char * const _name;
+
+    /** Event argument */
+    const int64_t _arg;
+
+    /** Begin time */
+    const uint64_t _beg_time;
+
+  };
+
+  /**
+   * \brief Gets the process-wide trace buffer
+   */
+  inline SickTrace & SickTrace::Instance( ) {
+
+    /* Intentionally leaked so it outlives any static driver objects */
+    static SickTrace *sick_trace = new SickTrace();
+    return *sick_trace;
+
+  }
+
+  /**
+   * \brief Primary constructor
+   */
+  inline SickTrace::SickTrace( ) : _events(new sick_trace_event_t[DEFAULT_SICK_TRACE_BUFFER_LENGTH]), _num_claimed(0), _enabled(true) {
+    Clear();
+  }
+
+  /**
+   * \brief Records an event
+   * \param *name The event name (must outlive the trace, e.g. a string literal)
+   * \param phase The Chrome trace phase
+   * \param ts The begin time (usecs)
+   * \param dur The duration (usecs)
+   * \param arg An argument shown w/ the event
+   */
+  inline void SickTrace::Record( const char * const name, const char phase, const uint64_t ts, const uint64_t dur, const int64_t arg ) {
+
+    if (!_enabled) {
+      return;
+    }
+
+    /* Claim a slot */
+    uint64_t claim = __sync_fetch_and_add(&_num_claimed,1);
+    sick_trace_event_t &event = _events[claim & (DEFAULT_SICK_TRACE_BUFFER_LENGTH - 1)];
+
+    /* Mark it as being written */
+    event.sick_trace_sequence = 0;
+    __sync_synchronize();
+
+    event.sick_trace_name = name;
+    event.sick_trace_phase = phase;
+    event.sick_trace_tid = ThreadId();
+    event.sick_trace_ts = ts;
+    event.sick_trace_dur = dur;
+    event.sick_trace_arg = arg;
+
+    /* Publish it */
+    __sync_synchronize();
+    event.sick_trace_sequence = claim + 1;
+
+  }
+
+  /**
+   * \brief Discards every recorded event
+   *
+   * NOTE: Events being recorded concurrently may or may not survive.
+   */
+  inline void SickTrace::Clear( ) {
+
+    for (unsigned int i = 0; i < DEFAULT_SICK_TRACE_BUFFER_LENGTH; i++) {
+      _events[i].sick_trace_sequence = 0;
+    }
+
+  }
+
+  /**
+   * \brief Writes the buffered events (oldest first) as Chrome trace JSON
+   * \param &out_stream The destination stream
+   */
+  inline void SickTrace::WriteChromeTrace( std::ostream &out_stream ) const {
+
+    const uint64_t num_claimed = _num_claimed;
+    const uint64_t first_claim = (num_claimed > DEFAULT_SICK_TRACE_BUFFER_LENGTH) ? num_claimed - DEFAULT_SICK_TRACE_BUFFER_LENGTH : 0;
+    const int pid = (int)getpid();
+
+    bool first_event = true;
+
+    out_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (uint64_t claim = first_claim; claim < num_claimed; claim++) {
+
+      const sick_trace_event_t &event = _events[claim & (DEFAULT_SICK_TRACE_BUFFER_LENGTH - 1)];
+
+      /* Copy the event, skipping it if it is being (re)written */
+      uint64_t sequence = event.sick_trace_sequence;
+      __sync_synchronize();
+      sick_trace_event_t event_copy = event;
+      __sync_synchronize();
+      if (sequence != claim + 1 || event.sick_trace_sequence != sequence) {
+	continue;
+      }
+
+      out_stream << (first_event ? "\n" : ",\n")
+		 << "{\"name\":\"" << event_copy.sick_trace_name << "\""
+		 << ",\"cat\":\"sick\""
+		 << ",\"ph\":\"" << event_copy.sick_trace_phase << "\""
+		 << ",\"pid\":" << pid
+		 << ",\"tid\":" << event_copy.sick_trace_tid
+		 << ",\"ts\":" << event_copy.sick_trace_ts;
+
+      if (event_copy.sick_trace_phase == 'X') {
+	out_stream << ",\"dur\":" << event_copy.sick_trace_dur;
+      }
+      else {
+	out_stream << ",\"s\":\"t\"";
+      }
+
+      if (event_copy.sick_trace_arg != 0) {
+	out_stream << ",\"args\":{\"arg\":" << event_copy.sick_trace_arg << "}";
+      }
+
+      out_stream << "}";
+      first_event = false;
+
+    }
+
+    out_stream << "\n]}" << std::endl;
+
+  }
+
+  /**
+   * \brief Writes the buffered events as Chrome trace JSON to a file
+   * \param &file_path The destination file
+   * \return True if the file was written
+   */
+  inline bool SickTrace::WriteChromeTrace( const std::string &file_path ) const {
+
+    std::ofstream out_file(file_path.c_str());
+    if (!out_file) {
+      return false;
+    }
+
+    WriteChromeTrace(out_file);
+    return out_file.good();
+
+  }
+
+} //namespace SickToolbox
+
+#endif /* SICK_ENABLE_TRACE */
+
+#endif /* SICK_TRACE */